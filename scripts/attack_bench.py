@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+ * attack_bench.py : Détection des trous noirs et gris et PDR préservé sous attaque
+ * Blackhole and grayhole detection and PDR preserved under attack
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Sur un même placement et une même graine (scenario_gen.py), lance
+ * Cooja sans interface :
+ *   - baseline : aucun attaquant, chien de garde actif
+ *   - open     : --attackers motes attaquantes, chien de garde coupé chez
+ *                les honnêtes (DSERAN_CONF_WATCHDOG=0, confiance déclarative)
+ *   - guarded  : mêmes attaquants, chien de garde actif
+ * pour chaque attaque, puis relève le PDR des sources honnêtes, le taux de
+ * détection (attaquants nommés par au moins une trace DETECT), le délai
+ * médian de première détection et les faux positifs (honnêtes nommés).
+ * preserved = PDR / PDR baseline. Le tableau va dans
+ * results/attack/<version>/attack.csv et la détection cumulée au cours du
+ * temps dans <attaque>/dseran_detection.csv, au format de
+ * DATA/<protocole>_detection.csv (temps s, %).
+ * On the same placement and seed (scenario_gen.py), runs headless Cooja:
+ *   - baseline: no attacker, watchdog enabled
+ *   - open:     --attackers attacking motes, watchdog off on the honest
+ *               motes (DSERAN_CONF_WATCHDOG=0, declarative trust)
+ *   - guarded:  same attackers, watchdog enabled
+ * for every attack, then records the PDR of the honest sources, the
+ * detection rate (attackers named by at least one DETECT trace), the median
+ * delay to the first detection and the false positives (honest motes named).
+ * preserved = PDR / baseline PDR. The table goes to
+ * results/attack/<version>/attack.csv and the cumulative detection over time
+ * to <attack>/dseran_detection.csv, in the format of
+ * DATA/<protocol>_detection.csv (time s, %).
+ *
+ * Usage : attack_bench.py [--nodes 50] [--attackers 5] [--attacks blackhole,grayhole]
+ *                         [--attack-drop 50] [--duration 900] [--seed 1] [--tag v1.3] [--dry-run]
+ * COOJA_JAR (ou / or --cooja) désigne le jar Cooja / points to the Cooja jar.
+"""
+
+import argparse
+import csv
+import os
+import shutil
+import statistics
+import subprocess
+import sys
+
+import scenario_gen
+from scenario_gen import ROOT, SRC
+from scaling_bench import LOGPARSE, SINK_ID, build_dir, git_tag
+from sweep import run_cooja
+
+COLUMNS = ['tag', 'attack', 'variant', 'nodes', 'attackers', 'duration_s', 'status',
+           'pdr', 'preserved', 'detected', 'detection_rate', 'detect_median_s', 'false_positives']
+OPEN_DEFINES = 'DSERAN_CONF_WATCHDOG=0'
+DETECTION_STEP = 10   # s, pas de dseran_detection.csv / dseran_detection.csv step
+
+
+def make(build, defines):
+    """d-seran.cooja dans src/<build> ; renvoie (commande Cooja, firmware)
+    d-seran.cooja in src/<build>; returns (Cooja command, firmware)"""
+    cmd = ['make', '-j4', 'd-seran.cooja', 'TARGET=cooja', f'BUILD_DIR={build}']
+    if defines:
+        cmd.append(f'DEFINES={defines}')
+    return cmd, os.path.join(SRC, build, 'cooja', 'd-seran.cooja')
+
+
+def build(cmd):
+    r = subprocess.run(cmd, cwd=SRC, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    if r.returncode != 0:
+        print(r.stdout[-2000:], file=sys.stderr)
+        sys.exit(f'Attack: {" ".join(cmd[4:])} : ÉCHEC / FAILED')
+
+
+def read_csv(path):
+    if not os.path.isfile(path):
+        return []
+    with open(path, newline='', encoding='utf-8') as f:
+        return list(csv.DictReader(f))
+
+
+def metrics(rundir, n, bad_ids):
+    """PDR des sources honnêtes et détections depuis les CSV de logparse
+    PDR of the honest sources and detections from the logparse CSVs"""
+    subprocess.run([LOGPARSE, '-q', '-f', 'csv', '-o', rundir, os.path.join(rundir, 'd-seran.log')],
+                   check=True)
+    bad = set(bad_ids)
+    tx = {(r['src'], r['seq']) for r in read_csv(os.path.join(rundir, 'dseran_data_tx.csv'))
+          if int(r['src']) not in bad}
+    rx = {(r['src'], r['seq']) for r in read_csv(os.path.join(rundir, 'dseran_data_rx.csv'))} & tx
+
+    # Première détection de chaque nœud nommé / First detection of every named node
+    first = {}
+    for r in read_csv(os.path.join(rundir, 'dseran_detect.csv')):
+        node, t = int(r['addr']), int(r['t_us']) / 1e6
+        if node != SINK_ID and (node not in first or t < first[node]):
+            first[node] = t
+    hit = {k: t for k, t in first.items() if k in bad}
+    out = {'pdr': round(len(rx) / len(tx), 3) if tx else '', 'first': hit}
+    if bad:
+        out.update(detected=f'{len(hit)}/{len(bad)}',
+                   detection_rate=round(len(hit) / len(bad), 3),
+                   detect_median_s=round(statistics.median(hit.values()), 1) if hit else '',
+                   false_positives=f'{len(set(first) - bad)}/{n - 1 - len(bad)}')
+    return out
+
+
+def detection_series(path, first, count, duration):
+    """% cumulé d'attaquants détectés toutes les DETECTION_STEP s
+    Cumulative % of detected attackers every DETECTION_STEP s"""
+    with open(path, 'w', encoding='utf-8') as f:
+        for t in range(0, int(duration) + 1, DETECTION_STEP):
+            f.write(f'{t},{100.0 * sum(1 for v in first.values() if v <= t) / count}\n')
+
+
+def main():
+    p = argparse.ArgumentParser(description='Détection et PDR sous attaque / Detection and PDR under attack')
+    p.add_argument('--nodes', type=int, default=50)
+    p.add_argument('--attackers', type=int, default=5)
+    p.add_argument('--attacks', default='blackhole,grayhole')
+    p.add_argument('--attack-drop', type=int, default=None, help='%% jeté par un trou gris / %% dropped by a grayhole')
+    p.add_argument('--topology', choices=scenario_gen.TOPOLOGIES, default='uniform')
+    p.add_argument('--range', type=float, default=50.0, help='portée UDGM en m / UDGM range in m')
+    p.add_argument('--loss', type=float, default=0.0, help='taux de pertes en réception / reception loss ratio')
+    p.add_argument('--degree', type=float, default=8.0, help='degré moyen visé / target mean degree')
+    p.add_argument('--duration', type=float, default=900, help='s simulées / simulated s')
+    p.add_argument('--seed', type=int, default=1)
+    p.add_argument('--timeout', type=float, default=None, help='s réelles par exécution / wall s per run')
+    p.add_argument('--cooja', default=os.environ.get('COOJA_JAR', ''))
+    p.add_argument('--tag', default=None, help='version (défaut / default: git describe)')
+    p.add_argument('-o', '--out', default=os.path.join(ROOT, 'results', 'attack'))
+    p.add_argument('--no-build', action='store_true')
+    p.add_argument('--dry-run', action='store_true', help='.csc seulement / .csc only')
+    args = p.parse_args()
+
+    attacks = [a for a in args.attacks.split(',') if a]
+    for a in attacks:
+        if a not in scenario_gen.ATTACKS:
+            p.error(f'attaque inconnue / unknown attack: {a}')
+    tag = args.tag or git_tag()
+    if not args.dry_run and not os.path.isfile(args.cooja):
+        p.error('COOJA_JAR ou / or --cooja : jar Cooja introuvable / Cooja jar not found')
+    if not args.dry_run and not os.access(LOGPARSE, os.X_OK):
+        subprocess.run(['make', '-s', '-C', os.path.dirname(LOGPARSE), 'logparse'], check=True)
+
+    n = args.nodes
+    side = scenario_gen.area_for(n, args.range, args.degree)
+    points = scenario_gen.place(args.topology, n, side, args.range, args.seed)
+    attackers = scenario_gen.pick_attackers(n, args.attackers, args.seed)
+    bad_ids = scenario_gen.attacker_ids(n, attackers)
+
+    # Firmwares : honnête avec et sans chien de garde, un par attaque
+    # Firmwares: honest with and without the watchdog, one per attack
+    honest = {'guarded': make('build', ''), 'open': make(build_dir(OPEN_DEFINES), OPEN_DEFINES)}
+    evil = {a: make(*scenario_gen.attack_variant(a, args.attack_drop)) for a in attacks}
+    if not args.dry_run and not args.no_build:
+        for cmd, _ in list(honest.values()) + list(evil.values()):
+            build(cmd)
+
+    runs = [('-', 'baseline', [])]
+    runs += [(a, v, attackers) for a in attacks for v in ('open', 'guarded')]
+    rows, base_pdr = [], None
+    for attack, variant, bad in runs:
+        rundir = os.path.join(args.out, tag, attack if attack != '-' else '', variant)
+        if os.path.isdir(rundir):
+            shutil.rmtree(rundir)
+        os.makedirs(rundir)
+        cmd, fw = honest['open' if variant == 'open' else 'guarded']
+        scenario_gen.write_csc(os.path.join(rundir, 'sim.csc'), 'd-seran', points, args.seed, args.duration,
+                               title=f'attack-{attack}-{variant}', radio_range=args.range, loss=args.loss,
+                               commands=' '.join(cmd).replace('make', '$(MAKE)', 1), firmware=fw,
+                               attackers=bad, attack=attack if bad else None, attack_drop=args.attack_drop)
+        if args.dry_run:
+            print(f'Attack: {attack} {variant} : {rundir}/sim.csc')
+            continue
+
+        rc = run_cooja(rundir, args.cooja, 'd-seran', args.timeout)
+        m = metrics(rundir, n, bad_ids if bad else [])
+        if variant == 'baseline':
+            base_pdr = m['pdr']
+        elif variant == 'guarded':
+            detection_series(os.path.join(os.path.dirname(rundir), 'dseran_detection.csv'),
+                             m['first'], len(bad_ids), args.duration)
+        row = {'tag': tag, 'attack': attack, 'variant': variant, 'nodes': n, 'attackers': len(bad),
+               'duration_s': f'{args.duration:g}', 'status': 'ok' if rc == 0 else f'rc={rc}',
+               'preserved': round(m['pdr'] / base_pdr, 3) if base_pdr and m['pdr'] != '' else ''}
+        row.update({k: v for k, v in m.items() if k != 'first'})
+        rows.append(row)
+        print(f'Attack: {attack} {variant} {row["status"]} PDR {row["pdr"]}')
+    if args.dry_run:
+        print(f'Attack: attaquants / attackers node_id {",".join(map(str, bad_ids))}')
+        return
+
+    table = os.path.join(args.out, tag, 'attack.csv')
+    with open(table, 'w', newline='', encoding='utf-8') as f:
+        w = csv.DictWriter(f, COLUMNS, restval='')
+        w.writeheader()
+        w.writerows(rows)
+
+    shown = ['attack', 'variant', 'pdr', 'preserved', 'detected', 'detect_median_s', 'false_positives']
+    print(f'\nAttack {tag} ({n} nœuds / motes, {len(bad_ids)} attaquants / attackers) -> {table}')
+    print(' '.join(f'{c:>15}' for c in shown))
+    for r in rows:
+        print(' '.join(f'{str(r.get(c, "")):>15}' for c in shown))
+    sys.exit(0 if all(r['status'] == 'ok' for r in rows) else 1)
+
+
+if __name__ == '__main__':
+    main()
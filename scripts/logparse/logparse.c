@@ -0,0 +1,578 @@
+/*
+ * logparse.c : Analyseur natif des logs de simulation, en une passe
+ * Native single-pass simulation log parser
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Remplace la boucle d'expressions régulières de parse_logs.py. Le log est
+ * projeté en mémoire (mmap) et parcouru une seule fois ; pour chaque ligne,
+ * le module entre crochets donne le protocole (D-SERAN, AODV-DEMO, DSR-DEMO,
+ * OLSR-DEMO) et le premier mot du message est cherché dans une seule table
+ * de hachage de tous les enregistrements. Les valeurs sont écrites au fil de
+ * l'eau, en CSV et/ou en colonnes binaires, et agrégées par nœud et par
+ * tranche de temps pendant la lecture.
+ * Replaces parse_logs.py's regular expression loop. The log is memory-mapped
+ * and walked once; for each line, the bracketed module gives the protocol
+ * (D-SERAN, AODV-DEMO, DSR-DEMO, OLSR-DEMO) and the first word of the message
+ * is looked up in a single hash table of all records. Values are streamed
+ * out as CSV and/or binary columns, and aggregated per node and per time bin
+ * while reading.
+ *
+ * Préfixes Cooja reconnus / Recognized Cooja prefixes:
+ *   <µs>\tID:<n>\t...         (ScriptRunner des .csc / .csc ScriptRunner)
+ *   [hh:]mm:ss.mmm\tID:<n>\t... (LogListener)
+ * Sans préfixe, nœud 0 et temps -1 / Without a prefix, node 0 and time -1.
+ *
+ * Format colonnes (.col), petit-boutiste / Column format (.col), little-endian:
+ *   "DSCOL1\0\0", u32 ncols, ncols noms terminés par \0 / NUL-terminated names,
+ *   puis des blocs / then blocks: u32 nrows, ncols x nrows x i64
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_ARGS   5
+#define BLOCK_ROWS 65536
+#define HASH_SIZE  64     // puissance de 2 > 2 x enregistrements / power of 2 > 2 x records
+
+// Protocoles, dans l'ordre de leurs noms de fichiers / Protocols, in the order of their file names
+enum { P_DSERAN, P_AODV, P_DSR, P_OLSR, NPROTO };
+static const char *proto_names[NPROTO] = { "dseran", "aodv", "dsr", "olsr" };
+static const char *proto_modules[NPROTO] = { "D-SERAN", "AODV-DEMO", "DSR-DEMO", "OLSR-DEMO" };
+
+// Enregistrements : mot-clé, nom de sortie (clés de parse_logs.py), champs
+// Records: keyword, output name (parse_logs.py keys), fields
+struct record {
+  const char *kw;
+  const char *key;
+  uint8_t nargs;
+  const char *fields[MAX_ARGS];
+};
+
+static const struct record records[] = {
+  { "ENERGY",         "energy",        2, { "a0", "a1" } },
+  { "SEND_UDP",       "send",          2, { "a0", "a1" } },
+  { "RECV",           "recv",          2, { "a0", "a1" } },
+  { "HOP",            "hop",           2, { "a0", "a1" } },
+  { "PDR",            "pdr",           2, { "a0", "a1" } },
+  { "LOSS",           "loss",          2, { "a0", "a1" } },
+  { "LIFETIME",       "lifetime",      2, { "addr", "t" } },
+  { "THROUGHPUT",     "throughput",    2, { "a0", "a1" } },
+  { "MOVE",           "mobility",      3, { "addr0", "addr1", "t" } },
+  { "NH_STATS",       "nhstats",       3, { "queries", "updates", "scans" } },
+  { "DATA_TX",        "data_tx",       3, { "src", "seq", "t" } },
+  { "DATA_RX",        "data_rx",       4, { "src", "seq", "latency_ms", "hops" } },
+  { "LOCAL_REPAIR",   "repair",        2, { "addr", "t" } },
+  { "REPAIR",         "repair_ms",     4, { "ms", "lost", "cause", "t" } },
+  { "HANDOFF",        "handoff",       3, { "addr", "life_ms", "t" } },
+  { "DETECT",         "detect",        5, { "addr", "expected", "forwarded", "dropped", "t" } },
+  { "HELLO_SUPPRESS", "suppress",      2, { "interval_s", "t" } },
+  { "TRICKLE_RESET",  "trickle_reset", 2, { "cause", "t" } },
+  { "LQE",            "lqe",           4, { "addr", "hrr", "etx100", "t" } },
+  { "ENERGEST",       "energest",      5, { "cpu", "lpm", "tx", "rx", "t" } },
+  { "POS",            "pos",           3, { "x10", "y10", "dist100" } },
+  { "ROUTE_DISC",     "route_disc",    2, { "count", "t" } },
+  { "ROUTE_CACHE",    "route_cache",   4, { "lookups", "hits", "salvaged", "t" } },
+  { "CTRL_BYTES",     "ctrl_bytes",    2, { "bytes", "t" } },
+  { "AGG",            "agg",           4, { "frames", "readings", "dropped", "t" } },
+  { "HELLO_MSG",      "hello_msg",     2, { "count", "t" } },
+};
+#define NREC (sizeof(records) / sizeof(records[0]))
+
+static uint8_t hash_slot[HASH_SIZE];   // indice + 1, 0 : vide / index + 1, 0: empty
+
+// Sortie colonnes d'un (protocole, enregistrement) / Column output of a (protocol, record)
+struct colout {
+  FILE *csv;
+  FILE *col;
+  uint32_t rows;
+  int64_t *block;          // [col][row]
+};
+
+// Agrégats sur le premier champ / Aggregates over the first field
+struct agg {
+  uint64_t count;
+  int64_t first_us, last_us;
+  int64_t sum, min, max;
+};
+
+struct aggvec {
+  struct agg *v;
+  size_t len;
+};
+
+static struct colout outs[NPROTO][NREC];
+static struct aggvec by_node[NPROTO][NREC];
+static struct aggvec by_time[NPROTO][NREC];
+
+static const char *out_dir = ".";
+static int want_csv = 1, want_col = 0;
+static int64_t bin_us = 10 * 1000000LL;
+static uint64_t n_lines, n_records;
+
+static uint32_t hash_word(const char *s, size_t n) {
+  uint32_t h = 2166136261u;
+  while(n--) {
+    h = (h ^ (uint8_t)*s++) * 16777619u;
+  }
+  return h;
+}
+
+static void hash_init(void) {
+  for(size_t i=0; i<NREC; i++) {
+    uint32_t h = hash_word(records[i].kw, strlen(records[i].kw));
+    while(hash_slot[h & (HASH_SIZE - 1)] != 0) {
+      h++;
+    }
+    hash_slot[h & (HASH_SIZE - 1)] = i + 1;
+  }
+}
+
+static int lookup(const char *w, size_t n) {
+  uint32_t h = hash_word(w, n);
+  uint8_t s;
+
+  while((s = hash_slot[h & (HASH_SIZE - 1)]) != 0) {
+    const char *kw = records[s - 1].kw;
+    if(strlen(kw) == n && memcmp(kw, w, n) == 0) {
+      return s - 1;
+    }
+    h++;
+  }
+  return -1;
+}
+
+static FILE *open_out(int p, int r, const char *ext) {
+  char path[4096];
+  FILE *f;
+
+  snprintf(path, sizeof(path), "%s/%s_%s.%s", out_dir, proto_names[p], records[r].key, ext);
+  f = fopen(path, "wb");
+  if(f == NULL) {
+    fprintf(stderr, "logparse: %s: %s\n", path, strerror(errno));
+    exit(1);
+  }
+  setvbuf(f, NULL, _IOFBF, 1 << 20);
+  return f;
+}
+
+static void col_flush(struct colout *o, int ncols) {
+  if(o->rows == 0) {
+    return;
+  }
+  fwrite(&o->rows, sizeof(o->rows), 1, o->col);
+  for(int c=0; c<ncols; c++) {
+    fwrite(o->block + (size_t)c * BLOCK_ROWS, sizeof(int64_t), o->rows, o->col);
+  }
+  o->rows = 0;
+}
+
+static struct agg *agg_at(struct aggvec *a, size_t i) {
+  if(i >= a->len) {
+    size_t n = a->len ? a->len : 64;
+    while(n <= i) {
+      n *= 2;
+    }
+    a->v = realloc(a->v, n * sizeof(struct agg));
+    if(a->v == NULL) {
+      perror("logparse");
+      exit(1);
+    }
+    memset(a->v + a->len, 0, (n - a->len) * sizeof(struct agg));
+    a->len = n;
+  }
+  return &a->v[i];
+}
+
+static void agg_add(struct agg *g, int64_t t, int64_t v) {
+  if(g->count++ == 0) {
+    g->first_us = t;
+    g->min = g->max = v;
+  }
+  g->last_us = t;
+  g->sum += v;
+  if(v < g->min) {
+    g->min = v;
+  }
+  if(v > g->max) {
+    g->max = v;
+  }
+}
+
+// Écriture décimale sans printf / Decimal writing without printf
+static char *put_int(char *q, int64_t v) {
+  char tmp[20];
+  int n = 0;
+  uint64_t u;
+
+  if(v < 0) {
+    *q++ = '-';
+    u = -(uint64_t)v;
+  } else {
+    u = v;
+  }
+  do {
+    tmp[n++] = '0' + u % 10;
+    u /= 10;
+  } while(u);
+  while(n) {
+    *q++ = tmp[--n];
+  }
+  return q;
+}
+
+static void emit(int p, int r, uint32_t node, int64_t t, const int64_t *a) {
+  const struct record *rec = &records[r];
+  struct colout *o = &outs[p][r];
+  int ncols = 2 + rec->nargs;
+
+  if(want_csv) {
+    if(o->csv == NULL) {
+      o->csv = open_out(p, r, "csv");
+      fputs("node,t_us", o->csv);
+      for(int i=0; i<rec->nargs; i++) {
+        fprintf(o->csv, ",%s", rec->fields[i]);
+      }
+      fputc('\n', o->csv);
+    }
+    char line[16 * (2 + MAX_ARGS)];
+    char *q = put_int(line, node);
+    *q++ = ',';
+    q = put_int(q, t);
+    for(int i=0; i<rec->nargs; i++) {
+      *q++ = ',';
+      q = put_int(q, a[i]);
+    }
+    *q++ = '\n';
+    fwrite_unlocked(line, 1, q - line, o->csv);
+  }
+  if(want_col) {
+    if(o->col == NULL) {
+      uint32_t nc = ncols;
+      o->col = open_out(p, r, "col");
+      o->block = malloc((size_t)ncols * BLOCK_ROWS * sizeof(int64_t));
+      fwrite("DSCOL1\0\0", 8, 1, o->col);
+      fwrite(&nc, sizeof(nc), 1, o->col);
+      fwrite("node", 5, 1, o->col);
+      fwrite("t_us", 5, 1, o->col);
+      for(int i=0; i<rec->nargs; i++) {
+        fwrite(rec->fields[i], strlen(rec->fields[i]) + 1, 1, o->col);
+      }
+    }
+    o->block[o->rows] = node;
+    o->block[BLOCK_ROWS + o->rows] = t;
+    for(int i=0; i<rec->nargs; i++) {
+      o->block[(size_t)(2 + i) * BLOCK_ROWS + o->rows] = a[i];
+    }
+    if(++o->rows == BLOCK_ROWS) {
+      col_flush(o, ncols);
+    }
+  }
+
+  agg_add(agg_at(&by_node[p][r], node), t, a[0]);
+  if(t >= 0) {
+    agg_add(agg_at(&by_time[p][r], t / bin_us), t, a[0]);
+  }
+}
+
+static int is_digit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Entier non signé ; avance *s / Unsigned integer; advances *s
+static int64_t parse_uint(const char **s, const char *end) {
+  int64_t v = 0;
+  const char *p = *s;
+
+  while(p < end && is_digit(*p)) {
+    v = v * 10 + (*p++ - '0');
+  }
+  *s = p;
+  return v;
+}
+
+// Préfixe Cooja : temps en µs et nœud / Cooja prefix: time in µs and node
+static void parse_prefix(const char *p, const char *end, int64_t *t, uint32_t *node) {
+  const char *q = p;
+
+  *t = -1;
+  *node = 0;
+  if(q < end && is_digit(*q)) {
+    int64_t v = parse_uint(&q, end);
+    if(q < end && *q == ':') {
+      // [hh:]mm:ss.mmm
+      int64_t ms = v;
+      while(q < end && *q == ':') {
+        q++;
+        ms = ms * 60 + parse_uint(&q, end);
+      }
+      ms *= 1000;
+      if(q < end && *q == '.') {
+        q++;
+        ms += parse_uint(&q, end);
+      }
+      *t = ms * 1000;
+    } else {
+      *t = v;
+    }
+  }
+  while(q < end && (*q == ' ' || *q == '\t')) {
+    q++;
+  }
+  if(end - q > 3 && memcmp(q, "ID:", 3) == 0) {
+    q += 3;
+    *node = (uint32_t)parse_uint(&q, end);
+  }
+}
+
+// Protocole d'après le module entre crochets / Protocol from the bracketed module
+static int module_proto(const char *lb, const char *rb) {
+  const char *m = memchr(lb, ':', rb - lb);
+  size_t n;
+
+  if(m == NULL) {
+    return -1;
+  }
+  m++;
+  while(m < rb && *m == ' ') {
+    m++;
+  }
+  n = rb - m;
+  while(n > 0 && m[n - 1] == ' ') {
+    n--;
+  }
+  for(int p=0; p<NPROTO; p++) {
+    if(strlen(proto_modules[p]) == n && memcmp(proto_modules[p], m, n) == 0) {
+      return p;
+    }
+  }
+  return -1;
+}
+
+static void parse_line(const char *p, const char *end, int default_proto) {
+  const char *rb = memrchr(p, ']', end - p);
+  const char *msg, *w;
+  int proto, r;
+  int64_t t, a[MAX_ARGS];
+  uint32_t node;
+
+  // Comme parse_logs.py : le message suit le dernier ']' / Like parse_logs.py: the message follows the last ']'
+  if(rb != NULL) {
+    const char *lb = memrchr(p, '[', rb - p);
+    if(lb == NULL || (proto = module_proto(lb + 1, rb)) < 0) {
+      return;
+    }
+    msg = rb + 1;
+  } else {
+    proto = default_proto;
+    msg = p;
+  }
+  while(msg < end && *msg == ' ') {
+    msg++;
+  }
+  w = msg;
+  while(msg < end && *msg != ' ' && *msg != '\t' && *msg != '\r') {
+    msg++;
+  }
+  if(msg == w || (r = lookup(w, msg - w)) < 0) {
+    return;
+  }
+  for(int i=0; i<records[r].nargs; i++) {
+    while(msg < end && (*msg == ' ' || *msg == '\t')) {
+      msg++;
+    }
+    if(msg == end || !is_digit(*msg)) {
+      return;
+    }
+    a[i] = parse_uint(&msg, end);
+  }
+  parse_prefix(p, rb != NULL ? rb : end, &t, &node);
+  emit(proto, r, node, t, a);
+  n_records++;
+}
+
+static int file_proto(const char *path) {
+  const char *b = strrchr(path, '/');
+  b = b ? b + 1 : path;
+  if(strstr(b, "seran")) {
+    return P_DSERAN;
+  }
+  for(int p=P_AODV; p<NPROTO; p++) {
+    if(strstr(b, proto_names[p])) {
+      return p;
+    }
+  }
+  return P_DSERAN;
+}
+
+static size_t parse_file(const char *path, int proto) {
+  struct stat st;
+  const char *data, *p, *end;
+  int fd = open(path, O_RDONLY);
+
+  if(fd < 0 || fstat(fd, &st) < 0) {
+    fprintf(stderr, "logparse: %s: %s\n", path, strerror(errno));
+    exit(1);
+  }
+  if(st.st_size == 0) {
+    close(fd);
+    return 0;
+  }
+  data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if(data == MAP_FAILED) {
+    fprintf(stderr, "logparse: %s: %s\n", path, strerror(errno));
+    exit(1);
+  }
+  madvise((void *)data, st.st_size, MADV_SEQUENTIAL);
+  if(proto < 0) {
+    proto = file_proto(path);
+  }
+
+  p = data;
+  end = data + st.st_size;
+  while(p < end) {
+    const char *nl = memchr(p, '\n', end - p);
+    const char *eol = nl ? nl : end;
+    parse_line(p, eol, proto);
+    n_lines++;
+    p = eol + 1;
+  }
+  munmap((void *)data, st.st_size);
+  close(fd);
+  return st.st_size;
+}
+
+static void write_aggregates(void) {
+  for(int p=0; p<NPROTO; p++) {
+    FILE *fn = NULL, *ft = NULL;
+    char path[4096];
+
+    for(size_t r=0; r<NREC; r++) {
+      if(by_node[p][r].len == 0) {
+        continue;
+      }
+      if(fn == NULL) {
+        snprintf(path, sizeof(path), "%s/%s_by_node.csv", out_dir, proto_names[p]);
+        fn = fopen(path, "w");
+        snprintf(path, sizeof(path), "%s/%s_by_time.csv", out_dir, proto_names[p]);
+        ft = fopen(path, "w");
+        if(fn == NULL || ft == NULL) {
+          fprintf(stderr, "logparse: %s: %s\n", path, strerror(errno));
+          exit(1);
+        }
+        fputs("node,record,count,first_us,last_us,sum,min,max\n", fn);
+        fputs("t_s,record,count,sum,min,max\n", ft);
+      }
+      for(size_t i=0; i<by_node[p][r].len; i++) {
+        const struct agg *g = &by_node[p][r].v[i];
+        if(g->count) {
+          fprintf(fn, "%zu,%s,%llu,%lld,%lld,%lld,%lld,%lld\n", i, records[r].key,
+                  (unsigned long long)g->count, (long long)g->first_us, (long long)g->last_us,
+                  (long long)g->sum, (long long)g->min, (long long)g->max);
+        }
+      }
+      for(size_t i=0; i<by_time[p][r].len; i++) {
+        const struct agg *g = &by_time[p][r].v[i];
+        if(g->count) {
+          fprintf(ft, "%lld,%s,%llu,%lld,%lld,%lld\n", (long long)(i * bin_us / 1000000),
+                  records[r].key, (unsigned long long)g->count, (long long)g->sum,
+                  (long long)g->min, (long long)g->max);
+        }
+      }
+    }
+    if(fn != NULL) {
+      fclose(fn);
+      fclose(ft);
+    }
+  }
+}
+
+static void usage(void) {
+  fprintf(stderr,
+          "usage: logparse [-o dir] [-p dseran|aodv|dsr|olsr] [-f csv|col|both] [-b bin_s] [-q] log...\n"
+          "  -p : protocole des lignes sans module / protocol of lines without a module\n"
+          "       (défaut : d'après le nom du fichier / default: from the file name)\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  struct timespec t0, t1;
+  int proto = -1, quiet = 0, c;
+  size_t bytes = 0;
+  double s;
+
+  while((c = getopt(argc, argv, "o:p:f:b:q")) != -1) {
+    switch(c) {
+    case 'o':
+      out_dir = optarg;
+      break;
+    case 'p':
+      for(proto=0; proto<NPROTO && strcmp(optarg, proto_names[proto]); proto++);
+      if(proto == NPROTO) {
+        usage();
+      }
+      break;
+    case 'f':
+      want_csv = strcmp(optarg, "col") != 0;
+      want_col = strcmp(optarg, "csv") != 0;
+      break;
+    case 'b':
+      bin_us = (int64_t)(atof(optarg) * 1000000);
+      if(bin_us <= 0) {
+        usage();
+      }
+      break;
+    case 'q':
+      quiet = 1;
+      break;
+    default:
+      usage();
+    }
+  }
+  if(optind >= argc) {
+    usage();
+  }
+
+  if(mkdir(out_dir, 0777) < 0 && errno != EEXIST) {
+    fprintf(stderr, "logparse: %s: %s\n", out_dir, strerror(errno));
+    return 1;
+  }
+  hash_init();
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for(int i=optind; i<argc; i++) {
+    bytes += parse_file(argv[i], proto);
+  }
+  for(int p=0; p<NPROTO; p++) {
+    for(size_t r=0; r<NREC; r++) {
+      if(outs[p][r].csv) {
+        fclose(outs[p][r].csv);
+      }
+      if(outs[p][r].col) {
+        col_flush(&outs[p][r], 2 + records[r].nargs);
+        fclose(outs[p][r].col);
+        free(outs[p][r].block);
+      }
+    }
+  }
+  write_aggregates();
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+
+  s = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+  if(!quiet) {
+    fprintf(stderr, "logparse: %.1f MB, %llu lignes / lines, %llu enregistrements / records, "
+            "%.2f s, %.0f MB/s\n", bytes / 1e6, (unsigned long long)n_lines,
+            (unsigned long long)n_records, s, s > 0 ? bytes / 1e6 / s : 0.0);
+  }
+  return 0;
+}
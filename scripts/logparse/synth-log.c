@@ -0,0 +1,81 @@
+/*
+ * synth-log.c : Log Cooja synthétique pour mesurer le débit de logparse
+ * Synthetic Cooja log to measure logparse throughput
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Mélange des quatre protocoles avec le préfixe ScriptRunner des .csc
+ * (µs, ID) et des lignes sans enregistrement (Main, CSMA, avertissements),
+ * dans les proportions de results/d-seran.log.
+ * Mix of the four protocols with the .csc ScriptRunner prefix (µs, ID) and
+ * lines without records (Main, CSMA, warnings), in the proportions of
+ * results/d-seran.log.
+ *
+ * Usage : synth-log <Mo / MB> <fichier / file>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+static uint32_t lcg_state = 2025;
+static uint32_t lcg_rand(void) {
+  lcg_state = lcg_state * 1103515245u + 12345u;
+  return lcg_state >> 8;
+}
+
+int main(int argc, char **argv) {
+  static const char *modules[] = { "D-SERAN   ", "AODV-DEMO ", "DSR-DEMO  ", "OLSR-DEMO " };
+  unsigned long long target, written = 0, t = 0;
+  FILE *f;
+
+  if(argc != 3) {
+    fprintf(stderr, "usage: synth-log <MB> <file>\n");
+    return 2;
+  }
+  target = strtoull(argv[1], NULL, 10) * 1000000ull;
+  f = fopen(argv[2], "w");
+  if(f == NULL) {
+    perror(argv[2]);
+    return 1;
+  }
+  setvbuf(f, NULL, _IOFBF, 1 << 20);
+
+  while(written < target) {
+    unsigned id = 1 + lcg_rand() % 50;
+    const char *m = modules[lcg_rand() % 4];
+    unsigned k = lcg_rand() % 20;
+    unsigned ms = (unsigned)(t / 1000);
+    int n;
+
+    t += 1000 + lcg_rand() % 20000;
+    if(k < 6) {
+      n = fprintf(f, "%llu\tID:%u\t[WARN: D-SERAN   ] Aucun voisin fiable pour le routage\n", t, id);
+    } else if(k < 7) {
+      n = fprintf(f, "%llu\tID:%u\t[WARN: CSMA      ] frame from 0%u.0%u.0%u dropped\n", t, id, id, id, id);
+    } else if(k < 11) {
+      n = fprintf(f, "%llu\tID:%u\t[INFO: %s] ENERGY %u %u\n", t, id, m, 40000 + lcg_rand() % 20000, ms);
+    } else if(k < 14) {
+      n = fprintf(f, "%llu\tID:%u\t[INFO: %s] SEND_UDP %u %u\n", t, id, m, lcg_rand() % 60000, ms);
+    } else if(k < 15) {
+      n = fprintf(f, "%llu\tID:%u\t[INFO: D-SERAN   ] DATA_TX %u %u %u\n", t, id, id, lcg_rand() % 65536, ms);
+    } else if(k < 16) {
+      n = fprintf(f, "%llu\tID:%u\t[INFO: D-SERAN   ] DATA_RX %u %u %u %u\n", t, id, 1 + lcg_rand() % 50,
+                  lcg_rand() % 65536, lcg_rand() % 2000, 1 + lcg_rand() % 6);
+    } else if(k < 17) {
+      n = fprintf(f, "%llu\tID:%u\t[INFO: D-SERAN   ] LQE %u %u %u %u\n", t, id, lcg_rand() % 50,
+                  lcg_rand() % 101, 100 + lcg_rand() % 900, ms);
+    } else if(k < 18) {
+      n = fprintf(f, "%llu\tID:%u\t[INFO: D-SERAN   ] NH_STATS %u %u %u\n", t, id, lcg_rand() % 100000,
+                  lcg_rand() % 100000, lcg_rand() % 1000);
+    } else if(k < 19) {
+      n = fprintf(f, "%llu\tID:%u\t[INFO: DSR-DEMO  ] ROUTE_DISC %u %u\n", t, id, lcg_rand() % 1000, ms);
+    } else {
+      n = fprintf(f, "%llu\tID:%u\t[INFO: OLSR-DEMO ] HELLO_MSG %u %u\n", t, id, lcg_rand() % 1000, ms);
+    }
+    written += n;
+  }
+  fclose(f);
+  return 0;
+}
@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+ * mobility_gen.py : Générateur de traces de mobilité pour le plugin Mobility de Cooja
+ * Mobility trace generator for the Cooja Mobility plugin
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Précalcule en une passe vectorisée (numpy, un pas pour tous les nœuds à la
+ * fois) les positions de milliers de nœuds selon les modèles de
+ * src/mobility.c : Random Waypoint avec pauses ou Gauss-Markov, mêmes
+ * paramètres, même générateur xorshift32 et même graine par nœud
+ * (graine * 2654435761 ^ (node_id * 40503 + 1)). En RWP, la trajectoire du
+ * nœud d'indice i est celle que calcule le micrologiciel de node_id = i + 1 ;
+ * en Gauss-Markov, les fonctions mathématiques de la libm peuvent faire
+ * diverger les deux au bout de quelques pas, les statistiques restent égales.
+ * Precomputes in one vectorized pass (numpy, one step for all nodes at once)
+ * the positions of thousands of nodes with the src/mobility.c models: Random
+ * Waypoint with pauses or Gauss-Markov, same parameters, same xorshift32
+ * generator and same per-node seed. With RWP, the trajectory of node index i
+ * is the one the firmware computes for node_id = i + 1; with Gauss-Markov,
+ * libm differences may make them drift apart after a few steps, statistics
+ * remain equal.
+ *
+ * Sortie : lignes "<indice> <temps s> <x> <y>" triées par temps, seules les
+ * positions qui changent sont écrites. À charger dans la simulation avec :
+ * Output: "<index> <time s> <x> <y>" lines sorted by time, only changed
+ * positions are written. Load it in the simulation with:
+ *   <plugin>Mobility<plugin_config>
+ *     <positions EXPORT="copy">[CONFIG_DIR]/positions.dat</positions>
+ *   </plugin_config></plugin>
+ *
+ * Usage : mobility_gen.py -n 2000 -d 3600 [--model rwp|gm] [--seed 2025] [-o positions.dat]
+"""
+
+import argparse
+import sys
+import time
+
+import numpy as np
+
+# Valeurs par défaut de src/mobility.h / Defaults from src/mobility.h
+AREA = 100.0
+SPEED_MIN = 1.0
+SPEED_MAX = 5.0
+PAUSE_MAX = 10
+GM_ALPHA = 0.75
+SEED = 2025
+
+F32 = np.float32
+
+
+class Xorshift32:
+    """Un générateur par nœud, avancé seulement pour les nœuds masqués
+    One generator per node, advanced only for the masked nodes"""
+
+    def __init__(self, seed, node_ids):
+        ids = node_ids.astype(np.uint32)
+        s = np.uint32((seed * 2654435761) & 0xffffffff) ^ (ids * np.uint32(40503) + np.uint32(1))
+        s[s == 0] = 1
+        self.state = s
+
+    def next(self, mask=None):
+        s = self.state if mask is None else self.state[mask]
+        s ^= s << np.uint32(13)
+        s ^= s >> np.uint32(17)
+        s ^= s << np.uint32(5)
+        if mask is not None:
+            self.state[mask] = s
+        return s
+
+    def uniform(self, mask=None):
+        return (self.next(mask) >> np.uint32(8)).astype(F32) * F32(1.0 / 16777216.0)
+
+    def gauss(self, mask=None):
+        u = F32(1.0) - self.uniform(mask)
+        return (np.sqrt(F32(-2.0) * np.log(u)) * np.cos(F32(2.0 * np.pi) * self.uniform(mask))).astype(F32)
+
+
+class RandomWaypoint:
+    """Destination uniforme, vitesse uniforme, pause uniforme à l'arrivée
+    Uniform waypoint, uniform speed, uniform pause on arrival"""
+
+    def __init__(self, rng, n, args):
+        self.rng, self.a = rng, args
+        self.x = rng.uniform() * F32(args.area)
+        self.y = rng.uniform() * F32(args.area)
+        self.wx = np.empty(n, F32)
+        self.wy = np.empty(n, F32)
+        self.speed = np.empty(n, F32)
+        self.pause = np.zeros(n, np.int32)
+        self.next_leg(np.ones(n, bool))
+
+    def next_leg(self, m):
+        a = self.a
+        self.wx[m] = self.rng.uniform(m) * F32(a.area)
+        self.wy[m] = self.rng.uniform(m) * F32(a.area)
+        self.speed[m] = F32(a.speed_min) + self.rng.uniform(m) * F32(a.speed_max - a.speed_min)
+
+    def step(self):
+        """Un pas ; renvoie le masque des nœuds déplacés / One step; returns the moved-node mask"""
+        paused = self.pause > 0
+        self.pause[paused] -= 1
+        moving = ~paused
+        dx = self.wx - self.x
+        dy = self.wy - self.y
+        left = np.sqrt(dx * dx + dy * dy)
+        step = self.speed * F32(self.a.dt)
+
+        arrive = moving & (left <= step)
+        go = moving & ~arrive
+        self.x[go] += dx[go] * step[go] / left[go]
+        self.y[go] += dy[go] * step[go] / left[go]
+        if arrive.any():
+            self.x[arrive] = self.wx[arrive]
+            self.y[arrive] = self.wy[arrive]
+            pause = self.rng.uniform(arrive) * F32(self.a.pause_max) / F32(self.a.dt)
+            self.pause[arrive] = pause.astype(np.int32)
+            self.next_leg(arrive)
+        return moving
+
+
+class GaussMarkov:
+    """Vitesse et direction à mémoire, direction moyenne vers le centre près des bords
+    Speed and direction with memory, mean direction towards the centre near edges"""
+
+    def __init__(self, rng, n, args):
+        self.rng, self.a = rng, args
+        self.x = rng.uniform() * F32(args.area)
+        self.y = rng.uniform() * F32(args.area)
+        self.speed = np.full(n, (args.speed_min + args.speed_max) / 2, F32)
+        self.direction = rng.uniform() * F32(2 * np.pi)
+        self.mean_dir = self.direction.copy()
+        self.alpha = F32(args.alpha ** args.dt)
+
+    def step(self):
+        a, area = self.alpha, F32(self.a.area)
+        noise = np.sqrt(F32(1) - a * a)
+        edge = area / F32(10)
+        mean_dir = self.mean_dir.copy()
+
+        near = (self.x < edge) | (self.x > area - edge) | (self.y < edge) | (self.y > area - edge)
+        if near.any():
+            c = np.arctan2(area / 2 - self.y[near], area / 2 - self.x[near])
+            # Écart angulaire le plus court / Shortest angular gap
+            c -= F32(2 * np.pi) * np.round((c - self.direction[near]) / F32(2 * np.pi))
+            mean_dir[near] = c
+
+        mean_speed = F32((self.a.speed_min + self.a.speed_max) / 2)
+        self.speed = a * self.speed + (1 - a) * mean_speed + \
+            noise * F32((self.a.speed_max - self.a.speed_min) / 4) * self.rng.gauss()
+        self.direction = a * self.direction + (1 - a) * mean_dir + \
+            noise * F32(np.pi / 4) * self.rng.gauss()
+        np.clip(self.speed, 0, self.a.speed_max, out=self.speed)
+
+        self.x += self.speed * np.cos(self.direction) * F32(self.a.dt)
+        self.y += self.speed * np.sin(self.direction) * F32(self.a.dt)
+
+        # Rebond sur les limites de la zone / Bounce on the area boundaries
+        out = (self.x < 0) | (self.x > area)
+        self.x[out] = np.where(self.x[out] < 0, -self.x[out], 2 * area - self.x[out])
+        self.direction[out] = F32(np.pi) - self.direction[out]
+        out = (self.y < 0) | (self.y > area)
+        self.y[out] = np.where(self.y[out] < 0, -self.y[out], 2 * area - self.y[out])
+        self.direction[out] = -self.direction[out]
+        return np.ones(len(self.x), bool)
+
+
+def write_block(dst, idx, t, x, y):
+    """Une ligne par nœud déplacé, un seul formatage par pas
+    One line per moved node, a single formatting call per step"""
+    k = len(idx)
+    if k == 0:
+        return
+    fields = np.empty(3 * k)
+    fields[0::3] = idx
+    fields[1::3] = x
+    fields[2::3] = y
+    dst.write((f'%d {t:.3f} %.2f %.2f\n' * k) % tuple(fields.tolist()))
+
+
+def main():
+    p = argparse.ArgumentParser(description='Traces de mobilité Cooja / Cooja mobility traces')
+    p.add_argument('-n', '--nodes', type=int, default=100)
+    p.add_argument('-d', '--duration', type=float, default=3600, help='s')
+    p.add_argument('--dt', type=float, default=1.0, help='pas en s / step in s (DSERAN_CONF_MOBILITY_INTERVAL)')
+    p.add_argument('--model', choices=['rwp', 'gm'], default='rwp')
+    p.add_argument('--seed', type=int, default=SEED)
+    p.add_argument('--area', type=float, default=AREA, help='m')
+    p.add_argument('--speed-min', type=float, default=SPEED_MIN, help='m/s')
+    p.add_argument('--speed-max', type=float, default=SPEED_MAX, help='m/s')
+    p.add_argument('--pause-max', type=float, default=PAUSE_MAX, help='s')
+    p.add_argument('--alpha', type=float, default=GM_ALPHA, help='mémoire Gauss-Markov / Gauss-Markov memory')
+    p.add_argument('--first-id', type=int, default=1, help='node_id du nœud d\'indice 0 / node_id of index 0')
+    p.add_argument('-o', '--output', default='positions.dat')
+    args = p.parse_args()
+
+    n = args.nodes
+    idx = np.arange(n)
+    rng = Xorshift32(args.seed, idx + args.first_id)
+    model = (GaussMarkov if args.model == 'gm' else RandomWaypoint)(rng, n, args)
+    steps = int(args.duration / args.dt)
+
+    t0 = time.perf_counter()
+    lines = n
+    with open(args.output, 'w', encoding='utf-8') as dst:
+        dst.write(f'# D-SERAN {args.model} seed={args.seed} nodes={n} area={args.area} dt={args.dt}\n')
+        write_block(dst, idx, 0.0, model.x, model.y)
+        for k in range(1, steps + 1):
+            moved = model.step()
+            write_block(dst, idx[moved], k * args.dt, model.x[moved], model.y[moved])
+            lines += int(moved.sum())
+    elapsed = time.perf_counter() - t0
+
+    print(f'Mobility Gen: {n} nœuds / nodes, {steps} pas / steps, {lines} positions -> {args.output} '
+          f'en / in {elapsed:.1f} s ({n * steps / elapsed / 1e6:.2f} M nœud-pas/s / node-steps/s)',
+          file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
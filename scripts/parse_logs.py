@@ -16,8 +16,8 @@
 """
 
 import re
-import pandas as pd
 import os
+import subprocess
 import sys
 import time
 
@@ -37,13 +37,31 @@ print(f"Parse Logs: Output directory: {OUTPUT_DIR}")
 # Configuration des fichiers de logs / Log files configuration
 LOGS = {
     'dseran': os.path.join(INPUT_DIR, 'd-seran.log'),
-    'aodv': os.path.join(INPUT_DIR, 'aodv.log')
+    'aodv': os.path.join(INPUT_DIR, 'aodv.log'),
+    'dsr': os.path.join(INPUT_DIR, 'dsr.log'),
+    'olsr': os.path.join(INPUT_DIR, 'olsr.log')
 }
 
+# Analyseur natif s'il est compilé (make -C scripts/logparse) : une passe, mêmes fichiers
+# <proto>_<clé>.csv que la boucle Python, plus les agrégats par nœud et par temps
+# Native parser when built (make -C scripts/logparse): one pass, the same <proto>_<key>.csv
+# files as the Python loop, plus the per-node and per-time aggregates
+LOGPARSE = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'logparse', 'logparse')
+if os.access(LOGPARSE, os.X_OK) and os.environ.get('DSERAN_PY_PARSER') is None:
+    os.makedirs(OUTPUT_DIR, exist_ok=True)
+    found = [f for f in LOGS.values() if os.path.exists(f)]
+    if found:
+        print(f"Parse Logs: analyseur natif / native parser: {LOGPARSE}", flush=True)
+        sys.exit(subprocess.call([LOGPARSE, '-o', OUTPUT_DIR] + found))
+
+# Préfixe Cooja : <µs> ou [hh:]mm:ss.mmm, puis ID:<n> ; sans préfixe, nœud 0 et temps -1
+# Cooja prefix: <µs> or [hh:]mm:ss.mmm, then ID:<n>; without a prefix, node 0 and time -1
+PREFIX = re.compile(r'^(?:((?:\d+:)+\d+)(?:\.(\d+))?|(\d+))?[ \t]*(?:ID:(\d+))?')
+
 # Expressions régulières pour extraire les métriques / Regular expressions for metric extraction
 # Format: [INFO: MODULE] MSG
 PATTERNS = {
-    'energy': re.compile(r'ENERGY\s+(\d+)\s+(\d+)'),
+    'energy': re.compile(r'(?<!_)ENERGY\s+(\d+)\s+(\d+)'),
     'send': re.compile(r'SEND_UDP\s+(\d+)\s+(\d+)'),
     'recv': re.compile(r'RECV\s+(\d+)\s+(\d+)'),
     'hop': re.compile(r'HOP\s+(\d+)\s+(\d+)'),
@@ -51,64 +69,131 @@ PATTERNS = {
     'loss': re.compile(r'LOSS\s+(\d+)\s+(\d+)'),
     'lifetime': re.compile(r'LIFETIME\s+(\d+)\s+(\d+)'),
     'throughput': re.compile(r'THROUGHPUT\s+(\d+)\s+(\d+)'),
-    'mobility': re.compile(r'MOVE\s+(\d+)\s+(\d+)\s+(\d+)')
+    'mobility': re.compile(r'MOVE\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'nhstats': re.compile(r'NH_STATS\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'data_tx': re.compile(r'DATA_TX\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'data_rx': re.compile(r'DATA_RX\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'repair': re.compile(r'LOCAL_REPAIR\s+(\d+)\s+(\d+)'),
+    'repair_ms': re.compile(r'(?<!_)REPAIR\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'handoff': re.compile(r'HANDOFF\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'detect': re.compile(r'DETECT\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'suppress': re.compile(r'HELLO_SUPPRESS\s+(\d+)\s+(\d+)'),
+    'trickle_reset': re.compile(r'TRICKLE_RESET\s+(\d+)\s+(\d+)'),
+    'lqe': re.compile(r'LQE\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'energest': re.compile(r'ENERGEST\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'route_disc': re.compile(r'ROUTE_DISC\s+(\d+)\s+(\d+)'),
+    'route_cache': re.compile(r'ROUTE_CACHE\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)'),
+    'ctrl_bytes': re.compile(r'CTRL_BYTES\s+(\d+)\s+(\d+)'),
+    'agg': re.compile(r'(?<![A-Z_])AGG\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)')
 }
 
-# Création du répertoire de sortie / Create output directory
-os.makedirs(OUTPUT_DIR, exist_ok=True)
-
-# Traitement de chaque protocole / Process each protocol
-for proto, logfile in LOGS.items():
-    print(f"Traitement du protocole: {proto.upper()}")
-    print(f"Processing protocol: {proto.upper()}")
-    
-    # Initialisation des données / Data initialization
-    data = {k: [] for k in PATTERNS}
-    
-    if not os.path.exists(logfile):
-        print(f"  Fichier de log non trouvé: {logfile}")
-        print(f"  Log file not found: {logfile}")
-        continue
-    
-    # Lecture et analyse du fichier de log / Read and analyze log file
-    with open(logfile, 'r', encoding='utf-8', errors='ignore') as f:
-        line_count = 0
-        for line in f:
-            line_count += 1
-            
-            # Extraction de la partie message après le crochet / Extract message part after bracket
-            if ']' in line:
-                msg = line.split(']')[-1]
+# Colonnes de chaque fichier, comme scripts/logparse/logparse.c / Columns of each file, as in scripts/logparse/logparse.c
+FIELDS = {
+    'energy': ('a0', 'a1'),
+    'send': ('a0', 'a1'),
+    'recv': ('a0', 'a1'),
+    'hop': ('a0', 'a1'),
+    'pdr': ('a0', 'a1'),
+    'loss': ('a0', 'a1'),
+    'lifetime': ('addr', 't'),
+    'throughput': ('a0', 'a1'),
+    'mobility': ('addr0', 'addr1', 't'),
+    'nhstats': ('queries', 'updates', 'scans'),
+    'data_tx': ('src', 'seq', 't'),
+    'data_rx': ('src', 'seq', 'latency_ms', 'hops'),
+    'repair': ('addr', 't'),
+    'repair_ms': ('ms', 'lost', 'cause', 't'),
+    'handoff': ('addr', 'life_ms', 't'),
+    'detect': ('addr', 'expected', 'forwarded', 'dropped', 't'),
+    'suppress': ('interval_s', 't'),
+    'trickle_reset': ('cause', 't'),
+    'lqe': ('addr', 'hrr', 'etx100', 't'),
+    'energest': ('cpu', 'lpm', 'tx', 'rx', 't'),
+    'route_disc': ('count', 't'),
+    'route_cache': ('lookups', 'hits', 'salvaged', 't'),
+    'ctrl_bytes': ('bytes', 't'),
+    'agg': ('frames', 'readings', 'dropped', 't'),
+}
+
+
+def prefix(head):
+    """(nœud, temps µs) du préfixe Cooja / (node, time µs) from the Cooja prefix"""
+    m = PREFIX.match(head)
+    node = int(m.group(4)) if m.group(4) else 0
+    if m.group(1):
+        ms = 0
+        for part in m.group(1).split(':'):
+            ms = ms * 60 + int(part)
+        return node, (ms * 1000 + int(m.group(2) or 0)) * 1000
+    if m.group(3):
+        return node, int(m.group(3))
+    return node, -1
+
+
+def parse_python():
+    """Boucle d'expressions régulières, sans les agrégats / Regular expression loop, without the aggregates"""
+    import pandas as pd
+
+    # Création du répertoire de sortie / Create output directory
+    os.makedirs(OUTPUT_DIR, exist_ok=True)
+
+    # Traitement de chaque protocole / Process each protocol
+    for proto, logfile in LOGS.items():
+        print(f"Traitement du protocole: {proto.upper()}")
+        print(f"Processing protocol: {proto.upper()}")
+        
+        # Initialisation des données / Data initialization
+        data = {k: [] for k in PATTERNS}
+        
+        if not os.path.exists(logfile):
+            print(f"  Fichier de log non trouvé: {logfile}")
+            print(f"  Log file not found: {logfile}")
+            continue
+        
+        # Lecture et analyse du fichier de log / Read and analyze log file
+        with open(logfile, 'r', encoding='utf-8', errors='ignore') as f:
+            line_count = 0
+            for line in f:
+                line_count += 1
+                
+                # Extraction de la partie message après le crochet / Extract message part after bracket
+                if ']' in line:
+                    head, msg = line.rsplit(']', 1)
+                else:
+                    head, msg = line, line
+                where = None
+                
+                # Recherche des motifs dans chaque ligne / Pattern search in each line
+                for key, pat in PATTERNS.items():
+                    m = pat.search(msg)
+                    if m:
+                        if where is None:
+                            where = prefix(head)
+                        data[key].append(where + tuple(int(v) for v in m.groups()))
+                        
+                        # Traces de débogage occasionnelles / Occasional debug traces
+                        if line_count % 1000 == 0:
+                            print(f"    Ligne {line_count}: {key} trouvé - {m.groups()}")
+                            print(f"    Line {line_count}: {key} found - {m.groups()}")
+        
+        print(f"  Total de lignes traitées: {line_count}")
+        print(f"  Total simulation lines: {line_count}")
+        
+        # Sauvegarde des données extraites / Save extracted data
+        for key, values in data.items():
+            if values:
+                df = pd.DataFrame(values, columns=['node', 't_us', *FIELDS[key]])
+                output_file = os.path.join(OUTPUT_DIR, f'{proto}_{key}.csv')
+                df.to_csv(output_file, index=False)
+                
+                print(f"    {key}: {len(values)} valeurs sauvegardées dans {output_file}")
+                print(f"    {key}: {len(values)} values saved in {output_file}")
             else:
-                msg = line
-            
-            # Recherche des motifs dans chaque ligne / Pattern search in each line
-            for key, pat in PATTERNS.items():
-                m = pat.search(msg)
-                if m:
-                    data[key].append(m.groups())
-                    
-                    # Traces de débogage occasionnelles / Occasional debug traces
-                    if line_count % 1000 == 0:
-                        print(f"    Ligne {line_count}: {key} trouvé - {m.groups()}")
-                        print(f"    Line {line_count}: {key} found - {m.groups()}")
-    
-    print(f"  Total de lignes traitées: {line_count}")
-    print(f"  Total simulation lines: {line_count}")
-    
-    # Sauvegarde des données extraites / Save extracted data
-    for key, values in data.items():
-        if values:
-            df = pd.DataFrame(values)
-            output_file = os.path.join(OUTPUT_DIR, f'{proto}_{key}.csv')
-            df.to_csv(output_file, index=False, header=False)
-            
-            print(f"    {key}: {len(values)} valeurs sauvegardées dans {output_file}")
-            print(f"    {key}: {len(values)} values saved in {output_file}")
-        else:
-            print(f"    {key}: Aucune donnée trouvée")
-            print(f"    {key}: No data found")
+                print(f"    {key}: Aucune donnée trouvée")
+                print(f"    {key}: No data found")
+
 
+parse_python()
 print("\nAnalyse des logs terminée / Log analysis completed")
 print(f"Résultats sauvegardés dans: {OUTPUT_DIR}")
 print(f"Results saved in: {OUTPUT_DIR}") 
\ No newline at end of file
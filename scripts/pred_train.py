@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+ * pred_train.py : Entraînement et export du prédicteur d'épuisement int8
+ * Training and export of the int8 depletion predictor
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Les historiques d'énergie sont rééchantillonnés à la période du modèle ;
+ * la consommation des HIST dernières périodes (la plus récente d'abord)
+ * prédit la consommation moyenne des AHEAD périodes suivantes. Les poids
+ * sont positifs, de somme 1 et sans biais (moindres carrés projetés sur le
+ * simplexe) : le modèle ne dépend pas de l'échelle, si bien que des
+ * historiques de quelques mJ servent aussi à un nœud qui consomme des
+ * centaines de mJ par période, l'unité d'entrée restant un paramètre du
+ * micrologiciel (DSERAN_CONF_PRED_UNIT). Chaque poids vaut au moins
+ * --min-weight fois la part uniforme 1/HIST : sur des historiques dont le
+ * niveau est bruité, la consommation de la période la plus récente est
+ * corrélée négativement à la suite (différence de deux bruits) et le
+ * simplexe lui donnerait un poids nul, si bien qu'un voisin dont la
+ * consommation bondit ne serait vu qu'une période plus tard. Les poids sont quantifiés sur
+ * 8 bits et le noyau entier de src/dseran-pred.h est rejoué ici à
+ * l'identique pour l'évaluation. Le résultat est écrit dans
+ * src/dseran-pred-model.h.
+ * Energy histories are resampled at the model period; the drain of the last
+ * HIST periods (newest first) predicts the mean drain of the next AHEAD
+ * periods. Weights are non-negative, sum to 1 and have no bias (least
+ * squares projected on the simplex): the model is scale free, so histories
+ * of a few mJ also serve a node draining hundreds of mJ per period, the
+ * input unit staying a firmware parameter (DSERAN_CONF_PRED_UNIT). Each
+ * weight is at least --min-weight times the uniform share 1/HIST: on
+ * histories with a noisy level, the newest period's drain is negatively
+ * correlated with what follows (difference of two noise samples) and the
+ * simplex would give it a zero weight, so a neighbor whose drain jumps would
+ * only be seen one period later. Weights
+ * are quantized to 8 bits and the integer kernel of src/dseran-pred.h is
+ * replayed here bit for bit for the evaluation. The result is written to
+ * src/dseran-pred-model.h.
+ *
+ * Entrées / Inputs :
+ *   - CSV sans en-tête temps (s), énergie : DATA/<proto>_energy.csv
+ *     headerless CSV time (s), energy: DATA/<proto>_energy.csv
+ *   - CSV logparse (node,t_us,a0,...) des traces ENERGY, un historique par nœud
+ *     logparse CSV (node,t_us,a0,...) of the ENERGY traces, one history per node
+ * Un temps qui recule ouvre un nouvel historique / A time going backwards starts a new history.
+ * DATA/aodv_energy.csv (rampe synthétique, temps décroissant) n'est pas pris par défaut.
+ * DATA/aodv_energy.csv (synthetic ramp, decreasing time) is not used by default.
+ *
+ * Usage : pred_train.py [csv ...] [--hist 8] [--ahead 8] [--period 10] [--min-weight 0.5]
+ *                       [-o src/dseran-pred-model.h]
+"""
+
+import argparse
+import csv
+import os
+import sys
+
+import numpy as np
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_INPUTS = [os.path.join(ROOT, 'DATA', f'{p}_energy.csv') for p in ('dseran', 'dsr', 'olsr')]
+DEFAULT_OUTPUT = os.path.join(ROOT, 'src', 'dseran-pred-model.h')
+TTD_NONE = 0xffff
+
+
+def load_histories(path):
+    """Liste de (temps s, énergie) par historique / List of (time s, energy) per history"""
+    with open(path, newline='', encoding='utf-8') as f:
+        rows = list(csv.reader(f))
+    if not rows:
+        return []
+    series = {}
+    if rows[0][0] == 'node':
+        col = {name: i for i, name in enumerate(rows[0])}
+        for r in rows[1:]:
+            if r[col['t_us']] != '-1':
+                series.setdefault(r[col['node']], []).append((int(r[col['t_us']]) / 1e6, float(r[col['a0']])))
+    else:
+        series[''] = [(float(r[0]), float(r[1])) for r in rows if len(r) >= 2]
+
+    histories = []
+    for points in series.values():
+        cur = []
+        for t, e in points:
+            if cur and t <= cur[-1][0]:
+                histories.append(cur)
+                cur = []
+            cur.append((t, e))
+        histories.append(cur)
+    return [np.array(h) for h in histories if len(h) >= 2]
+
+
+def resample(h, period):
+    """Énergie entière (mJ) à chaque période / Integer energy (mJ) at every period"""
+    grid = np.arange(h[0, 0], h[-1, 0] + 1e-9, period)
+    return np.rint(np.interp(grid, h[:, 0], h[:, 1])).astype(np.int64)
+
+
+def windows(energy, hist, ahead):
+    """(consommations passées, la plus récente d'abord ; consommation moyenne à venir ; énergie)
+    (past drains, newest first; mean drain ahead; energy)"""
+    drain = energy[:-1] - energy[1:]
+    x, y, e = [], [], []
+    for k in range(hist, len(drain) - ahead + 1):
+        x.append(drain[k - hist:k][::-1])
+        y.append(drain[k:k + ahead].mean())
+        e.append(energy[k])
+    return x, y, e
+
+
+def quantize_input(d, unit):
+    """Comme le noyau C : arrondi loin de zéro, saturé sur 8 bits
+    Like the C kernel: rounded away from zero, saturated to 8 bits"""
+    q = np.where(d >= 0, (d + unit // 2) // unit, -((-d + unit // 2) // unit))
+    return np.clip(q, -128, 127)
+
+
+def kernel(xq, w, unit):
+    """Consommation prédite en mJ/période << shift (dseran_pred_drain())
+    Predicted drain in mJ/period << shift (dseran_pred_drain())"""
+    return (xq.astype(np.int64) @ w.astype(np.int64)) * unit
+
+
+def project_simplex(v, floor=0.0):
+    """Projection euclidienne sur {w >= floor, somme 1} / Euclidean projection onto {w >= floor, sum 1}"""
+    s = 1 - floor * len(v)
+    u = np.sort(v - floor)[::-1]
+    css = np.cumsum(u) - s
+    k = np.nonzero(u - css / np.arange(1, len(v) + 1) > 0)[0][-1]
+    return np.maximum(v - floor - css[k] / (k + 1), 0) + floor
+
+
+def fit(x, y, floor=0.0, iters=5000):
+    """Moindres carrés sous contrainte du simplexe, gradient projeté
+    Simplex-constrained least squares, projected gradient"""
+    g = x.T @ x
+    step = 1 / np.linalg.eigvalsh(g)[-1]
+    w = np.full(x.shape[1], 1 / x.shape[1])
+    for _ in range(iters):
+        w = project_simplex(w - step * (g @ w - x.T @ y), floor)
+    return w
+
+
+def step_response(w, unit, shift, before=1, after=16):
+    """Périodes avant que la consommation prédite bouge, puis dépasse la moitié d'un saut de
+    before à after unités / Periods before the predicted drain moves, then exceeds half a
+    step from before to after units"""
+    hist = np.full(len(w), before)
+    first = half = len(w)
+    for k in range(1, len(w) + 1):
+        hist = np.concatenate(([after], hist[:-1]))
+        drain = kernel(hist, w, unit)
+        if drain > before * unit << shift:
+            first = min(first, k)
+        if drain >= (before + after) * unit << shift >> 1:
+            half = min(half, k)
+    return first, half
+
+
+def ttd(energy, drain_q, shift):
+    """Périodes avant épuisement, comme dseran_pred_ttd() / Periods to depletion, like dseran_pred_ttd()"""
+    out = np.full(len(energy), TTD_NONE, dtype=np.int64)
+    live = drain_q > 0
+    out[live] = np.minimum((energy[live] << shift) // drain_q[live], TTD_NONE - 1)
+    return out
+
+
+def main():
+    p = argparse.ArgumentParser(description='Prédicteur d\'épuisement int8 / int8 depletion predictor')
+    p.add_argument('inputs', nargs='*', default=DEFAULT_INPUTS)
+    p.add_argument('--hist', type=int, default=8, help='périodes en entrée / input periods')
+    p.add_argument('--ahead', type=int, default=8, help='périodes prédites / predicted periods')
+    p.add_argument('--period', type=int, default=10, help='période en s / period in s')
+    p.add_argument('--min-weight', type=float, default=0.5,
+                   help='poids minimal, en part de 1/hist / minimum weight, as a share of 1/hist')
+    p.add_argument('-o', '--output', default=DEFAULT_OUTPUT)
+    args = p.parse_args()
+
+    x, y, e = [], [], []
+    for path in args.inputs:
+        for h in load_histories(path):
+            wx, wy, we = windows(resample(h, args.period), args.hist, args.ahead)
+            x += wx
+            y += wy
+            e += we
+    if len(x) < 2 * args.hist:
+        sys.exit(f'Pred: {len(x)} fenêtres, trop peu / windows, too few')
+    x, y, e = np.array(x), np.array(y, dtype=float), np.array(e)
+
+    # Unité d'évaluation : puissance de 2 qui garde 99,9 % des consommations sur 8 bits
+    # Evaluation unit: power of two keeping 99.9 % of the drains within 8 bits
+    unit = 1
+    while np.percentile(np.abs(x), 99.9) / unit > 127:
+        unit *= 2
+    xq = quantize_input(x, unit)
+    w_f = fit(x.astype(float), y, args.min_weight / args.hist)
+
+    # Plus grand décalage (11 au plus, calculs 32 bits du noyau) qui garde les poids sur
+    # 8 bits ; le plus gros poids absorbe l'arrondi pour que la somme vaille exactement
+    # 1 << shift / Largest shift (at most 11, 32-bit kernel arithmetic) keeping the weights
+    # within 8 bits; the largest weight absorbs the rounding so that the sum is exactly
+    # 1 << shift
+    shift = 0
+    while shift < 11 and w_f.max() * 2 ** (shift + 1) <= 127:
+        shift += 1
+    w = np.rint(w_f * 2 ** shift).astype(np.int64)
+    w[np.argmax(w)] += 2 ** shift - w.sum()
+
+    pred_f = x @ w_f
+    drain_q = kernel(xq, w, unit)
+    pred_q = drain_q / 2 ** shift
+    last = x[:, 0]
+    mae = lambda p_: float(np.abs(p_ - y).mean())
+    ttd_true = ttd(e, np.rint(y * 2 ** shift).astype(np.int64), shift)
+    ttd_pred = ttd(e, drain_q, shift)
+    both = (ttd_true != TTD_NONE) & (ttd_pred != TTD_NONE)
+    print(f'Pred: {len(x)} fenêtres / windows, unité d\'évaluation / evaluation unit {unit} mJ, '
+          f'décalage / shift {shift}')
+    print(f'Pred: MAE mJ/période / period : flottant / float {mae(pred_f):.3f}, '
+          f'int8 {mae(pred_q):.3f}, dernière période / last period {mae(last):.3f}, '
+          f'moyenne / mean {mae(np.full_like(y, y.mean())):.3f}')
+    if both.any():
+        rel = np.abs(ttd_pred[both] - ttd_true[both]) / np.maximum(ttd_true[both], 1)
+        print(f'Pred: erreur relative médiane du temps avant épuisement / median relative '
+              f'time-to-depletion error {np.median(rel):.2f} ({both.sum()} fenêtres / windows)')
+    first, half = step_response(w, unit, shift)
+    print(f'Pred: poids / weights {w.tolist()} ; saut de consommation vu après / drain step seen after '
+          f'{first} période(s) / period(s), à moitié après / half after {half}')
+    print(f'Pred: {args.hist} MAC 8x8 bits par inférence / 8x8-bit MACs per inference')
+
+    sources = ', '.join(os.path.relpath(path, ROOT) for path in args.inputs)
+    with open(args.output, 'w', encoding='utf-8') as f:
+        f.write(f"""/*
+ * dseran-pred-model.h : Poids du prédicteur d'épuisement (généré)
+ * Depletion predictor weights (generated)
+ *
+ * Généré par / Generated by scripts/pred_train.py --hist {args.hist} --ahead {args.ahead} --period {args.period} --min-weight {args.min_weight:g}
+ * Données / Data: {sources}
+ * {len(x)} fenêtres / windows ; MAE int8 {mae(pred_q):.3f} mJ/période / period
+ * (dernière période / last period {mae(last):.3f})
+ */
+
+#ifndef DSERAN_PRED_MODEL_H_
+#define DSERAN_PRED_MODEL_H_
+
+#define DSERAN_PRED_MODEL_PERIOD_S {args.period}     // période d'échantillonnage en s / sampling period in s
+#define DSERAN_PRED_MODEL_HIST     {args.hist}      // périodes en entrée / input periods
+#define DSERAN_PRED_MODEL_SHIFT    {shift}      // somme des poids / weight sum: 1 << SHIFT
+// Poids, de la période la plus récente à la plus ancienne / Weights, newest period to oldest
+#define DSERAN_PRED_MODEL_WEIGHTS  {{ {', '.join(str(int(v)) for v in w)} }}
+
+#endif /* DSERAN_PRED_MODEL_H_ */
+""")
+    print(f'Pred: {os.path.relpath(args.output)}')
+
+
+if __name__ == '__main__':
+    main()
@@ -11,11 +11,13 @@
 # 
 # Utilise Cooja en mode sans interface graphique pour l'exécution en lot
 # Uses Cooja in headless mode for batch execution
+# Pour plusieurs graines, protocoles ou tailles en parallèle : sweep.py
+# For several seeds, protocols or sizes in parallel: sweep.py
 
 set -e
 
 # Configuration des chemins / Path configuration
-COOJA_JAR=/home/belacel/contiki-ng1/tools/cooja/dist/cooja.jar
+COOJA_JAR=${COOJA_JAR:-/home/belacel/contiki-ng1/tools/cooja/dist/cooja.jar}
 SIMDIR=$(dirname "$0")/..
 
 # Vérification de l'existence de Cooja / Check Cooja existence
@@ -42,7 +44,10 @@ echo "[INFO] Lancement de la simulation D-SERAN..."
 echo "[INFO] Launching D-SERAN simulation..."
 start_time=$(date +%s)
 
-java -jar "$COOJA_JAR" -nogui "$SIMDIR/simulations/d-seran.csc" > "$SIMDIR/results/d-seran.log" 2>&1
+java -jar "$COOJA_JAR" -nogui "$SIMDIR/simulations/d-seran.csc" > "$SIMDIR/results/d-seran.trc" 2>&1
+
+# Décodage des traces binaires en enregistrements texte / Decode binary traces into text records
+python3 "$SIMDIR/scripts/trace_decode.py" "$SIMDIR/results/d-seran.trc" "$SIMDIR/results/d-seran.log"
 
 end_time=$(date +%s)
 duration=$((end_time - start_time))
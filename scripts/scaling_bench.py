@@ -0,0 +1,378 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+ * scaling_bench.py : Banc de passage à l'échelle D-SERAN dans Cooja
+ * D-SERAN scaling benchmark in Cooja
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Pour chaque taille de réseau, génère le scénario (scenario_gen.py, degré
+ * moyen constant), lance Cooja sans interface, analyse le log (logparse) et
+ * relève : temps réel de simulation, ROM/RAM par nœud (size sur les builds
+ * .cooja et .sky), surcoût de contrôle (hellos par nœud et par minute),
+ * PDR et temps de convergence (instant où le dernier nœud obtient une
+ * route, c'est-à-dire son premier DATA_TX) et durée de vie (premier nœud
+ * épuisé, trace LIFETIME). Le tableau est écrit dans
+ * results/scaling/<version>/scaling.csv et ajouté à
+ * results/scaling/history.csv pour suivre les versions ; --defines compile
+ * une variante (par exemple DSERAN_CONF_PREDICT=0) dans son propre
+ * répertoire de build pour la comparer sous une autre étiquette.
+ * --protocol passe une référence (dsr, aodv, olsr) dans le même banc : la
+ * convergence est alors le premier HOP (route découverte) de chaque nœud,
+ * et s'y ajoutent les découvertes par nœud et par minute et, pour DSR, le
+ * taux de succès du cache de routes (dernier ROUTE_CACHE de chaque nœud).
+ * Pour D-SERAN et OLSR, qui n'émettent une donnée que s'ils ont une route,
+ * s'ajoutent les octets de contrôle par nœud et par minute (CTRL_BYTES) et
+ * la disponibilité des routes : DATA_TX émis sur envois attendus toutes les
+ * --data-interval s (à régler comme DSERAN_CONF_DATA_INTERVAL). --degree
+ * élevé donne les scénarios denses. --mac tsch construit D-SERAN sur son
+ * ordonnancement TSCH (make MAC=tsch) et s'ajoute le taux d'activité de la
+ * radio (émission et écoute, d'après le dernier ENERGEST de chaque nœud),
+ * à comparer avec durée de vie aux lignes CSMA de la même version. Tous les
+ * protocoles donnent le débit utile au puits (octets applicatifs livrés,
+ * origine, numéro et horodatage) ; D-SERAN y ajoute les lectures par trame
+ * de sa file d'agrégation (AGG), l'énergie par octet livré (somme des
+ * derniers ENERGEST) et l'énergie d'émission par nœud et par heure, où se
+ * lit l'économie des hellos Trickle face à une variante à période fixe.
+ * For each network size, generates the scenario (scenario_gen.py, constant
+ * mean degree), runs headless Cooja, parses the log (logparse) and records:
+ * simulation wall time, per-mote ROM/RAM (size on the .cooja and .sky
+ * builds), control overhead (hellos per node per minute), PDR and
+ * convergence time (when the last node gets a route, i.e. its first
+ * DATA_TX) and lifetime (first depleted node, LIFETIME trace). The table is
+ * written to results/scaling/<version>/scaling.csv and appended to
+ * results/scaling/history.csv to track releases; --defines builds a variant
+ * (for instance DSERAN_CONF_PREDICT=0) in its own build directory to compare
+ * it under another tag. --protocol runs a baseline (dsr, aodv, olsr) through
+ * the same bench: convergence is then each node's first HOP (route
+ * discovered), and discoveries per node per minute are added, plus for DSR
+ * the route cache hit rate (last ROUTE_CACHE of each node). For D-SERAN
+ * and OLSR, which only send data when they hold a route, control bytes per
+ * node per minute (CTRL_BYTES) and route availability are added: DATA_TX
+ * sent over the sends expected every --data-interval s (to be set like
+ * DSERAN_CONF_DATA_INTERVAL). A high --degree gives dense scenarios.
+ * --mac tsch builds D-SERAN on its TSCH schedule (make MAC=tsch) and adds
+ * the radio duty cycle (transmit and listen, from each node's last
+ * ENERGEST), to compare along with lifetime against the CSMA rows of the
+ * same version. Every protocol reports the goodput at the sink (application
+ * bytes delivered: origin, sequence number and timestamp); D-SERAN adds the
+ * readings per frame of its aggregation queue (AGG), the energy per
+ * delivered byte (sum of the last ENERGEST records) and the transmit energy
+ * per node per hour, where the saving of Trickle hellos over a fixed-period
+ * variant shows.
+ *
+ * Usage : scaling_bench.py [--nodes 10,100,500,1000] [--topology uniform]
+ *                          [--duration 600] [--seed 1] [--tag v1.2] [--dry-run]
+ *                          [--protocol d-seran|dsr|aodv|olsr] [--data-interval 15]
+ *                          [--mac csma|tsch]
+ *                          [--defines "DSERAN_CONF_PREDICT=0,DSERAN_CONF_INIT_ENERGY=3000"]
+ * COOJA_JAR (ou / or --cooja) désigne le jar Cooja / points to the Cooja jar.
+"""
+
+import argparse
+import csv
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+import scenario_gen
+from scenario_gen import PROTOCOLS, ROOT, SRC
+from sweep import parse_list, run_cooja
+
+LOGPARSE = os.path.join(ROOT, 'scripts', 'logparse', 'logparse')
+SINK_ID = 1
+# Courants radio de dseran-energy.c (sky, Cooja) en mA, alimentation 3 V
+# Radio currents of dseran-energy.c (sky, Cooja) in mA, 3 V supply
+RADIO_MA = {'tx': 17.7, 'rx': 19.7}
+SUPPLY_V = 3.0
+# Octets applicatifs d'une donnée (origine, numéro, horodatage), les mêmes pour tous les protocoles
+# Application bytes of one data reading (origin, sequence, timestamp), the same for every protocol
+APP_BYTES = 8
+
+COLUMNS = ['tag', 'date', 'nodes', 'topology', 'duration_s', 'wall_s', 'speedup',
+           'rom_cooja', 'ram_cooja', 'rom_sky', 'ram_sky',
+           'hello_per_node_min', 'pdr', 'converged', 'convergence_s', 'status',
+           'defines', 'first_death_s', 'deaths', 'protocol', 'disc_per_node_min', 'cache_hit_rate',
+           'ctrl_bytes_per_node_min', 'route_avail', 'mac', 'duty_cycle',
+           'goodput_bps', 'readings_per_frame', 'uj_per_byte', 'tx_mj_per_node_h']
+
+
+def git_tag():
+    try:
+        return subprocess.run(['git', 'describe', '--always', '--dirty'], cwd=ROOT, stdout=subprocess.PIPE,
+                              stderr=subprocess.DEVNULL, text=True, check=True).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def mem_size(path):
+    """(ROM, RAM) en octets d'après size : text+data, data+bss
+    (ROM, RAM) in bytes from size: text+data, data+bss"""
+    tool = 'msp430-size' if path.endswith('.sky') else 'size'
+    if not os.path.isfile(path) or shutil.which(tool) is None:
+        return None, None
+    out = subprocess.run([tool, path], stdout=subprocess.PIPE, text=True, check=True).stdout
+    text, data, bss = (int(v) for v in out.splitlines()[1].split()[:3])
+    return text + data, data + bss
+
+
+def build_dir(defines, mac='csma', protocol='d-seran'):
+    """Un répertoire de build par protocole, couche MAC et jeu de DEFINES ; le pilote de
+    routage (NETSTACK_CONF_ROUTING) change les objets du cœur Contiki-NG
+    One build directory per protocol, MAC layer and DEFINES set; the routing driver
+    (NETSTACK_CONF_ROUTING) changes the Contiki-NG core objects"""
+    base = 'build' if protocol == 'd-seran' else f'build-{protocol}'
+    if mac != 'csma':
+        base += f'-{mac}'
+    if not defines:
+        return base
+    return base + '-' + ''.join(c if c.isalnum() else '_' for c in defines.replace('DSERAN_CONF_', ''))
+
+
+def build(target, defines='', protocol='d-seran', mac='csma'):
+    """Le protocole pour une cible ; le .sky n'est construit qu'avec msp430-gcc
+    The protocol for one target; the .sky is only built with msp430-gcc"""
+    if target == 'sky' and shutil.which('msp430-gcc') is None:
+        return None
+    project, makefile = PROTOCOLS[protocol]
+    cmd = ['make', '-j4', f'{project}.{target}', f'TARGET={target}', f'BUILD_DIR={build_dir(defines, mac, protocol)}']
+    if makefile != 'Makefile':
+        cmd += ['-f', makefile]
+    if mac != 'csma':
+        cmd.append(f'MAC={mac}')
+    if defines:
+        cmd.append(f'DEFINES={defines}')
+    r = subprocess.run(cmd, cwd=SRC, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    if r.returncode != 0:
+        print(r.stdout[-2000:], file=sys.stderr)
+        sys.exit(f'Scaling: build {target} : ÉCHEC / FAILED')
+    return os.path.join(SRC, build_dir(defines, mac, protocol), target, f'{project}.{target}')
+
+
+def by_node(path):
+    """{(nœud, enregistrement): (nombre, premier µs, somme)} / {(node, record): (count, first µs, sum)}"""
+    out = {}
+    if os.path.isfile(path):
+        with open(path, newline='', encoding='utf-8') as f:
+            for row in csv.DictReader(f):
+                out[(int(row['node']), row['record'])] = (int(row['count']), int(row['first_us']),
+                                                          int(row['sum']))
+    return out
+
+
+def cache_hit_rate(path):
+    """Succès / recherches sur le dernier ROUTE_CACHE (cumulatif) de chaque nœud
+    Hits / lookups over each node's last (cumulative) ROUTE_CACHE"""
+    last = {}
+    if os.path.isfile(path):
+        with open(path, newline='', encoding='utf-8') as f:
+            for row in csv.DictReader(f):
+                last[row['node']] = (int(row['lookups']), int(row['hits']))
+    lookups = sum(l for l, _ in last.values())
+    return round(sum(h for _, h in last.values()) / lookups, 3) if lookups else ''
+
+
+def last_by_node(path):
+    """{nœud: dernière ligne} d'un enregistrement cumulatif / {node: last row} of a cumulative record"""
+    last = {}
+    if os.path.isfile(path):
+        with open(path, newline='', encoding='utf-8') as f:
+            for row in csv.DictReader(f):
+                last[row['node']] = row
+    return last
+
+
+def duty_cycle(path):
+    """% moyen du temps radio allumée, d'après le dernier ENERGEST (cumulatif) de chaque nœud
+    Mean % of radio-on time, from each node's last (cumulative) ENERGEST"""
+    duty = []
+    for row in last_by_node(path).values():
+        on_s = sum(int(row[k]) / (RADIO_MA[k] * SUPPLY_V) for k in RADIO_MA)
+        if int(row['t_us']) > 0:
+            duty.append(on_s / (int(row['t_us']) / 1e6))
+    return round(100 * sum(duty) / len(duty), 2) if duty else ''
+
+
+def tx_mj_per_node_h(path):
+    """mJ d'émission radio par nœud et par heure (dernier ENERGEST de chaque nœud)
+    Radio transmit mJ per node per hour (each node's last ENERGEST)"""
+    rates = [int(row['tx']) / (int(row['t_us']) / 3.6e9)
+             for row in last_by_node(path).values() if int(row['t_us']) > 0]
+    return round(sum(rates) / len(rates), 2) if rates else ''
+
+
+def readings_per_frame(path):
+    """Lectures portées / trames de données émises (AGG), relais compris
+    Readings carried / data frames sent (AGG), relays included"""
+    frames = readings = 0
+    if os.path.isfile(path):
+        with open(path, newline='', encoding='utf-8') as f:
+            for row in csv.DictReader(f):
+                frames += int(row['frames'])
+                readings += int(row['readings'])
+    return round(readings / frames, 2) if frames else ''
+
+
+def uj_per_byte(path, delivered):
+    """µJ consommés par tout le réseau (derniers ENERGEST) par octet applicatif livré
+    µJ consumed by the whole network (last ENERGEST records) per delivered application byte"""
+    mj = sum(int(row[k]) for row in last_by_node(path).values() for k in ('cpu', 'lpm', 'tx', 'rx'))
+    return round(mj * 1000 / (delivered * APP_BYTES), 1) if mj and delivered else ''
+
+
+def metrics(rundir, n, duration, protocol='d-seran', data_interval=15.0):
+    """Surcoût, PDR, convergence et durée de vie depuis les agrégats de logparse
+    Overhead, PDR, convergence and lifetime from the logparse aggregates"""
+    prefix = protocol.replace('-', '')
+    subprocess.run([LOGPARSE, '-q', '-f', 'csv', '-o', rundir, os.path.join(rundir, f'{protocol}.log')],
+                   check=True)
+    agg = by_node(os.path.join(rundir, f'{prefix}_by_node.csv'))
+
+    def total(rec):
+        return sum(c for (_, r), (c, _, _) in agg.items() if r == rec)
+
+    def total_sum(rec):
+        return sum(v for (_, r), (_, _, v) in agg.items() if r == rec)
+
+    # Route obtenue : premier DATA_TX pour D-SERAN, premier HOP (découverte) sinon
+    # Route obtained: first DATA_TX for D-SERAN, first HOP (discovery) otherwise
+    routed = 'data_tx' if protocol == 'd-seran' else 'hop'
+    tx, rx = total('data_tx'), total('data_rx')
+    first_tx = [agg[(i, routed)][1] for i in range(1, n + 1) if i != SINK_ID and (i, routed) in agg]
+    deaths = [first for (_, r), (_, first, _) in agg.items() if r == 'lifetime']
+    # Premier envoi entre 1 et 2 intervalles après le démarrage / First sending 1 to 2 intervals after boot
+    expected = (n - 1) * max(duration / data_interval - 1, 1)
+    proactive = protocol in ('d-seran', 'olsr')
+    return {
+        'hello_per_node_min': round(total('send') / n / (duration / 60), 2),
+        'disc_per_node_min': round(total('route_disc') / n / (duration / 60), 3),
+        'cache_hit_rate': cache_hit_rate(os.path.join(rundir, f'{prefix}_route_cache.csv')),
+        'duty_cycle': duty_cycle(os.path.join(rundir, f'{prefix}_energest.csv')),
+        'ctrl_bytes_per_node_min': round(total_sum('ctrl_bytes') / n / (duration / 60), 1) if proactive else '',
+        'route_avail': round(min(tx / expected, 1), 3) if proactive else '',
+        'pdr': round(rx / tx, 3) if tx else '',
+        'goodput_bps': round(rx * APP_BYTES * 8 / duration, 2),
+        'readings_per_frame': readings_per_frame(os.path.join(rundir, f'{prefix}_agg.csv')),
+        'uj_per_byte': uj_per_byte(os.path.join(rundir, f'{prefix}_energest.csv'), rx),
+        'tx_mj_per_node_h': tx_mj_per_node_h(os.path.join(rundir, f'{prefix}_energest.csv')),
+        'converged': f'{len(first_tx)}/{n - 1}',
+        # Seulement si tous les nœuds ont une route / Only when every node has a route
+        'convergence_s': round(max(first_tx) / 1e6, 1) if first_tx and len(first_tx) == n - 1 else '',
+        # Aucun épuisement : au-delà de la durée simulée / No depletion: beyond the simulated duration
+        'first_death_s': round(min(deaths) / 1e6, 1) if deaths else f'>{duration:g}',
+        'deaths': len(deaths),
+    }
+
+
+def main():
+    p = argparse.ArgumentParser(description='Banc de passage à l\'échelle / Scaling benchmark')
+    p.add_argument('--nodes', default='10,100,500,1000')
+    p.add_argument('--topology', choices=scenario_gen.TOPOLOGIES, default='uniform')
+    p.add_argument('--range', type=float, default=50.0, help='portée UDGM en m / UDGM range in m')
+    p.add_argument('--loss', type=float, default=0.0, help='taux de pertes en réception / reception loss ratio')
+    p.add_argument('--degree', type=float, default=8.0, help='degré moyen visé / target mean degree')
+    p.add_argument('--duration', type=float, default=600, help='s simulées / simulated s')
+    p.add_argument('--seed', type=int, default=1)
+    p.add_argument('--timeout', type=float, default=None, help='s réelles par taille / wall s per size')
+    p.add_argument('--cooja', default=os.environ.get('COOJA_JAR', ''))
+    p.add_argument('--tag', default=None, help='version (défaut / default: git describe)')
+    p.add_argument('-o', '--out', default=os.path.join(ROOT, 'results', 'scaling'))
+    p.add_argument('--protocol', choices=sorted(PROTOCOLS), default='d-seran')
+    p.add_argument('--mac', choices=['csma', 'tsch'], default='csma',
+                   help='couche MAC de D-SERAN (make MAC=) / D-SERAN MAC layer (make MAC=)')
+    p.add_argument('--data-interval', type=float, default=15.0,
+                   help='s entre deux données / s between two data frames (DSERAN_CONF_DATA_INTERVAL)')
+    p.add_argument('--defines', default='', help='DEFINES de la variante / variant DEFINES, ex. DSERAN_CONF_PREDICT=0')
+    p.add_argument('--no-build', action='store_true')
+    p.add_argument('--dry-run', action='store_true', help='.csc seulement / .csc only')
+    args = p.parse_args()
+
+    nodes = parse_list(args.nodes, int)
+    if args.mac != 'csma' and args.protocol != 'd-seran':
+        p.error('--mac : D-SERAN seulement / D-SERAN only')
+    tag = args.tag or git_tag()
+    if not args.dry_run and not os.path.isfile(args.cooja):
+        p.error('COOJA_JAR ou / or --cooja : jar Cooja introuvable / Cooja jar not found')
+    if not args.dry_run and not os.access(LOGPARSE, os.X_OK):
+        subprocess.run(['make', '-s', '-C', os.path.dirname(LOGPARSE), 'logparse'], check=True)
+
+    # Empreinte mémoire : identique pour toutes les tailles / Memory footprint: the same for every size
+    project, _ = PROTOCOLS[args.protocol]
+    fw = os.path.join(SRC, build_dir(args.defines, args.mac, args.protocol), 'cooja', f'{project}.cooja')
+    sky = os.path.join(SRC, build_dir(args.defines, args.mac, args.protocol), 'sky', f'{project}.sky')
+    if not args.dry_run and not args.no_build:
+        fw = build('cooja', args.defines, args.protocol, args.mac)
+        sky = build('sky', args.defines, args.protocol, args.mac) or sky
+    rom_cooja, ram_cooja = mem_size(fw)
+    rom_sky, ram_sky = mem_size(sky)
+
+    # Les tailles passent l'une après l'autre : le temps réel reste comparable
+    # Sizes run one after the other: wall times stay comparable
+    # Les références ont leurs propres répertoires et tableau / Baselines get their own directories and table
+    stem = '' if args.protocol == 'd-seran' else f'{args.protocol}-'
+    if args.mac != 'csma':
+        stem += f'{args.mac}-'
+    rows = []
+    for n in nodes:
+        rundir = os.path.join(args.out, tag, f'{stem}n{n}')
+        if os.path.isdir(rundir):
+            shutil.rmtree(rundir)
+        os.makedirs(rundir)
+        side = scenario_gen.area_for(n, args.range, args.degree)
+        scenario_gen.write_csc(os.path.join(rundir, 'sim.csc'), args.protocol,
+                               scenario_gen.place(args.topology, n, side, args.range, args.seed),
+                               args.seed, args.duration, title=f'scaling-n{n}', radio_range=args.range,
+                               loss=args.loss, firmware=fw)
+        row = {'tag': tag, 'date': time.strftime('%Y-%m-%d'), 'nodes': n, 'topology': args.topology,
+               'duration_s': f'{args.duration:g}', 'rom_cooja': rom_cooja, 'ram_cooja': ram_cooja,
+               'rom_sky': rom_sky, 'ram_sky': ram_sky, 'defines': args.defines, 'protocol': args.protocol,
+               'mac': args.mac}
+        if args.dry_run:
+            print(f'Scaling: n={n} : {rundir}/sim.csc, zone / area {side:.0f} x {side:.0f} m')
+            continue
+
+        t0 = time.monotonic()
+        rc = run_cooja(rundir, args.cooja, args.protocol, args.timeout)
+        wall = time.monotonic() - t0
+        row.update(wall_s=round(wall, 1), speedup=round(args.duration / wall, 2),
+                   status='ok' if rc == 0 else f'rc={rc}')
+        row.update(metrics(rundir, n, args.duration, args.protocol, args.data_interval))
+        rows.append(row)
+        print(f'Scaling: n={n} {row["status"]} {row["wall_s"]} s')
+    if args.dry_run:
+        return
+
+    # Tableau de la version, puis historique / Table of this version, then history
+    table = os.path.join(args.out, tag, f'{stem}scaling.csv')
+    with open(table, 'w', newline='', encoding='utf-8') as f:
+        w = csv.DictWriter(f, COLUMNS, restval='')
+        w.writeheader()
+        w.writerows(rows)
+    history = os.path.join(args.out, 'history.csv')
+    new = not os.path.isfile(history)
+    with open(history, 'a', newline='', encoding='utf-8') as f:
+        w = csv.DictWriter(f, COLUMNS, restval='')
+        if new:
+            w.writeheader()
+        w.writerows(rows)
+
+    shown = ['nodes', 'wall_s', 'speedup', 'rom_cooja', 'ram_cooja', 'rom_sky', 'ram_sky',
+             'hello_per_node_min', 'pdr', 'goodput_bps', 'converged', 'convergence_s', 'first_death_s', 'deaths']
+    if args.protocol in ('d-seran', 'olsr'):
+        shown += ['ctrl_bytes_per_node_min', 'route_avail']
+    if args.protocol == 'd-seran':
+        shown += ['duty_cycle', 'readings_per_frame', 'uj_per_byte', 'tx_mj_per_node_h']
+    if args.protocol != 'd-seran':
+        shown += ['disc_per_node_min', 'cache_hit_rate']
+    print(f'\nScaling {tag} {args.protocol}/{args.mac} ({args.topology}, {args.duration:g} s) -> {table}')
+    print(' '.join(f'{c:>12}' for c in shown))
+    for r in rows:
+        print(' '.join(f'{str(r.get(c, "")) if r.get(c) is not None else "n/a":>12}' for c in shown))
+    sys.exit(0 if all(r['status'] == 'ok' for r in rows) else 1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+ * scenario_gen.py : Générateur de scénarios Cooja paramétriques
+ * Parametric Cooja scenario generator
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Écrit un .csc dérivé de simulations/<protocole>.csc : N nœuds en grille,
+ * uniformes ou en grappes, portée et pertes UDGM, durée et graine. La zone
+ * est dimensionnée pour un degré moyen donné (--degree), si bien qu'un
+ * scénario à 1000 nœuds a la même densité qu'un scénario à 10. Le nœud le
+ * plus proche du centre reçoit l'indice 0, donc node_id 1 : le puits
+ * (DSERAN_CONF_SINK_ID) est au milieu du réseau. Avec --attackers, des
+ * nœuds tirés au hasard (jamais le puits) deviennent des motes D-SERAN
+ * attaquantes, trou noir ou trou gris (DSERAN_CONF_ATTACK), d'un second
+ * type de mote compilé dans son propre répertoire ; Cooja numérote les
+ * types l'un après l'autre, les attaquants reçoivent donc les derniers
+ * node_id.
+ * Writes a .csc derived from simulations/<protocol>.csc: N motes in a grid,
+ * uniform or clustered, UDGM range and loss, duration and seed. The area is
+ * sized for a given mean degree (--degree), so a 1000-node scenario has the
+ * same density as a 10-node one. The mote closest to the centre gets index 0,
+ * hence node_id 1: the sink (DSERAN_CONF_SINK_ID) sits in the middle of the
+ * network. With --attackers, randomly drawn motes (never the sink) become
+ * attacking D-SERAN motes, blackhole or grayhole (DSERAN_CONF_ATTACK), of a
+ * second mote type built in its own directory; Cooja numbers the types one
+ * after the other, so the attackers get the last node_ids.
+ *
+ * Usage : scenario_gen.py -n 500 --topology clustered [--range 50] [--loss 0.1]
+ *                         [--degree 8] [--duration 600] [--seed 1] -o sim.csc
+ *                         [--attackers 5 --attack blackhole|grayhole [--attack-drop 50]]
+"""
+
+import argparse
+import math
+import os
+import random
+import xml.etree.ElementTree as ET
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..'))
+SRC = os.path.join(ROOT, 'src')
+SIMDIR = os.path.join(ROOT, 'simulations')
+
+# Projet et Makefile de chaque protocole / Project and Makefile of each protocol
+PROTOCOLS = {
+    'd-seran': ('d-seran', 'Makefile'),
+    'aodv': ('aodv-demo', 'Makefile.aodv'),
+    'dsr': ('dsr-demo', 'Makefile.dsr'),
+    'olsr': ('olsr-demo', 'Makefile.olsr'),
+}
+
+TOPOLOGIES = ('grid', 'uniform', 'clustered')
+CLUSTER_SIZE = 20   # nœuds par grappe / motes per cluster
+
+# Motes attaquantes D-SERAN : valeur de DSERAN_CONF_ATTACK (src/dseran-watchdog.h)
+# Attacking D-SERAN motes: DSERAN_CONF_ATTACK value (src/dseran-watchdog.h)
+ATTACKS = {'blackhole': 1, 'grayhole': 2}
+
+
+def area_for(n, radio_range, degree):
+    """Côté de la zone carrée pour un degré moyen donné / Square side for a given mean degree"""
+    return math.sqrt(n * math.pi * radio_range ** 2 / max(degree, 1))
+
+
+def place(topology, n, side, radio_range, seed):
+    """Positions (m) ; le nœud le plus central en premier / Positions (m); the most central mote first"""
+    rng = random.Random(seed)
+    if topology == 'grid':
+        cols = math.ceil(math.sqrt(n))
+        step = side / cols
+        pts = [((i % cols + 0.5) * step, (i // cols + 0.5) * step) for i in range(n)]
+    elif topology == 'clustered':
+        k = max(1, math.ceil(n / CLUSTER_SIZE))
+        centres = [(rng.uniform(0, side), rng.uniform(0, side)) for _ in range(k)]
+        pts = []
+        for i in range(n):
+            cx, cy = centres[i % k]
+            pts.append((min(max(rng.gauss(cx, radio_range / 2), 0), side),
+                        min(max(rng.gauss(cy, radio_range / 2), 0), side)))
+    else:
+        pts = [(rng.uniform(0, side), rng.uniform(0, side)) for _ in range(n)]
+
+    c = side / 2
+    sink = min(range(n), key=lambda i: (pts[i][0] - c) ** 2 + (pts[i][1] - c) ** 2)
+    pts[0], pts[sink] = pts[sink], pts[0]
+    return pts
+
+
+def pick_attackers(n, count, seed):
+    """Indices des attaquants, jamais le puits (indice 0) / Attacker indices, never the sink (index 0)"""
+    rng = random.Random(seed + 7919)
+    return sorted(rng.sample(range(1, n), min(count, n - 1)))
+
+
+def attack_variant(attack, drop=None):
+    """(répertoire de build, DEFINES) des motes attaquantes / (build directory, DEFINES) of the attacking motes"""
+    defines = f'DSERAN_CONF_ATTACK={ATTACKS[attack]}'
+    build_dir = f'build-{attack}'
+    if attack == 'grayhole' and drop is not None:
+        defines += f',DSERAN_CONF_ATTACK_DROP={drop}'
+        build_dir += f'{drop}'
+    return build_dir, defines
+
+
+def attacker_ids(n, attackers):
+    """node_id Cooja des attaquants : les derniers, dans l'ordre des indices
+    Cooja node_ids of the attackers: the last ones, in index order"""
+    return list(range(n - len(attackers) + 1, n + 1))
+
+
+def fill_motes(mt, points):
+    """Remplace les motes du type par une mote par position / Replace the type's motes with one mote per position"""
+    motes = mt.findall('mote')
+    template, last_tail = motes[0], motes[-1].tail
+    for m in motes:
+        mt.remove(m)
+    for x, y in points:
+        m = ET.fromstring(ET.tostring(template))
+        m.tail = template.tail
+        for pos in m.iter('pos'):
+            pos.set('x', f'{x:.2f}')
+            pos.set('y', f'{y:.2f}')
+        mt.append(m)
+    m.tail = last_tail
+
+
+def write_csc(path, protocol, points, seed, duration, title=None, radio_range=None, loss=None,
+              commands=None, firmware=None, mobility_plugin=None, attackers=(), attack=None,
+              attack_drop=None):
+    """.csc dérivé du modèle du protocole, chemins absolus ; les indices attackers
+    de points deviennent des motes attack / .csc derived from the protocol template,
+    absolute paths; the attackers indices of points become attack motes"""
+    tree = ET.parse(os.path.join(SIMDIR, f'{protocol}.csc'))
+    root = tree.getroot()
+    sim = root.find('simulation')
+    sim.find('title').text = title or os.path.splitext(os.path.basename(path))[0]
+    sim.find('randomseed').text = str(seed)
+    for ev in sim.iter('event'):
+        if ev.findtext('command', '').strip() == 'quit':
+            ev.find('time').text = str(int(duration * 1000))
+
+    # Portée UDGM, interférences au double, pertes à la réception
+    # UDGM range, interference at twice the range, losses on reception
+    radio = sim.find('radiomedium')
+    if radio_range is not None:
+        radio.find('transmitting_range').text = f'{radio_range:g}'
+        radio.find('interference_range').text = f'{2 * radio_range:g}'
+    if loss is not None:
+        radio.find('success_ratio_rx').text = f'{1 - loss:g}'
+
+    # Le .csc ne vit plus dans simulations/ / The .csc no longer lives in simulations/
+    mt = sim.find('motetype')
+    project, _ = PROTOCOLS[protocol]
+    mt.find('source').text = os.path.join(SRC, f'{project}.c')
+    if commands is not None:
+        mt.find('commands').text = commands
+    mt.find('firmware').text = firmware or os.path.join(SRC, 'build', 'cooja', f'{project}.cooja')
+
+    if attackers and protocol != 'd-seran':
+        raise ValueError(f'{protocol} : pas de motes attaquantes / no attacking motes')
+    bad = set(attackers)
+    honest = [pt for i, pt in enumerate(points) if i not in bad]
+    # Le type attaquant est copié avant de vider le type honnête / The attacking type is copied before emptying the honest type
+    evil = ET.fromstring(ET.tostring(mt)) if bad else None
+    fill_motes(mt, honest)
+
+    # Même firmware, compilé avec DSERAN_CONF_ATTACK / Same firmware, built with DSERAN_CONF_ATTACK
+    if bad:
+        build_dir, defines = attack_variant(attack, attack_drop)
+        evil.find('identifier').text = f'{project}-{attack}'
+        evil.find('description').text = f'D-SERAN {attack}'
+        evil.find('commands').text = (f'$(MAKE) -j$(CPUS) {project}.cooja TARGET=cooja '
+                                      f'BUILD_DIR={build_dir} DEFINES={defines}')
+        evil.find('firmware').text = os.path.join(SRC, build_dir, 'cooja', f'{project}.cooja')
+        fill_motes(evil, [points[i] for i in sorted(bad)])
+        children = list(sim)
+        evil.tail, mt.tail = mt.tail, children[children.index(mt) - 1].tail
+        sim.insert(children.index(mt) + 1, evil)
+
+    if mobility_plugin:
+        plugin = ET.SubElement(root, 'plugin')
+        plugin.text = mobility_plugin
+        conf = ET.SubElement(plugin, 'plugin_config')
+        pos = ET.SubElement(conf, 'positions', EXPORT='copy')
+        pos.text = '[CONFIG_DIR]/positions.dat'
+
+    tree.write(path, encoding='UTF-8', xml_declaration=True)
+
+
+def main():
+    p = argparse.ArgumentParser(description='Scénarios Cooja / Cooja scenarios')
+    p.add_argument('-n', '--nodes', type=int, default=100)
+    p.add_argument('--protocol', choices=sorted(PROTOCOLS), default='d-seran')
+    p.add_argument('--topology', choices=TOPOLOGIES, default='uniform')
+    p.add_argument('--range', type=float, default=50.0, help='portée UDGM en m / UDGM range in m')
+    p.add_argument('--loss', type=float, default=0.0, help='taux de pertes en réception / reception loss ratio')
+    p.add_argument('--degree', type=float, default=8.0, help='degré moyen visé / target mean degree')
+    p.add_argument('--duration', type=float, default=600, help='s simulées / simulated s')
+    p.add_argument('--seed', type=int, default=1)
+    p.add_argument('--attackers', type=int, default=0, help='motes attaquantes / attacking motes')
+    p.add_argument('--attack', choices=sorted(ATTACKS), default='blackhole')
+    p.add_argument('--attack-drop', type=int, default=None, help='%% jeté par un trou gris / %% dropped by a grayhole')
+    p.add_argument('-o', '--output', default=None)
+    args = p.parse_args()
+
+    side = area_for(args.nodes, args.range, args.degree)
+    out = args.output or f'{args.protocol}-{args.topology}-n{args.nodes}.csc'
+    attackers = pick_attackers(args.nodes, args.attackers, args.seed) if args.attackers else []
+    write_csc(out, args.protocol, place(args.topology, args.nodes, side, args.range, args.seed),
+              args.seed, args.duration, radio_range=args.range, loss=args.loss,
+              attackers=attackers, attack=args.attack, attack_drop=args.attack_drop)
+    print(f'Scenario Gen: {out}: {args.nodes} nœuds / motes, {args.topology}, zone / area '
+          f'{side:.0f} x {side:.0f} m')
+    if attackers:
+        print(f'Scenario Gen: {args.attack} : node_id {",".join(map(str, attacker_ids(args.nodes, attackers)))}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,341 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+ * sweep.py : Balayage parallèle de simulations Cooja (protocole x graine x nœuds x vitesse x hello)
+ * Parallel Cooja simulation sweep (protocol x seed x nodes x speed x hello)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Développe la matrice de paramètres en fichiers .csc générés à partir de
+ * simulations/<protocole>.csc, compile une fois chaque variante de
+ * micrologiciel (un répertoire de build par intervalle hello et par
+ * protocole ; en mobilité, D-SERAN est compilé avec DSERAN_CONF_MOBILITY et
+ * la graine, la vitesse et la surface de l'exécution, pour que mobility.c
+ * suive la trajectoire que le plugin Mobility impose au mote), puis lance Cooja sans interface dans un pool borné de
+ * processus. Chaque exécution a son répertoire results/sweep/<id>/ (csc,
+ * positions.dat, trace brute, log décodé, run.json) ; une exécution dont
+ * run.json indique "ok" est sautée, le balayage reprend donc là où il a été
+ * interrompu.
+ * Expands the parameter matrix into .csc files generated from
+ * simulations/<protocol>.csc, builds each firmware variant once (one build
+ * directory per hello interval and per protocol; when moving, D-SERAN is
+ * built with DSERAN_CONF_MOBILITY and the seed, speed and area of the run,
+ * so that mobility.c follows the trajectory the Mobility plugin imposes on
+ * the mote), then runs headless Cooja in
+ * a bounded process pool. Each run gets its own results/sweep/<id>/
+ * directory (csc, positions.dat, raw trace, decoded log, run.json); a run
+ * whose run.json says "ok" is skipped, so the sweep resumes where it was
+ * interrupted.
+ *
+ * Usage : sweep.py --protocols d-seran,aodv,dsr,olsr --seeds 1-10 --nodes 10,50
+ *                  --speeds 0,2 --hello 2,8 [--topology grid] [--range 50] [--loss 0.1]
+ *                  [--duration 600] [-j 32] [--dry-run]
+ * COOJA_JAR (ou / or --cooja) désigne le jar Cooja / points to the Cooja jar.
+"""
+
+import argparse
+import csv
+import itertools
+import json
+import os
+import shutil
+import signal
+import subprocess
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+import scenario_gen
+from scenario_gen import PROTOCOLS, ROOT, SRC
+from trace_decode import decode_line
+
+# Horloge de la plateforme cooja (CLOCK_SECOND) / cooja platform clock (CLOCK_SECOND)
+COOJA_CLOCK_SECOND = 1000
+
+# Exécutions en cours, arrêtées sur interruption / Running processes, stopped on interrupt
+running = set()
+running_lock = threading.Lock()
+stopping = threading.Event()
+
+
+def parse_list(text, conv=float):
+    """"1,2,5" ou "1-10" / "1,2,5" or "1-10" """
+    out = []
+    for part in text.split(','):
+        if '-' in part[1:]:
+            lo, hi = part.split('-', 1)
+            out.extend(range(int(lo), int(hi) + 1))
+        else:
+            out.append(conv(part))
+    return out
+
+
+def fmt(v):
+    return f'{v:g}'
+
+
+def expand(args):
+    """Matrice des exécutions ; l'intervalle hello et la mobilité du micrologiciel ne
+    concernent que D-SERAN
+    Run matrix; the hello interval and the firmware mobility only apply to D-SERAN"""
+    runs = []
+    seen = set()
+    for proto, n, speed, hello, seed in itertools.product(args.protocols, args.nodes, args.speeds,
+                                                          args.hello, args.seeds):
+        if proto != 'd-seran':
+            hello = None
+        key = (proto, n, speed, hello, seed)
+        if key in seen:
+            continue
+        seen.add(key)
+        rid = f'{proto}-n{n}-v{fmt(speed)}' + (f'-h{fmt(hello)}' if hello is not None else '') + f'-s{seed}'
+        mobility = (seed, speed, args.area) if proto == 'd-seran' and speed > 0 else None
+        runs.append({'id': rid, 'protocol': proto, 'nodes': n, 'speed': speed, 'hello': hello,
+                     'seed': seed, 'duration': args.duration, 'mobility': mobility})
+    return runs
+
+
+def variant(run):
+    """Clé de build d'une exécution / Build key of a run"""
+    mobility = run['mobility']
+    return run['protocol'], run['hello'], tuple(mobility) if mobility else None
+
+
+def build_variant(proto, hello, mobility=None):
+    """Répertoire de build et DEFINES d'une variante ; chaque référence a le sien, le
+    pilote de routage (NETSTACK_CONF_ROUTING) changeant les objets du cœur Contiki-NG.
+    mobility (graine, vitesse max, surface) : mêmes paramètres que mobility_gen.py
+    Build directory and DEFINES of a variant; each baseline gets its own, since the
+    routing driver (NETSTACK_CONF_ROUTING) changes the Contiki-NG core objects.
+    mobility (seed, max speed, area): same parameters as mobility_gen.py"""
+    if proto != 'd-seran':
+        return f'build-{proto}', ''
+    build_dir, defines = 'build', []
+    if hello is not None:
+        build_dir = f'build-h{fmt(hello)}'
+        defines.append(f'DSERAN_CONF_HELLO_IMIN={int(hello * COOJA_CLOCK_SECOND)}')
+    if mobility is not None:
+        seed, speed, area = mobility
+        build_dir += f'-m{seed}-v{fmt(speed)}-a{fmt(area)}'
+        defines += ['DSERAN_CONF_MOBILITY=1', f'DSERAN_CONF_MOBILITY_SEED={seed}',
+                    f'DSERAN_CONF_MOBILITY_AREA={float(area)!r}f',
+                    f'DSERAN_CONF_MOBILITY_SPEED_MIN={float(speed / 2)!r}f',
+                    f'DSERAN_CONF_MOBILITY_SPEED_MAX={float(speed)!r}f']
+    return build_dir, ','.join(defines)
+
+
+def make_cmd(proto, hello, mobility=None):
+    project, makefile = PROTOCOLS[proto]
+    build_dir, defines = build_variant(proto, hello, mobility)
+    cmd = ['make', '-j4', f'{project}.cooja', 'TARGET=cooja', f'BUILD_DIR={build_dir}']
+    if makefile != 'Makefile':
+        cmd += ['-f', makefile]
+    if defines:
+        cmd.append(f'DEFINES={defines}')
+    return cmd
+
+
+def firmware_path(proto, hello, mobility=None):
+    project, _ = PROTOCOLS[proto]
+    build_dir, _ = build_variant(proto, hello, mobility)
+    return os.path.join(SRC, build_dir, 'cooja', f'{project}.cooja')
+
+
+def positions(run, rundir, args):
+    """Positions initiales ; trajectoires pour le plugin Mobility si la vitesse est non nulle
+    Initial positions; trajectories for the Mobility plugin when the speed is non-zero"""
+    n, seed = run['nodes'], run['seed']
+    if run['speed'] <= 0:
+        return scenario_gen.place(args.topology, n, args.area, args.range, seed)
+    out = os.path.join(rundir, 'positions.dat')
+    subprocess.run([sys.executable, os.path.join(ROOT, 'scripts', 'mobility_gen.py'),
+                    '-n', str(n), '-d', str(run['duration']), '--seed', str(seed),
+                    '--area', str(args.area), '--speed-min', str(run['speed'] / 2),
+                    '--speed-max', str(run['speed']), '-o', out],
+                   check=True, stderr=subprocess.DEVNULL)
+    first = {}
+    with open(out, encoding='utf-8') as f:
+        for line in f:
+            if line.startswith('#'):
+                continue
+            i, t, x, y = line.split()
+            if float(t) > 0:
+                break
+            first[int(i)] = (float(x), float(y))
+    return [first[i] for i in range(n)]
+
+
+def write_csc(run, rundir, args):
+    """.csc de l'exécution, dérivé du modèle du protocole / Run .csc, derived from the protocol template"""
+    commands = ' '.join(make_cmd(*variant(run))).replace('make', '$(MAKE)', 1)
+    scenario_gen.write_csc(os.path.join(rundir, 'sim.csc'), run['protocol'], positions(run, rundir, args),
+                           run['seed'], run['duration'], title=run['id'], radio_range=args.range,
+                           loss=args.loss, commands=commands,
+                           firmware=firmware_path(*variant(run)),
+                           mobility_plugin=args.mobility_plugin if run['speed'] > 0 else None)
+
+
+def done(rundir):
+    try:
+        with open(os.path.join(rundir, 'run.json'), encoding='utf-8') as f:
+            return json.load(f).get('status') == 'ok'
+    except (OSError, ValueError):
+        return False
+
+
+def run_cooja(rundir, cooja, protocol, timeout=None):
+    """Cooja sans interface sur rundir/sim.csc, puis décodage des traces dans rundir/<protocole>.log ;
+    renvoie le code de sortie, None si le balayage s'arrête
+    Headless Cooja on rundir/sim.csc, then trace decoding into rundir/<protocol>.log;
+    returns the exit code, None if the sweep is stopping"""
+    # Cooja écrit COOJA.testlog dans son répertoire courant / Cooja writes COOJA.testlog in its working directory
+    raw = os.path.join(rundir, 'cooja.trc')
+    with open(raw, 'w', encoding='utf-8') as out:
+        with running_lock:
+            if stopping.is_set():
+                return None
+            p = subprocess.Popen(['java', '-jar', cooja, '-nogui', os.path.join(rundir, 'sim.csc')],
+                                 cwd=rundir, stdout=out, stderr=subprocess.STDOUT, start_new_session=True)
+            running.add(p)
+        try:
+            rc = p.wait(timeout=timeout)
+        except subprocess.TimeoutExpired:
+            os.killpg(p.pid, signal.SIGKILL)
+            rc = p.wait()
+        finally:
+            with running_lock:
+                running.discard(p)
+
+    # Traces binaires décodées pour parse_logs.py / Binary traces decoded for parse_logs.py
+    with open(raw, encoding='utf-8', errors='ignore') as src, \
+         open(os.path.join(rundir, f'{protocol}.log'), 'w', encoding='utf-8') as dst:
+        for line in src:
+            try:
+                dst.writelines(decode_line(line))
+            except ValueError:
+                pass
+    return rc
+
+
+def execute(run, args):
+    """Une exécution Cooja dans son répertoire / One Cooja run in its own directory"""
+    rundir = os.path.join(args.out, run['id'])
+    if os.path.isdir(rundir):
+        shutil.rmtree(rundir)   # exécution partielle / partial run
+    os.makedirs(rundir)
+    write_csc(run, rundir, args)
+    if args.dry_run:
+        return dict(run, status='dry-run', wall_s=0.0)
+
+    t0 = time.monotonic()
+    rc = run_cooja(rundir, args.cooja, run['protocol'], args.timeout)
+    if rc is None:
+        return dict(run, status='interrupted', wall_s=0.0)
+
+    res = dict(run, status='ok' if rc == 0 else f'rc={rc}', wall_s=round(time.monotonic() - t0, 1))
+    tmp = os.path.join(rundir, 'run.json.tmp')
+    with open(tmp, 'w', encoding='utf-8') as f:
+        json.dump(res, f, indent=1)
+    os.replace(tmp, os.path.join(rundir, 'run.json'))
+    return res
+
+
+def build_all(runs, jobs):
+    """Chaque variante de micrologiciel une seule fois, avant le pool
+    Each firmware variant exactly once, before the pool"""
+    variants = sorted({variant(r) for r in runs}, key=str)
+
+    def build(v):
+        r = subprocess.run(make_cmd(*v), cwd=SRC, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+        return v, r.returncode, r.stdout[-2000:]
+
+    with ThreadPoolExecutor(max_workers=jobs) as pool:
+        for (proto, hello, mobility), rc, log in pool.map(build, variants):
+            print(f'Sweep: build {proto} hello={hello} mobility={mobility}: '
+                  f'{"ok" if rc == 0 else "ÉCHEC / FAILED"}')
+            if rc != 0:
+                print(log, file=sys.stderr)
+                sys.exit(1)
+
+
+def main():
+    p = argparse.ArgumentParser(description='Balayage Cooja parallèle / Parallel Cooja sweep')
+    p.add_argument('--protocols', default='d-seran,aodv,dsr,olsr')
+    p.add_argument('--seeds', default='1-5')
+    p.add_argument('--nodes', default='10')
+    p.add_argument('--speeds', default='0', help='vitesse max m/s, 0 : statique / max speed m/s, 0: static')
+    p.add_argument('--hello', default='2', help='Imin hello en s (D-SERAN) / hello Imin in s (D-SERAN)')
+    p.add_argument('--duration', type=float, default=600, help='s simulées / simulated s')
+    p.add_argument('--area', type=float, default=100.0, help='m')
+    p.add_argument('--topology', choices=scenario_gen.TOPOLOGIES, default='uniform',
+                   help='placement statique / static placement')
+    p.add_argument('--range', type=float, default=50.0, help='portée UDGM en m / UDGM range in m')
+    p.add_argument('--loss', type=float, default=0.0, help='taux de pertes en réception / reception loss ratio')
+    p.add_argument('-j', '--jobs', type=int, default=os.cpu_count())
+    p.add_argument('--timeout', type=float, default=None, help='s réelles par exécution / wall s per run')
+    p.add_argument('--cooja', default=os.environ.get('COOJA_JAR', ''))
+    p.add_argument('--mobility-plugin', default='Mobility')
+    p.add_argument('-o', '--out', default=os.path.join(ROOT, 'results', 'sweep'))
+    p.add_argument('--no-build', action='store_true')
+    p.add_argument('--dry-run', action='store_true', help='.csc seulement / .csc only')
+    args = p.parse_args()
+
+    args.protocols = args.protocols.split(',')
+    for proto in args.protocols:
+        if proto not in PROTOCOLS:
+            p.error(f'protocole inconnu / unknown protocol: {proto}')
+    args.seeds = parse_list(args.seeds, int)
+    args.nodes = parse_list(args.nodes, int)
+    args.speeds = parse_list(args.speeds)
+    args.hello = parse_list(args.hello)
+    if not args.dry_run and not os.path.isfile(args.cooja):
+        p.error('COOJA_JAR ou / or --cooja : jar Cooja introuvable / Cooja jar not found')
+
+    runs = expand(args)
+    todo = [r for r in runs if not done(os.path.join(args.out, r['id']))]
+    print(f'Sweep: {len(runs)} exécutions / runs, {len(runs) - len(todo)} déjà faites / already done, '
+          f'{args.jobs} workers')
+    if not args.dry_run and not args.no_build:
+        build_all(todo, args.jobs)
+
+    t0 = time.monotonic()
+    failed = 0
+    pool = ThreadPoolExecutor(max_workers=args.jobs)
+    try:
+        futures = [pool.submit(execute, r, args) for r in todo]
+        for k, fut in enumerate(as_completed(futures), 1):
+            res = fut.result()
+            failed += res['status'] not in ('ok', 'dry-run')
+            print(f'Sweep: [{k}/{len(todo)}] {res["id"]} {res["status"]} {res["wall_s"]} s')
+    except KeyboardInterrupt:
+        # Les exécutions finies sont gardées, les autres reprendront / Finished runs are kept, the others will resume
+        pool.shutdown(wait=False, cancel_futures=True)
+        with running_lock:
+            stopping.set()
+            for proc in running:
+                os.killpg(proc.pid, signal.SIGTERM)
+        print('Sweep: interrompu, relancer pour reprendre / interrupted, rerun to resume', file=sys.stderr)
+        sys.exit(130)
+    pool.shutdown()
+
+    # Index de toutes les exécutions terminées / Index of all finished runs
+    with open(os.path.join(args.out, 'runs.csv'), 'w', newline='', encoding='utf-8') as f:
+        w = csv.writer(f)
+        w.writerow(['id', 'protocol', 'nodes', 'speed', 'hello', 'seed', 'duration', 'status', 'wall_s'])
+        for r in runs:
+            try:
+                with open(os.path.join(args.out, r['id'], 'run.json'), encoding='utf-8') as j:
+                    res = json.load(j)
+            except (OSError, ValueError):
+                continue
+            w.writerow([res[k] for k in ('id', 'protocol', 'nodes', 'speed', 'hello', 'seed',
+                                         'duration', 'status', 'wall_s')])
+
+    print(f'Sweep: terminé en / finished in {time.monotonic() - t0:.0f} s, {failed} échec(s) / failure(s)')
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == '__main__':
+    main()
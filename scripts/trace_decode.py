@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+ * trace_decode.py : Décodeur des traces binaires D-SERAN
+ * D-SERAN binary trace decoder
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Remplace chaque ligne "TRC" d'un log Cooja par les enregistrements texte
+ * d'origine (ENERGY, SEND_UDP, RECV, HOP...) attendus par parse_logs.py.
+ * Les autres lignes sont recopiées telles quelles.
+ * Replaces each "TRC" line of a Cooja log with the original text records
+ * (ENERGY, SEND_UDP, RECV, HOP...) expected by parse_logs.py.
+ * Other lines are copied unchanged.
+ *
+ * Usage : trace_decode.py <log binaire / binary log> [<log texte / text log>]
+"""
+
+import re
+import sys
+
+# Table des événements, alignée avec src/dseran-trace.h : (nom, nb d'arguments, horodatage)
+# Event table, in sync with src/dseran-trace.h: (name, argument count, timestamp)
+EVENTS = {
+    1: ('ENERGY', 2, False),
+    2: ('SEND_UDP', 1, True),
+    3: ('RECV', 1, True),
+    4: ('HOP', 1, True),
+    5: ('MOVE', 2, True),
+    6: ('LIFETIME', 1, True),
+    7: ('DATA_TX', 2, True),
+    8: ('DATA_RX', 4, False),
+    9: ('LOCAL_REPAIR', 1, True),
+    10: ('POS', 3, False),
+    11: ('HELLO_SUPPRESS', 1, True),
+    12: ('TRICKLE_RESET', 1, True),
+    13: ('LQE', 3, True),
+    14: ('ENERGEST', 4, True),
+    15: ('REPAIR', 3, True),
+    16: ('HANDOFF', 2, True),
+    17: ('DETECT', 4, True),
+    18: ('CTRL_BYTES', 1, True),
+    19: ('AGG', 3, True),
+}
+
+LOG_PREFIX = '[INFO: D-SERAN   ] '
+TRC_LINE = re.compile(r'TRC ([0-9a-f]{8}) ([0-9a-f]*)\s*$')
+
+
+def decode_batch(t0, payload):
+    """Décode un lot en (nom, arguments, horodatage) / Decode a batch into (name, args, timestamp)"""
+    data = bytes.fromhex(payload)
+    t = t0
+    pos = 0
+    while pos < len(data):
+        ev = data[pos]
+        if ev not in EVENTS or pos + 3 > len(data):
+            raise ValueError(f'enregistrement invalide / invalid record at byte {pos}')
+        name, nargs, with_time = EVENTS[ev]
+        t += data[pos + 1] | (data[pos + 2] << 8)
+        pos += 3
+        if pos + 2 * nargs > len(data):
+            raise ValueError(f'enregistrement tronqué / truncated record at byte {pos}')
+        args = [data[pos + 2 * i] | (data[pos + 2 * i + 1] << 8) for i in range(nargs)]
+        pos += 2 * nargs
+        yield name, args, (t if with_time else None)
+
+
+def decode_line(line):
+    """Lignes texte équivalentes à une ligne de log / Text lines equivalent to one log line"""
+    m = TRC_LINE.search(line)
+    if not m:
+        return [line]
+    prefix = line[:m.start()]
+    out = []
+    for name, args, t in decode_batch(int(m.group(1), 16), m.group(2)):
+        fields = [name] + [str(a) for a in args]
+        if t is not None:
+            fields.append(str(t))
+        out.append(f'{prefix}{LOG_PREFIX}{" ".join(fields)}\n')
+    return out
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+
+    dst = open(sys.argv[2], 'w', encoding='utf-8') if len(sys.argv) >= 3 else sys.stdout
+    batches = records = errors = 0
+    with open(sys.argv[1], 'r', encoding='utf-8', errors='ignore') as src:
+        for line in src:
+            try:
+                lines = decode_line(line)
+            except ValueError as e:
+                errors += 1
+                print(f'Ligne ignorée / Skipped line: {e}', file=sys.stderr)
+                continue
+            if lines[0] is not line:
+                batches += 1
+                records += len(lines)
+            dst.writelines(lines)
+
+    print(f'Trace Decode: {batches} lots / batches, {records} enregistrements / records, '
+          f'{errors} erreurs / errors', file=sys.stderr)
+    if dst is not sys.stdout:
+        dst.close()
+
+
+if __name__ == '__main__':
+    main()
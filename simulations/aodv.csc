@@ -20,7 +20,7 @@
     <motetype>
       org.contikios.cooja.contikimote.ContikiMoteType
       <identifier>aodv-demo</identifier>
-      <description>AODV/UDP Flooding Mote</description>
+      <description>AODV Mote</description>
       <source>[CONFIG_DIR]/../src/aodv-demo.c</source>
       <commands>$(MAKE) -j$(CPUS) aodv-demo.cooja TARGET=cooja -f Makefile.aodv</commands>
       <firmware>[CONFIG_DIR]/../src/build/cooja/aodv-demo.cooja</firmware>
@@ -93,7 +93,7 @@
         while (true) {
           YIELD();
           if (typeof msg !== 'undefined' &amp;&amp; msg !== null) {
-            log.log(String(msg) + "\n");
+            log.log(time + "\tID:" + id + "\t" + String(msg) + "\n");
           }
         }
       </script>
@@ -69,11 +69,11 @@
     org.contikios.cooja.plugins.ScriptRunner
     <plugin_config>
       <script>
-        /* Ecrire chaque message de mote dans le test log */
+        /* Ecrire chaque message de mote dans le test log, avec temps (µs) et nœud */
         while (true) {
           YIELD();
           if (typeof msg !== 'undefined' &amp;&amp; msg !== null) {
-            log.log(String(msg) + "\n");
+            log.log(time + "\tID:" + id + "\t" + String(msg) + "\n");
           }
         }
       </script>
@@ -93,7 +93,7 @@
         while (true) {
           YIELD();
           if (typeof msg !== 'undefined' &amp;&amp; msg !== null) {
-            log.log(String(msg) + "\n");
+            log.log(time + "\tID:" + id + "\t" + String(msg) + "\n");
           }
         }
       </script>
@@ -1,98 +1,186 @@
 /*
- * aodv-demo.c : Protocole de référence simple (UDP Flooding) pour MANET sous Contiki-NG
- * Simple reference protocol (UDP Flooding) for MANET under Contiki-NG
- * 
+ * aodv-demo.c : Protocole de référence AODV pour MANET sous Contiki-NG
+ * AODV reference protocol for MANET under Contiki-NG
+ *
  * Auteur / Author: Madani Belacel
  * Date de création / Created: 18/03/2023
- * Dernière mise à jour / Last updated: 25/04/2023
- * 
- * Implémentation simplifiée d'AODV pour comparaison avec D-SERAN
- * Simplified AODV implementation for comparison with D-SERAN
+ * Dernière mise à jour / Last updated: Août 2025
+ *
+ * Même charge que D-SERAN (une donnée vers le puits toutes les
+ * DSERAN_CONF_DATA_INTERVAL, énergie mesurée par energest) routée par AODV
+ * (aodv.c) : sans route valide, les données attendent la fin de la
+ * découverte dans un petit tampon.
+ * Same workload as D-SERAN (one data frame to the sink every
+ * DSERAN_CONF_DATA_INTERVAL, energy measured through energest) routed by
+ * AODV (aodv.c): without a valid route, data waits in a small buffer for the
+ * discovery to end.
  */
 
 #include "contiki.h"
+#include "net/netstack.h"
+#include "net/routing/routing.h"
+#include "net/ipv6/simple-udp.h"
 #include "net/ipv6/uip-ds6.h"
 #include "net/ipv6/uip.h"
-#include "net/ipv6/uip-udp-packet.h"
 #include "sys/log.h"
+#include "sys/node-id.h"
 #include "lib/random.h"
+#include "aodv.h"
+#include "dseran-energy.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define LOG_MODULE "AODV-DEMO"
 #define LOG_LEVEL LOG_LEVEL_INFO
 
-// Configuration des paramètres / Parameter configuration
-#define UDP_PORT 1235
-#define SEND_INTERVAL (CLOCK_SECOND * 10)
-#define MAX_HOPS 10
+// Puits et trafic partagés avec D-SERAN / Sink and traffic shared with D-SERAN
+#ifdef DSERAN_CONF_SINK_ID
+#define SINK_ID DSERAN_CONF_SINK_ID
+#else
+#define SINK_ID 1
+#endif
+#ifdef DSERAN_CONF_DATA_INTERVAL
+#define DATA_INTERVAL DSERAN_CONF_DATA_INTERVAL
+#else
+#define DATA_INTERVAL (CLOCK_SECOND * 15)
+#endif
+#define DATA_PORT 5678
+#define ENERGY_INTERVAL (CLOCK_SECOND * 5)
 
-PROCESS(aodv_demo_process, "AODV/UDP Flooding Demo");
+// Données en attente d'une route (RFC 3561, section 6.3) / Data awaiting a route (RFC 3561, section 6.3)
+#ifdef AODV_CONF_DATA_BUFFER
+#define DATA_BUFFER AODV_CONF_DATA_BUFFER
+#else
+#define DATA_BUFFER 4
+#endif
+
+PROCESS(aodv_demo_process, "AODV Demo");
 AUTOSTART_PROCESSES(&aodv_demo_process);
 
+struct aodv_data {
+  uint16_t origin;      // node_id de la source / source node_id
+  uint16_t seq;
+  uint32_t send_time;   // clock_time() de l'émetteur / sender clock_time()
+};
+
 // Variables globales / Global variables
-static struct uip_udp_conn *udp_conn;
+static struct simple_udp_connection data_conn;
+static uip_ipaddr_t sink_ipaddr;
 static uint16_t seq_id = 0;
 
-// Statistiques de performance / Performance statistics
-static uint16_t packets_sent = 0;
+// File d'attente de la découverte ; la plus ancienne donnée cède sa place
+// Discovery queue; the oldest data frame gives way
+static struct aodv_data pending[DATA_BUFFER];
+static uint8_t pending_len = 0;
+
+// Énergie résiduelle / Residual energy
+static uint16_t my_energy;
+
+static void data_send(const struct aodv_data *msg) {
+  simple_udp_sendto(&data_conn, msg, sizeof(*msg), &sink_ipaddr);
+}
 
-// Simulation de l'énergie / Energy simulation
-static uint16_t my_energy = 100;
+// Fin de découverte : le tampon part par la nouvelle route ou est perdu
+// Discovery end: the buffer leaves through the new route or is lost
+static void route_found(const uip_ipaddr_t *dest, uint8_t found) {
+  uint8_t hops;
+  
+  if(found && aodv_route_valid(dest, &hops)) {
+    LOG_INFO("HOP %u %lu\n", hops, (unsigned long)clock_time());
+    for(uint8_t i=0; i<pending_len; i++) {
+      data_send(&pending[i]);
+    }
+  }
+  pending_len = 0;
+}
 
 // Fonction d'envoi de paquets / Packet sending function
 static void send_packet(void) {
-  char buf[32];
+  struct aodv_data msg;
   
-  // Préparation du message / Message preparation
-  sprintf(buf, "DATA %u %lu", seq_id++, clock_time());
+  msg.origin = node_id;
+  msg.seq = ++seq_id;
+  msg.send_time = (uint32_t)clock_time();
+  LOG_INFO("DATA_TX %u %u %lu\n", msg.origin, msg.seq, (unsigned long)clock_time());
   
-  // Envoi UDP / UDP sending
-  uip_udp_packet_send(udp_conn, buf, strlen(buf));
+  if(aodv_route_valid(&sink_ipaddr, NULL)) {
+    data_send(&msg);
+    return;
+  }
+  if(pending_len == DATA_BUFFER) {
+    memmove(&pending[0], &pending[1], (DATA_BUFFER - 1) * sizeof(pending[0]));
+    pending_len--;
+  }
+  pending[pending_len++] = msg;
+  aodv_discover(&sink_ipaddr, route_found);
+}
+
+// Réception des données au puits / Data reception at the sink
+static void data_rx_callback(struct simple_udp_connection *c, const uip_ipaddr_t *sender_addr,
+                             uint16_t sender_port, const uip_ipaddr_t *receiver_addr,
+                             uint16_t receiver_port, const uint8_t *data, uint16_t datalen) {
+  struct aodv_data msg;
   
-  // Mise à jour des statistiques / Statistics update
-  packets_sent++;
-  my_energy--;
+  if(!NETSTACK_ROUTING.node_is_root() || datalen != sizeof(msg)) {
+    return;
+  }
+  memcpy(&msg, data, sizeof(msg));
   
-  // Logs de débogage / Debug logs
-  LOG_INFO("SEND_UDP %u %lu\n", seq_id, clock_time());
-  LOG_INFO("ENERGY %u %lu\n", my_energy, clock_time());
+  // Latence en ms (horloges Cooja alignées) et sauts déduits du TTL
+  // Latency in ms (aligned Cooja clocks) and hops derived from the TTL
+  uint32_t latency = ((uint32_t)clock_time() - msg.send_time) * 1000 / CLOCK_SECOND;
+  uint8_t hops = uip_ds6_if.cur_hop_limit - UIP_IP_BUF->ttl + 1;
   
-  // Traces de débogage occasionnelles / Occasional debug traces
-  if (random_rand() % 15 == 0) {
-    printf("AODV: Paquet envoyé #%u, énergie: %u mJ\n", seq_id-1, my_energy);
-  }
+  LOG_INFO("DATA_RX %u %u %lu %u\n", msg.origin, msg.seq, (unsigned long)latency, hops);
 }
 
 // Processus principal AODV / Main AODV process
 PROCESS_THREAD(aodv_demo_process, ev, data) {
-  static struct etimer send_timer;
+  static struct etimer send_timer, energy_timer;
   
   PROCESS_BEGIN();
   
-  // Configuration de la connexion UDP / UDP connection setup
-  udp_conn = udp_new(NULL, UIP_HTONS(UDP_PORT), NULL);
-  udp_bind(udp_conn, UIP_HTONS(UDP_PORT));
+  dseran_energy_init();
+  my_energy = dseran_energy_residual();
+  NETSTACK_ROUTING.get_root_ipaddr(&sink_ipaddr);
+  if(node_id == SINK_ID) {
+    NETSTACK_ROUTING.root_start();
+  }
+  simple_udp_register(&data_conn, DATA_PORT, NULL, DATA_PORT, data_rx_callback);
   
-  // Configuration du timer d'envoi / Send timer setup
-  etimer_set(&send_timer, SEND_INTERVAL);
+  // Configuration des timers, premier envoi décalé / Timer setup, first sending offset
+  etimer_set(&energy_timer, ENERGY_INTERVAL);
+  etimer_set(&send_timer, DATA_INTERVAL + random_rand() % DATA_INTERVAL);
   
-  printf("AODV: Démonstration démarrée, port UDP: %d\n", UDP_PORT);
+  printf("AODV: Démonstration démarrée, puits / sink %u\n", SINK_ID);
   
   while(1) {
-    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&send_timer));
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&send_timer) || etimer_expired(&energy_timer));
     
-    // Envoi périodique / Periodic sending
-    send_packet();
-    etimer_reset(&send_timer);
+    // Énergie mesurée / Measured energy
+    if(etimer_expired(&energy_timer)) {
+      dseran_energy_update();
+      my_energy = dseran_energy_residual();
+      LOG_INFO("ENERGY %u %lu\n", my_energy, (unsigned long)clock_time());
+      etimer_reset(&energy_timer);
+    }
+    
+    // Envoi périodique vers le puits / Periodic sending to the sink
+    if(etimer_expired(&send_timer)) {
+      if(node_id != SINK_ID) {
+        send_packet();
+      }
+      etimer_reset(&send_timer);
+    }
     
     // Vérification de la fin de vie / Lifetime check
     if(my_energy == 0) {
-      LOG_INFO("LIFETIME %u %lu\n", linkaddr_node_addr.u8[0], clock_time());
+      LOG_INFO("LIFETIME %u %lu\n", linkaddr_node_addr.u8[0], (unsigned long)clock_time());
       printf("AODV: Énergie épuisée, arrêt du protocole\n");
       PROCESS_EXIT();
     }
   }
   
   PROCESS_END();
-} 
\ No newline at end of file
+}
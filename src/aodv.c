@@ -0,0 +1,832 @@
+/*
+ * aodv.c : Routage AODV à la demande (RFC 3561) pour Contiki-NG
+ * On-demand AODV routing (RFC 3561) for Contiki-NG
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Écarts à la RFC : pas de hellos, la rupture d'un lien est apprise du
+ * retour MAC (section 6.10 : détection par la couche liaison) ; pas de
+ * liste de précurseurs, le RERR est toujours diffusé et seuls les voisins
+ * qui routaient par l'émetteur le relaient ; pas de réparation locale ni de
+ * RREP gratuit. Les adresses sont les adresses globales fd00::IID.
+ * Departures from the RFC: no hellos, link breaks are learnt from the MAC
+ * feedback (section 6.10: link-layer detection); no precursor lists, the
+ * RERR is always broadcast and only the neighbors routing through its
+ * sender relay it; no local repair nor gratuitous RREP. Addresses are the
+ * fd00::IID global addresses.
+ */
+
+#include "contiki.h"
+#include "net/routing/routing.h"
+#include "net/ipv6/simple-udp.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "net/linkaddr.h"
+#include "net/mac/mac.h"
+#include "lib/random.h"
+#include "sys/ctimer.h"
+#include "sys/log.h"
+#include "aodv.h"
+#include "dseran-energy.h"
+#include "dseran-net.h"
+#include <string.h>
+
+// Module des journaux attendu par parse_logs.py et logparse / Log module expected by parse_logs.py and logparse
+#define LOG_MODULE "AODV-DEMO"
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+// Délais dérivés (RFC 3561, section 10) / Derived delays (RFC 3561, section 10)
+#define NET_TRAVERSAL_TIME  (2 * AODV_NODE_TRAVERSAL_TIME * AODV_NET_DIAMETER)
+#define PATH_DISCOVERY_TIME (2 * NET_TRAVERSAL_TIME)
+#define MY_ROUTE_TIMEOUT    (2 * AODV_ACTIVE_ROUTE_TIMEOUT)
+#define DELETE_PERIOD       (5 * AODV_ACTIVE_ROUTE_TIMEOUT)
+#define TIMEOUT_BUFFER      2
+#define RING_TRAVERSAL_TIME(ttl) (2 * AODV_NODE_TRAVERSAL_TIME * ((ttl) + TIMEOUT_BUFFER))
+#define PURGE_INTERVAL      CLOCK_SECOND
+
+// Messages / Messages
+#define AODV_RREQ 1
+#define AODV_RREP 2
+#define AODV_RERR 3
+
+#define RREQ_FLAG_D 0x01   // seule la destination répond / only the destination replies
+#define RREQ_FLAG_U 0x02   // numéro de séquence inconnu / unknown sequence number
+
+struct aodv_rreq {
+  uint8_t type;
+  uint8_t flags;
+  uint8_t hop_count;
+  uint8_t ttl;
+  uint32_t rreq_id;
+  uint32_t dest_seq;
+  uint32_t orig_seq;
+  uip_ipaddr_t dest;
+  uip_ipaddr_t orig;
+};
+
+struct aodv_rrep {
+  uint8_t type;
+  uint8_t flags;
+  uint8_t hop_count;
+  uint8_t reserved;
+  uint32_t dest_seq;
+  uint32_t lifetime_ms;
+  uip_ipaddr_t dest;
+  uip_ipaddr_t orig;
+};
+
+#define RERR_MAX_DEST 3
+struct aodv_unreach {
+  uip_ipaddr_t dest;
+  uint32_t seq;
+};
+
+struct aodv_rerr {
+  uint8_t type;
+  uint8_t flags;
+  uint8_t count;
+  uint8_t reserved;
+  struct aodv_unreach unreach[RERR_MAX_DEST];
+};
+
+// Forme sur l'air, champs de 32 bits en ordre réseau (section 5) : aucune dépendance à
+// l'alignement ni à l'ordre des octets du compilateur, RERR de 4 + 20 octets par destination
+// Wire form, 32-bit fields in network order (section 5): no dependency on the compiler
+// alignment or byte order, RERR of 4 + 20 bytes per destination
+#define RREQ_LEN    48
+#define RREP_LEN    44
+#define RERR_LEN(n) (4 + (n) * 20)
+#define MSG_MAX     RERR_LEN(RERR_MAX_DEST)
+
+// Table de routage / Routing table
+#define RT_USED  0x01
+#define RT_VALID 0x02
+#define RT_SEQ   0x04   // numéro de séquence connu / sequence number known
+
+struct aodv_route {
+  uip_ipaddr_t dest;
+  linkaddr_t next_hop;
+  uint32_t seq;
+  clock_time_t expires;   // route valide : fin de vie ; invalide : effacement / valid: end of life; invalid: deletion
+  uint8_t hops;
+  uint8_t flags;
+};
+
+// RREQ déjà vu / RREQ already seen
+struct rreq_seen {
+  uip_ipaddr_t orig;
+  uint32_t id;
+  clock_time_t expires;
+};
+
+// Découverte en cours / Discovery in progress
+struct discovery {
+  uip_ipaddr_t dest;
+  aodv_route_callback_t cb;
+  struct ctimer timer;
+  uint8_t ttl;
+  uint8_t retries;
+  uint8_t used;
+};
+
+// Diffusion relayée après une gigue / Broadcast relayed after a jitter
+#define DELAYED_NUM 4
+struct delayed {
+  uint8_t buf[MSG_MAX];
+  uint8_t len;
+  struct ctimer timer;
+};
+
+PROCESS(aodv_process, "AODV");
+
+static struct simple_udp_connection aodv_conn;
+static struct aodv_route routes[AODV_MAX_ROUTES];
+static struct rreq_seen seen[AODV_RREQ_CACHE];
+static uint8_t seen_pos = 0;
+static struct discovery discoveries[AODV_DISCOVERIES];
+static struct delayed delayed[DELAYED_NUM];
+static struct aodv_stats stats;
+
+static uip_ipaddr_t my_ipaddr;
+static uip_ipaddr_t sink_ipaddr;
+static uint8_t is_root = 0;
+static uint32_t own_seq = 0;
+static uint32_t rreq_id = 0;
+
+// Comparaison circulaire des numéros de séquence (section 6.1) / Circular sequence number comparison (section 6.1)
+static int seq_newer(uint32_t a, uint32_t b) {
+  return (int32_t)(a - b) > 0;
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static uint8_t rreq_pack(const struct aodv_rreq *m, uint8_t *buf) {
+  buf[0] = m->type;
+  buf[1] = m->flags;
+  buf[2] = m->hop_count;
+  buf[3] = m->ttl;
+  put_u32(&buf[4], m->rreq_id);
+  put_u32(&buf[8], m->dest_seq);
+  put_u32(&buf[12], m->orig_seq);
+  memcpy(&buf[16], &m->dest, sizeof(uip_ipaddr_t));
+  memcpy(&buf[32], &m->orig, sizeof(uip_ipaddr_t));
+  return RREQ_LEN;
+}
+
+static void rreq_unpack(struct aodv_rreq *m, const uint8_t *buf) {
+  m->type = buf[0];
+  m->flags = buf[1];
+  m->hop_count = buf[2];
+  m->ttl = buf[3];
+  m->rreq_id = get_u32(&buf[4]);
+  m->dest_seq = get_u32(&buf[8]);
+  m->orig_seq = get_u32(&buf[12]);
+  memcpy(&m->dest, &buf[16], sizeof(uip_ipaddr_t));
+  memcpy(&m->orig, &buf[32], sizeof(uip_ipaddr_t));
+}
+
+static uint8_t rrep_pack(const struct aodv_rrep *m, uint8_t *buf) {
+  buf[0] = m->type;
+  buf[1] = m->flags;
+  buf[2] = m->hop_count;
+  buf[3] = 0;
+  put_u32(&buf[4], m->dest_seq);
+  put_u32(&buf[8], m->lifetime_ms);
+  memcpy(&buf[12], &m->dest, sizeof(uip_ipaddr_t));
+  memcpy(&buf[28], &m->orig, sizeof(uip_ipaddr_t));
+  return RREP_LEN;
+}
+
+static void rrep_unpack(struct aodv_rrep *m, const uint8_t *buf) {
+  m->type = buf[0];
+  m->flags = buf[1];
+  m->hop_count = buf[2];
+  m->reserved = 0;
+  m->dest_seq = get_u32(&buf[4]);
+  m->lifetime_ms = get_u32(&buf[8]);
+  memcpy(&m->dest, &buf[12], sizeof(uip_ipaddr_t));
+  memcpy(&m->orig, &buf[28], sizeof(uip_ipaddr_t));
+}
+
+static uint8_t rerr_pack(const struct aodv_rerr *m, uint8_t *buf) {
+  buf[0] = m->type;
+  buf[1] = m->flags;
+  buf[2] = m->count;
+  buf[3] = 0;
+  for(uint8_t i=0; i<m->count; i++) {
+    memcpy(&buf[RERR_LEN(i)], &m->unreach[i].dest, sizeof(uip_ipaddr_t));
+    put_u32(&buf[RERR_LEN(i) + 16], m->unreach[i].seq);
+  }
+  return RERR_LEN(m->count);
+}
+
+// 0 si le nombre de destinations ne correspond pas à la longueur / 0 when the destination count does not match the length
+static uint8_t rerr_unpack(struct aodv_rerr *m, const uint8_t *buf, uint16_t len) {
+  if(len < RERR_LEN(0) || buf[2] > RERR_MAX_DEST || len != RERR_LEN(buf[2])) {
+    return 0;
+  }
+  m->type = buf[0];
+  m->flags = buf[1];
+  m->count = buf[2];
+  m->reserved = 0;
+  for(uint8_t i=0; i<m->count; i++) {
+    memcpy(&m->unreach[i].dest, &buf[RERR_LEN(i)], sizeof(uip_ipaddr_t));
+    m->unreach[i].seq = get_u32(&buf[RERR_LEN(i) + 16]);
+  }
+  return 1;
+}
+
+// Envoi d'un message ; to NULL : diffusion à ff02::1 / Send a message; to NULL: broadcast to ff02::1
+static void send_msg(const void *buf, uint16_t len, const linkaddr_t *to) {
+  uip_ipaddr_t ip;
+
+  if(to == NULL) {
+    uip_create_linklocal_allnodes_mcast(&ip);
+  } else {
+    dseran_net_nbr_ipaddr(&ip, to);
+  }
+  simple_udp_sendto(&aodv_conn, buf, len, &ip);
+  LOG_INFO("SEND_UDP %u %lu\n", dseran_energy_residual(), (unsigned long)clock_time());
+}
+
+static void delayed_cb(void *ptr) {
+  struct delayed *d = ptr;
+
+  send_msg(d->buf, d->len, NULL);
+  d->len = 0;
+}
+
+// Diffusion après une gigue aléatoire, immédiate si aucune place
+// Broadcast after a random jitter, immediate when no slot is free
+static void send_jittered(const void *buf, uint16_t len) {
+  for(uint8_t i=0; i<DELAYED_NUM; i++) {
+    if(delayed[i].len == 0) {
+      memcpy(delayed[i].buf, buf, len);
+      delayed[i].len = len;
+      ctimer_set(&delayed[i].timer, 1 + random_rand() % AODV_JITTER, delayed_cb, &delayed[i]);
+      return;
+    }
+  }
+  send_msg(buf, len, NULL);
+}
+
+static struct aodv_route *route_lookup(const uip_ipaddr_t *dest) {
+  for(uint8_t i=0; i<AODV_MAX_ROUTES; i++) {
+    if((routes[i].flags & RT_USED) && uip_ipaddr_cmp(&routes[i].dest, dest)) {
+      return &routes[i];
+    }
+  }
+  return NULL;
+}
+
+// Route hôte uIP vers dest par le prochain saut / uIP host route to dest through the next hop
+static void route_install(struct aodv_route *r) {
+  uip_ipaddr_t nh;
+
+  dseran_net_nbr_ipaddr(&nh, &r->next_hop);
+  if(uip_ds6_route_add(&r->dest, 128, &nh) == NULL) {
+    LOG_WARN("Route uIP refusée / uIP route refused\n");
+  }
+}
+
+static void route_uninstall(struct aodv_route *r) {
+  uip_ds6_route_t *rt = uip_ds6_route_lookup(&r->dest);
+
+  if(rt != NULL) {
+    uip_ds6_route_rm(rt);
+  }
+}
+
+// Route invalidée, gardée DELETE_PERIOD pour son numéro de séquence (section 6.11)
+// Route invalidated, kept DELETE_PERIOD for its sequence number (section 6.11)
+static void route_invalidate(struct aodv_route *r) {
+  r->flags &= ~RT_VALID;
+  r->expires = clock_time() + DELETE_PERIOD;
+  route_uninstall(r);
+}
+
+// Rang d'éviction : invalides, puis routes de voisinage sans numéro, puis les autres
+// Eviction rank: invalid routes, then numberless neighbor routes, then the others
+#define RT_RANK(r) ((r)->flags & (RT_VALID | RT_SEQ))
+
+// Case libre, sinon la route de plus petit rang qui expire le plus tôt
+// Free slot, otherwise the lowest-ranked route expiring first
+static struct aodv_route *route_alloc(void) {
+  struct aodv_route *victim = NULL;
+
+  for(uint8_t i=0; i<AODV_MAX_ROUTES; i++) {
+    struct aodv_route *r = &routes[i];
+    if(!(r->flags & RT_USED)) {
+      return r;
+    }
+    if(victim == NULL || RT_RANK(r) < RT_RANK(victim) ||
+       (RT_RANK(r) == RT_RANK(victim) && CLOCK_LT(r->expires, victim->expires))) {
+      victim = r;
+    }
+  }
+  if(victim->flags & RT_VALID) {
+    route_uninstall(victim);
+  }
+  victim->flags = 0;
+  return victim;
+}
+
+// Durée de vie prolongée, jamais raccourcie / Lifetime extended, never shortened
+static void route_extend(struct aodv_route *r, clock_time_t lifetime) {
+  clock_time_t expires = clock_time() + lifetime;
+
+  if(CLOCK_LT(r->expires, expires)) {
+    r->expires = expires;
+  }
+}
+
+// Mise à jour d'une route (section 6.2) : numéro plus récent, égal avec moins de
+// sauts, ou route absente, invalide ou sans numéro / Route update (section 6.2):
+// newer number, equal with fewer hops, or route missing, invalid or numberless
+static struct aodv_route *route_update(const uip_ipaddr_t *dest, const linkaddr_t *nh, uint8_t hops,
+                                       uint32_t seq, uint8_t seq_valid, clock_time_t lifetime) {
+  struct aodv_route *r = route_lookup(dest);
+  uint8_t better;
+
+  if(r == NULL || !(r->flags & RT_VALID)) {
+    better = 1;
+  } else if(seq_valid && (r->flags & RT_SEQ)) {
+    better = seq_newer(seq, r->seq) || (seq == r->seq && hops < r->hops);
+  } else {
+    better = hops < r->hops || (seq_valid && !(r->flags & RT_SEQ));
+  }
+  if(!better) {
+    // Même chemin confirmé / Same path confirmed
+    if(hops == r->hops && linkaddr_cmp(&r->next_hop, nh)) {
+      route_extend(r, lifetime);
+    }
+    return r;
+  }
+
+  if(r == NULL) {
+    r = route_alloc();
+    uip_ipaddr_copy(&r->dest, dest);
+  }
+  if(!(r->flags & RT_VALID) || !linkaddr_cmp(&r->next_hop, nh)) {
+    r->expires = clock_time();
+  }
+  linkaddr_copy(&r->next_hop, nh);
+  r->hops = hops;
+  if(seq_valid) {
+    r->seq = seq;
+    r->flags |= RT_SEQ;
+  }
+  r->flags |= RT_USED | RT_VALID;
+  route_extend(r, lifetime);
+  route_install(r);
+  return r;
+}
+
+static uint8_t rreq_seen(const uip_ipaddr_t *orig, uint32_t id) {
+  clock_time_t now = clock_time();
+
+  for(uint8_t i=0; i<AODV_RREQ_CACHE; i++) {
+    if(seen[i].id == id && CLOCK_LT(now, seen[i].expires) && uip_ipaddr_cmp(&seen[i].orig, orig)) {
+      return 1;
+    }
+  }
+  uip_ipaddr_copy(&seen[seen_pos].orig, orig);
+  seen[seen_pos].id = id;
+  seen[seen_pos].expires = now + PATH_DISCOVERY_TIME;
+  seen_pos = (seen_pos + 1) % AODV_RREQ_CACHE;
+  return 0;
+}
+
+// RERR pour les destinations désormais injoignables, par paquets de RERR_MAX_DEST
+// RERR for the destinations now unreachable, in batches of RERR_MAX_DEST
+static void rerr_send(struct aodv_rerr *m) {
+  uint8_t buf[MSG_MAX];
+
+  send_jittered(buf, rerr_pack(m, buf));
+  stats.rerr_sent++;
+  m->count = 0;
+}
+
+static void rerr_add(struct aodv_rerr *m, const struct aodv_route *r) {
+  m->unreach[m->count].dest = r->dest;
+  m->unreach[m->count].seq = r->seq;
+  if(++m->count == RERR_MAX_DEST) {
+    rerr_send(m);
+  }
+}
+
+static void rerr_flush(struct aodv_rerr *m) {
+  if(m->count > 0) {
+    rerr_send(m);
+  }
+}
+
+static void rerr_init(struct aodv_rerr *m) {
+  memset(m, 0, sizeof(*m));
+  m->type = AODV_RERR;
+}
+
+// Lien rompu : routes par ce voisin invalidées, numéro incrémenté (section 6.11)
+// Broken link: routes through this neighbor invalidated, number incremented (section 6.11)
+static void link_break(const linkaddr_t *nbr) {
+  struct aodv_rerr m;
+
+  rerr_init(&m);
+  for(uint8_t i=0; i<AODV_MAX_ROUTES; i++) {
+    struct aodv_route *r = &routes[i];
+    if((r->flags & RT_VALID) && linkaddr_cmp(&r->next_hop, nbr)) {
+      r->seq++;
+      route_invalidate(r);
+      rerr_add(&m, r);
+    }
+  }
+  stats.link_breaks++;
+  rerr_flush(&m);
+}
+
+static struct discovery *discovery_lookup(const uip_ipaddr_t *dest) {
+  for(uint8_t i=0; i<AODV_DISCOVERIES; i++) {
+    if(discoveries[i].used && uip_ipaddr_cmp(&discoveries[i].dest, dest)) {
+      return &discoveries[i];
+    }
+  }
+  return NULL;
+}
+
+static void discovery_end(struct discovery *d, uint8_t found) {
+  ctimer_stop(&d->timer);
+  d->used = 0;
+  if(!found) {
+    stats.failures++;
+  }
+  if(d->cb != NULL) {
+    d->cb(&d->dest, found);
+  }
+}
+
+static void rreq_originate(struct discovery *d) {
+  struct aodv_rreq m;
+  uint8_t buf[RREQ_LEN];
+  const struct aodv_route *r = route_lookup(&d->dest);
+
+  // Numéro propre incrémenté avant chaque RREQ (section 6.1) / Own number incremented before each RREQ (section 6.1)
+  own_seq++;
+  memset(&m, 0, sizeof(m));
+  m.type = AODV_RREQ;
+  m.ttl = d->ttl;
+  m.rreq_id = ++rreq_id;
+  m.orig_seq = own_seq;
+  uip_ipaddr_copy(&m.dest, &d->dest);
+  uip_ipaddr_copy(&m.orig, &my_ipaddr);
+  if(r != NULL && (r->flags & RT_SEQ)) {
+    m.dest_seq = r->seq;
+  } else {
+    m.flags |= RREQ_FLAG_U;
+  }
+  rreq_seen(&m.orig, m.rreq_id);
+  send_msg(buf, rreq_pack(&m, buf), NULL);
+  stats.rreq_sent++;
+}
+
+// Anneau croissant puis RREQ_RETRIES essais au diamètre, attente doublée à chacun
+// Expanding ring then RREQ_RETRIES attempts at the diameter, wait doubled each time
+static void discovery_timeout(void *ptr) {
+  struct discovery *d = ptr;
+  clock_time_t wait;
+
+  if(d->ttl < AODV_NET_DIAMETER) {
+    d->ttl += AODV_TTL_INCREMENT;
+    if(d->ttl > AODV_TTL_THRESHOLD) {
+      d->ttl = AODV_NET_DIAMETER;
+    }
+  } else if(++d->retries > AODV_RREQ_RETRIES) {
+    discovery_end(d, 0);
+    return;
+  }
+  wait = d->ttl < AODV_NET_DIAMETER ? RING_TRAVERSAL_TIME(d->ttl) : NET_TRAVERSAL_TIME << d->retries;
+  rreq_originate(d);
+  ctimer_set(&d->timer, wait, discovery_timeout, d);
+}
+
+uint8_t aodv_route_valid(const uip_ipaddr_t *dest, uint8_t *hops) {
+  const struct aodv_route *r = route_lookup(dest);
+
+  if(r == NULL || !(r->flags & RT_VALID)) {
+    return 0;
+  }
+  if(hops != NULL) {
+    *hops = r->hops;
+  }
+  return 1;
+}
+
+void aodv_discover(const uip_ipaddr_t *dest, aodv_route_callback_t cb) {
+  const struct aodv_route *r;
+  struct discovery *d = NULL;
+
+  if(discovery_lookup(dest) != NULL) {
+    return;
+  }
+  for(uint8_t i=0; i<AODV_DISCOVERIES; i++) {
+    if(!discoveries[i].used) {
+      d = &discoveries[i];
+      break;
+    }
+  }
+  if(d == NULL) {
+    if(cb != NULL) {
+      cb(dest, 0);
+    }
+    return;
+  }
+  stats.discoveries++;
+  LOG_INFO("ROUTE_DISC %lu %lu\n", (unsigned long)stats.discoveries, (unsigned long)clock_time());
+
+  // Anneau initial : dernière distance connue + TTL_INCREMENT (section 6.4)
+  // Initial ring: last known distance + TTL_INCREMENT (section 6.4)
+  r = route_lookup(dest);
+  uip_ipaddr_copy(&d->dest, dest);
+  d->cb = cb;
+  d->used = 1;
+  d->retries = 0;
+  d->ttl = r != NULL ? r->hops + AODV_TTL_INCREMENT : AODV_TTL_START;
+  if(d->ttl > AODV_TTL_THRESHOLD) {
+    d->ttl = AODV_NET_DIAMETER;
+  }
+  rreq_originate(d);
+  ctimer_set(&d->timer, d->ttl < AODV_NET_DIAMETER ? RING_TRAVERSAL_TIME(d->ttl) : NET_TRAVERSAL_TIME,
+             discovery_timeout, d);
+}
+
+const struct aodv_stats *aodv_get_stats(void) {
+  return &stats;
+}
+
+// RREP vers l'origine par la route inverse / RREP towards the originator through the reverse route
+static void rrep_send(struct aodv_rrep *m) {
+  struct aodv_route *rev = route_lookup(&m->orig);
+  uint8_t buf[RREP_LEN];
+
+  if(rev == NULL || !(rev->flags & RT_VALID)) {
+    return;
+  }
+  route_extend(rev, AODV_ACTIVE_ROUTE_TIMEOUT);
+  send_msg(buf, rrep_pack(m, buf), &rev->next_hop);
+  stats.rrep_sent++;
+}
+
+static void rreq_input(const linkaddr_t *from, struct aodv_rreq *m) {
+  struct aodv_rrep rep;
+  struct aodv_route *r;
+  uint8_t buf[RREQ_LEN];
+
+  if(uip_ipaddr_cmp(&m->orig, &my_ipaddr) || rreq_seen(&m->orig, m->rreq_id)) {
+    return;
+  }
+  // Route inverse vers l'origine (section 6.5) / Reverse route to the originator (section 6.5)
+  m->hop_count++;
+  route_update(&m->orig, from, m->hop_count, m->orig_seq, 1,
+               2 * NET_TRAVERSAL_TIME - 2 * m->hop_count * AODV_NODE_TRAVERSAL_TIME);
+
+  memset(&rep, 0, sizeof(rep));
+  rep.type = AODV_RREP;
+  uip_ipaddr_copy(&rep.dest, &m->dest);
+  uip_ipaddr_copy(&rep.orig, &m->orig);
+  r = route_lookup(&m->dest);
+
+  if(uip_ds6_is_my_addr(&m->dest)) {
+    // Réponse de la destination (section 6.6.1) / Reply by the destination (section 6.6.1)
+    if(!(m->flags & RREQ_FLAG_U) && m->dest_seq == own_seq + 1) {
+      own_seq++;
+    }
+    rep.dest_seq = own_seq;
+    rep.lifetime_ms = MY_ROUTE_TIMEOUT * 1000 / CLOCK_SECOND;
+    rrep_send(&rep);
+  } else if(r != NULL && (r->flags & (RT_VALID | RT_SEQ)) == (RT_VALID | RT_SEQ) &&
+            CLOCK_LT(clock_time(), r->expires) && !(m->flags & RREQ_FLAG_D) &&
+            ((m->flags & RREQ_FLAG_U) || !seq_newer(m->dest_seq, r->seq))) {
+    // Réponse d'un intermédiaire à route fraîche (section 6.6.2) / Reply by an intermediate with a fresh route (section 6.6.2)
+    rep.hop_count = r->hops;
+    rep.dest_seq = r->seq;
+    rep.lifetime_ms = (r->expires - clock_time()) * 1000 / CLOCK_SECOND;
+    rrep_send(&rep);
+  } else if(m->ttl > 1) {
+    // Relais : TTL décrémenté, meilleur numéro connu (section 6.5) / Relay: TTL decremented, best known number (section 6.5)
+    m->ttl--;
+    if(r != NULL && (r->flags & RT_SEQ) && ((m->flags & RREQ_FLAG_U) || seq_newer(r->seq, m->dest_seq))) {
+      m->dest_seq = r->seq;
+      m->flags &= ~RREQ_FLAG_U;
+    }
+    send_jittered(buf, rreq_pack(m, buf));
+    stats.rreq_sent++;
+  }
+}
+
+static void rrep_input(const linkaddr_t *from, struct aodv_rrep *m) {
+  struct discovery *d;
+
+  // Route directe vers la destination (section 6.7) / Forward route to the destination (section 6.7)
+  m->hop_count++;
+  route_update(&m->dest, from, m->hop_count, m->dest_seq, 1,
+               (clock_time_t)m->lifetime_ms * CLOCK_SECOND / 1000);
+
+  if(uip_ipaddr_cmp(&m->orig, &my_ipaddr)) {
+    d = discovery_lookup(&m->dest);
+    if(d != NULL) {
+      discovery_end(d, 1);
+    }
+    return;
+  }
+  rrep_send(m);
+}
+
+static void rerr_input(const linkaddr_t *from, const struct aodv_rerr *m) {
+  struct aodv_rerr out;
+
+  // Seules les routes par l'émetteur tombent, puis sont signalées à leur tour
+  // Only the routes through the sender fall, then are reported in turn
+  rerr_init(&out);
+  for(uint8_t i=0; i<m->count; i++) {
+    struct aodv_route *r = route_lookup(&m->unreach[i].dest);
+    if(r != NULL && (r->flags & RT_VALID) && linkaddr_cmp(&r->next_hop, from)) {
+      r->seq = m->unreach[i].seq;
+      r->flags |= RT_SEQ;
+      route_invalidate(r);
+      rerr_add(&out, r);
+    }
+  }
+  rerr_flush(&out);
+}
+
+static void aodv_rx_callback(struct simple_udp_connection *c, const uip_ipaddr_t *sender_addr,
+                             uint16_t sender_port, const uip_ipaddr_t *receiver_addr,
+                             uint16_t receiver_port, const uint8_t *data, uint16_t datalen) {
+  union {
+    struct aodv_rreq rreq;
+    struct aodv_rrep rrep;
+    struct aodv_rerr rerr;
+  } m;
+  linkaddr_t from;
+  uip_ipaddr_t prev;
+
+  if(datalen == 0) {
+    return;
+  }
+  dseran_net_lladdr_from_ipaddr(&from, sender_addr);
+  LOG_INFO("RECV %u %lu\n", dseran_energy_residual(), (unsigned long)clock_time());
+
+  // Route vers le voisin émetteur, sans numéro (section 6.2) / Route to the sending neighbor, numberless (section 6.2)
+  dseran_net_global_from_lladdr(&prev, &from);
+  route_update(&prev, &from, 1, 0, 0, AODV_ACTIVE_ROUTE_TIMEOUT);
+
+  switch(data[0]) {
+  case AODV_RREQ:
+    if(datalen == RREQ_LEN) {
+      rreq_unpack(&m.rreq, data);
+      rreq_input(&from, &m.rreq);
+    }
+    break;
+  case AODV_RREP:
+    if(datalen == RREP_LEN) {
+      rrep_unpack(&m.rrep, data);
+      rrep_input(&from, &m.rrep);
+    }
+    break;
+  case AODV_RERR:
+    if(rerr_unpack(&m.rerr, data, datalen)) {
+      rerr_input(&from, &m.rerr);
+    }
+    break;
+  default:
+    LOG_WARN("Message AODV inconnu / unknown AODV message %u\n", data[0]);
+  }
+}
+
+// Routes actives expirées puis effacées / Active routes expired then deleted
+static void purge(void) {
+  clock_time_t now = clock_time();
+
+  for(uint8_t i=0; i<AODV_MAX_ROUTES; i++) {
+    struct aodv_route *r = &routes[i];
+    if(!(r->flags & RT_USED) || CLOCK_LT(now, r->expires)) {
+      continue;
+    }
+    if(r->flags & RT_VALID) {
+      route_invalidate(r);
+    } else {
+      r->flags = 0;
+    }
+  }
+}
+
+PROCESS_THREAD(aodv_process, ev, data) {
+  static struct etimer purge_timer;
+
+  PROCESS_BEGIN();
+
+  simple_udp_register(&aodv_conn, AODV_UDP_PORT, NULL, AODV_UDP_PORT, aodv_rx_callback);
+  etimer_set(&purge_timer, PURGE_INTERVAL);
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&purge_timer));
+    purge();
+    etimer_reset(&purge_timer);
+  }
+
+  PROCESS_END();
+}
+
+// Interface du pilote de routage / Routing driver interface
+
+// Adresse globale fd00::IID et adresse bien connue du puits, fd00::1
+// Global fd00::IID address and well-known sink address, fd00::1
+static void driver_init(void) {
+  dseran_net_global_from_lladdr(&my_ipaddr, &linkaddr_node_addr);
+  uip_ds6_addr_add(&my_ipaddr, 0, ADDR_AUTOCONF);
+  uip_ip6addr(&sink_ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 1);
+  process_start(&aodv_process, NULL);
+}
+
+static int driver_root_start(void) {
+  if(!is_root) {
+    is_root = 1;
+    uip_ds6_addr_add(&sink_ipaddr, 0, ADDR_MANUAL);
+  }
+  return 0;
+}
+
+static int driver_node_is_root(void) {
+  return is_root;
+}
+
+static int driver_get_root_ipaddr(uip_ipaddr_t *ipaddr) {
+  uip_ipaddr_copy(ipaddr, &sink_ipaddr);
+  return 1;
+}
+
+// À la demande : joint dès qu'une route vers le puits existe / On demand: joined once a route to the sink exists
+static int driver_node_has_joined(void) {
+  return is_root || aodv_route_valid(&sink_ipaddr, NULL);
+}
+
+static int driver_node_is_reachable(void) {
+  return driver_node_has_joined();
+}
+
+// Retour MAC : un acquittement prolonge les routes par ce voisin, un échec les rompt
+// MAC feedback: an ack extends the routes through this neighbor, a failure breaks them
+static void driver_link_callback(const linkaddr_t *addr, int status, int numtx) {
+  if(status == MAC_TX_OK) {
+    for(uint8_t i=0; i<AODV_MAX_ROUTES; i++) {
+      if((routes[i].flags & RT_VALID) && linkaddr_cmp(&routes[i].next_hop, addr)) {
+        route_extend(&routes[i], AODV_ACTIVE_ROUTE_TIMEOUT);
+      }
+    }
+  } else if(status == MAC_TX_NOACK) {
+    link_break(addr);
+  }
+}
+
+// Route évincée par uIP : AODV la perd aussi / Route evicted by uIP: AODV loses it too
+static void driver_drop_route(uip_ds6_route_t *route) {
+  struct aodv_route *r = route_lookup(&route->ipaddr);
+
+  if(r != NULL && (r->flags & RT_VALID)) {
+    r->flags &= ~RT_VALID;
+    r->expires = clock_time() + DELETE_PERIOD;
+  }
+}
+
+const struct routing_driver aodv_routing_driver = {
+  "aodv",
+  driver_init,
+  dseran_net_root_set_prefix,
+  driver_root_start,
+  driver_node_is_root,
+  driver_get_root_ipaddr,
+  dseran_net_get_sr_node_ipaddr,
+  dseran_net_leave_network,
+  driver_node_has_joined,
+  driver_node_is_reachable,
+  dseran_net_repair,
+  dseran_net_repair,
+  dseran_net_ext_header_remove,
+  dseran_net_ext_header_update,
+  dseran_net_ext_header_hbh_update,
+  dseran_net_ext_header_srh_update,
+  dseran_net_ext_header_srh_get_next_hop,
+  driver_link_callback,
+  dseran_net_neighbor_state_changed,
+  driver_drop_route,
+  dseran_net_is_in_leaf_mode,
+};
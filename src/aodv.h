@@ -0,0 +1,123 @@
+/*
+ * aodv.h : Routage AODV à la demande (RFC 3561) pour Contiki-NG
+ * On-demand AODV routing (RFC 3561) for Contiki-NG
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Pilote de routage aodv_routing_driver : RREQ diffusés en anneau croissant
+ * avec suppression des doublons, RREP renvoyé en unicast par le chemin
+ * inverse (par la destination ou par un nœud ayant une route assez
+ * fraîche), numéros de séquence de destination, routes à durée de vie
+ * prolongée par les acquittements MAC et RERR diffusé à la rupture d'un
+ * lien. Les routes valides sont recopiées en routes hôtes uIP : uIP relaie
+ * les données, AODV ne décide que des routes. Les messages de contrôle
+ * passent en UDP (port 654) sur les adresses lien-local.
+ * Routing driver aodv_routing_driver: RREQs flooded as an expanding ring
+ * with duplicate suppression, RREP unicast back along the reverse path (by
+ * the destination or by a node holding a fresh enough route), destination
+ * sequence numbers, route lifetimes extended by MAC acks and RERR broadcast
+ * when a link breaks. Valid routes are mirrored as uIP host routes: uIP
+ * forwards the data, AODV only decides the routes. Control messages go over
+ * UDP (port 654) on link-local addresses.
+ */
+
+#ifndef AODV_H_
+#define AODV_H_
+
+#include "contiki.h"
+#include "net/ipv6/uip.h"
+
+// Routes connues, valides ou non ; pas plus que de routes uIP, pour qu'AODV
+// choisisse seul les routes évincées / Known routes, valid or not; no more than
+// uIP routes, so that AODV alone picks the evicted routes
+#ifdef AODV_CONF_MAX_ROUTES
+#define AODV_MAX_ROUTES AODV_CONF_MAX_ROUTES
+#elif defined(UIP_CONF_MAX_ROUTES)
+#define AODV_MAX_ROUTES UIP_CONF_MAX_ROUTES
+#else
+#define AODV_MAX_ROUTES 16
+#endif
+
+// Durée de vie d'une route active ; 3 s dans la RFC, allongée pour une donnée toutes les 15 s
+// Active route lifetime; 3 s in the RFC, lengthened for one data frame every 15 s
+#ifdef AODV_CONF_ACTIVE_ROUTE_TIMEOUT
+#define AODV_ACTIVE_ROUTE_TIMEOUT AODV_CONF_ACTIVE_ROUTE_TIMEOUT
+#else
+#define AODV_ACTIVE_ROUTE_TIMEOUT (CLOCK_SECOND * 30)
+#endif
+
+// Traversée d'un nœud et diamètre du réseau (RFC 3561, section 10)
+// Node traversal time and network diameter (RFC 3561, section 10)
+#ifdef AODV_CONF_NODE_TRAVERSAL_TIME
+#define AODV_NODE_TRAVERSAL_TIME AODV_CONF_NODE_TRAVERSAL_TIME
+#else
+#define AODV_NODE_TRAVERSAL_TIME (CLOCK_SECOND / 25)
+#endif
+#ifdef AODV_CONF_NET_DIAMETER
+#define AODV_NET_DIAMETER AODV_CONF_NET_DIAMETER
+#else
+#define AODV_NET_DIAMETER 35
+#endif
+
+// Anneau croissant : TTL initial, pas, seuil, puis diamètre et RREQ_RETRIES essais
+// Expanding ring: initial TTL, step, threshold, then diameter and RREQ_RETRIES attempts
+#define AODV_TTL_START     1
+#define AODV_TTL_INCREMENT 2
+#define AODV_TTL_THRESHOLD 7
+#ifdef AODV_CONF_RREQ_RETRIES
+#define AODV_RREQ_RETRIES AODV_CONF_RREQ_RETRIES
+#else
+#define AODV_RREQ_RETRIES 2
+#endif
+
+// RREQ déjà vus (origine, identifiant) / RREQs already seen (originator, identifier)
+#ifdef AODV_CONF_RREQ_CACHE
+#define AODV_RREQ_CACHE AODV_CONF_RREQ_CACHE
+#else
+#define AODV_RREQ_CACHE 16
+#endif
+
+// Découvertes simultanées / Concurrent discoveries
+#ifdef AODV_CONF_DISCOVERIES
+#define AODV_DISCOVERIES AODV_CONF_DISCOVERIES
+#else
+#define AODV_DISCOVERIES 2
+#endif
+
+// Gigue avant de relayer une diffusion, contre les tempêtes à 100+ nœuds
+// Jitter before relaying a broadcast, against storms at 100+ nodes
+#ifdef AODV_CONF_JITTER
+#define AODV_JITTER AODV_CONF_JITTER
+#else
+#define AODV_JITTER (CLOCK_SECOND / 50)
+#endif
+
+#define AODV_UDP_PORT 654
+
+// Fin d'une découverte : found vaut 0 après le dernier essai sans réponse
+// End of a discovery: found is 0 after the last unanswered attempt
+typedef void (*aodv_route_callback_t)(const uip_ipaddr_t *dest, uint8_t found);
+
+// Compteurs depuis le démarrage / Counters since boot
+struct aodv_stats {
+  uint32_t rreq_sent;       // émis ou relayés / originated or relayed
+  uint32_t rrep_sent;
+  uint32_t rerr_sent;
+  uint32_t discoveries;
+  uint32_t failures;        // découvertes sans réponse / unanswered discoveries
+  uint32_t link_breaks;
+};
+
+// Vrai si une route valide mène à dest (sauts dans *hops si non NULL)
+// True when a valid route leads to dest (hops in *hops when not NULL)
+uint8_t aodv_route_valid(const uip_ipaddr_t *dest, uint8_t *hops);
+
+// Lance une découverte de dest, sans effet si elle est déjà en cours ;
+// cb est appelé à sa fin / Starts a discovery of dest, no effect when one is
+// already running; cb is called when it ends
+void aodv_discover(const uip_ipaddr_t *dest, aodv_route_callback_t cb);
+
+const struct aodv_stats *aodv_get_stats(void);
+
+#endif /* AODV_H_ */
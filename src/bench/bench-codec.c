@@ -0,0 +1,194 @@
+/*
+ * bench-codec.c : Aller-retour encodage / décodage des hellos D-SERAN
+ * D-SERAN hello encode / decode round trip
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Chaque ligne : opération, cas essayés, écart maximal, borne, verdict.
+ *   - hello_trust  : toute confiance Q1.15 de 0 à 1.0, à un demi-pas de 1/255
+ *     près, 0 et 1.0 exacts ;
+ *   - hello_energy : toute énergie sur 16 bits, à un demi-pas près jusqu'à
+ *     255 pas, saturée au-delà (jamais repliée) ;
+ *   - hello_bytes  : un octet de confiance ou d'énergie relu puis réannoncé
+ *     ne change pas, sinon l'erreur s'accumulerait de relais en relais ;
+ *   - hello_hops   : distances 0 à 62 conservées, 63 et plus « aucune route » ;
+ *   - hello_tlv    : extensions aux bornes, extension inconnue ignorée,
+ *     version, en-tête ou extension tronqués refusés, tampon trop petit.
+ * Les trois dernières comptent les écarts, la borne est 0. Code de sortie
+ * non nul si une ligne dépasse sa borne (make regress).
+ * One line each: operation, cases tried, maximum error, bound, verdict.
+ *   - hello_trust: every Q1.15 trust from 0 to 1.0, within half a 1/255
+ *     step, 0 and 1.0 exact;
+ *   - hello_energy: every 16-bit energy, within half a step up to 255 steps,
+ *     saturated above (never wrapped);
+ *   - hello_bytes: a trust or energy byte read then re-advertised does not
+ *     change, otherwise the error would build up from relay to relay;
+ *   - hello_hops: distances 0 to 62 kept, 63 and above "no route";
+ *   - hello_tlv: extensions at their limits, unknown extension skipped,
+ *     truncated version, header or extension rejected, buffer too small.
+ * The last three count mismatches, the bound is 0. Non-zero exit code when
+ * a line exceeds its bound (make regress).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "contiki.h"
+#include "../dseran-hello.h"
+#include "../dseran-nbr.h"
+
+// Demi-pas de 1/255, plus l'arrondi du décodage / Half a 1/255 step, plus decoding rounding
+#define TRUST_TOL ((DSERAN_Q_ONE + 509) / 510 + 1)
+#define ENERGY_TOL (DSERAN_HELLO_ENERGY_STEP / 2)
+#define ENERGY_MAX (255u * DSERAN_HELLO_ENERGY_STEP)
+
+static uint8_t fail;
+
+static void row(const char *op, unsigned cases, unsigned err, unsigned bound) {
+  uint8_t bad = err > bound;
+
+  fail |= bad;
+  printf("%-16s %6u %8u %8u  %s\n", op, cases, err, bound, bad ? "RÉGRESSION / REGRESSION" : "ok");
+}
+
+static uint8_t round_trip(const struct dseran_hello *in, struct dseran_hello *out) {
+  uint8_t buf[DSERAN_HELLO_MAX_LEN];
+  uint16_t len = dseran_hello_pack(in, buf, sizeof(buf));
+
+  memset(out, 0, sizeof(*out));
+  return len > 0 && dseran_hello_parse(out, buf, len);
+}
+
+static unsigned dist(unsigned a, unsigned b) {
+  return a > b ? a - b : b - a;
+}
+
+static void trust_case(void) {
+  struct dseran_hello h = { .hops = 1 }, d;
+  unsigned err = 0;
+
+  for(uint32_t t=0; t<=DSERAN_Q_ONE; t++) {
+    h.trust = (dseran_trust_t)t;
+    if(!round_trip(&h, &d)) {
+      err = ~0u;
+      break;
+    }
+    if(dist(d.trust, h.trust) > err) {
+      err = dist(d.trust, h.trust);
+    }
+    // Bornes exactes : 1.0 reste pleinement fiable / Exact limits: 1.0 stays fully trusted
+    if((t == 0 || t == DSERAN_Q_ONE) && d.trust != h.trust) {
+      err = ~0u;
+      break;
+    }
+  }
+  row("hello_trust", DSERAN_Q_ONE + 1, err, TRUST_TOL);
+}
+
+static void energy_case(void) {
+  struct dseran_hello h = { .hops = 1 }, d;
+  unsigned err = 0;
+
+  for(uint32_t e=0; e<=0xffff; e++) {
+    h.energy = (uint16_t)e;
+    if(!round_trip(&h, &d)) {
+      err = ~0u;
+      break;
+    }
+    // Au-delà de 255 pas : saturation à 255 pas / Above 255 steps: saturated at 255 steps
+    if(e >= ENERGY_MAX + ENERGY_TOL) {
+      if(d.energy != ENERGY_MAX) {
+        err = ~0u;
+        break;
+      }
+    } else if(dist(d.energy, h.energy) > err) {
+      err = dist(d.energy, h.energy);
+    }
+  }
+  row("hello_energy", 0x10000, err, ENERGY_TOL);
+}
+
+static void bytes_case(void) {
+  unsigned bad = 0;
+
+  for(unsigned q=0; q<256; q++) {
+    uint8_t in[DSERAN_HELLO_HDR_LEN] = { DSERAN_HELLO_VERSION << 6, 0, q, q };
+    uint8_t out[DSERAN_HELLO_MAX_LEN];
+    struct dseran_hello d;
+
+    if(!dseran_hello_parse(&d, in, sizeof(in)) ||
+       dseran_hello_pack(&d, out, sizeof(out)) != DSERAN_HELLO_HDR_LEN ||
+       out[2] != q || out[3] != q) {
+      bad++;
+    }
+  }
+  row("hello_bytes", 256, bad, 0);
+}
+
+static void hops_case(void) {
+  struct dseran_hello h = { 0 }, d;
+  unsigned bad = 0;
+
+  for(unsigned hops=0; hops<256; hops++) {
+    h.hops = hops;
+    if(!round_trip(&h, &d) ||
+       d.hops != (hops < DSERAN_HELLO_HOPS_NONE ? hops : DSERAN_HOPS_INF)) {
+      bad++;
+    }
+  }
+  row("hello_hops", 256, bad, 0);
+}
+
+static void tlv_case(void) {
+  struct dseran_hello h = {
+    .seq = 255, .hops = 62, .energy = ENERGY_MAX, .trust = DSERAN_Q_ONE,
+    .ext = DSERAN_HELLO_HAS_QUEUE | DSERAN_HELLO_HAS_POS | DSERAN_HELLO_HAS_VEL,
+    .queue = 255, .pos_x = 0xffff, .pos_y = 0, .vel_x = -32768, .vel_y = 32767
+  }, d;
+  uint8_t buf[DSERAN_HELLO_MAX_LEN + 2];
+  uint16_t len;
+  unsigned bad = 0, cases = 0;
+
+  // Toutes les extensions aux bornes / Every extension at its limits
+  cases++;
+  len = dseran_hello_pack(&h, buf, DSERAN_HELLO_MAX_LEN);
+  bad += len != DSERAN_HELLO_MAX_LEN || !dseran_hello_parse(&d, buf, len) ||
+         d.seq != h.seq || d.hops != h.hops || d.ext != h.ext || d.queue != h.queue ||
+         d.pos_x != h.pos_x || d.pos_y != h.pos_y || d.vel_x != h.vel_x || d.vel_y != h.vel_y;
+
+  // Extension inconnue de 1 octet à la fin : ignorée / Unknown 1-byte extension at the end: skipped
+  cases++;
+  buf[len] = (15 << 4) | 1;
+  buf[len + 1] = 0xaa;
+  bad += !dseran_hello_parse(&d, buf, len + 2) || d.ext != h.ext;
+
+  // Dernière extension tronquée / Last extension truncated
+  for(uint16_t cut=DSERAN_HELLO_HDR_LEN + 1; cut<len; cut++) {
+    uint8_t ok = dseran_hello_parse(&d, buf, cut);
+
+    // Coupe entre deux extensions : hello valide / Cut between two extensions: valid hello
+    cases++;
+    bad += ok != (cut == DSERAN_HELLO_HDR_LEN + 2 || cut == DSERAN_HELLO_HDR_LEN + 7);
+  }
+
+  // En-tête tronqué, autre version / Truncated header, other version
+  cases += 2;
+  bad += dseran_hello_parse(&d, buf, DSERAN_HELLO_HDR_LEN - 1) != 0;
+  buf[0] ^= 0xc0;
+  bad += dseran_hello_parse(&d, buf, len) != 0;
+
+  // Tampon trop petit pour le pire cas / Buffer too small for the worst case
+  cases++;
+  bad += dseran_hello_pack(&h, buf, DSERAN_HELLO_MAX_LEN - 1) != 0;
+
+  row("hello_tlv", cases, bad, 0);
+}
+
+int main(void) {
+  trust_case();
+  energy_case();
+  bytes_case();
+  hops_case();
+  tlv_case();
+  return fail;
+}
@@ -0,0 +1,206 @@
+/*
+ * bench-core.c : Microbancs du cœur D-SERAN (hello, table, confiance, prochain saut, prédiction, chien de garde)
+ * Microbenchmarks of the D-SERAN core (hello, table, trust, next hop, prediction, watchdog)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * dseran-core.c, dseran-nbr.c et dseran-hello.c liés aux substituts de
+ * stubs/ ; un binaire par capacité (DSERAN_CONF_MAX_NEIGHBORS). Chaque
+ * opération est chronométrée BENCH_REPS fois sur un flux de hellos
+ * synthétique et le minimum est retenu, ce qui écarte les interruptions de
+ * l'hôte. Les allocations sont comptées par --wrap=malloc (elles doivent
+ * rester à 0 : la table est statique).
+ * dseran-core.c, dseran-nbr.c and dseran-hello.c linked against the stubs/
+ * stand-ins; one binary per capacity (DSERAN_CONF_MAX_NEIGHBORS). Each
+ * operation is timed BENCH_REPS times over a synthetic hello stream and the
+ * minimum is kept, which discards host interruptions. Allocations are
+ * counted through --wrap=malloc (they must stay at 0: the table is static).
+ *
+ * Chaque mesure est aussi rapportée à une boucle de calibration chronométrée
+ * juste avant (une étape LCG dépendante) : ce rapport suit le code, pas la
+ * fréquence de l'hôte, et sert à la détection de régressions.
+ * Each measurement is also divided by a calibration loop timed just before
+ * it (one dependent LCG step): this ratio follows the code, not the host
+ * frequency, and drives regression detection.
+ *
+ * Sortie / Output : opération, voisins, ns/op, ns/op / calibration, allocations, octets de RAM de la table
+ *                   operation, neighbors, ns/op, ns/op / calibration, allocations, table RAM bytes
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "lib/random.h"
+#include "../dseran-core.h"
+#include "bench-util.h"
+
+#define BENCH_OPS   200000
+#define BENCH_REPS  7
+#define BENCH_CALIB 1000000
+
+// Flux avec renouvellement : deux fois plus d'émetteurs que de places
+// Churn stream: twice as many senders as slots
+#define BENCH_SENDERS (2 * DSERAN_MAX_NEIGHBORS)
+
+static linkaddr_t addrs[BENCH_SENDERS];
+static uint8_t hellos[BENCH_SENDERS][DSERAN_HELLO_MAX_LEN];
+static uint8_t hello_len[BENCH_SENDERS];
+static uint16_t steady[BENCH_OPS];
+static uint16_t churn[BENCH_OPS];
+static struct dseran_nbr *entries[DSERAN_MAX_NEIGHBORS];
+static struct dseran_pred preds[DSERAN_MAX_NEIGHBORS];
+static volatile uint32_t sink;
+
+// Allocations du code mesuré / Allocations of the measured code
+static unsigned long allocs;
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t size);
+
+void *__wrap_malloc(size_t size) {
+  allocs++;
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  allocs++;
+  return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *p, size_t size) {
+  allocs++;
+  return __real_realloc(p, size);
+}
+
+// Étapes LCG dépendantes : pas de parallélisme d'instructions / Dependent LCG steps: no instruction-level parallelism
+static uint64_t calib_ns(void) {
+  uint32_t x = sink;
+  uint64_t t0 = now_ns();
+
+  for(uint32_t k=0; k<BENCH_CALIB; k++) {
+    x = x * 1103515245u + 12345u;
+  }
+  sink = x;
+  return now_ns() - t0;
+}
+
+// Table pleine des DSERAN_MAX_NEIGHBORS premiers émetteurs / Table filled with the first DSERAN_MAX_NEIGHBORS senders
+static void fill(void) {
+  struct dseran_hello h;
+
+  dseran_nbr_init(NULL);
+  for(uint16_t i=0; i<DSERAN_MAX_NEIGHBORS; i++) {
+    dseran_hello_parse(&h, hellos[i], hello_len[i]);
+    entries[i] = dseran_core_hello(&addrs[i], &h);
+    dseran_pred_init(&preds[i], 60000, 0);
+  }
+}
+
+// Une opération sur un flux ; l'horloge avance d'un tick tous les 64 appels
+// One operation over a stream; the clock advances one tick every 64 calls
+// predict : un échantillon par appel, donc une inférence int8 à chaque fois ;
+// observe : une preuve du chien de garde (7 relais sur 8), confiance recalculée
+// predict: one sample per call, hence one int8 inference every time; observe: one
+// watchdog evidence (7 forwards out of 8), trust recomputed
+enum { OP_HELLO, OP_CHURN, OP_ADD, OP_LOOKUP, OP_TRUST, OP_LINK, OP_NEXT_HOP, OP_PREDICT, OP_OBSERVE, OP_COUNT };
+static const char *op_names[OP_COUNT] = {
+  "process_hello", "churn_hello", "add_or_update", "lookup", "update_trust", "link_tx", "select_next_hop",
+  "predict", "observe"
+};
+
+static void run(int op) {
+  struct dseran_hello h;
+  uint32_t acc = 0;
+
+  for(uint32_t k=0; k<BENCH_OPS; k++) {
+    uint16_t i = steady[k];
+
+    if((k & 63) == 0) {
+      stub_clock_advance(1);
+    }
+    switch(op) {
+    case OP_HELLO:
+      dseran_hello_parse(&h, hellos[i], hello_len[i]);
+      acc += dseran_core_hello(&addrs[i], &h) != NULL;
+      break;
+    case OP_CHURN:
+      i = churn[k];
+      dseran_hello_parse(&h, hellos[i], hello_len[i]);
+      acc += dseran_core_hello(&addrs[i], &h) != NULL;
+      break;
+    case OP_ADD:
+      acc += dseran_nbr_add_or_update(&addrs[i], 50 + (k & 31), DSERAN_Q(0.9), 1 + (k & 3),
+                                      (uint8_t)k) != NULL;
+      break;
+    case OP_LOOKUP:
+      acc += dseran_nbr_lookup(&addrs[i]) != NULL;
+      break;
+    case OP_TRUST:
+      dseran_nbr_update_trust(entries[i], (k & 1) ? DSERAN_TRUST_HELLO_BONUS : DSERAN_TRUST_NOACK_PENALTY);
+      break;
+    case OP_LINK:
+      acc += dseran_core_link_tx(entries[i], (k & 7) != 0, 1 + (k & 1));
+      break;
+    case OP_NEXT_HOP:
+      acc += dseran_core_next_hop().u8[1];
+      break;
+    case OP_PREDICT:
+      acc += dseran_pred_sample(&preds[i], 60000 - (k >> 4) - (k & 7), (clock_time_t)(k + 1) * DSERAN_PRED_PERIOD);
+      break;
+    case OP_OBSERVE:
+      dseran_nbr_expect(entries[i]);
+      dseran_nbr_observe(entries[i], (k & 7) != 0);
+      break;
+    }
+  }
+  sink += acc;
+}
+
+int main(void) {
+  const uint16_t n = DSERAN_MAX_NEIGHBORS;
+  struct dseran_hello h;
+
+  // Hellos encodés d'avance : l'encodage n'est pas mesuré / Hellos encoded beforehand: encoding is not measured
+  random_init(2025);
+  memset(&h, 0, sizeof(h));
+  for(uint16_t i=0; i<BENCH_SENDERS; i++) {
+    make_addr(&addrs[i], i + 1);
+    h.seq = (uint8_t)random_rand();
+    h.hops = 1 + random_rand() % 6;
+    h.energy = 20 + random_rand() % 200;
+    h.trust = DSERAN_Q(0.5) + random_rand() % (DSERAN_Q_ONE / 2);
+    hello_len[i] = (uint8_t)dseran_hello_pack(&h, hellos[i], sizeof(hellos[i]));
+  }
+  for(uint32_t k=0; k<BENCH_OPS; k++) {
+    steady[k] = random_rand() % n;
+    churn[k] = random_rand() % BENCH_SENDERS;
+  }
+
+  for(int op=0; op<OP_COUNT; op++) {
+    uint64_t best = UINT64_MAX, calib = UINT64_MAX;
+    unsigned long op_allocs = 0;
+
+    for(int rep=0; rep<BENCH_REPS; rep++) {
+      uint64_t t0, t1, c;
+      unsigned long a0;
+
+      fill();
+      c = calib_ns();
+      if(c < calib) {
+        calib = c;
+      }
+      a0 = allocs;
+      t0 = now_ns();
+      run(op);
+      t1 = now_ns();
+      op_allocs += allocs - a0;
+      if(t1 - t0 < best) {
+        best = t1 - t0;
+      }
+    }
+    printf("%-16s %6u %10.2f %8.2f %8lu %8u\n", op_names[op], n, (double)best / BENCH_OPS,
+           (double)best * BENCH_CALIB / ((double)calib * BENCH_OPS), op_allocs / BENCH_REPS,
+           (unsigned)(DSERAN_NBR_RAM_PER_ENTRY * n));
+  }
+  return 0;
+}
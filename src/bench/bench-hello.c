@@ -0,0 +1,90 @@
+/*
+ * bench-hello.c : Coût du traitement d'un hello en fonction du nombre de voisins
+ * Hello processing cost against neighbor count
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Compare une table linéaire faisant le même travail par hello (nbr-linear.c :
+ * qualité du lien, prédiction, score et classement) à la table hachée de
+ * dseran-nbr.c. Chaque voisin est entendu toutes les HELLO_GAP en moyenne,
+ * si bien que la prédiction échantillonne comme sur un nœud ; les deux
+ * tables doivent finir avec le même meilleur voisin. La capacité de
+ * dseran-nbr.c est fixée à la compilation par DSERAN_CONF_MAX_NEIGHBORS ;
+ * `make bench-hello` construit un binaire par capacité.
+ * Compares a linear table doing the same work per hello (nbr-linear.c: link
+ * quality, prediction, score and ranking) with the hashed table of
+ * dseran-nbr.c. Each neighbor is heard every HELLO_GAP on average, so the
+ * prediction samples as on a node; both tables must end with the same best
+ * neighbor. The dseran-nbr.c capacity is fixed at compile time by
+ * DSERAN_CONF_MAX_NEIGHBORS; `make bench-hello` builds one binary per
+ * capacity.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench-hello.h"
+#include "../dseran-nbr.h"
+#include "bench-util.h"
+
+#define HELLOS 200000
+#define HELLO_GAP (CLOCK_SECOND * 8)
+
+static linkaddr_t addrs[DSERAN_MAX_NEIGHBORS];
+static uint16_t order[HELLOS];
+
+static uint32_t lcg_state = 123456;
+static uint16_t lcg_rand(void) {
+  lcg_state = lcg_state * 1103515245u + 12345u;
+  return (uint16_t)(lcg_state >> 16);
+}
+
+int main(void) {
+  const uint16_t n = DSERAN_MAX_NEIGHBORS;
+  const clock_time_t step = HELLO_GAP / n;
+  const struct dseran_nbr *best;
+  uint64_t t0, t1, t2;
+
+  for(uint16_t i=0; i<n; i++) {
+    make_addr(&addrs[i], i + 1);
+  }
+  for(uint32_t h=0; h<HELLOS; h++) {
+    order[h] = lcg_rand() % n;
+  }
+
+  // Table linéaire de référence ; l'horloge avance de HELLO_GAP / n par hello
+  // Reference linear table; the clock advances by HELLO_GAP / n per hello
+  linear_init();
+  t0 = now_ns();
+  for(uint32_t h=0; h<HELLOS; h++) {
+    linear_hello(&addrs[order[h]], 5000 - (h >> 6), DSERAN_Q(0.9), 1 + (h & 3), (uint8_t)h);
+    stub_clock_advance(step);
+  }
+  t1 = now_ns();
+
+  // Table hachée, mêmes hellos aux mêmes intervalles / Hashed table, same hellos at the same intervals
+  dseran_nbr_init(NULL);
+  for(uint32_t h=0; h<HELLOS; h++) {
+    struct dseran_nbr *nb = dseran_nbr_add_or_update(&addrs[order[h]], 5000 - (h >> 6),
+                                                      DSERAN_Q(0.9), 1 + (h & 3), (uint8_t)h);
+    if(nb != NULL) {
+      dseran_nbr_update_trust(nb, BENCH_HELLO_BONUS);
+    }
+    stub_clock_advance(step);
+  }
+  t2 = now_ns();
+
+  best = dseran_nbr_best();
+  if((best == NULL) != (linear_best() == NULL) ||
+     (best != NULL && !linkaddr_cmp(&best->addr, linear_best()))) {
+    fprintf(stderr, "bench-hello: meilleurs voisins différents / different best neighbors\n");
+    return 1;
+  }
+
+  const struct dseran_nbr_stats *st = dseran_nbr_get_stats();
+  printf("%-10u %12.1f %12.1f %9.2fx %14.2f %10u\n", n,
+         (double)(t1 - t0) / HELLOS, (double)(t2 - t1) / HELLOS,
+         (double)(t1 - t0) / (t2 - t1),
+         (double)st->probes / st->lookups, (unsigned)DSERAN_NBR_RAM_PER_ENTRY);
+  return 0;
+}
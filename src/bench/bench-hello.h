@@ -0,0 +1,22 @@
+/*
+ * bench-hello.h : Banc d'essai du traitement des hello
+ * Hello processing benchmark
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#ifndef BENCH_HELLO_H_
+#define BENCH_HELLO_H_
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+#include "../dseran-fixed.h"
+
+#define BENCH_HELLO_BONUS DSERAN_DQ(0.01)
+
+void linear_init(void);
+void linear_hello(const linkaddr_t *src, uint16_t energy, dseran_trust_t trust, uint8_t hops, uint8_t seq);
+const linkaddr_t *linear_best(void);
+
+#endif /* BENCH_HELLO_H_ */
@@ -0,0 +1,73 @@
+/*
+ * bench-mobility.c : Trajectoires de mobility.c au format de mobility_gen.py
+ * mobility.c trajectories in the mobility_gen.py format
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Déroule mobility.c pour MOBILITY_NODES nœuds (node_id = indice + 1)
+ * pendant MOBILITY_STEPS pas et écrit les lignes « indice temps x y » des
+ * nœuds déplacés, comme scripts/mobility_gen.py. En balayage, le plugin
+ * Mobility joue la trace de mobility_gen.py tandis que les hellos annoncent
+ * la position calculée par mobility.c : « make regress » vérifie que les
+ * deux coïncident en Random Waypoint.
+ * Runs mobility.c for MOBILITY_NODES nodes (node_id = index + 1) over
+ * MOBILITY_STEPS steps and writes the "index time x y" lines of the moved
+ * nodes, like scripts/mobility_gen.py. In sweeps, the Mobility plugin plays
+ * the mobility_gen.py trace while hellos advertise the position computed by
+ * mobility.c: "make regress" checks that both match under Random Waypoint.
+ */
+
+#include <stdio.h>
+#include "contiki.h"
+#include "sys/node-id.h"
+#include "../mobility.h"
+
+#ifndef MOBILITY_NODES
+#define MOBILITY_NODES 10
+#endif
+#ifndef MOBILITY_STEPS
+#define MOBILITY_STEPS 600
+#endif
+
+uint16_t node_id;
+
+void notify_d_seran_of_movement(void) {
+}
+
+int main(void) {
+  static float px[MOBILITY_STEPS + 1][MOBILITY_NODES];
+  static float py[MOBILITY_STEPS + 1][MOBILITY_NODES];
+  static uint8_t step_moved[MOBILITY_STEPS + 1][MOBILITY_NODES];
+  float dt = (float)DSERAN_MOBILITY_INTERVAL / CLOCK_SECOND;
+
+  // Un nœud à la fois : mobility.c n'a qu'un état / One node at a time: mobility.c holds a single state
+  for(uint16_t i=0; i<MOBILITY_NODES; i++) {
+    node_id = i + 1;
+    mobility_init();
+    mobility_get_position(&px[0][i], &py[0][i]);
+    step_moved[0][i] = 1;
+    for(uint16_t k=1; k<=MOBILITY_STEPS; k++) {
+      float vx, vy;
+
+      // Vitesse nulle : en pause, le pas ne déplace pas le nœud / Zero velocity: paused, the step does not move the node
+      mobility_get_velocity(&vx, &vy);
+      step_moved[k][i] = vx != 0 || vy != 0;
+      mobility_update();
+      mobility_get_position(&px[k][i], &py[k][i]);
+    }
+  }
+
+  // Triées par temps, comme mobility_gen.py / Sorted by time, like mobility_gen.py
+  printf("# D-SERAN %s seed=%u nodes=%u area=%g dt=%g\n",
+         DSERAN_MOBILITY_MODEL == MOBILITY_MODEL_RWP ? "rwp" : "gm", (unsigned)DSERAN_MOBILITY_SEED,
+         MOBILITY_NODES, (double)DSERAN_MOBILITY_AREA, (double)dt);
+  for(uint16_t k=0; k<=MOBILITY_STEPS; k++) {
+    for(uint16_t i=0; i<MOBILITY_NODES; i++) {
+      if(step_moved[k][i]) {
+        printf("%u %.3f %.2f %.2f\n", i, k * dt, (double)px[k][i], (double)py[k][i]);
+      }
+    }
+  }
+  return 0;
+}
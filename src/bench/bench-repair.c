@@ -0,0 +1,339 @@
+/*
+ * bench-repair.c : Durée de réparation et trames perdues par rupture du parent
+ * Repair time and lost frames per parent link break
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Simulation sur l'horloge des substituts : un nœud entend DEGREE voisins
+ * (hellos Trickle à l'intervalle maximal, 10 % de pertes), tous à un saut du
+ * puits (« flat ») ou seul le parent à un saut et les autres à deux
+ * (« layered »), et envoie une donnée en unicast à son meilleur voisin
+ * toutes les DATA_INTERVAL.
+ * Le parent se tait puis n'acquitte plus rien à un instant aléatoire. Trois
+ * politiques pilotent la même table dseran-nbr.c :
+ *   - retrait : le parent n'est retiré qu'après LINK_FAIL_MAX trames perdues
+ *     ou à son expiration (comportement précédent) ;
+ *   - secours : le parent est suspendu dès la première trame perdue ou après
+ *     HELLO_MISS_FACTOR écarts de hello, le premier secours classé prend la route ;
+ *   - sonde : secours, et une sonde part vers le parent quand il n'a rien
+ *     acquitté depuis PROBE_INTERVAL (comportement actuel).
+ * Simulation on the stub clock: a node hears DEGREE neighbors (Trickle hellos
+ * at the maximum interval, 10 % loss), all one hop from the sink ("flat") or
+ * only the parent at one hop and the others at two ("layered"), and unicasts
+ * one data frame to its best neighbor every DATA_INTERVAL. At a random time the
+ * parent goes silent and stops acking. Three policies drive the same
+ * dseran-nbr.c table:
+ *   - removal: the parent is only removed after LINK_FAIL_MAX lost frames or
+ *     when it expires (previous behavior);
+ *   - backup: the parent is suspended from the first lost frame or after
+ *     HELLO_MISS_FACTOR hello gaps, the first ranked backup takes the route;
+ *   - probe: backup, and a probe goes to the parent when it acked nothing for
+ *     PROBE_INTERVAL (current behavior).
+ *
+ * « bench-repair-bin loop » vérifie seulement la boucle à deux nœuds : une
+ * donnée reçue du parent doit faire passer la route par le secours.
+ * "bench-repair-bin loop" only checks the two-node loop: data received from
+ * the parent must move the route to the backup.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "contiki.h"
+#include "net/linkaddr.h"
+#include "../dseran-nbr.h"
+
+#define DEGREE 6
+#define TRIALS 500
+#define HELLO_IMAX (CLOCK_SECOND * 32)
+#define HELLO_IMIN (CLOCK_SECOND * 2)
+#define HELLO_LOSS 10                 // % de hellos perdus / % of hellos lost
+#define ACK_LOSS 5                    // % de trames non acquittées sur un lien sain / % unacked frames on a sound link
+#define WARMUP (CLOCK_SECOND * 200)
+#define HORIZON (CLOCK_SECOND * 400)  // après la rupture / after the break
+
+// Mêmes constantes que d-seran.c / Same constants as d-seran.c
+#define LINK_FAIL_MAX 3
+#define HELLO_MISS_FACTOR 2
+#define PROBE_INTERVAL HELLO_IMIN
+#define TRUST_HELLO_BONUS DSERAN_DQ(0.01)
+#define TRUST_NOACK_PENALTY DSERAN_DQ(-0.05)
+
+#define POLICY_REMOVAL 0
+#define POLICY_BACKUP  1
+#define POLICY_PROBE   2
+
+struct peer {
+  linkaddr_t addr;
+  uint16_t energy;
+  uint8_t hops;
+  clock_time_t next_hello;
+  clock_time_t interval_end;
+  uint8_t seq;
+  uint8_t broken;
+};
+
+static struct peer peers[DEGREE];
+
+static uint32_t lcg_state = 2025;
+static uint16_t lcg_rand(void) {
+  lcg_state = lcg_state * 1103515245u + 12345u;
+  return (uint16_t)(lcg_state >> 16);
+}
+
+// Prochain hello dans l'intervalle Trickle suivant : [I/2, I)
+// Next hello in the following Trickle interval: [I/2, I)
+static void peer_schedule(struct peer *p) {
+  p->next_hello = p->interval_end + HELLO_IMAX / 2 + lcg_rand() % (HELLO_IMAX / 2);
+  p->interval_end += HELLO_IMAX;
+}
+
+// Surveillance du parent, comme parent_hello() et parent_select() de d-seran.c
+// Parent watch, like parent_hello() and parent_select() in d-seran.c
+static linkaddr_t watched;
+static clock_time_t watch_last, watch_gap, watch_deadline;
+
+static void watch_arm(void) {
+  clock_time_t d = watch_gap * HELLO_MISS_FACTOR;
+  watch_deadline = clock_time() + (d < DSERAN_ROUTE_TIMEOUT ? d : DSERAN_ROUTE_TIMEOUT);
+}
+
+static void watch_hello(void) {
+  clock_time_t gap = clock_time() - watch_last;
+
+  watch_last = clock_time();
+  watch_gap -= watch_gap / 8;
+  if(gap > watch_gap) {
+    watch_gap = gap;
+  }
+  if(watch_gap < HELLO_IMIN) {
+    watch_gap = HELLO_IMIN;
+  }
+  watch_arm();
+}
+
+static void watch_follow(void) {
+  const struct dseran_nbr *best = dseran_nbr_best();
+
+  if(best == NULL) {
+    linkaddr_copy(&watched, &linkaddr_null);
+  } else if(!linkaddr_cmp(&best->addr, &watched)) {
+    linkaddr_copy(&watched, &best->addr);
+    watch_last = clock_time();
+    watch_gap = HELLO_IMAX;
+    watch_arm();
+  }
+}
+
+// Trame vers n non acquittée, comme driver_link_callback() / Unacked frame to n, like driver_link_callback()
+static void on_noack(struct dseran_nbr *n, uint8_t policy, uint8_t is_parent) {
+  dseran_nbr_link_tx(n, 0, 1);
+  dseran_nbr_update_trust(n, TRUST_NOACK_PENALTY);
+  if(policy != POLICY_REMOVAL && is_parent) {
+    dseran_nbr_suspend(n);
+  }
+  if(++n->tx_fail >= LINK_FAIL_MAX) {
+    dseran_nbr_remove(n);
+  }
+}
+
+// Une rupture : durée (ticks) jusqu'à une route par un autre voisin, trames perdues
+// One break: time (ticks) until a route through another neighbor, lost frames
+static void trial(uint8_t policy, clock_time_t data_interval, clock_time_t *repair, uint16_t *lost) {
+  clock_time_t t0 = clock_time();
+  clock_time_t t_break = t0 + WARMUP + lcg_rand() % (CLOCK_SECOND * 60);
+  clock_time_t next_data = t0 + lcg_rand() % data_interval;
+  clock_time_t next_probe = t0 + PROBE_INTERVAL;
+  const struct peer *parent = NULL;
+
+  dseran_nbr_init(NULL);
+  linkaddr_copy(&watched, &linkaddr_null);
+  for(uint8_t i=0; i<DEGREE; i++) {
+    peers[i].broken = 0;
+    peers[i].interval_end = t0 + lcg_rand() % HELLO_IMAX;
+    peer_schedule(&peers[i]);
+  }
+  *repair = HORIZON;
+  *lost = 0;
+
+  while(clock_time() < t_break + HORIZON) {
+    stub_clock_advance(1);
+    clock_time_t now = clock_time();
+
+    // Rupture : le parent courant se tait, dès qu'il y en a un
+    // Break: the current parent goes silent, as soon as there is one
+    if(parent == NULL && now >= t_break && dseran_nbr_best() != NULL) {
+      t_break = now;
+      for(uint8_t i=0; i<DEGREE; i++) {
+        if(linkaddr_cmp(&peers[i].addr, &dseran_nbr_best()->addr)) {
+          peers[i].broken = 1;
+          parent = &peers[i];
+        }
+      }
+    }
+
+    for(uint8_t i=0; i<DEGREE; i++) {
+      struct peer *p = &peers[i];
+      if(now < p->next_hello) {
+        continue;
+      }
+      p->seq++;
+      if(!p->broken && lcg_rand() % 100 >= HELLO_LOSS) {
+        struct dseran_nbr *n = dseran_nbr_add_or_update(&p->addr, p->energy, DSERAN_Q(0.9),
+                                                         p->hops, p->seq);
+        if(n != NULL) {
+          dseran_nbr_update_trust(n, TRUST_HELLO_BONUS);
+        }
+        if(policy != POLICY_REMOVAL && linkaddr_cmp(&p->addr, &watched)) {
+          watch_hello();
+        }
+      }
+      peer_schedule(p);
+    }
+
+    if(policy != POLICY_REMOVAL) {
+      watch_follow();
+      if(!linkaddr_cmp(&watched, &linkaddr_null) && now >= watch_deadline) {
+        struct dseran_nbr *n = dseran_nbr_lookup(&watched);
+        if(n != NULL) {
+          dseran_nbr_suspend(n);
+        }
+        watch_follow();
+      }
+    }
+
+    if(now >= next_data) {
+      const struct dseran_nbr *best = dseran_nbr_best();
+      uint8_t to_parent = best != NULL && parent != NULL && linkaddr_cmp(&best->addr, &parent->addr);
+
+      next_data += data_interval;
+      if(best == NULL || to_parent || lcg_rand() % 100 < ACK_LOSS) {
+        if(now >= t_break && *repair == HORIZON) {
+          (*lost)++;
+        }
+        if(best != NULL) {
+          on_noack(dseran_nbr_lookup(&best->addr), policy, 1);
+        }
+      } else {
+        struct dseran_nbr *n = dseran_nbr_lookup(&best->addr);
+        n->tx_fail = 0;
+        dseran_nbr_link_tx(n, 1, 1);
+        next_probe = now + PROBE_INTERVAL;
+      }
+    }
+
+    // Sonde sans donnée : aucune lecture perdue / Probe without data: no reading lost
+    if(policy == POLICY_PROBE && now >= next_probe) {
+      const struct dseran_nbr *best = dseran_nbr_best();
+
+      next_probe += PROBE_INTERVAL;
+      if(best != NULL) {
+        struct dseran_nbr *n = dseran_nbr_lookup(&best->addr);
+        if((parent != NULL && linkaddr_cmp(&best->addr, &parent->addr)) || lcg_rand() % 100 < ACK_LOSS) {
+          on_noack(n, policy, 1);
+        } else {
+          n->tx_fail = 0;
+          dseran_nbr_link_tx(n, 1, 1);
+        }
+      }
+    }
+
+    // Réparée : une route passe par un autre voisin / Repaired: a route goes through another neighbor
+    if(parent != NULL && *repair == HORIZON) {
+      const struct dseran_nbr *best = dseran_nbr_best();
+      if(best != NULL && !linkaddr_cmp(&best->addr, &parent->addr)) {
+        *repair = now - t_break;
+      }
+    }
+  }
+}
+
+// Boucle à deux nœuds : le parent, à un saut selon son dernier hello, nous
+// renvoie nos données. Comme data_rx_callback() de d-seran.c, il est suspendu ;
+// son hello suivant annonce notre distance plus un. Vrai si la route quitte le
+// parent et n'y revient pas.
+// Two-node loop: the parent, one hop away by its last hello, sends our data
+// back. As in data_rx_callback() in d-seran.c, it is suspended; its next hello
+// advertises our distance plus one. True when the route leaves the parent and
+// does not come back to it.
+static uint8_t loop_case(void) {
+  const struct peer *parent = &peers[0], *backup = &peers[1];
+  const struct dseran_nbr *best;
+  uint8_t ok;
+
+  dseran_nbr_init(NULL);
+  dseran_nbr_add_or_update(&parent->addr, 900, DSERAN_Q(0.9), 1, 1);
+  dseran_nbr_add_or_update(&backup->addr, 500, DSERAN_Q(0.9), 2, 1);
+  best = dseran_nbr_best();
+  if(best == NULL || !linkaddr_cmp(&best->addr, &parent->addr)) {
+    return 0;
+  }
+
+  dseran_nbr_suspend(dseran_nbr_lookup(&parent->addr));
+  best = dseran_nbr_best();
+  ok = best != NULL && linkaddr_cmp(&best->addr, &backup->addr);
+  printf("loop     suspend  parent -> %s\n", ok ? "backup" : "parent");
+
+  stub_clock_advance(HELLO_IMAX);
+  dseran_nbr_add_or_update(&parent->addr, 900, DSERAN_Q(0.9), 2 + 1, 2);
+  best = dseran_nbr_best();
+  ok = ok && best != NULL && linkaddr_cmp(&best->addr, &backup->addr);
+  printf("loop     hello    parent -> %s\n", ok ? "backup" : "parent");
+  return ok;
+}
+
+static int cmp_clock(const void *a, const void *b) {
+  clock_time_t x = *(const clock_time_t *)a, y = *(const clock_time_t *)b;
+  return x < y ? -1 : x > y;
+}
+
+int main(int argc, char **argv) {
+  static const uint8_t intervals_s[] = { 1, 15, 60 };
+  static const char *layouts[] = { "flat", "layered" };
+  static const char *names[] = { "removal", "backup", "probe" };
+  static clock_time_t repairs[TRIALS];
+
+  for(uint8_t i=0; i<DEGREE; i++) {
+    memset(&peers[i].addr, 0, sizeof(linkaddr_t));
+    peers[i].addr.u8[0] = i + 2;
+    peers[i].addr.u8[LINKADDR_SIZE - 1] = i + 2;
+  }
+  if(argc > 1 && strcmp(argv[1], "loop") == 0) {
+    return loop_case() ? 0 : 1;
+  }
+
+  printf("%-8s %-8s %-8s %12s %12s %12s %12s\n", "layout", "data s", "policy", "repair ms",
+         "p95 ms", "lost/break", "unrepaired");
+  for(uint8_t l=0; l<2; l++) {
+    // Parent : le plus d'énergie (flat) ou le seul à un saut (layered)
+    // Parent: the most energy (flat) or the only one at one hop (layered)
+    for(uint8_t i=0; i<DEGREE; i++) {
+      peers[i].energy = l == 0 ? 900 - 100 * i : 400 + 100 * i;
+      peers[i].hops = (l == 0 || i == 0) ? 1 : 2;
+    }
+    for(uint8_t d=0; d<sizeof(intervals_s); d++) {
+      for(uint8_t policy=POLICY_REMOVAL; policy<=POLICY_PROBE; policy++) {
+        uint32_t lost_total = 0;
+        uint16_t unrepaired = 0;
+        double sum = 0;
+
+        // Mêmes ruptures pour les trois politiques / Same breaks for all three policies
+        lcg_state = 2025 + d;
+        for(uint16_t t=0; t<TRIALS; t++) {
+          uint16_t lost;
+          trial(policy, intervals_s[d] * CLOCK_SECOND, &repairs[t], &lost);
+          lost_total += lost;
+          unrepaired += repairs[t] == HORIZON;
+          sum += repairs[t];
+        }
+        qsort(repairs, TRIALS, sizeof(repairs[0]), cmp_clock);
+        printf("%-8s %-8u %-8s %12.0f %12lu %12.2f %12u\n", layouts[l], intervals_s[d],
+               names[policy], sum * 1000 / TRIALS / CLOCK_SECOND,
+               (unsigned long)(repairs[TRIALS * 95 / 100] * 1000 / CLOCK_SECOND),
+               (double)lost_total / TRIALS, unrepaired);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * bench-score.c : Banc d'essai hôte de select_next_hop (flottant vs virgule fixe)
+ * Host benchmark of select_next_hop (float vs fixed-point)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Mesure les cycles par sélection pour plusieurs tailles de table et vérifie
+ * que les deux noyaux choisissent le même voisin.
+ * Measures cycles per selection for several table sizes and checks that
+ * both kernels pick the same neighbor.
+ *
+ * Usage: make bench   (ou / or ./bench-score [iterations])
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench-score.h"
+#include "bench-util.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#define MAX_TABLE 64
+
+static struct nbr_float table_f[MAX_TABLE];
+static struct nbr_fixed table_q[MAX_TABLE];
+static volatile int sink;
+
+// Générateur pseudo-aléatoire reproductible / Reproducible pseudo-random generator
+static uint32_t lcg_state = 123456;
+static uint16_t lcg_rand(void) {
+  lcg_state = lcg_state * 1103515245u + 12345u;
+  return (uint16_t)(lcg_state >> 16);
+}
+
+static uint64_t now_cycles(void) {
+#ifdef HAVE_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// Remplit les deux tables avec les mêmes voisins / Fill both tables with the same neighbors
+static void fill_tables(uint8_t n) {
+  for(uint8_t i=0; i<n; i++) {
+    uint16_t q = lcg_rand() % (DSERAN_Q_ONE + 1);
+    table_q[i].trust = q;
+    table_q[i].residual_energy = lcg_rand() % 101;
+    table_f[i].trust = (float)q / DSERAN_Q_ONE;
+    table_f[i].residual_energy = table_q[i].residual_energy;
+  }
+}
+
+int main(int argc, char **argv) {
+  static const uint8_t sizes[] = { 8, 16, 32, 64 };
+  unsigned long iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : 200000;
+
+  printf("%-6s %-8s %14s %14s %10s %10s\n",
+         "size", "kernel", "cycles/select", "ns/select", "speedup", "mismatch");
+
+  for(unsigned s=0; s<sizeof(sizes)/sizeof(sizes[0]); s++) {
+    uint8_t n = sizes[s];
+    unsigned mismatch = 0;
+    uint64_t c_f = 0, c_q = 0, t_f = 0, t_q = 0;
+
+    // Vérification de cohérence sur des tables aléatoires / Consistency check on random tables
+    for(unsigned r=0; r<1000; r++) {
+      fill_tables(n);
+      if(select_float(table_f, n) != select_fixed(table_q, n)) {
+        mismatch++;
+      }
+    }
+
+    fill_tables(n);
+    for(int k=0; k<2; k++) {
+      uint64_t c0 = now_cycles(), t0 = now_ns();
+      for(unsigned long it=0; it<iterations; it++) {
+        sink = select_float(table_f, n);
+      }
+      uint64_t c1 = now_cycles(), t1 = now_ns();
+      for(unsigned long it=0; it<iterations; it++) {
+        sink = select_fixed(table_q, n);
+      }
+      uint64_t c2 = now_cycles(), t2 = now_ns();
+      // Premier passage = échauffement / First pass is warm-up
+      c_f = c1 - c0; c_q = c2 - c1;
+      t_f = t1 - t0; t_q = t2 - t1;
+    }
+
+    printf("%-6u %-8s %14.1f %14.2f %10s %10s\n", n, "float",
+           (double)c_f / iterations, (double)t_f / iterations, "-", "-");
+    printf("%-6u %-8s %14.1f %14.2f %9.2fx %6u/1000\n", n, "q1.15",
+           (double)c_q / iterations, (double)t_q / iterations,
+           t_q ? (double)t_f / t_q : 0.0, mismatch);
+  }
+
+  printf("\nLes écarts proviennent de l'arrondi Q1.15 sur des scores quasi égaux.\n");
+  printf("Mismatches come from Q1.15 rounding on near-equal scores.\n");
+  printf("Sur un hôte avec FPU les deux noyaux sont proches ; sur MSP430 le flottant est émulé.\n");
+  printf("On a host with an FPU both kernels are close; on MSP430 float is emulated.\n");
+  return 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * bench-score.h : Noyaux de sélection flottant et virgule fixe pour le banc d'essai
+ * Float and fixed-point selection kernels for the benchmark
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Reproduit la boucle de select_next_hop() de d-seran.c dans ses deux variantes
+ * Reproduces the select_next_hop() loop of d-seran.c in both variants
+ */
+
+#ifndef BENCH_SCORE_H_
+#define BENCH_SCORE_H_
+
+#include <stdint.h>
+#include "../dseran-fixed.h"
+
+#define BENCH_ENERGY_THRESHOLD 10
+
+// Voisin flottant (ancienne version) / Float neighbor (previous version)
+struct nbr_float {
+  float trust;
+  uint16_t residual_energy;
+};
+
+// Voisin virgule fixe (version actuelle) / Fixed-point neighbor (current version)
+struct nbr_fixed {
+  dseran_trust_t trust;
+  uint16_t residual_energy;
+};
+
+int select_float(const struct nbr_float *t, uint8_t n);
+int select_fixed(const struct nbr_fixed *t, uint8_t n);
+
+#endif /* BENCH_SCORE_H_ */
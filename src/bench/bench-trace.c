@@ -0,0 +1,137 @@
+/*
+ * bench-trace.c : Coût CPU et volume de log par heure simulée, texte vs binaire
+ * CPU cost and log volume per simulated hour, text vs binary
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Rejoue une heure de trafic d'un nœud (hellos, réceptions, énergie, données,
+ * changements de saut) à travers les anciens LOG_INFO/printf (formatés par
+ * snprintf, préfixe Contiki compris) puis à travers dseran-trace.c dont la
+ * sortie caractère est comptée. Le temps UART suppose 115200 bauds (Cooja, sky).
+ * Replays one hour of a node's traffic (hellos, receptions, energy, data,
+ * next hop changes) through the previous LOG_INFO/printf records (formatted
+ * by snprintf, Contiki prefix included) then through dseran-trace.c whose
+ * character output is counted. UART time assumes 115200 baud (Cooja, sky).
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include "contiki.h"
+#include "../dseran-trace.h"
+#include "bench-util.h"
+
+#define SIM_SECONDS 3600
+#define DEGREE 6          // voisins entendus / neighbors heard
+#define REPEAT 200
+#define UART_US_PER_BYTE (10.0 * 1000000.0 / 115200.0)
+
+static char line[160];
+static unsigned long text_bytes;
+static unsigned long bin_bytes;
+
+int bench_putchar(int c) {
+  bin_bytes++;
+  return c;
+}
+
+// Équivalent de LOG_INFO / printf de la version texte / Text version LOG_INFO / printf equivalent
+static void text_log(int prefix, const char *fmt, ...) {
+  va_list ap;
+  int n = 0;
+
+  if(prefix) {
+    n = snprintf(line, sizeof(line), "[INFO: D-SERAN   ] ");
+  }
+  va_start(ap, fmt);
+  n += vsnprintf(line + n, sizeof(line) - n, fmt, ap);
+  va_end(ap);
+  text_bytes += n;
+}
+
+static void text_second(unsigned long s, unsigned long t) {
+  if(s % 10 == 0) {
+    text_log(1, "SEND_UDP %u %lu\n", 95, t);
+    if(s % 100 == 0) {
+      text_log(0, "D-SERAN: Hello envoyé, énergie résiduelle: %u mJ\n", 95);
+    }
+  }
+  if(s % 10 < DEGREE) {
+    // Hello reçu : trace de mise à jour du voisin à chaque fois / Received hello: neighbor update trace every time
+    text_log(0, "D-SERAN: Voisin %02x:%02x mis à jour, énergie: %u, confiance: %u%%\n",
+             (unsigned)(s % 10), (unsigned)(s % 10), 80, 90);
+    text_log(1, "RECV %u %lu\n", 80, t);
+    if(s % 200 == 1) {
+      text_log(0, "D-SERAN: Hello reçu de %02x:%02x, énergie: %u, confiance: %u%%\n",
+               (unsigned)(s % 10), (unsigned)(s % 10), 80, 90);
+    }
+  }
+  if(s % 5 == 0) {
+    text_log(1, "ENERGY %u %u\n", 95, (unsigned)(s / 5 * 2));
+  }
+  if(s % 15 == 7) {
+    text_log(1, "DATA_TX %u %u %lu\n", 3, (unsigned)(s / 15), t);
+  }
+  if(s % 300 == 150) {
+    text_log(1, "HOP %u %lu\n", 2, t);
+  }
+}
+
+static void binary_second(unsigned long s) {
+  if(s % 10 == 0) {
+    DSERAN_TRACE1(DSERAN_EV_SEND_UDP, 95);
+  }
+  if(s % 10 < DEGREE) {
+    DSERAN_TRACE1(DSERAN_EV_RECV, 80);
+  }
+  if(s % 5 == 0) {
+    DSERAN_TRACE2(DSERAN_EV_ENERGY, 95, s / 5 * 2);
+  }
+  if(s % 15 == 7) {
+    DSERAN_TRACE2(DSERAN_EV_DATA_TX, 3, s / 15);
+  }
+  if(s % 300 == 150) {
+    DSERAN_TRACE1(DSERAN_EV_HOP, 2);
+  }
+}
+
+int main(void) {
+  uint64_t t0, t1, t2;
+  unsigned long text_hour = 0, bin_hour = 0;
+
+  t0 = now_ns();
+  for(int r=0; r<REPEAT; r++) {
+    text_bytes = 0;
+    for(unsigned long s=0; s<SIM_SECONDS; s++) {
+      text_second(s, s * CLOCK_SECOND);
+    }
+    text_hour = text_bytes;
+  }
+  t1 = now_ns();
+
+  dseran_trace_init();
+  for(int r=0; r<REPEAT; r++) {
+    bin_bytes = 0;
+    for(unsigned long s=0; s<SIM_SECONDS; s++) {
+      binary_second(s);
+      stub_clock_advance(CLOCK_SECOND);
+    }
+    dseran_trace_flush();
+    bin_hour = bin_bytes;
+  }
+  t2 = now_ns();
+
+  double text_us = (double)(t1 - t0) / REPEAT / 1000.0;
+  double bin_us = (double)(t2 - t1) / REPEAT / 1000.0;
+
+  printf("Heure simulée, 1 nœud, %u voisins / Simulated hour, 1 node, %u neighbors\n",
+         DEGREE, DEGREE);
+  printf("%-8s %14s %16s %18s\n", "format", "bytes/hour", "host CPU us/hour", "UART s/hour");
+  printf("%-8s %14lu %16.1f %18.2f\n", "text", text_hour, text_us,
+         text_hour * UART_US_PER_BYTE / 1e6);
+  printf("%-8s %14lu %16.1f %18.2f\n", "binary", bin_hour, bin_us,
+         bin_hour * UART_US_PER_BYTE / 1e6);
+  printf("Réduction / Reduction: %.1fx octets / bytes, %.1fx CPU hôte / host CPU\n",
+         (double)text_hour / bin_hour, text_us / bin_us);
+  return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * nbr-linear.c : Table des voisins linéaire faisant le même travail que dseran-nbr.c (référence)
+ * Linear neighbor table doing the same work as dseran-nbr.c (reference)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Un hello fait ici ce que font dseran_nbr_add_or_update() puis
+ * dseran_nbr_update_trust() : mêmes champs, même estimation de la qualité du
+ * lien (dseran-lqe.h), même échantillon de prédiction (dseran-pred.h), même
+ * score et même classement incrémental du meilleur et de ses secours. Seule
+ * la recherche diffère : un parcours de la table au lieu de l'index haché,
+ * et l'expiration se lit dans last_seen au lieu d'une roue.
+ * A hello does here what dseran_nbr_add_or_update() then
+ * dseran_nbr_update_trust() do: same fields, same link quality estimate
+ * (dseran-lqe.h), same prediction sample (dseran-pred.h), same score and same
+ * incremental ranking of the best neighbor and its backups. Only the lookup
+ * differs: a scan of the table instead of the hashed index, and expiry is
+ * read from last_seen instead of a wheel.
+ */
+
+#include "bench-hello.h"
+#include "../dseran-nbr.h"
+
+#define LINEAR_MAX 256
+
+struct linear_nbr {
+  linkaddr_t addr;
+  dseran_trust_t trust;
+  uint16_t residual_energy;
+  clock_time_t last_seen;
+  uint8_t hops;
+  uint8_t suspended;
+  struct dseran_lqe lqe;
+#if DSERAN_PREDICT
+  struct dseran_pred pred;
+#endif
+};
+
+static struct linear_nbr table[LINEAR_MAX];
+static uint16_t count;
+
+static uint16_t rank[DSERAN_NBR_RANKED];
+static dseran_score_t rank_score[DSERAN_NBR_RANKED];
+static uint8_t rank_len;
+static uint8_t rank_stale;
+
+void linear_init(void) {
+  count = 0;
+  rank_len = 0;
+  rank_stale = 0;
+}
+
+// compose_score() de dseran-nbr.c / compose_score() of dseran-nbr.c
+static dseran_score_t linear_score(uint16_t i) {
+  const struct linear_nbr *n = &table[i];
+  dseran_score_t te;
+
+  if(n->suspended || n->trust <= DSERAN_TRUST_THRESHOLD || n->residual_energy <= DSERAN_ENERGY_THRESHOLD) {
+    return 0;
+  }
+#if DSERAN_PREDICT
+  if(n->pred.ttd <= DSERAN_PRED_CRITICAL) {
+    return 0;
+  }
+#endif
+  te = dseran_score(n->trust, n->residual_energy) >> 7;
+#if DSERAN_ETX_WEIGHT >= 1
+  te = te * DSERAN_ETX_DIVISOR / n->lqe.etx;
+#endif
+#if DSERAN_ETX_WEIGHT >= 2
+  te = te * DSERAN_ETX_DIVISOR / n->lqe.etx;
+#endif
+#if DSERAN_PREDICT
+  if(n->pred.ttd < DSERAN_PRED_HORIZON) {
+    te = te * n->pred.ttd / DSERAN_PRED_HORIZON;
+  }
+#endif
+  return ((dseran_score_t)(DSERAN_HOPS_INF - n->hops) << 24) | te;
+}
+
+static void rank_insert(uint8_t pos, uint16_t i, dseran_score_t score) {
+  uint8_t r = rank_len < DSERAN_NBR_RANKED ? rank_len++ : DSERAN_NBR_RANKED - 1;
+
+  for(; r > pos; r--) {
+    rank[r] = rank[r - 1];
+    rank_score[r] = rank_score[r - 1];
+  }
+  rank[pos] = i;
+  rank_score[pos] = score;
+}
+
+static uint8_t rank_position(dseran_score_t score) {
+  uint8_t pos = rank_len;
+
+  while(pos > 0 && score > rank_score[pos - 1]) {
+    pos--;
+  }
+  return pos;
+}
+
+static void rank_rescan(void) {
+  rank_len = 0;
+  rank_stale = 0;
+  for(uint16_t i=0; i<count; i++) {
+    dseran_score_t score = linear_score(i);
+    uint8_t pos = rank_position(score);
+    if(score > 0 && pos < DSERAN_NBR_RANKED) {
+      rank_insert(pos, i, score);
+    }
+  }
+}
+
+// nh_index_update() de dseran-nbr.c / nh_index_update() of dseran-nbr.c
+static void rank_update(uint16_t i) {
+  dseran_score_t score = linear_score(i);
+  uint8_t pos;
+
+  for(pos=0; pos<rank_len; pos++) {
+    if(rank[pos] == i) {
+      if(score > 0 && (pos == 0 || score <= rank_score[pos - 1]) &&
+         (pos + 1 < rank_len ? score >= rank_score[pos + 1] :
+          score >= rank_score[pos] || (!rank_stale && rank_len < DSERAN_NBR_RANKED))) {
+        rank_score[pos] = score;
+        return;
+      }
+      if(rank_len == DSERAN_NBR_RANKED) {
+        rank_stale = 1;
+      }
+      rank_len--;
+      for(; pos<rank_len; pos++) {
+        rank[pos] = rank[pos + 1];
+        rank_score[pos] = rank_score[pos + 1];
+      }
+      break;
+    }
+  }
+  if(score > 0) {
+    pos = rank_position(score);
+    if(pos < rank_len) {
+      rank_insert(pos, i, score);
+      if(rank_len == DSERAN_NBR_RANKED) {
+        rank_stale = 0;
+      }
+    } else if(!rank_stale && rank_len < DSERAN_NBR_RANKED) {
+      rank_insert(pos, i, score);
+    }
+  }
+  if(rank_stale && rank_len == 0) {
+    rank_rescan();
+  }
+}
+
+static uint16_t linear_find(const linkaddr_t *addr) {
+  uint16_t i;
+
+  for(i=0; i<count; i++) {
+    if(linkaddr_cmp(&table[i].addr, addr)) {
+      break;
+    }
+  }
+  return i;
+}
+
+void linear_hello(const linkaddr_t *src, uint16_t energy, dseran_trust_t trust, uint8_t hops, uint8_t seq) {
+  uint16_t i = linear_find(src);
+  struct linear_nbr *n = &table[i];
+
+  if(i < count) {
+    n->residual_energy = energy;
+#if !DSERAN_WATCHDOG
+    n->trust = trust;
+#endif
+    n->hops = hops;
+    n->suspended = 0;
+    dseran_lqe_hello(&n->lqe, seq);
+#if DSERAN_PREDICT
+    dseran_pred_sample(&n->pred, energy, clock_time());
+#endif
+  } else if(count < LINEAR_MAX) {
+    count++;
+    linkaddr_copy(&n->addr, src);
+    n->residual_energy = energy;
+#if DSERAN_WATCHDOG
+    n->trust = DSERAN_WD_INIT_TRUST;
+#else
+    n->trust = trust;
+#endif
+    n->hops = hops;
+    n->suspended = 0;
+    dseran_lqe_init(&n->lqe, seq);
+#if DSERAN_PREDICT
+    dseran_pred_init(&n->pred, energy, clock_time());
+#endif
+  } else {
+    return;
+  }
+  n->last_seen = clock_time();
+  rank_update(i);
+
+  // dseran_nbr_update_trust()
+  n->trust = dseran_trust_add_sat(n->trust, BENCH_HELLO_BONUS);
+  rank_update(i);
+}
+
+const linkaddr_t *linear_best(void) {
+  return rank_len > 0 ? &table[rank[0]].addr : NULL;
+}
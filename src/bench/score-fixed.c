@@ -0,0 +1,36 @@
+/*
+ * score-fixed.c : Sélection du prochain saut en virgule fixe Q1.15
+ * Q1.15 fixed-point next hop selection
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#include "bench-score.h"
+
+#define TRUST_THRESHOLD_Q DSERAN_Q(0.5)
+
+int select_fixed(const struct nbr_fixed *t, uint8_t n) {
+  dseran_score_t best_score = 0;
+  int best_idx = -1;
+
+  for(uint8_t i=0; i<n; i++) {
+    dseran_score_t score = dseran_score(t[i].trust, t[i].residual_energy);
+    if(score > best_score && t[i].trust > TRUST_THRESHOLD_Q &&
+       t[i].residual_energy > BENCH_ENERGY_THRESHOLD) {
+      best_score = score;
+      best_idx = i;
+    }
+  }
+  return best_idx;
+}
+
+#ifdef ROM_MAIN
+// Programme minimal pour la mesure ROM / Minimal program for ROM measurement
+volatile struct nbr_fixed rom_table[16];
+volatile int rom_sink;
+int main(void) {
+  rom_sink = select_fixed((const struct nbr_fixed *)rom_table, 16);
+  return 0;
+}
+#endif
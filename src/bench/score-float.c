@@ -0,0 +1,36 @@
+/*
+ * score-float.c : Sélection du prochain saut en flottant (référence)
+ * Floating-point next hop selection (reference)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#include "bench-score.h"
+
+#define TRUST_THRESHOLD_F 0.5
+
+int select_float(const struct nbr_float *t, uint8_t n) {
+  float best_score = -1.0;
+  int best_idx = -1;
+
+  for(uint8_t i=0; i<n; i++) {
+    float score = t[i].trust * (float)t[i].residual_energy;
+    if(score > best_score && t[i].trust > TRUST_THRESHOLD_F &&
+       t[i].residual_energy > BENCH_ENERGY_THRESHOLD) {
+      best_score = score;
+      best_idx = i;
+    }
+  }
+  return best_idx;
+}
+
+#ifdef ROM_MAIN
+// Programme minimal pour la mesure ROM / Minimal program for ROM measurement
+volatile struct nbr_float rom_table[16];
+volatile int rom_sink;
+int main(void) {
+  rom_sink = select_float((const struct nbr_float *)rom_table, 16);
+  return 0;
+}
+#endif
@@ -0,0 +1,74 @@
+/*
+ * score-mote.c : Cycles de select_next_hop sur la cible (flottant vs virgule fixe)
+ * select_next_hop cycles on the target (float vs fixed-point)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Application Contiki-NG sans réseau : chronomètre ROUNDS sélections par noyau
+ * avec rtimer et affiche les cycles CPU par sélection. Sur un mote sky de
+ * Cooja, MSPSim compte les cycles exactement.
+ * Network-less Contiki-NG application: times ROUNDS selections per kernel with
+ * rtimer and prints CPU cycles per selection. On a Cooja sky mote, MSPSim
+ * counts cycles exactly.
+ *
+ * Usage: make -f Makefile.mote TARGET=sky
+ */
+
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include <stdio.h>
+#include "bench-score.h"
+
+#define NBRS 16
+#define ROUNDS 32
+
+// Fréquence du processeur si la plate-forme ne la donne pas (DCO du sky)
+// CPU frequency when the platform does not provide it (sky DCO)
+#ifndef F_CPU
+#define F_CPU 3900000UL
+#endif
+
+static struct nbr_float table_f[NBRS];
+static struct nbr_fixed table_q[NBRS];
+static volatile int sink;
+
+// Cycles par sélection d'après la durée rtimer de ROUNDS sélections
+// Cycles per selection from the rtimer duration of ROUNDS selections
+static unsigned long cycles_of(rtimer_clock_t ticks) {
+  return (unsigned long)((uint64_t)ticks * F_CPU / RTIMER_SECOND / ROUNDS);
+}
+
+PROCESS(score_mote_process, "Score cycles");
+AUTOSTART_PROCESSES(&score_mote_process);
+
+PROCESS_THREAD(score_mote_process, ev, data)
+{
+  static rtimer_clock_t t0, t1, t2;
+  static uint8_t r;
+
+  PROCESS_BEGIN();
+
+  // Mêmes voisins pour les deux noyaux / Same neighbors for both kernels
+  for(r=0; r<NBRS; r++) {
+    table_q[r].trust = DSERAN_Q_ONE / NBRS * (r + 1);
+    table_q[r].residual_energy = 1000 - 37 * r;
+    table_f[r].trust = (float)table_q[r].trust / DSERAN_Q_ONE;
+    table_f[r].residual_energy = table_q[r].residual_energy;
+  }
+
+  t0 = RTIMER_NOW();
+  for(r=0; r<ROUNDS; r++) {
+    sink = select_float(table_f, NBRS);
+  }
+  t1 = RTIMER_NOW();
+  for(r=0; r<ROUNDS; r++) {
+    sink = select_fixed(table_q, NBRS);
+  }
+  t2 = RTIMER_NOW();
+
+  printf("SCORE %u voisins / neighbors : float %lu fixed %lu cycles/selection\n",
+         NBRS, cycles_of((rtimer_clock_t)(t1 - t0)), cycles_of((rtimer_clock_t)(t2 - t1)));
+
+  PROCESS_END();
+}
@@ -0,0 +1,23 @@
+/*
+ * bench-util.c : Outils communs aux bancs d'essai hôtes
+ * Helpers shared by the host benchmarks
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#include <time.h>
+#include "bench-util.h"
+
+uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void make_addr(linkaddr_t *a, uint16_t id) {
+  for(uint8_t i=0; i<LINKADDR_SIZE; i += 2) {
+    a->u8[i] = id >> 8;
+    a->u8[i + 1] = id & 0xff;
+  }
+}
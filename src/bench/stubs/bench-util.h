@@ -0,0 +1,21 @@
+/*
+ * bench-util.h : Outils communs aux bancs d'essai hôtes
+ * Helpers shared by the host benchmarks
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#ifndef BENCH_UTIL_H_
+#define BENCH_UTIL_H_
+
+#include <stdint.h>
+#include "net/linkaddr.h"
+
+// Horloge monotone en ns / Monotonic clock in ns
+uint64_t now_ns(void);
+
+// Même forme d'adresse que Cooja (identifiant répété) / Cooja-like address (repeated id)
+void make_addr(linkaddr_t *a, uint16_t id);
+
+#endif /* BENCH_UTIL_H_ */
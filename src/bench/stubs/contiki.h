@@ -0,0 +1,62 @@
+/*
+ * contiki.h : Substitut minimal de Contiki-NG pour les bancs d'essai hôtes
+ * Minimal Contiki-NG stand-in for host benchmarks
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Fournit l'horloge, les ctimers, les etimers et les processus nécessaires
+ * aux modules D-SERAN compilés sur l'hôte ; l'horloge est pilotée par le
+ * banc d'essai.
+ * Provides the clock, ctimers, etimers and processes needed by D-SERAN
+ * modules built on the host; the clock is driven by the benchmark.
+ */
+
+#ifndef CONTIKI_H_
+#define CONTIKI_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef unsigned long clock_time_t;
+#define CLOCK_SECOND 128UL
+
+struct process {
+  const char *name;
+};
+
+struct ctimer {
+  clock_time_t expiry;
+  clock_time_t interval;
+  void (*f)(void *);
+  void *ptr;
+};
+
+clock_time_t clock_time(void);
+void process_poll(struct process *p);
+void ctimer_set(struct ctimer *c, clock_time_t t, void (*f)(void *), void *ptr);
+void ctimer_reset(struct ctimer *c);
+void ctimer_stop(struct ctimer *c);
+
+// Processus et etimers : déclarés pour compiler les modules, jamais ordonnancés sur l'hôte
+// Processes and etimers: declared so that modules build, never scheduled on the host
+#define PROCESS(name, strname)         struct process name = { strname }
+#define PROCESS_NAME(name)             extern struct process name
+#define PROCESS_THREAD(name, ev, data) int process_thread_##name(int ev, void *data)
+#define PROCESS_BEGIN()
+#define PROCESS_END()                  return 0
+#define PROCESS_WAIT_EVENT_UNTIL(c)
+
+struct etimer {
+  clock_time_t expiry;
+};
+
+void etimer_set(struct etimer *e, clock_time_t t);
+void etimer_reset(struct etimer *e);
+int etimer_expired(struct etimer *e);
+
+// Contrôle de l'horloge simulée / Simulated clock control
+void stub_clock_advance(clock_time_t ticks);
+
+#endif /* CONTIKI_H_ */
@@ -0,0 +1,17 @@
+/*
+ * random.h : Générateur pseudo-aléatoire pour les bancs d'essai hôtes
+ * Pseudo-random generator for host benchmarks
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#define RANDOM_RAND_MAX 65535U
+
+void random_init(unsigned short seed);
+unsigned short random_rand(void);
+
+#endif /* RANDOM_H_ */
@@ -0,0 +1,29 @@
+/*
+ * linkaddr.h : Adresses lien pour les bancs d'essai hôtes
+ * Link addresses for host benchmarks
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#ifndef LINKADDR_H_
+#define LINKADDR_H_
+
+#include <stdint.h>
+
+#ifndef LINKADDR_SIZE
+#define LINKADDR_SIZE 8
+#endif
+
+typedef union {
+  unsigned char u8[LINKADDR_SIZE];
+  uint16_t u16;
+} linkaddr_t;
+
+extern linkaddr_t linkaddr_node_addr;
+extern const linkaddr_t linkaddr_null;
+
+int linkaddr_cmp(const linkaddr_t *addr1, const linkaddr_t *addr2);
+void linkaddr_copy(linkaddr_t *dest, const linkaddr_t *src);
+
+#endif /* LINKADDR_H_ */
@@ -0,0 +1,92 @@
+/*
+ * stubs.c : Implémentation des substituts Contiki-NG pour l'hôte
+ * Host implementation of the Contiki-NG stand-ins
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Un seul ctimer est suivi (la roue d'expiration) ; stub_clock_advance()
+ * déclenche ses échéances dans l'ordre.
+ * A single ctimer is tracked (the expiry wheel); stub_clock_advance()
+ * fires its deadlines in order.
+ */
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+#include "lib/random.h"
+
+linkaddr_t linkaddr_node_addr;
+const linkaddr_t linkaddr_null;
+
+static clock_time_t now;
+static struct ctimer *armed;
+static uint32_t rand_state = 1;
+
+int linkaddr_cmp(const linkaddr_t *addr1, const linkaddr_t *addr2) {
+  return memcmp(addr1, addr2, LINKADDR_SIZE) == 0;
+}
+
+void linkaddr_copy(linkaddr_t *dest, const linkaddr_t *src) {
+  memcpy(dest, src, LINKADDR_SIZE);
+}
+
+clock_time_t clock_time(void) {
+  return now;
+}
+
+void process_poll(struct process *p) {
+  (void)p;
+}
+
+void ctimer_set(struct ctimer *c, clock_time_t t, void (*f)(void *), void *ptr) {
+  c->interval = t;
+  c->expiry = now + t;
+  c->f = f;
+  c->ptr = ptr;
+  armed = c;
+}
+
+void ctimer_reset(struct ctimer *c) {
+  c->expiry += c->interval;
+  armed = c;
+}
+
+void ctimer_stop(struct ctimer *c) {
+  if(armed == c) {
+    armed = NULL;
+  }
+}
+
+void etimer_set(struct etimer *e, clock_time_t t) {
+  e->expiry = now + t;
+}
+
+void etimer_reset(struct etimer *e) {
+}
+
+int etimer_expired(struct etimer *e) {
+  return e->expiry <= now;
+}
+
+void stub_clock_advance(clock_time_t ticks) {
+  clock_time_t target = now + ticks;
+
+  while(armed != NULL && armed->expiry <= target) {
+    struct ctimer *c = armed;
+    now = c->expiry;
+    armed = NULL;
+    c->f(c->ptr);
+  }
+  now = target;
+}
+
+// Même générateur congruentiel que random_rand() de Contiki-NG
+// Same linear congruential generator as Contiki-NG random_rand()
+void random_init(unsigned short seed) {
+  rand_state = seed;
+}
+
+unsigned short random_rand(void) {
+  rand_state = rand_state * 1103515245 + 12345;
+  return (unsigned short)((rand_state / 65536) % (RANDOM_RAND_MAX + 1));
+}
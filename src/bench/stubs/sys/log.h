@@ -0,0 +1,24 @@
+/*
+ * log.h : Journalisation désactivée pour les bancs d'essai hôtes
+ * Logging disabled for host benchmarks
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#ifndef LOG_H_
+#define LOG_H_
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERR  1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DBG  4
+
+#define LOG_ERR(...)
+#define LOG_WARN(...)
+#define LOG_INFO(...)
+#define LOG_DBG(...)
+#define LOG_INFO_(...)
+
+#endif /* LOG_H_ */
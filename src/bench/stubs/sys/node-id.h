@@ -0,0 +1,17 @@
+/*
+ * node-id.h : Identifiant du nœud pour les bancs d'essai hôtes
+ * Node identifier for host benchmarks
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#ifndef NODE_ID_H_
+#define NODE_ID_H_
+
+#include <stdint.h>
+
+// Défini par le banc d'essai / Defined by the benchmark
+extern uint16_t node_id;
+
+#endif /* NODE_ID_H_ */
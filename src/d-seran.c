@@ -15,250 +15,806 @@
 #include "sys/log.h"
 #include "project-conf.h"
 #include "lib/random.h"
+#include "lib/trickle-timer.h"
 #include "net/linkaddr.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "net/mac/mac.h"
+#include "net/queuebuf.h"
+#include "net/packetbuf.h"
+#include "sys/node-id.h"
+#include "dseran-fixed.h"
+#include "dseran-nbr.h"
+#include "dseran-core.h"
+#include "dseran-trace.h"
+#include "dseran-hello.h"
+#include "dseran-energy.h"
+#include "dseran-net.h"
+#include "dseran-watchdog.h"
+#include "dseran-agg.h"
+#include "dseran-tsch.h"
+#include "mobility.h"
 #include <stdio.h>
-#include <stdlib.h>
 #include <math.h>
+#include <stdlib.h>
 
 #define LOG_MODULE "D-SERAN"
-#define LOG_LEVEL LOG_LEVEL_INFO
+#define LOG_LEVEL DSERAN_LOG_LEVEL
 
 // Configuration des seuils et paramètres / Thresholds and parameters configuration
-#define MAX_NEIGHBORS 16
-#define ENERGY_THRESHOLD 10    // mJ, seuil pour l'alerte faible énergie / energy alert threshold
-#define TRUST_THRESHOLD 0.5    // seuil de confiance / trust threshold
-#define INIT_TRUST 0.7
-#define INIT_ENERGY 100
-#define HARVEST_STEP 2
-#define MAX_ENERGY 100
-#define HELLO_INTERVAL (CLOCK_SECOND * 10)
-#define ROUTE_TIMEOUT (CLOCK_SECOND * 30)
+#define ENERGY_THRESHOLD DSERAN_ENERGY_THRESHOLD  // mJ, seuil pour l'alerte faible énergie / energy alert threshold
+#define ENERGY_INTERVAL (CLOCK_SECOND * 5)   // intégration energest / energest integration
+#define ENERGY_DETAIL_EVERY 12               // détail par poste toutes les minutes / per-state detail every minute
+
+// Hellos Trickle (RFC 6206) : Imin, doublements, constante de redondance k
+// Trickle hellos (RFC 6206): Imin, doublings, redundancy constant k
+#ifdef DSERAN_CONF_HELLO_IMIN
+#define HELLO_IMIN DSERAN_CONF_HELLO_IMIN
+#else
+#define HELLO_IMIN (CLOCK_SECOND * 2)
+#endif
+#ifdef DSERAN_CONF_HELLO_IDOUBLINGS
+#define HELLO_IDOUBLINGS DSERAN_CONF_HELLO_IDOUBLINGS
+#else
+#define HELLO_IDOUBLINGS 4
+#endif
+#ifdef DSERAN_CONF_HELLO_K
+#define HELLO_K DSERAN_CONF_HELLO_K
+#else
+#define HELLO_K 3
+#endif
+// Au plus un hello supprimé d'affilée : les voisins doivent nous entendre avant l'expiration
+// At most one hello suppressed in a row: neighbors must hear us before expiry
+#define HELLO_MAX_SUPPRESS 1
+
+// Causes de réinitialisation Trickle / Trickle reset causes
+#define TRICKLE_RESET_CHURN 1   // voisin ajouté ou perdu / neighbor added or lost
+#define TRICKLE_RESET_HOPS  2   // distance au puits modifiée / distance to the sink changed
+#define TRICKLE_RESET_MOVE  3   // mouvement du nœud / node movement
+
+// Puits de collecte (surchargeable dans project-conf.h) / Collection sink (overridable in project-conf.h)
+#ifdef DSERAN_CONF_SINK_ID
+#define DSERAN_SINK_ID DSERAN_CONF_SINK_ID
+#else
+#define DSERAN_SINK_ID 1
+#endif
+
+// Trafic de données / Data traffic
+#ifdef DSERAN_CONF_DATA_INTERVAL
+#define DATA_INTERVAL DSERAN_CONF_DATA_INTERVAL
+#else
+#define DATA_INTERVAL (CLOCK_SECOND * 15)
+#endif
+
+// Bascule sur un secours : le parent est suspecté dès la première trame perdue ou
+// après HELLO_MISS_FACTOR écarts de hello sans nouvelles
+// Backup failover: the parent is suspected from the first lost frame or after
+// HELLO_MISS_FACTOR hello gaps without news
+#define HELLO_MISS_FACTOR 2
+
+// Sonde du parent : sans trame acquittée par lui pendant PROBE_INTERVAL, une
+// trame d'un octet vérifie le lien ; la détection ne dépend plus de la période
+// des données. 0 désactive la sonde
+// Parent probe: when it acked no frame for PROBE_INTERVAL, a one-byte frame
+// checks the link; detection no longer depends on the data period. 0 disables
+// the probe
+#ifdef DSERAN_CONF_PROBE_INTERVAL
+#define PROBE_INTERVAL DSERAN_CONF_PROBE_INTERVAL
+#else
+#define PROBE_INTERVAL HELLO_IMIN
+#endif
+
+// Mobilité : hellos à l'estime, durée de vie des liens et basculement anticipé
+// d'après les positions et vitesses annoncées / Mobility: dead-reckoning hellos,
+// link lifetime and pre-emptive handoff from advertised positions and velocities
+#ifdef DSERAN_CONF_MOBILITY
+#define DSERAN_MOBILITY DSERAN_CONF_MOBILITY
+#else
+#define DSERAN_MOBILITY 0
+#endif
+#ifdef DSERAN_CONF_RADIO_RANGE
+#define RADIO_RANGE DSERAN_CONF_RADIO_RANGE
+#else
+#define RADIO_RANGE 50.0f                     // m, portée UDGM des scénarios Cooja / UDGM range of the Cooja scenarios
+#endif
+#define MOVE_HELLO_ERROR (RADIO_RANGE / 10)   // m, écart à notre position estimée par les voisins / deviation from our position as estimated by neighbors
+#define MOVE_RESET_ERROR (RADIO_RANGE / 2)    // m, saut qui renouvelle le voisinage / jump that renews the neighborhood
+#define HANDOFF_HORIZON (CLOCK_SECOND * 5)    // parent quitté s'il sort de portée avant / parent left if it leaves range sooner
+
+// Causes de réparation / Repair causes
+#define REPAIR_NOACK  1   // trame non acquittée par le parent / frame not acked by the parent
+#define REPAIR_MISS   2   // hellos du parent manqués / parent hellos missed
+#define REPAIR_EXPIRY 3   // parent expiré de la table / parent expired from the table
+#define REPAIR_LOOP   4   // données reçues du parent / data received from the parent
 
 PROCESS(d_seran_process, "D-SERAN Routing Protocol");
 AUTOSTART_PROCESSES(&d_seran_process);
 
-// Structure pour un voisin / Structure for a neighbor
-struct neighbor {
-  linkaddr_t addr;
-  float trust;
-  uint16_t residual_energy;
-  clock_time_t last_seen;
-};
-static struct neighbor neighbors[MAX_NEIGHBORS];
-static uint8_t neighbor_count = 0;
-
 // Energie du noeud / Node energy
-static uint16_t my_residual_energy = INIT_ENERGY;
+static uint16_t my_residual_energy = DSERAN_INIT_ENERGY;
 static uint16_t my_harvested_energy = 0;
 
 // UDP pour échanges "hello" (découverte/MAJ voisins) / UDP for hello exchanges
 static struct simple_udp_connection udp_conn;
 #define UDP_PORT 1234
 
+// Extensions position et vitesse dans les hellos (modèles de mobilité)
+// Position and velocity extensions in hellos (mobility models)
+#ifdef DSERAN_CONF_HELLO_POSITION
+#define DSERAN_HELLO_POSITION DSERAN_CONF_HELLO_POSITION
+#else
+#define DSERAN_HELLO_POSITION DSERAN_MOBILITY
+#endif
+#if DSERAN_MOBILITY && !DSERAN_HELLO_POSITION
+#error "DSERAN_CONF_MOBILITY demande / requires DSERAN_CONF_HELLO_POSITION"
+#endif
+
+// UDP pour les données, saut par saut vers le puits / UDP for data, hop by hop towards the sink
+static struct simple_udp_connection data_conn;
+#define DATA_PORT 5678
+
+// État de routage vers le puits / Routing state towards the sink
+static uint8_t is_sink = 0;
+static uint8_t my_hops = DSERAN_HOPS_INF;
+static uip_ipaddr_t sink_ipaddr;
+static uip_ipaddr_t defrt_ipaddr;     // route par défaut installée / installed default route
+static uint8_t defrt_set = 0;
+static uint16_t data_seq = 0;
+
+// Ordonnancement adaptatif des hellos / Adaptive hello scheduling
+static struct trickle_timer hello_tt;
+static uint8_t hello_suppressed = 0;
+static uint8_t hello_seq = 0;
+static uint32_t nbr_churn = 0;   // ajouts + retraits déjà vus / joins + leaves already seen
+static uint32_t ctrl_bytes = 0;  // charge de contrôle émise depuis le dernier relevé / control payload sent since the last report
+
+// Surveillance du parent et mesure des réparations / Parent watch and repair measurement
+static struct ctimer parent_watch;
+static struct ctimer parent_probe;
+static linkaddr_t parent_addr;          // prochain saut de la route installée / next hop of the installed route
+static clock_time_t parent_last_hello;
+static clock_time_t parent_gap;         // plus grand écart récent entre ses hellos / largest recent gap between its hellos
+static clock_time_t repair_start;
+static uint8_t repair_cause = 0;        // 0 : aucune réparation en cours / no repair in progress
+static uint16_t repair_lost = 0;        // lectures perdues pendant la réparation / readings lost during the repair
+
+#if DSERAN_MOBILITY
+// Cinématique en m et m/s à l'instant t / Kinematics in m and m/s at time t
+struct kinematics {
+  float x, y;
+  float vx, vy;
+  clock_time_t t;
+};
+static struct kinematics adv_kin;       // notre dernière annonce / our last advertisement
+static struct kinematics parent_kin;    // dernier hello du parent / parent's last hello
+static uint8_t parent_kin_valid = 0;
+#endif
+
 // Prototypes des fonctions / Function prototypes
 static void send_hello(void);
-static void process_hello(const linkaddr_t *src, uint16_t energy, float trust);
-static void update_trust(const linkaddr_t *addr, float delta);
-static void add_or_update_neighbor(const linkaddr_t *addr, uint16_t energy, float trust);
-static linkaddr_t select_next_hop(void);
-static void harvest_energy(void);
-void notify_d_seran_of_movement(void);
+static void process_hello(const linkaddr_t *src, const struct dseran_hello *h);
+static void update_energy(void);
+static void route_refresh(uint8_t force);
+static void failover(struct dseran_nbr *n, uint8_t cause);
+static void parent_hello(void);
+#if DSERAN_MOBILITY
+static clock_time_t link_lifetime(const struct kinematics *nk);
+static void handoff_check(clock_time_t life);
+#endif
+static void send_data(void);
+static uint8_t data_output(const uint8_t *buf, uint16_t len, uint8_t count);
 static void udp_rx_callback(struct simple_udp_connection *c, const uip_ipaddr_t *sender_addr,
                            uint16_t sender_port, const uip_ipaddr_t *receiver_addr,
                            uint16_t receiver_port, const uint8_t *data, uint16_t datalen);
+static void data_rx_callback(struct simple_udp_connection *c, const uip_ipaddr_t *sender_addr,
+                            uint16_t sender_port, const uip_ipaddr_t *receiver_addr,
+                            uint16_t receiver_port, const uint8_t *data, uint16_t datalen);
+
+// Le puits est à distance nulle de lui-même / The sink is at distance zero from itself
+static void become_sink(void) {
+  if(is_sink) {
+    return;
+  }
+  is_sink = 1;
+  my_hops = 0;
+  uip_ds6_addr_add(&sink_ipaddr, 0, ADDR_MANUAL);
+#if DSERAN_TSCH
+  dseran_tsch_set_coordinator();
+#endif
+  LOG_INFO("SINK %u\n", node_id);
+}
 
 // Initialisation du protocole / Protocol initialization
 static void d_seran_init(void) {
-  neighbor_count = 0;
-  my_residual_energy = INIT_ENERGY;
+  // Comptabilité energest / Energest accounting
+  dseran_energy_init();
+  my_residual_energy = dseran_energy_residual();
   my_harvested_energy = 0;
   
+  // Traces binaires / Binary traces
+  dseran_trace_init();
+  
+  // Table des voisins et roue d'expiration / Neighbor table and expiry wheel
+  dseran_nbr_init(&d_seran_process);
+  
+#if DSERAN_MOBILITY
+  // Déplacement périodique / Periodic movement
+  process_start(&mobility_process, NULL);
+#endif
+  
   // Configuration UDP pour communication / UDP setup for communication
   simple_udp_register(&udp_conn, UDP_PORT, NULL, UDP_PORT, udp_rx_callback);
+  simple_udp_register(&data_conn, DATA_PORT, NULL, DATA_PORT, data_rx_callback);
+  dseran_agg_init(data_output);
+  
+  if(node_id == DSERAN_SINK_ID) {
+    become_sink();
+  }
+  
+#if DSERAN_TSCH
+  // Supertrames D-SERAN, puis association TSCH / D-SERAN slotframes, then TSCH association
+  dseran_tsch_init();
+#endif
   
   // Traces de débogage / Debug traces
-  printf("D-SERAN: Initialisation terminée, énergie: %u mJ\n", my_residual_energy);
+  DSERAN_PRINTF("D-SERAN: Initialisation terminée, énergie: %u mJ\n", my_residual_energy);
   LOG_INFO("D-SERAN initialisé\n");
 }
 
 // Envoi périodique de "hello" (découverte/MAJ voisins) / Periodic hello sending
 static void send_hello(void) {
-  uint8_t buf[8];
+  uint8_t buf[DSERAN_HELLO_MAX_LEN];
+  struct dseran_hello h;
+  uint16_t len;
+  uint8_t queue = QUEUEBUF_NUM - queuebuf_numfree();
   
   // Préparation des données hello / Hello data preparation
-  memcpy(&buf[0], &my_residual_energy, sizeof(uint16_t));
-  float my_trust = 1.0;  // On se fait confiance à soi-même / We trust ourselves
-  memcpy(&buf[2], &my_trust, sizeof(float));
+  h.seq = hello_seq++;
+  h.hops = my_hops;
+#if DSERAN_ATTACK == DSERAN_ATTACK_BLACKHOLE
+  // Trou noir : un saut du puits annoncé attire les routes / Blackhole: one advertised hop to the sink lures the routes
+  if(my_hops != DSERAN_HOPS_INF) {
+    h.hops = 1;
+  }
+#endif
+  h.energy = my_residual_energy;
+  h.trust = DSERAN_Q_ONE;  // On se fait confiance à soi-même / We trust ourselves
+  h.ext = 0;
   
-  // Ajout d'un champ random pour simuler la mobilité / Random field for mobility simulation
-  uint16_t rand_val = random_rand();
-  memcpy(&buf[6], &rand_val, sizeof(uint16_t));
+  // Extensions seulement si utiles / Extensions only when useful
+  if(queue > 0) {
+    h.queue = queue;
+    h.ext |= DSERAN_HELLO_HAS_QUEUE;
+  }
+#if DSERAN_HELLO_POSITION
+  float x, y, vx, vy;
+  mobility_get_position(&x, &y);
+  mobility_get_velocity(&vx, &vy);
+  h.pos_x = (uint16_t)(x * 10);
+  h.pos_y = (uint16_t)(y * 10);
+  h.vel_x = (int16_t)(vx * 10);
+  h.vel_y = (int16_t)(vy * 10);
+  h.ext |= DSERAN_HELLO_HAS_POS | DSERAN_HELLO_HAS_VEL;
+#endif
+#if DSERAN_MOBILITY
+  // Les voisins extrapolent notre position depuis cette annonce
+  // Neighbors extrapolate our position from this advertisement
+  adv_kin.x = x;
+  adv_kin.y = y;
+  adv_kin.vx = vx;
+  adv_kin.vy = vy;
+  adv_kin.t = clock_time();
+#endif
+  len = dseran_hello_pack(&h, buf, sizeof(buf));
   
-  // Broadcast du message hello / Hello message broadcast
-  simple_udp_sendto(&udp_conn, buf, sizeof(buf), NULL);
+  // Diffusion à tous les nœuds du lien (ff02::1) / Broadcast to all link nodes (ff02::1)
+  uip_ipaddr_t mcast;
+  uip_create_linklocal_allnodes_mcast(&mcast);
+  simple_udp_sendto(&udp_conn, buf, len, &mcast);
+  ctrl_bytes += len;
   
   // Log avec timestamp / Log with timestamp
-  LOG_INFO("SEND_UDP %u %lu\n", my_residual_energy, clock_time());
+  DSERAN_TRACE1(DSERAN_EV_SEND_UDP, my_residual_energy);
   
   // Trace de débogage occasionnelle / Occasional debug trace
-  if (random_rand() % 10 == 0) {
-    printf("D-SERAN: Hello envoyé, énergie résiduelle: %u mJ\n", my_residual_energy);
+  if(DSERAN_VERBOSE && random_rand() % 10 == 0) {
+    DSERAN_PRINTF("D-SERAN: Hello envoyé, énergie résiduelle: %u mJ\n", my_residual_energy);
   }
 }
 
-// Traitement d'un "hello" reçu / Processing received hello
-static void process_hello(const linkaddr_t *src, uint16_t energy, float trust) {
-  add_or_update_neighbor(src, energy, trust);
-  
-  // Mise à jour de la confiance / Trust update
-  update_trust(src, 0.01);
+// Vrai si un voisin a été ajouté ou retiré depuis le dernier appel
+// True when a neighbor was added or removed since the last call
+static uint8_t neighborhood_changed(void) {
+  const struct dseran_nbr_stats *st = dseran_nbr_get_stats();
+  uint32_t churn = st->joins + st->leaves;
   
-  // Vérification de l'énergie du voisin / Neighbor energy check
-  if (energy < ENERGY_THRESHOLD) {
-    printf("D-SERAN: Voisin %02x:%02x a une énergie faible: %u mJ\n", 
-           src->u8[0], src->u8[1], energy);
-  }
-}
-
-// Mise à jour de la confiance d'un voisin / Update neighbor trust
-static void update_trust(const linkaddr_t *addr, float delta) {
-  for(uint8_t i=0; i<neighbor_count; i++) {
-    if(linkaddr_cmp(&neighbors[i].addr, addr)) {
-      neighbors[i].trust += delta;
-      
-      // Limitation de la confiance entre 0 et 1 / Trust limitation between 0 and 1
-      if(neighbors[i].trust > 1.0) neighbors[i].trust = 1.0;
-      if(neighbors[i].trust < 0.0) neighbors[i].trust = 0.0;
-      
-      return;
-    }
+  if(churn == nbr_churn) {
+    return 0;
   }
+  nbr_churn = churn;
+  return 1;
 }
 
-// Ajout ou mise à jour d'un voisin / Add or update neighbor
-static void add_or_update_neighbor(const linkaddr_t *addr, uint16_t energy, float trust) {
-  for(uint8_t i=0; i<neighbor_count; i++) {
-    if(linkaddr_cmp(&neighbors[i].addr, addr)) {
-      // Mise à jour des informations existantes / Update existing information
-      neighbors[i].residual_energy = energy;
-      neighbors[i].trust = trust;
-      neighbors[i].last_seen = clock_time();
-      
-      // Trace de débogage / Debug trace
-      printf("D-SERAN: Voisin %02x:%02x mis à jour, énergie: %u, confiance: %.2f\n",
-             addr->u8[0], addr->u8[1], energy, trust);
-      return;
-    }
+// Retour à Imin : le voisinage doit être réannoncé / Back to Imin: the neighborhood must be re-advertised
+static void hello_reset(uint8_t cause) {
+  DSERAN_TRACE1(DSERAN_EV_TRICKLE_RESET, cause);
+  trickle_timer_reset_event(&hello_tt);
+}
+
+// Échéance Trickle : hello, sauf si k voisins cohérents ont déjà été entendus
+// Trickle deadline: hello, unless k consistent neighbors were already heard
+static void hello_trickle_cb(void *ptr, uint8_t suppress) {
+  if(suppress && hello_suppressed < HELLO_MAX_SUPPRESS) {
+    hello_suppressed++;
+    DSERAN_TRACE1(DSERAN_EV_HELLO_SUPPRESS, hello_tt.i_cur / CLOCK_SECOND);
+    return;
   }
+  hello_suppressed = 0;
+  send_hello();
   
-  // Ajout d'un nouveau voisin / Add new neighbor
-  if(neighbor_count < MAX_NEIGHBORS) {
-    linkaddr_copy(&neighbors[neighbor_count].addr, addr);
-    neighbors[neighbor_count].residual_energy = energy;
-    neighbors[neighbor_count].trust = trust;
-    neighbors[neighbor_count].last_seen = clock_time();
-    neighbor_count++;
-    
-    printf("D-SERAN: Nouveau voisin ajouté: %02x:%02x (total: %u)\n", 
-           addr->u8[0], addr->u8[1], neighbor_count);
-  } else {
-    printf("D-SERAN: Impossible d'ajouter le voisin %02x:%02x, table pleine\n",
-           addr->u8[0], addr->u8[1]);
-  }
+#if DSERAN_STATS
+  // Efficacité de l'index : balayages évités = requêtes - balayages
+  // Index efficiency: scans avoided = queries - scans
+  const struct dseran_nbr_stats *st = dseran_nbr_get_stats();
+  LOG_INFO("NH_STATS %lu %lu %lu\n", (unsigned long)st->queries,
+           (unsigned long)st->updates, (unsigned long)st->scans);
+#endif
 }
 
-// Sélection du prochain saut basé sur la confiance et l'énergie / Next hop selection
-static linkaddr_t select_next_hop(void) {
-  float best_score = -1.0;
-  int best_idx = -1;
+// Traitement d'un "hello" reçu / Processing received hello
+static void process_hello(const linkaddr_t *src, const struct dseran_hello *h) {
+  // Une seule recherche dans la table par hello, puis confiance / A single table lookup per hello, then trust
+  struct dseran_nbr *n = dseran_core_hello(src, h);
+  
+  // Hello du parent : la surveillance est repoussée / Parent hello: the watch is pushed back
+  if(linkaddr_cmp(src, &parent_addr)) {
+    parent_hello();
+  }
   
-  // Évaluation de tous les voisins / Evaluate all neighbors
-  for(uint8_t i=0; i<neighbor_count; i++) {
-    // Calcul du score combiné / Combined score calculation
-    float score = neighbors[i].trust * (float)neighbors[i].residual_energy;
+#if DSERAN_MOBILITY
+  // Voisin mobile : il expire quand il sortira de portée, pas après ROUTE_TIMEOUT
+  // Mobile neighbor: it expires when it leaves range, not after ROUTE_TIMEOUT
+  if(n != NULL && (h->ext & DSERAN_HELLO_HAS_POS) && (h->ext & DSERAN_HELLO_HAS_VEL)) {
+    struct kinematics nk;
+    clock_time_t life;
     
-    if(score > best_score && neighbors[i].trust > TRUST_THRESHOLD && 
-       neighbors[i].residual_energy > ENERGY_THRESHOLD) {
-      best_score = score;
-      best_idx = i;
+    nk.x = h->pos_x / 10.0f;
+    nk.y = h->pos_y / 10.0f;
+    nk.vx = h->vel_x / 10.0f;
+    nk.vy = h->vel_y / 10.0f;
+    nk.t = clock_time();
+    life = link_lifetime(&nk);
+    dseran_nbr_set_validity(n, life);
+    if(linkaddr_cmp(src, &parent_addr)) {
+      parent_kin = nk;
+      parent_kin_valid = 1;
+      handoff_check(life);
+    } else if(life < HANDOFF_HORIZON && defrt_set) {
+      // Sur le départ : pas candidat tant qu'une route existe / Leaving: not a candidate while a route exists
+      dseran_nbr_suspend(n);
     }
   }
+#else
+  (void)n;
+#endif
   
-  if(best_idx >= 0) {
-    LOG_INFO("HOP %u %lu\n", best_idx, clock_time());
-    
-    // Log détaillé de la sélection / Detailed selection log
-    printf("D-SERAN: Prochain saut sélectionné: %02x:%02x (score: %.2f)\n",
-           neighbors[best_idx].addr.u8[0], neighbors[best_idx].addr.u8[1], best_score);
-    
-    return neighbors[best_idx].addr;
+  // Un hello sans changement de voisinage est redondant / A hello without neighborhood change is redundant
+  if(neighborhood_changed()) {
+    hello_reset(TRICKLE_RESET_CHURN);
+  } else {
+    trickle_timer_consistency(&hello_tt);
   }
   
-  printf("D-SERAN: Aucun voisin valide trouvé pour le routage\n");
-  return linkaddr_null;
+  // Vérification de l'énergie du voisin / Neighbor energy check
+  if (h->energy < ENERGY_THRESHOLD) {
+    DSERAN_PRINTF("D-SERAN: Voisin %02x:%02x a une énergie faible: %u mJ\n",
+                  src->u8[0], src->u8[1], h->energy);
+  }
 }
 
-// Simulation de récolte d'énergie / Energy harvesting simulation
-static void harvest_energy(void) {
-  my_harvested_energy += HARVEST_STEP;
-  my_residual_energy += HARVEST_STEP;
+// Les traces portent des valeurs de 16 bits / Trace records carry 16-bit values
+#define SAT16(v) ((v) > 0xffff ? 0xffff : (uint16_t)(v))
+
+// Énergie mesurée : consommation energest moins récolte / Measured energy: energest consumption minus harvesting
+static void update_energy(void) {
+  static uint8_t update_count = 0;
+  
+  dseran_energy_update();
+  my_residual_energy = dseran_energy_residual();
+  my_harvested_energy = dseran_energy_harvested();
+  
+  DSERAN_TRACE2(DSERAN_EV_ENERGY, my_residual_energy, my_harvested_energy);
   
-  // Limitation de l'énergie maximale / Maximum energy limitation
-  if(my_residual_energy > MAX_ENERGY) {
-    my_residual_energy = MAX_ENERGY;
+  // Détail périodique par poste / Periodic per-state detail
+  if(++update_count % ENERGY_DETAIL_EVERY == 0) {
+    const struct dseran_energy_stats *st = dseran_energy_get_stats();
+    DSERAN_TRACE4(DSERAN_EV_ENERGEST, SAT16(st->cpu), SAT16(st->lpm), SAT16(st->tx), SAT16(st->rx));
+    DSERAN_TRACE1(DSERAN_EV_CTRL_BYTES, SAT16(ctrl_bytes));
+    ctrl_bytes = 0;
+    struct dseran_agg_stats agg;
+    dseran_agg_take_stats(&agg);
+    DSERAN_TRACE3(DSERAN_EV_AGG, agg.frames, agg.readings, agg.dropped);
+    DSERAN_PRINTF("D-SERAN: Énergie récoltée: %u mJ, résiduelle: %u mJ\n",
+                  my_harvested_energy, my_residual_energy);
   }
+}
+
+#if DSERAN_MOBILITY
+// Position extrapolée à l'instant now / Position extrapolated at time now
+static void kin_predict(const struct kinematics *k, clock_time_t now, float *x, float *y) {
+  float dt = (float)(now - k->t) / CLOCK_SECOND;
+  
+  *x = k->x + k->vx * dt;
+  *y = k->y + k->vy * dt;
+}
+
+// Durée (ticks) avant que le voisin nk sorte de portée : plus petite racine
+// positive de |d + w t| = RADIO_RANGE, d et w relatifs à notre position et vitesse
+// Time (ticks) before neighbor nk leaves range: smallest positive root of
+// |d + w t| = RADIO_RANGE, d and w relative to our position and velocity
+static clock_time_t link_lifetime(const struct kinematics *nk) {
+  clock_time_t now = clock_time();
+  float x, y, nx, ny, vx, vy;
+  float dx, dy, wx, wy, a, b, c, t;
   
-  LOG_INFO("ENERGY %u %u\n", my_residual_energy, my_harvested_energy);
+  mobility_get_position(&x, &y);
+  mobility_get_velocity(&vx, &vy);
+  kin_predict(nk, now, &nx, &ny);
+  dx = nx - x;
+  dy = ny - y;
+  wx = nk->vx - vx;
+  wy = nk->vy - vy;
+  a = wx * wx + wy * wy;
+  b = 2 * (dx * wx + dy * wy);
+  c = dx * dx + dy * dy - RADIO_RANGE * RADIO_RANGE;
   
-  // Affichage périodique de l'état énergétique / Periodic energy status display
-  static uint8_t harvest_count = 0;
-  if(++harvest_count % 5 == 0) {
-    printf("D-SERAN: Énergie récoltée: %u mJ, résiduelle: %u mJ\n", 
-           my_harvested_energy, my_residual_energy);
+  // Déjà hors de portée : perdu s'il s'éloigne / Already out of range: lost if moving away
+  if(c >= 0) {
+    return b >= 0 ? 0 : DSERAN_ROUTE_TIMEOUT;
+  }
+  // Vitesses égales : la distance ne change pas / Equal velocities: the distance does not change
+  if(a < 1e-4f) {
+    return DSERAN_ROUTE_TIMEOUT;
   }
+  // c < 0 : une racine positive exactement / c < 0: exactly one positive root
+  t = (-b + sqrtf(b * b - 4 * a * c)) / (2 * a);
+  if(t * CLOCK_SECOND >= DSERAN_ROUTE_TIMEOUT) {
+    return DSERAN_ROUTE_TIMEOUT;
+  }
+  return (clock_time_t)(t * CLOCK_SECOND);
+}
+
+// Parent sur le point de sortir de portée : le premier secours prend la route avant la rupture
+// Parent about to leave range: the first backup takes the route before the break
+static void handoff_check(clock_time_t life) {
+  struct dseran_nbr *n;
+  
+  if(life >= HANDOFF_HORIZON || dseran_nbr_backup(1) == NULL) {
+    return;
+  }
+  n = dseran_nbr_lookup(&parent_addr);
+  if(n == NULL) {
+    return;
+  }
+  DSERAN_TRACE2(DSERAN_EV_HANDOFF, parent_addr.u8[0], (uint16_t)(life * 1000 / CLOCK_SECOND));
+  parent_kin_valid = 0;
+  dseran_nbr_suspend(n);
+  route_refresh(1);
 }
+#endif
 
 // Gestion de la mobilité / Mobility management
 void notify_d_seran_of_movement(void) {
-  LOG_INFO("MOVE %u %u %lu\n", linkaddr_node_addr.u8[0], linkaddr_node_addr.u8[1], (unsigned long)clock_time());
+#if DSERAN_MOBILITY
+  clock_time_t now = clock_time();
+  float x, y, ex, ey, dx, dy, err;
+  
+  // Écart entre notre position et celle que les voisins extrapolent de notre dernier hello
+  // Gap between our position and the one neighbors extrapolate from our last hello
+  mobility_get_position(&x, &y);
+  kin_predict(&adv_kin, now, &ex, &ey);
+  dx = x - ex;
+  dy = y - ey;
+  err = sqrtf(dx * dx + dy * dy);
+  
+  if(err > MOVE_RESET_ERROR) {
+    // Saut : le voisinage a changé, redécouverte rapide / Jump: the neighborhood changed, fast rediscovery
+    DSERAN_TRACE2(DSERAN_EV_MOVE, linkaddr_node_addr.u8[0], linkaddr_node_addr.u8[1]);
+    hello_reset(TRICKLE_RESET_MOVE);
+  } else if(err > MOVE_HELLO_ERROR && now - adv_kin.t >= HELLO_IMIN) {
+    // Trajectoire annoncée périmée : un seul hello la corrige, Trickle garde son rythme
+    // Advertised trajectory stale: a single hello corrects it, Trickle keeps its pace
+    DSERAN_TRACE2(DSERAN_EV_MOVE, linkaddr_node_addr.u8[0], linkaddr_node_addr.u8[1]);
+    send_hello();
+  }
+  
+  // Notre propre déplacement peut nous éloigner du parent / Our own movement may take us away from the parent
+  if(parent_kin_valid) {
+    handoff_check(link_lifetime(&parent_kin));
+  }
+#else
+  DSERAN_TRACE2(DSERAN_EV_MOVE, linkaddr_node_addr.u8[0], linkaddr_node_addr.u8[1]);
+  
+  DSERAN_PRINTF("D-SERAN: Mouvement détecté, recalcul du routage en cours...\n");
+  
+  // Redécouverte rapide des voisins / Fast neighbor rediscovery
+  hello_reset(TRICKLE_RESET_MOVE);
+#endif
+}
+
+// Échéance de surveillance : le parent n'a plus été entendu / Watch deadline: the parent went silent
+static void parent_watch_cb(void *ptr) {
+  struct dseran_nbr *n = dseran_nbr_lookup(&parent_addr);
+  
+  if(n != NULL) {
+    failover(n, REPAIR_MISS);
+  }
+}
+
+// Réarme la surveillance à HELLO_MISS_FACTOR écarts, sans dépasser l'expiration
+// Re-arm the watch at HELLO_MISS_FACTOR gaps, without exceeding expiry
+static void parent_watch_arm(void) {
+  clock_time_t deadline = parent_gap * HELLO_MISS_FACTOR;
+  
+  ctimer_set(&parent_watch, deadline < DSERAN_ROUTE_TIMEOUT ? deadline : DSERAN_ROUTE_TIMEOUT,
+             parent_watch_cb, NULL);
+}
+
+// Sonde d'un octet : data_rx_callback l'ignore, seul l'acquittement MAC compte
+// One-byte probe: data_rx_callback ignores it, only the MAC ack counts
+static void parent_probe_cb(void *ptr) {
+  static const uint8_t probe = 0;
+  
+  if(defrt_set) {
+    simple_udp_sendto(&data_conn, &probe, sizeof(probe), &defrt_ipaddr);
+    ctimer_reset(&parent_probe);
+  }
+}
+
+// Écart entre hellos du parent : maximum glissant, Trickle peut doubler l'intervalle
+// Gap between parent hellos: sliding maximum, Trickle may double the interval
+static void parent_hello(void) {
+  clock_time_t now = clock_time();
+  clock_time_t gap = now - parent_last_hello;
+  
+  parent_last_hello = now;
+  parent_gap -= parent_gap / 8;
+  if(gap > parent_gap) {
+    parent_gap = gap;
+  }
+  if(parent_gap < HELLO_IMIN) {
+    parent_gap = HELLO_IMIN;
+  }
+  parent_watch_arm();
+}
+
+// Nouveau parent : surveillance à l'intervalle Trickle maximal, puis fin de la réparation
+// New parent: watch at the maximum Trickle interval, then close the repair
+static void parent_select(const linkaddr_t *addr) {
+  linkaddr_copy(&parent_addr, addr);
+#if DSERAN_TSCH
+  dseran_tsch_set_next_hop(addr);
+#endif
+#if DSERAN_MOBILITY
+  parent_kin_valid = 0;
+#endif
+  parent_last_hello = clock_time();
+  parent_gap = HELLO_IMIN << HELLO_IDOUBLINGS;
+  parent_watch_arm();
+  if(PROBE_INTERVAL > 0) {
+    ctimer_set(&parent_probe, PROBE_INTERVAL, parent_probe_cb, NULL);
+  }
+  
+  if(repair_cause != 0) {
+    uint32_t ms = (uint32_t)(clock_time() - repair_start) * 1000 / CLOCK_SECOND;
+    DSERAN_TRACE3(DSERAN_EV_REPAIR, ms > UINT16_MAX ? UINT16_MAX : (uint16_t)ms,
+                  repair_lost, repair_cause);
+    repair_cause = 0;
+  }
+}
+
+// Début d'une réparation (la première cause l'emporte) / Repair start (the first cause wins)
+static void repair_begin(uint8_t cause) {
+  if(repair_cause == 0) {
+    repair_cause = cause;
+    repair_start = clock_time();
+    repair_lost = 0;
+  }
+}
+
+// Parent suspect : le premier secours classé devient la route, sans attendre
+// Suspect parent: the first ranked backup becomes the route, without waiting
+static void failover(struct dseran_nbr *n, uint8_t cause) {
+  repair_begin(cause);
+  dseran_nbr_suspend(n);
+  route_refresh(1);
+}
+
+// Retrait de la route par défaut installée / Remove the installed default route
+static void defrt_remove(void) {
+  if(defrt_set) {
+    uip_ds6_defrt_t *old = uip_ds6_defrt_lookup(&defrt_ipaddr);
+    if(old != NULL) {
+      uip_ds6_defrt_rm(old);
+    }
+    defrt_set = 0;
+  }
+}
+
+// Plus de route : ni route par défaut, ni parent surveillé, ni case d'émission TSCH
+// No route left: no default route, no watched parent, no TSCH transmit cell
+static void route_clear(void) {
+  defrt_remove();
+  ctimer_stop(&parent_watch);
+  ctimer_stop(&parent_probe);
+  linkaddr_copy(&parent_addr, &linkaddr_null);
+#if DSERAN_TSCH
+  dseran_tsch_set_next_hop(&linkaddr_null);
+#endif
+}
+
+// Distance au puits et route par défaut suivant le meilleur voisin
+// Distance to the sink and default route following the best neighbor
+static void route_refresh(uint8_t force) {
+  const struct dseran_nbr *best = dseran_nbr_best();
+  uint8_t hops = (best != NULL && best->hops < DSERAN_MAX_HOPS) ? best->hops + 1 : DSERAN_HOPS_INF;
   
-  printf("D-SERAN: Mouvement détecté, recalcul du routage en cours...\n");
+  // Rien à faire si ni le voisin ni sa distance n'ont changé
+  // Nothing to do when neither the neighbor nor its distance changed
+  if(is_sink || (!force && hops == my_hops)) {
+    return;
+  }
+  // Même voisin à la même distance : la route installée reste valable
+  // Same neighbor at the same distance: the installed route still holds
+  if(defrt_set && hops == my_hops && best != NULL && linkaddr_cmp(&best->addr, &parent_addr)) {
+    return;
+  }
+  // Parent disparu de la table sans avoir été suspecté / Parent gone from the table without suspicion
+  if(defrt_set && dseran_nbr_lookup(&parent_addr) == NULL) {
+    repair_begin(REPAIR_EXPIRY);
+  }
+  my_hops = hops;
   
-  // Ici, on pourrait déclencher une redécouverte de voisins / Here we could trigger neighbor rediscovery
-  // ou une mise à jour de la table de routage / or routing table update
+  // Retrait de l'ancienne route / Remove the previous route
+  if(my_hops == DSERAN_HOPS_INF) {
+    route_clear();
+    return;
+  }
+  defrt_remove();
+  
+  // Adresse lien-local du prochain saut / Next hop link-local address
+  uip_ip6addr(&defrt_ipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&defrt_ipaddr, (uip_lladdr_t *)&best->addr);
+  if(uip_ds6_nbr_lookup(&defrt_ipaddr) == NULL) {
+    uip_ds6_nbr_add(&defrt_ipaddr, (const uip_lladdr_t *)&best->addr, 1,
+                    NBR_REACHABLE, NBR_TABLE_REASON_ROUTE, NULL);
+  }
+  // Données et trafic uIP vers le puits par ce prochain saut / Data and uIP traffic to the sink through this next hop
+  if(uip_ds6_defrt_add(&defrt_ipaddr, 0) != NULL) {
+    defrt_set = 1;
+    parent_select(&best->addr);
+  }
+}
+
+// Lecture locale mise en file vers le puits / Local reading queued towards the sink
+static void send_data(void) {
+  struct dseran_data msg;
+  
+  if(is_sink) {
+    return;
+  }
+  if(my_hops == DSERAN_HOPS_INF) {
+    // Donnée perdue faute de route pendant une réparation / Data lost for lack of a route during a repair
+    if(repair_cause != 0) {
+      repair_lost++;
+    }
+    return;
+  }
+  msg.origin = node_id;
+  msg.seq = ++data_seq;
+  msg.send_time = (uint32_t)clock_time();
+  msg.hops = 0;
+  msg.budget = (uint32_t)DSERAN_AGG_LATENCY * 1000 / CLOCK_SECOND;
+  msg.magic = DSERAN_DATA_MAGIC;
+  DSERAN_TRACE2(DSERAN_EV_DATA_TX, node_id, msg.seq);
+  dseran_agg_push(&msg, my_hops);
+}
+
+// Trame agrégée vers le prochain saut courant (dseran-agg.c) / Aggregated frame to the current next hop (dseran-agg.c)
+static uint8_t data_output(const uint8_t *buf, uint16_t len, uint8_t count) {
+  if(!defrt_set) {
+    if(repair_cause != 0) {
+      repair_lost += count;
+    }
+    return 0;
+  }
+  simple_udp_sendto(&data_conn, buf, len, &defrt_ipaddr);
+  return 1;
+}
+
+// Trame de lectures d'un enfant : consommée au puits, fusionnée ailleurs dans notre file
+// Frame of readings from a child: consumed at the sink, merged into our queue elsewhere
+static void data_rx_callback(struct simple_udp_connection *c, const uip_ipaddr_t *sender_addr,
+                            uint16_t sender_port, const uip_ipaddr_t *receiver_addr,
+                            uint16_t receiver_port, const uint8_t *data, uint16_t datalen) {
+  struct dseran_data msg;
+  linkaddr_t src;
+  
+  if(datalen == 0 || datalen % sizeof(msg) != 0) {
+    return;
+  }
+  // Trame de notre propre parent : la route boucle, le parent est suspendu
+  // jusqu'à son prochain hello et le premier secours prend la route
+  // Frame from our own parent: the route loops, the parent is suspended until
+  // its next hello and the first backup takes the route
+  dseran_net_lladdr_from_ipaddr(&src, sender_addr);
+  if(!is_sink && linkaddr_cmp(&src, &parent_addr)) {
+    struct dseran_nbr *n = dseran_nbr_lookup(&parent_addr);
+    
+    dseran_agg_drop(datalen / sizeof(msg));
+    if(n != NULL) {
+      failover(n, REPAIR_LOOP);
+    } else {
+      route_refresh(1);
+    }
+    return;
+  }
+  for(; datalen > 0; data += sizeof(msg), datalen -= sizeof(msg)) {
+    memcpy(&msg, data, sizeof(msg));
+    if(msg.magic != DSERAN_DATA_MAGIC) {
+      continue;
+    }
+    msg.hops++;
+    if(!is_sink) {
+      // Limite de sauts : une boucle non détectée ne retient pas la lecture indéfiniment
+      // Hop limit: an undetected loop does not keep the reading forever
+      if(msg.hops >= DSERAN_MAX_HOPS) {
+        dseran_agg_drop(1);
+      } else {
+        dseran_agg_push(&msg, my_hops);
+      }
+      continue;
+    }
+    
+    // Latence en ms (horloges Cooja alignées), attente en file comprise
+    // Latency in ms (aligned Cooja clocks), queueing included
+    uint32_t latency = ((uint32_t)clock_time() - msg.send_time) * 1000 / CLOCK_SECOND;
+    
+    DSERAN_TRACE4(DSERAN_EV_DATA_RX, msg.origin, msg.seq,
+                  latency > UINT16_MAX ? UINT16_MAX : (uint16_t)latency, msg.hops);
+  }
 }
 
 // Callback UDP pour réception de paquets hello / UDP callback for hello packet reception
 static void udp_rx_callback(struct simple_udp_connection *c, const uip_ipaddr_t *sender_addr,
                            uint16_t sender_port, const uip_ipaddr_t *receiver_addr,
                            uint16_t receiver_port, const uint8_t *data, uint16_t datalen) {
-  if(datalen >= 6) {
-    uint16_t energy;
-    float trust;
-    
-    // Extraction des données reçues / Extract received data
-    memcpy(&energy, &data[0], sizeof(uint16_t));
-    memcpy(&trust, &data[2], sizeof(float));
-    
-    // Récupération de l'adresse du voisin / Get neighbor address
-    linkaddr_t src;
-    memcpy(&src, &sender_addr->u8[14], 2);  // IPv6 -> linkaddr conversion
-    
-    // Traitement du message hello / Process hello message
-    process_hello(&src, energy, trust);
-    LOG_INFO("RECV %u %lu\n", energy, clock_time());
-    
-    // Traces de débogage occasionnelles / Occasional debug traces
-    if (random_rand() % 20 == 0) {
-      printf("D-SERAN: Hello reçu de %02x:%02x, énergie: %u, confiance: %.2f\n",
-             src.u8[0], src.u8[1], energy, trust);
-    }
+  struct dseran_hello h;
+  linkaddr_t src;
+  
+  // Version et longueurs vérifiées avant usage / Version and lengths checked before use
+  if(!dseran_hello_parse(&h, data, datalen)) {
+    LOG_WARN("Hello invalide ignoré (%u octets)\n", datalen);
+    return;
+  }
+  
+  // Récupération de l'adresse du voisin / Get neighbor address
+  dseran_net_lladdr_from_ipaddr(&src, sender_addr);
+  
+  // Traitement du message hello / Process hello message
+  process_hello(&src, &h);
+  DSERAN_TRACE1(DSERAN_EV_RECV, h.energy);
+  
+  // Traces de débogage occasionnelles / Occasional debug traces
+  if(DSERAN_VERBOSE && random_rand() % 20 == 0) {
+    DSERAN_PRINTF("D-SERAN: Hello reçu de %02x:%02x, énergie: %u, confiance: %u%%\n",
+                  src.u8[0], src.u8[1], h.energy, DSERAN_Q_TO_CENT(h.trust));
   }
 }
 
 // Fonction principale du protocole / Main protocol function
 PROCESS_THREAD(d_seran_process, ev, data) {
-  static struct etimer hello_timer, harvest_timer;
+  static struct etimer boot_timer, energy_timer, data_timer;
   
   PROCESS_BEGIN();
   
@@ -267,45 +823,72 @@ PROCESS_THREAD(d_seran_process, ev, data) {
   simple_udp_register(&udp_conn, UDP_PORT, NULL, UDP_PORT, udp_rx_callback);
   
   // Configuration des timers / Timer setup
-  etimer_set(&hello_timer, HELLO_INTERVAL);
-  etimer_set(&harvest_timer, CLOCK_SECOND * 5);
+  etimer_set(&energy_timer, ENERGY_INTERVAL);
+  etimer_set(&data_timer, DATA_INTERVAL + random_rand() % DATA_INTERVAL);
+  
+  DSERAN_PRINTF("D-SERAN: Processus principal démarré, timers configurés\n");
   
-  printf("D-SERAN: Processus principal démarré, timers configurés\n");
+  // Désynchronisation au démarrage : premier intervalle Trickle décalé aléatoirement
+  // Boot-time desynchronisation: first Trickle interval randomly offset
+  etimer_set(&boot_timer, random_rand() % HELLO_IMIN);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&boot_timer));
+  trickle_timer_config(&hello_tt, HELLO_IMIN, HELLO_IDOUBLINGS, HELLO_K);
+  trickle_timer_set(&hello_tt, hello_trickle_cb, NULL);
   
   while(1) {
     PROCESS_WAIT_EVENT();
     
-    // Gestion du timer hello / Hello timer management
-    if(etimer_expired(&hello_timer)) {
-      send_hello();
-      etimer_reset(&hello_timer);
+    // Intégration périodique de l'énergie / Periodic energy integration
+    if(etimer_expired(&energy_timer)) {
+      update_energy();
+      etimer_reset(&energy_timer);
     }
     
-    // Gestion du timer de récolte d'énergie / Energy harvesting timer management
-    if(etimer_expired(&harvest_timer)) {
-      harvest_energy();
-      etimer_reset(&harvest_timer);
+    // Trafic de données vers le puits / Data traffic towards the sink
+    if(etimer_expired(&data_timer)) {
+      send_data();
+      etimer_reset(&data_timer);
     }
     
-    // Routage auto-réparateur : sélection dynamique du next hop / Self-healing routing
-    linkaddr_t next_hop = select_next_hop();
-    if(!linkaddr_cmp(&next_hop, &linkaddr_null)) {
-      LOG_INFO("Next hop sélectionné : %u.%u\n", next_hop.u8[0], next_hop.u8[1]);
-      
-      // Affichage occasionnel du routage / Occasional routing display
-      static uint8_t route_count = 0;
-      if(++route_count % 15 == 0) {
-        printf("D-SERAN: Routage actif vers %02x:%02x\n", next_hop.u8[0], next_hop.u8[1]);
+    // Routage auto-réparateur : le next hop est lu dans l'index, rien à faire
+    // si aucun voisin n'a changé / Self-healing routing: the next hop is read from
+    // the index, nothing to do when no neighbor changed
+    linkaddr_t next_hop = dseran_core_next_hop();
+    uint8_t best_changed = dseran_nbr_best_changed();
+    uint8_t old_hops = my_hops;
+    route_refresh(best_changed);
+    
+    // Voisin perdu (expiration) ou nouvelle distance : hellos rapides
+    // Lost neighbor (expiry) or new distance: fast hellos
+    if(neighborhood_changed()) {
+      hello_reset(TRICKLE_RESET_CHURN);
+    } else if(my_hops != old_hops) {
+      hello_reset(TRICKLE_RESET_HOPS);
+    }
+    if(best_changed) {
+      if(!linkaddr_cmp(&next_hop, &linkaddr_null)) {
+        const struct dseran_nbr *best = dseran_nbr_best();
+        DSERAN_TRACE1(DSERAN_EV_HOP, dseran_nbr_best_index());
+        DSERAN_TRACE3(DSERAN_EV_LQE, best->addr.u8[0],
+                      dseran_lqe_hrr(&best->lqe) * 100 / DSERAN_ETX_DIVISOR,
+                      best->lqe.etx * 100 / DSERAN_ETX_DIVISOR);
+        LOG_INFO("Next hop sélectionné : %u.%u\n", next_hop.u8[0], next_hop.u8[1]);
+        
+        // Log détaillé de la sélection / Detailed selection log
+        DSERAN_PRINTF("D-SERAN: Prochain saut sélectionné: %02x:%02x (score: %lu, sauts: %u)\n",
+                      next_hop.u8[0], next_hop.u8[1],
+                      (unsigned long)DSERAN_NBR_SCORE_TE(dseran_nbr_best_score()), my_hops);
+      } else {
+        LOG_WARN("Aucun voisin fiable pour le routage\n");
+        DSERAN_PRINTF("D-SERAN: Aucune route disponible, attente de nouveaux voisins...\n");
       }
-    } else {
-      LOG_WARN("Aucun voisin fiable pour le routage\n");
-      printf("D-SERAN: Aucune route disponible, attente de nouveaux voisins...\n");
     }
     
     // Vérification de la fin de vie / Lifetime check
     if(my_residual_energy == 0) {
-      LOG_INFO("LIFETIME %u %lu\n", linkaddr_node_addr.u8[0], clock_time());
-      printf("D-SERAN: Énergie épuisée, arrêt du protocole\n");
+      DSERAN_TRACE1(DSERAN_EV_LIFETIME, linkaddr_node_addr.u8[0]);
+      dseran_trace_flush();
+      LOG_WARN("Énergie épuisée, arrêt du protocole\n");
       PROCESS_EXIT();
     }
   }
@@ -313,8 +896,117 @@ PROCESS_THREAD(d_seran_process, ev, data) {
   PROCESS_END();
 } 
 
+// Interface du pilote de routage / Routing driver interface
+
+// Adresses globales : la sienne et celle, bien connue, du puits
+// Global addresses: our own and the well-known sink address
+static void driver_init(void) {
+  uip_ipaddr_t ipaddr;
+  
+  uip_ip6addr(&ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&ipaddr, &uip_lladdr);
+  uip_ds6_addr_add(&ipaddr, 0, ADDR_AUTOCONF);
+  uip_ip6addr(&sink_ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 1);
+}
+
+static int driver_root_start(void) {
+  become_sink();
+  return 0;
+}
+
+static int driver_node_is_root(void) {
+  return is_sink;
+}
+
+static int driver_get_root_ipaddr(uip_ipaddr_t *ipaddr) {
+  uip_ipaddr_copy(ipaddr, &sink_ipaddr);
+  return 1;
+}
+
+static void driver_leave_network(void) {
+  if(!is_sink) {
+    my_hops = DSERAN_HOPS_INF;
+    route_clear();
+  }
+}
+
+static int driver_node_has_joined(void) {
+  return my_hops != DSERAN_HOPS_INF;
+}
+
+static int driver_node_is_reachable(void) {
+  return my_hops != DSERAN_HOPS_INF;
+}
+
+static void driver_global_repair(const char *str) {
+  LOG_INFO("GLOBAL_REPAIR %lu\n", (unsigned long)clock_time());
+}
+
+static void driver_local_repair(const char *str) {
+  route_refresh(1);
+}
+
+// Retour de la couche MAC : confiance, chien de garde et réparation locale
+// MAC feedback: trust, watchdog and local repair
+static void driver_link_callback(const linkaddr_t *addr, int status, int numtx) {
+  struct dseran_nbr *n = dseran_nbr_lookup(addr);
+  
+  if(n == NULL) {
+    return;
+  }
+  if(status == MAC_TX_OK) {
+    dseran_core_link_tx(n, 1, numtx);
+    // Lien vers le parent vérifié : la sonde attend / Link to the parent checked: the probe waits
+    if(PROBE_INTERVAL > 0 && linkaddr_cmp(addr, &parent_addr)) {
+      ctimer_restart(&parent_probe);
+    }
+#if DSERAN_WD_VERIFY
+    // Donnée acquittée : n doit maintenant la relayer / Acked data: n must now relay it
+    dseran_watchdog_sent(n);
+#endif
+  } else if(status == MAC_TX_NOACK) {
+    uint8_t broken = dseran_core_link_tx(n, 0, numtx);
+    // Bascule dès la première trame perdue par le parent / Failover from the first frame lost by the parent
+    uint8_t from_parent = linkaddr_cmp(addr, &parent_addr);
+    if(from_parent) {
+      repair_begin(REPAIR_NOACK);
+    }
+    // Lectures de la trame perdue, encore dans packetbuf / Readings of the lost frame, still in packetbuf
+    if(repair_cause != 0) {
+      repair_lost += dseran_agg_count(packetbuf_dataptr(), packetbuf_datalen());
+    }
+    if(from_parent) {
+      failover(n, REPAIR_NOACK);
+    }
+    if(broken) {
+      // Lien rompu : le voisin quitte la table et le classement / Broken link: the neighbor leaves the table and the ranking
+      DSERAN_TRACE1(DSERAN_EV_LOCAL_REPAIR, addr->u8[0]);
+      dseran_nbr_remove(n);
+    }
+  }
+}
+
 // Structure du pilote de routage / Routing driver structure
 const struct routing_driver d_seran_routing_driver = {
   "d-seran",
-  NULL, NULL, NULL, NULL, NULL, NULL
+  driver_init,
+  dseran_net_root_set_prefix,
+  driver_root_start,
+  driver_node_is_root,
+  driver_get_root_ipaddr,
+  dseran_net_get_sr_node_ipaddr,
+  driver_leave_network,
+  driver_node_has_joined,
+  driver_node_is_reachable,
+  driver_global_repair,
+  driver_local_repair,
+  dseran_net_ext_header_remove,
+  dseran_net_ext_header_update,
+  dseran_net_ext_header_hbh_update,
+  dseran_net_ext_header_srh_update,
+  dseran_net_ext_header_srh_get_next_hop,
+  driver_link_callback,
+  dseran_net_neighbor_state_changed,
+  dseran_net_drop_route,
+  dseran_net_is_in_leaf_mode,
 }; 
\ No newline at end of file
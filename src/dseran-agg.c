@@ -0,0 +1,127 @@
+/*
+ * dseran-agg.c : File d'émission agrégée des données D-SERAN
+ * Aggregated transmit queue for D-SERAN data
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * La file est triée par échéance croissante : la minuterie ne suit que la
+ * première. Elle ne dépasse jamais DSERAN_AGG_MAX lectures, puisqu'une
+ * trame pleine part aussitôt, et une trame emporte toute la file. Le temps
+ * passé en file est retiré du budget de chaque lecture au départ.
+ * The queue is sorted by increasing deadline: the timer only follows the
+ * first one. It never holds more than DSERAN_AGG_MAX readings, since a full
+ * frame leaves at once, and a frame takes the whole queue. The time spent
+ * queued is taken off each reading's budget on departure.
+ */
+
+#include "contiki.h"
+#include "sys/ctimer.h"
+#include "dseran-agg.h"
+#include <string.h>
+
+// Lecture en attente / Waiting reading
+struct entry {
+  struct dseran_data d;
+  clock_time_t queued;
+  clock_time_t deadline;
+};
+
+static struct entry queue[DSERAN_AGG_MAX];
+static uint8_t queue_len = 0;
+static struct ctimer flush_timer;
+static dseran_agg_output_t output;
+static struct dseran_agg_stats stats;
+
+static uint16_t ms_of(clock_time_t t) {
+  uint32_t ms = (uint32_t)t * 1000 / CLOCK_SECOND;
+  return ms > UINT16_MAX ? UINT16_MAX : (uint16_t)ms;
+}
+
+// Toute la file en une trame / The whole queue in one frame
+static void flush(void) {
+  uint8_t buf[DSERAN_AGG_MAX * sizeof(struct dseran_data)];
+  clock_time_t now = clock_time();
+  uint8_t count = queue_len;
+
+  for(uint8_t i=0; i<count; i++) {
+    struct dseran_data d = queue[i].d;
+    uint16_t waited = ms_of(now - queue[i].queued);
+
+    d.budget = d.budget > waited ? d.budget - waited : 0;
+    memcpy(buf + i * sizeof(d), &d, sizeof(d));
+  }
+  queue_len = 0;
+  if(output(buf, count * sizeof(struct dseran_data), count)) {
+    stats.frames++;
+    stats.readings += count;
+  } else {
+    stats.dropped += count;
+  }
+}
+
+static void flush_cb(void *ptr) {
+  if(queue_len > 0) {
+    flush();
+  }
+}
+
+void dseran_agg_init(dseran_agg_output_t out) {
+  output = out;
+  queue_len = 0;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void dseran_agg_push(const struct dseran_data *d, uint8_t hops_left) {
+  clock_time_t now = clock_time();
+  clock_time_t wait = (clock_time_t)d->budget * CLOCK_SECOND / 1000;
+  uint8_t i;
+
+  // Part du budget laissée à ce saut / Share of the budget left to this hop
+  if(hops_left > 1) {
+    wait /= hops_left;
+  }
+  if(wait > DSERAN_AGG_HOLD) {
+    wait = DSERAN_AGG_HOLD;
+  }
+
+  // Insertion par échéance croissante / Insertion by increasing deadline
+  for(i=queue_len; i>0 && CLOCK_LT(now + wait, queue[i - 1].deadline); i--) {
+    queue[i] = queue[i - 1];
+  }
+  queue[i].d = *d;
+  queue[i].queued = now;
+  queue[i].deadline = now + wait;
+  queue_len++;
+
+  // Trame pleine ou échéance atteinte : départ immédiat, sinon à la première échéance
+  // Full frame or deadline reached: immediate departure, otherwise at the first deadline
+  if(queue_len == DSERAN_AGG_MAX || wait == 0) {
+    ctimer_stop(&flush_timer);
+    flush();
+  } else if(i == 0) {
+    ctimer_set(&flush_timer, wait, flush_cb, NULL);
+  }
+}
+
+void dseran_agg_drop(uint8_t count) {
+  stats.dropped += count;
+}
+
+uint8_t dseran_agg_count(const uint8_t *buf, uint16_t len) {
+  struct dseran_data d;
+  uint8_t count = 0;
+
+  for(; len >= sizeof(d) && count < DSERAN_AGG_MAX; len -= sizeof(d), count++) {
+    memcpy(&d, buf + len - sizeof(d), sizeof(d));
+    if(d.magic != DSERAN_DATA_MAGIC) {
+      break;
+    }
+  }
+  return count;
+}
+
+void dseran_agg_take_stats(struct dseran_agg_stats *st) {
+  *st = stats;
+  memset(&stats, 0, sizeof(stats));
+}
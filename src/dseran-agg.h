@@ -0,0 +1,95 @@
+/*
+ * dseran-agg.h : File d'émission agrégée des données D-SERAN
+ * Aggregated transmit queue for D-SERAN data
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Les données vont au puits saut par saut : chaque nœud, source ou relais,
+ * range les lectures reçues dans une seule file (il n'a qu'un prochain
+ * saut) et les émet ensemble, jusqu'à DSERAN_AGG_MAX par trame, dès que la
+ * trame est pleine ou que l'échéance d'une lecture arrive. Chaque lecture
+ * porte le budget d'attente qui lui reste avant le puits ; un nœud à h sauts
+ * du puits n'en consomme au plus qu'un h-ième, et jamais plus de
+ * DSERAN_AGG_HOLD. Les lectures sont de taille fixe et finissent par
+ * DSERAN_DATA_MAGIC : le chien de garde les reconnaît en fin de trame.
+ * Data travels to the sink hop by hop: every node, source or relay, stores
+ * the readings it gets in a single queue (it has a single next hop) and
+ * sends them together, up to DSERAN_AGG_MAX per frame, as soon as the frame
+ * is full or a reading's deadline comes. Each reading carries the waiting
+ * budget it has left before the sink; a node h hops away from the sink uses
+ * at most an h-th of it, and never more than DSERAN_AGG_HOLD. Readings have
+ * a fixed size and end with DSERAN_DATA_MAGIC: the watchdog recognizes them
+ * at the end of the frame.
+ */
+
+#ifndef DSERAN_AGG_H_
+#define DSERAN_AGG_H_
+
+#include "contiki.h"
+
+// Lecture transportée vers le puits, reconnue en fin de trame par le chien de garde
+// Reading carried to the sink, recognized at the end of the frame by the watchdog
+#define DSERAN_DATA_MAGIC 0xd5e7da7aUL
+struct dseran_data {
+  uint16_t origin;      // node_id de la source / source node_id
+  uint16_t seq;
+  uint32_t send_time;   // clock_time() de l'émetteur / sender clock_time()
+  uint16_t hops;        // liens déjà franchis / links already crossed
+  uint16_t budget;      // attente encore permise en ms / waiting still allowed in ms
+  uint32_t magic;       // DSERAN_DATA_MAGIC, sans remplissage avant / no padding before
+};
+
+// Lectures par trame : 5 x 16 octets tiennent dans une trame 802.15.4 sans
+// fragmentation ; 1 désactive l'agrégation / Readings per frame: 5 x 16 bytes
+// fit in an 802.15.4 frame without fragmentation; 1 disables aggregation
+#ifdef DSERAN_CONF_AGG_MAX
+#define DSERAN_AGG_MAX DSERAN_CONF_AGG_MAX
+#else
+#define DSERAN_AGG_MAX 5
+#endif
+
+// Budget d'attente d'une lecture de la source au puits, 65 s au plus
+// Waiting budget of a reading from the source to the sink, 65 s at most
+#ifdef DSERAN_CONF_AGG_LATENCY
+#define DSERAN_AGG_LATENCY DSERAN_CONF_AGG_LATENCY
+#else
+#define DSERAN_AGG_LATENCY (CLOCK_SECOND * 10)
+#endif
+
+// Attente maximale dans une file / Maximum wait in one queue
+#ifdef DSERAN_CONF_AGG_HOLD
+#define DSERAN_AGG_HOLD DSERAN_CONF_AGG_HOLD
+#else
+#define DSERAN_AGG_HOLD (CLOCK_SECOND * 2)
+#endif
+
+// Émission d'une trame de count lectures ; faux si elle n'a pas pu partir
+// Sends a frame of count readings; false when it could not leave
+typedef uint8_t (*dseran_agg_output_t)(const uint8_t *buf, uint16_t len, uint8_t count);
+
+// Compteurs depuis le dernier relevé / Counters since the last report
+struct dseran_agg_stats {
+  uint16_t frames;      // trames émises / frames sent
+  uint16_t readings;    // lectures émises / readings sent
+  uint16_t dropped;     // lectures perdues faute de route ou en boucle / readings lost for lack of a route or in a loop
+};
+
+void dseran_agg_init(dseran_agg_output_t output);
+
+// Met une lecture en file, la trame part dès qu'elle est pleine ; hops_left :
+// distance au puits / Queues a reading, the frame leaves as soon as it is full;
+// hops_left: distance to the sink
+void dseran_agg_push(const struct dseran_data *d, uint8_t hops_left);
+
+// Lectures reçues mais écartées sans passer par la file / Readings received but discarded without going through the queue
+void dseran_agg_drop(uint8_t count);
+
+// Lectures en fin de trame, 0 pour une trame sans données
+// Readings at the end of a frame, 0 for a frame without data
+uint8_t dseran_agg_count(const uint8_t *buf, uint16_t len);
+
+// Relevé puis remise à zéro des compteurs / Counters report, then reset
+void dseran_agg_take_stats(struct dseran_agg_stats *st);
+
+#endif /* DSERAN_AGG_H_ */
@@ -0,0 +1,150 @@
+/*
+ * dseran-behavior.h : Confiance comportementale (fenêtre glissante du chien de garde)
+ * Behavior-based trust (watchdog sliding window)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Chaque donnée confiée à un voisin est une attente ; l'entendre relayer la
+ * donnée compte un relais, ne rien entendre avant l'échéance compte une
+ * perte (dseran-watchdog.c). Les compteurs sur 8 bits sont rangés dans
+ * DSERAN_WD_SLOTS cases qui tournent avec la roue d'expiration : les
+ * preuves les plus anciennes sortent de la fenêtre, d'où la décroissance.
+ * La confiance est la moyenne d'une loi bêta dont l'a priori vaut
+ * DSERAN_WD_INIT_TRUST, chaque perte pesant DSERAN_WD_DROP_WEIGHT relais :
+ * un voisin qui relaie moins de W/(W+1) des données finit sous le seuil
+ * d'éligibilité. Calculée localement, elle ne dépend plus de ce que le
+ * voisin annonce de lui-même.
+ * Every data frame handed to a neighbor is an expectation; overhearing the
+ * neighbor relay it counts a forward, hearing nothing before the deadline
+ * counts a drop (dseran-watchdog.c). The 8-bit counters live in
+ * DSERAN_WD_SLOTS slots that turn with the expiry wheel: the oldest evidence
+ * leaves the window, hence the decay. Trust is the mean of a beta law whose
+ * prior is DSERAN_WD_INIT_TRUST, each drop weighing DSERAN_WD_DROP_WEIGHT
+ * forwards: a neighbor relaying less than W/(W+1) of the data ends up below
+ * the eligibility threshold. Computed locally, it no longer depends on what
+ * the neighbor advertises about itself.
+ */
+
+#ifndef DSERAN_BEHAVIOR_H_
+#define DSERAN_BEHAVIOR_H_
+
+#include "contiki.h"
+#include <stdint.h>
+#include "dseran-fixed.h"
+
+// Chien de garde actif (profil minimal, sky et z1 : 0) / Watchdog enabled (minimal profile, sky and z1: 0)
+#ifdef DSERAN_CONF_WATCHDOG
+#define DSERAN_WATCHDOG DSERAN_CONF_WATCHDOG
+#else
+#define DSERAN_WATCHDOG 1
+#endif
+
+// Cases de la fenêtre, une par tick de la roue : la moitié de DSERAN_ROUTE_TIMEOUT
+// Window slots, one per wheel tick: half of DSERAN_ROUTE_TIMEOUT
+#ifdef DSERAN_CONF_WD_SLOTS
+#define DSERAN_WD_SLOTS DSERAN_CONF_WD_SLOTS
+#else
+#define DSERAN_WD_SLOTS 4
+#endif
+
+// A priori : DSERAN_WD_PRIOR_FWD relais et DSERAN_WD_PRIOR_DROP pertes fictifs (0,7)
+// Prior: DSERAN_WD_PRIOR_FWD forwards and DSERAN_WD_PRIOR_DROP drops assumed (0.7)
+#ifdef DSERAN_CONF_WD_PRIOR_FWD
+#define DSERAN_WD_PRIOR_FWD DSERAN_CONF_WD_PRIOR_FWD
+#else
+#define DSERAN_WD_PRIOR_FWD 14
+#endif
+#ifdef DSERAN_CONF_WD_PRIOR_DROP
+#define DSERAN_WD_PRIOR_DROP DSERAN_CONF_WD_PRIOR_DROP
+#else
+#define DSERAN_WD_PRIOR_DROP 6
+#endif
+
+// Poids d'une perte : 2 rend inéligible sous 2/3 de relais, un trou gris à 50 % compris
+// Weight of a drop: 2 makes a neighbor ineligible below 2/3 forwarded, a 50 % grayhole included
+#ifdef DSERAN_CONF_WD_DROP_WEIGHT
+#define DSERAN_WD_DROP_WEIGHT DSERAN_CONF_WD_DROP_WEIGHT
+#else
+#define DSERAN_WD_DROP_WEIGHT 2
+#endif
+
+#define DSERAN_WD_INIT_TRUST \
+  ((dseran_trust_t)(((uint32_t)DSERAN_WD_PRIOR_FWD << DSERAN_Q_SHIFT) / \
+                    (DSERAN_WD_PRIOR_FWD + DSERAN_WD_PRIOR_DROP)))
+
+// Fenêtre d'un voisin / Per-neighbor window
+struct dseran_behavior {
+  uint8_t expected[DSERAN_WD_SLOTS];    // données confiées / data handed over
+  uint8_t forwarded[DSERAN_WD_SLOTS];   // relais entendus / forwards overheard
+  uint8_t dropped[DSERAN_WD_SLOTS];     // échéances dépassées / deadlines missed
+};
+
+// Totaux sur la fenêtre / Window totals
+struct dseran_behavior_sum {
+  uint16_t expected;
+  uint16_t forwarded;
+  uint16_t dropped;
+};
+
+static inline void
+dseran_behavior_init(struct dseran_behavior *b)
+{
+  for(uint8_t i=0; i<DSERAN_WD_SLOTS; i++) {
+    b->expected[i] = 0;
+    b->forwarded[i] = 0;
+    b->dropped[i] = 0;
+  }
+}
+
+// Incrément saturant de la case courante / Saturating increment of the current slot
+static inline void
+dseran_behavior_count(uint8_t *c)
+{
+  if(*c < 0xff) {
+    (*c)++;
+  }
+}
+
+// La case slot devient courante : ses anciennes preuves sortent de la fenêtre ;
+// renvoie 1 si elle en contenait / Slot becomes current: its old evidence leaves the
+// window; returns 1 when it held any
+static inline uint8_t
+dseran_behavior_rotate(struct dseran_behavior *b, uint8_t slot)
+{
+  uint8_t had = (b->forwarded[slot] | b->dropped[slot]) != 0;
+
+  b->expected[slot] = 0;
+  b->forwarded[slot] = 0;
+  b->dropped[slot] = 0;
+  return had;
+}
+
+static inline void
+dseran_behavior_sum(const struct dseran_behavior *b, struct dseran_behavior_sum *s)
+{
+  s->expected = 0;
+  s->forwarded = 0;
+  s->dropped = 0;
+  for(uint8_t i=0; i<DSERAN_WD_SLOTS; i++) {
+    s->expected += b->expected[i];
+    s->forwarded += b->forwarded[i];
+    s->dropped += b->dropped[i];
+  }
+}
+
+// Confiance Q1.15 : (relais + a priori) / (relais + W pertes + a priori), < 2^31
+// Q1.15 trust: (forwards + prior) / (forwards + W drops + prior), < 2^31
+static inline dseran_trust_t
+dseran_behavior_trust(const struct dseran_behavior *b)
+{
+  struct dseran_behavior_sum s;
+  uint32_t good, all;
+
+  dseran_behavior_sum(b, &s);
+  good = (uint32_t)s.forwarded + DSERAN_WD_PRIOR_FWD;
+  all = good + (uint32_t)s.dropped * DSERAN_WD_DROP_WEIGHT + DSERAN_WD_PRIOR_DROP;
+  return (dseran_trust_t)((good << DSERAN_Q_SHIFT) / all);
+}
+
+#endif /* DSERAN_BEHAVIOR_H_ */
@@ -0,0 +1,48 @@
+/*
+ * dseran-core.c : Cœur D-SERAN indépendant de la pile réseau
+ * D-SERAN core, independent of the network stack
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Les décisions qui ne touchent qu'à la table des voisins vivent ici ;
+ * d-seran.c garde Trickle, la route par défaut et la réparation.
+ * Decisions that only touch the neighbor table live here; d-seran.c keeps
+ * Trickle, the default route and the repair.
+ */
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+#include "dseran-core.h"
+
+struct dseran_nbr *dseran_core_hello(const linkaddr_t *src, const struct dseran_hello *h) {
+  struct dseran_nbr *n = dseran_nbr_add_or_update(src, h->energy, h->trust, h->hops, h->seq);
+
+#if !DSERAN_WATCHDOG
+  if(n != NULL) {
+    dseran_nbr_update_trust(n, DSERAN_TRUST_HELLO_BONUS);
+  }
+#endif
+  return n;
+}
+
+uint8_t dseran_core_link_tx(struct dseran_nbr *n, uint8_t acked, uint8_t numtx) {
+  dseran_nbr_link_tx(n, acked, numtx);
+  if(acked) {
+    n->tx_fail = 0;
+    return 0;
+  }
+#if !DSERAN_WATCHDOG
+  dseran_nbr_update_trust(n, DSERAN_TRUST_NOACK_PENALTY);
+#endif
+  return ++n->tx_fail >= DSERAN_LINK_FAIL_MAX;
+}
+
+linkaddr_t dseran_core_next_hop(void) {
+  const struct dseran_nbr *best = dseran_nbr_best();
+
+  if(best != NULL) {
+    return best->addr;
+  }
+  return linkaddr_null;
+}
@@ -0,0 +1,45 @@
+/*
+ * dseran-core.h : Cœur D-SERAN indépendant de la pile réseau
+ * D-SERAN core, independent of the network stack
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Réception d'un hello, retour MAC et choix du prochain saut, au-dessus de
+ * dseran-nbr.c. Le module ne dépend que de l'horloge, des ctimers et de
+ * linkaddr : il compile pour TARGET=native comme pour les bancs d'essai
+ * hôtes de bench/.
+ * Hello reception, MAC feedback and next hop choice, on top of dseran-nbr.c.
+ * The module only depends on the clock, ctimers and linkaddr: it builds for
+ * TARGET=native as well as for the host benchmarks in bench/.
+ */
+
+#ifndef DSERAN_CORE_H_
+#define DSERAN_CORE_H_
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+#include "dseran-fixed.h"
+#include "dseran-nbr.h"
+#include "dseran-hello.h"
+
+// Confiance déclarative, sans chien de garde (dseran-behavior.h) / Declarative trust,
+// without the watchdog (dseran-behavior.h)
+#define DSERAN_TRUST_HELLO_BONUS   DSERAN_DQ(0.01)   // bonus par hello reçu / bonus per received hello
+#define DSERAN_TRUST_NOACK_PENALTY DSERAN_DQ(-0.05)  // pénalité par trame non acquittée / penalty per unacked frame
+#define DSERAN_LINK_FAIL_MAX 3                       // échecs MAC avant retrait / MAC failures before removal
+
+// Hello décodé de src : une seule recherche dans la table, puis bonus de confiance
+// sans chien de garde ; NULL si la table l'a refusé / Decoded hello from src: a single
+// table lookup, then trust bonus without the watchdog; NULL when the table refused it
+struct dseran_nbr *dseran_core_hello(const linkaddr_t *src, const struct dseran_hello *h);
+
+// Retour MAC d'un envoi unicast vers n ; vrai si le lien est rompu, l'appelant
+// retire alors n après sa propre réparation / MAC feedback of a unicast send to n;
+// true when the link is broken, the caller then removes n after its own repair
+uint8_t dseran_core_link_tx(struct dseran_nbr *n, uint8_t acked, uint8_t numtx);
+
+// Prochain saut en O(1), linkaddr_null si aucun / Next hop in O(1), linkaddr_null if none
+linkaddr_t dseran_core_next_hop(void);
+
+#endif /* DSERAN_CORE_H_ */
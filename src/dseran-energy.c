@@ -0,0 +1,111 @@
+/*
+ * dseran-energy.c : Énergie résiduelle mesurée par energest
+ * Residual energy measured through energest
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Énergie (nJ) = courant (µA) * tension (mV) * durée (s). Les calculs sont
+ * faits sur 64 bits en nJ pour ne rien perdre entre deux intégrations.
+ * Energy (nJ) = current (µA) * voltage (mV) * duration (s). Computations
+ * use 64 bits in nJ so nothing is lost between two integrations.
+ */
+
+#include "contiki.h"
+#include "sys/energest.h"
+#include "dseran-energy.h"
+
+// Courants par état en µA, fiches techniques / Per-state currents in µA, datasheets
+#if CONTIKI_TARGET_Z1
+// Zolertia Z1 : MSP430F2617 à 8 MHz, CC2420 / Zolertia Z1: MSP430F2617 at 8 MHz, CC2420
+#define CURRENT_CPU_UA 3600
+#define CURRENT_LPM_UA 50
+#define CURRENT_TX_UA  17400
+#define CURRENT_RX_UA  18800
+#else
+// Tmote Sky (et Cooja, qui émule ses temps) : MSP430F1611, CC2420
+// Tmote Sky (and Cooja, which emulates its timings): MSP430F1611, CC2420
+#define CURRENT_CPU_UA 1800
+#define CURRENT_LPM_UA 55
+#define CURRENT_TX_UA  17700
+#define CURRENT_RX_UA  19700
+#endif
+
+#define SUPPLY_MV 3000
+#define NJ_PER_MJ 1000000LL
+
+static const energest_type_t types[] = {
+  ENERGEST_TYPE_CPU, ENERGEST_TYPE_LPM, ENERGEST_TYPE_DEEP_LPM,
+  ENERGEST_TYPE_TRANSMIT, ENERGEST_TYPE_LISTEN
+};
+static const uint16_t currents_ua[] = {
+  CURRENT_CPU_UA, CURRENT_LPM_UA, CURRENT_LPM_UA, CURRENT_TX_UA, CURRENT_RX_UA
+};
+#define NTYPES (sizeof(types) / sizeof(types[0]))
+
+static uint64_t last_time[NTYPES];
+static uint64_t last_total;
+static uint64_t consumed_nj[NTYPES];
+static uint64_t harvested_nj;
+static int64_t residual_nj;
+static struct dseran_energy_stats stats;
+
+void dseran_energy_init(void) {
+  uint8_t i;
+
+  energest_flush();
+  for(i=0; i<NTYPES; i++) {
+    last_time[i] = energest_type_time(types[i]);
+    consumed_nj[i] = 0;
+  }
+  last_total = energest_get_total_time();
+  harvested_nj = 0;
+  residual_nj = (int64_t)DSERAN_INIT_ENERGY * NJ_PER_MJ;
+}
+
+void dseran_energy_update(void) {
+  uint64_t used = 0;
+  uint64_t now, total, gained;
+  uint8_t i;
+
+  energest_flush();
+  for(i=0; i<NTYPES; i++) {
+    now = energest_type_time(types[i]);
+    uint64_t nj = (now - last_time[i]) * currents_ua[i] * SUPPLY_MV / ENERGEST_SECOND;
+    last_time[i] = now;
+    consumed_nj[i] += nj;
+    used += nj;
+  }
+
+  // Récolte à puissance constante sur la durée écoulée / Constant-power harvesting over elapsed time
+  total = energest_get_total_time();
+  gained = (total - last_total) * DSERAN_HARVEST_UW * 1000 / ENERGEST_SECOND;
+  last_total = total;
+  harvested_nj += gained;
+
+  // Batterie bornée à sa capacité initiale / Battery bounded by its initial capacity
+  residual_nj += (int64_t)gained - (int64_t)used;
+  if(residual_nj < 0) {
+    residual_nj = 0;
+  } else if(residual_nj > (int64_t)DSERAN_INIT_ENERGY * NJ_PER_MJ) {
+    residual_nj = (int64_t)DSERAN_INIT_ENERGY * NJ_PER_MJ;
+  }
+
+  stats.cpu = consumed_nj[0] / NJ_PER_MJ;
+  stats.lpm = (consumed_nj[1] + consumed_nj[2]) / NJ_PER_MJ;
+  stats.tx = consumed_nj[3] / NJ_PER_MJ;
+  stats.rx = consumed_nj[4] / NJ_PER_MJ;
+}
+
+uint16_t dseran_energy_residual(void) {
+  return (uint16_t)(residual_nj / NJ_PER_MJ);
+}
+
+uint16_t dseran_energy_harvested(void) {
+  uint64_t mj = harvested_nj / NJ_PER_MJ;
+  return mj > UINT16_MAX ? UINT16_MAX : (uint16_t)mj;
+}
+
+const struct dseran_energy_stats *dseran_energy_get_stats(void) {
+  return &stats;
+}
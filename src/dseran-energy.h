@@ -0,0 +1,55 @@
+/*
+ * dseran-energy.h : Énergie résiduelle mesurée par energest
+ * Residual energy measured through energest
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Les temps CPU, LPM, émission et écoute d'energest sont intégrés
+ * périodiquement avec les courants de la plateforme (sky, z1, cooja) pour
+ * obtenir l'énergie consommée ; une récolte à puissance constante s'y ajoute.
+ * Energest CPU, LPM, transmit and listen times are periodically integrated
+ * with the platform currents (sky, z1, cooja) to obtain the consumed energy;
+ * constant-power harvesting is added on top.
+ */
+
+#ifndef DSERAN_ENERGY_H_
+#define DSERAN_ENERGY_H_
+
+#include "contiki.h"
+
+// Budget initial en mJ (surchargeable dans project-conf.h) / Initial budget in mJ (overridable in project-conf.h)
+#ifdef DSERAN_CONF_INIT_ENERGY
+#define DSERAN_INIT_ENERGY DSERAN_CONF_INIT_ENERGY
+#else
+#define DSERAN_INIT_ENERGY 60000
+#endif
+#if DSERAN_INIT_ENERGY > 65535
+#error "DSERAN_CONF_INIT_ENERGY doit tenir sur 16 bits / must fit in 16 bits (mJ)"
+#endif
+
+// Puissance récoltée en µW / Harvested power in µW
+#ifdef DSERAN_CONF_HARVEST_UW
+#define DSERAN_HARVEST_UW DSERAN_CONF_HARVEST_UW
+#else
+#define DSERAN_HARVEST_UW 1000
+#endif
+
+// Consommation par poste depuis le démarrage, en mJ / Consumption per state since boot, in mJ
+struct dseran_energy_stats {
+  uint32_t cpu;
+  uint32_t lpm;
+  uint32_t tx;
+  uint32_t rx;
+};
+
+void dseran_energy_init(void);
+
+// Intègre energest depuis l'appel précédent / Integrates energest since the previous call
+void dseran_energy_update(void);
+
+uint16_t dseran_energy_residual(void);    // mJ
+uint16_t dseran_energy_harvested(void);   // mJ, cumul / cumulative
+const struct dseran_energy_stats *dseran_energy_get_stats(void);
+
+#endif /* DSERAN_ENERGY_H_ */
@@ -0,0 +1,80 @@
+/*
+ * dseran-fixed.h : Arithmétique en virgule fixe pour les scores D-SERAN
+ * Fixed-point arithmetic for D-SERAN scoring
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Confiance au format Q1.15 non signé, énergie entière (mJ), score sur 32 bits.
+ * Toutes les opérations sont saturantes et n'utilisent aucune unité flottante,
+ * ce qui évite l'émulation logicielle sur MSP430 (sky/z1).
+ * Trust in unsigned Q1.15, integer energy (mJ), 32-bit score.
+ * All operations saturate and never touch floating point, which avoids
+ * software float emulation on MSP430 (sky/z1).
+ */
+
+#ifndef DSERAN_FIXED_H_
+#define DSERAN_FIXED_H_
+
+#include <stdint.h>
+
+// Types de base / Base types
+typedef uint16_t dseran_trust_t;    // Q1.15, [0, DSERAN_Q_ONE]
+typedef int16_t  dseran_dtrust_t;   // Variation signée Q1.15 / Signed Q1.15 delta
+typedef uint32_t dseran_score_t;    // confiance * énergie / trust * energy
+
+#define DSERAN_Q_SHIFT 15
+#define DSERAN_Q_ONE   ((dseran_trust_t)(1u << DSERAN_Q_SHIFT))
+
+// Conversion de constantes à la compilation (aucun flottant à l'exécution)
+// Compile-time constant conversion (no runtime float)
+#define DSERAN_Q(x)  ((dseran_trust_t)((x) * DSERAN_Q_ONE + 0.5))
+#define DSERAN_DQ(x) ((dseran_dtrust_t)((x) * DSERAN_Q_ONE + ((x) < 0 ? -0.5 : 0.5)))
+
+// Confiance en centièmes pour les traces entières / Trust in hundredths for integer traces
+#define DSERAN_Q_TO_CENT(q) ((unsigned)(((uint32_t)(q) * 100u + (DSERAN_Q_ONE / 2)) >> DSERAN_Q_SHIFT))
+
+// Borne une confiance reçue dans [0, 1] / Clamp a received trust into [0, 1]
+static inline dseran_trust_t
+dseran_trust_sat(uint16_t raw)
+{
+  return raw > DSERAN_Q_ONE ? DSERAN_Q_ONE : (dseran_trust_t)raw;
+}
+
+// Addition saturante de la confiance / Saturating trust addition
+static inline dseran_trust_t
+dseran_trust_add_sat(dseran_trust_t t, dseran_dtrust_t delta)
+{
+  int32_t s = (int32_t)t + delta;
+  if(s < 0) {
+    return 0;
+  }
+  if(s > DSERAN_Q_ONE) {
+    return DSERAN_Q_ONE;
+  }
+  return (dseran_trust_t)s;
+}
+
+// Addition saturante de l'énergie dans [0, max] / Saturating energy addition in [0, max]
+static inline uint16_t
+dseran_energy_add_sat(uint16_t e, int16_t delta, uint16_t max)
+{
+  int32_t s = (int32_t)e + delta;
+  if(s < 0) {
+    return 0;
+  }
+  if(s > max) {
+    return max;
+  }
+  return (uint16_t)s;
+}
+
+// Score combiné : multiplication 16x16 -> 32 bits, jamais de débordement
+// Combined score: 16x16 -> 32-bit multiply, never overflows
+static inline dseran_score_t
+dseran_score(dseran_trust_t trust, uint16_t energy)
+{
+  return (dseran_score_t)trust * energy;
+}
+
+#endif /* DSERAN_FIXED_H_ */
@@ -0,0 +1,111 @@
+/*
+ * dseran-hello.c : Encodage et décodage des messages hello D-SERAN
+ * D-SERAN hello message encoding and decoding
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Tous les champs sont écrits octet par octet (petit-boutiste pour les
+ * valeurs de 16 bits) : le format ne dépend pas de l'architecture.
+ * All fields are written byte by byte (little-endian for 16-bit values):
+ * the format does not depend on the architecture.
+ */
+
+#include "contiki.h"
+#include "dseran-hello.h"
+#include "dseran-nbr.h"
+
+// Quantification de la confiance : 255 représente exactement 1.0
+// Trust quantization: 255 represents exactly 1.0
+static uint8_t trust_to_u8(dseran_trust_t t) {
+  return (uint8_t)(((uint32_t)t * 255 + DSERAN_Q_ONE / 2) >> DSERAN_Q_SHIFT);
+}
+
+static dseran_trust_t trust_from_u8(uint8_t q) {
+  return (dseran_trust_t)(((uint32_t)q * DSERAN_Q_ONE + 127) / 255);
+}
+
+static uint8_t energy_to_u8(uint16_t e) {
+  uint16_t q = (e + DSERAN_HELLO_ENERGY_STEP / 2) / DSERAN_HELLO_ENERGY_STEP;
+  return q > 255 ? 255 : (uint8_t)q;
+}
+
+static void put_u16(uint8_t *p, uint16_t v) {
+  p[0] = v & 0xff;
+  p[1] = v >> 8;
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+  return p[0] | ((uint16_t)p[1] << 8);
+}
+
+uint16_t dseran_hello_pack(const struct dseran_hello *h, uint8_t *buf, uint16_t size) {
+  uint16_t len = DSERAN_HELLO_HDR_LEN;
+  uint8_t hops = h->hops >= DSERAN_HELLO_HOPS_NONE ? DSERAN_HELLO_HOPS_NONE : h->hops;
+
+  if(size < DSERAN_HELLO_MAX_LEN) {
+    return 0;
+  }
+  buf[0] = (DSERAN_HELLO_VERSION << 6) | hops;
+  buf[1] = h->seq;
+  buf[2] = energy_to_u8(h->energy);
+  buf[3] = trust_to_u8(h->trust);
+
+  if(h->ext & DSERAN_HELLO_HAS_QUEUE) {
+    buf[len++] = (DSERAN_HELLO_TLV_QUEUE << 4) | 1;
+    buf[len++] = h->queue;
+  }
+  if(h->ext & DSERAN_HELLO_HAS_POS) {
+    buf[len++] = (DSERAN_HELLO_TLV_POS << 4) | 4;
+    put_u16(&buf[len], h->pos_x);
+    put_u16(&buf[len + 2], h->pos_y);
+    len += 4;
+  }
+  if(h->ext & DSERAN_HELLO_HAS_VEL) {
+    buf[len++] = (DSERAN_HELLO_TLV_VEL << 4) | 4;
+    put_u16(&buf[len], (uint16_t)h->vel_x);
+    put_u16(&buf[len + 2], (uint16_t)h->vel_y);
+    len += 4;
+  }
+  return len;
+}
+
+uint8_t dseran_hello_parse(struct dseran_hello *h, const uint8_t *buf, uint16_t len) {
+  uint16_t pos = DSERAN_HELLO_HDR_LEN;
+
+  if(len < DSERAN_HELLO_HDR_LEN || (buf[0] >> 6) != DSERAN_HELLO_VERSION) {
+    return 0;
+  }
+  h->hops = buf[0] & 0x3f;
+  if(h->hops == DSERAN_HELLO_HOPS_NONE) {
+    h->hops = DSERAN_HOPS_INF;
+  }
+  h->seq = buf[1];
+  h->energy = (uint16_t)buf[2] * DSERAN_HELLO_ENERGY_STEP;
+  h->trust = trust_from_u8(buf[3]);
+  h->ext = 0;
+
+  // Extensions : longueur vérifiée avant toute lecture / Extensions: length checked before any read
+  while(pos < len) {
+    uint8_t type = buf[pos] >> 4;
+    uint8_t tlen = buf[pos] & 0x0f;
+
+    if(pos + 1 + tlen > len) {
+      return 0;
+    }
+    if(type == DSERAN_HELLO_TLV_QUEUE && tlen == 1) {
+      h->queue = buf[pos + 1];
+      h->ext |= DSERAN_HELLO_HAS_QUEUE;
+    } else if(type == DSERAN_HELLO_TLV_POS && tlen == 4) {
+      h->pos_x = get_u16(&buf[pos + 1]);
+      h->pos_y = get_u16(&buf[pos + 3]);
+      h->ext |= DSERAN_HELLO_HAS_POS;
+    } else if(type == DSERAN_HELLO_TLV_VEL && tlen == 4) {
+      h->vel_x = (int16_t)get_u16(&buf[pos + 1]);
+      h->vel_y = (int16_t)get_u16(&buf[pos + 3]);
+      h->ext |= DSERAN_HELLO_HAS_VEL;
+    }
+    pos += 1 + tlen;
+  }
+  return 1;
+}
@@ -0,0 +1,78 @@
+/*
+ * dseran-hello.h : Format binaire versionné des messages hello D-SERAN
+ * Versioned binary format of D-SERAN hello messages
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * En-tête fixe de 4 octets, indépendant de l'endianness, suivi d'extensions
+ * TLV optionnelles (type et longueur sur un octet) :
+ * Fixed 4-byte header, endian-independent, followed by optional TLV
+ * extensions (type and length in one byte):
+ *
+ *   octet / byte 0 : version (2 bits) | sauts vers le puits / hops to sink (6 bits, 63 = aucun / none)
+ *   octet / byte 1 : numéro de séquence de l'émetteur / sender sequence number
+ *   octet / byte 2 : énergie résiduelle quantifiée / quantized residual energy
+ *   octet / byte 3 : confiance quantifiée (255 = 1.0) / quantized trust (255 = 1.0)
+ *   TLV            : type (4 bits) | longueur / length (4 bits), valeur / value
+ *
+ * Les extensions inconnues sont ignorées, ce qui permet d'en ajouter sans
+ * changer de version. Un hello complet occupe au plus DSERAN_HELLO_MAX_LEN
+ * octets et laisse plus de 60 octets d'une trame 802.15.4 aux données.
+ * Unknown extensions are skipped, so new ones can be added without a version
+ * change. A full hello takes at most DSERAN_HELLO_MAX_LEN bytes and leaves
+ * more than 60 bytes of an 802.15.4 frame for data.
+ */
+
+#ifndef DSERAN_HELLO_H_
+#define DSERAN_HELLO_H_
+
+#include "contiki.h"
+#include "dseran-fixed.h"
+
+#define DSERAN_HELLO_VERSION   1
+#define DSERAN_HELLO_HDR_LEN   4
+#define DSERAN_HELLO_HOPS_NONE 63
+
+// Pas de quantification de l'énergie (mJ par unité) / Energy quantization step (mJ per unit)
+#ifdef DSERAN_CONF_HELLO_ENERGY_STEP
+#define DSERAN_HELLO_ENERGY_STEP DSERAN_CONF_HELLO_ENERGY_STEP
+#else
+#define DSERAN_HELLO_ENERGY_STEP 1
+#endif
+
+// Extensions TLV / TLV extensions
+#define DSERAN_HELLO_TLV_QUEUE 1   // occupation de la file (1 octet) / queue depth (1 byte)
+#define DSERAN_HELLO_TLV_POS   2   // position x, y en dm (2 x 16 bits) / x, y position in dm (2 x 16 bits)
+#define DSERAN_HELLO_TLV_VEL   3   // vitesse x, y en dm/s (2 x 16 bits signés) / x, y velocity in dm/s (2 x signed 16 bits)
+
+// Extensions présentes dans struct dseran_hello / Extensions present in struct dseran_hello
+#define DSERAN_HELLO_HAS_QUEUE 0x01
+#define DSERAN_HELLO_HAS_POS   0x02
+#define DSERAN_HELLO_HAS_VEL   0x04
+
+#define DSERAN_HELLO_MAX_LEN (DSERAN_HELLO_HDR_LEN + 2 + 5 + 5)
+
+// Contenu décodé d'un hello / Decoded hello content
+struct dseran_hello {
+  uint8_t seq;
+  uint8_t hops;              // DSERAN_HOPS_INF si aucune route / if no route
+  uint16_t energy;           // mJ, à la précision de DSERAN_HELLO_ENERGY_STEP / mJ, at DSERAN_HELLO_ENERGY_STEP precision
+  dseran_trust_t trust;      // Q1.15, à 1/255 près / within 1/255
+  uint8_t ext;               // DSERAN_HELLO_HAS_* présentes / present DSERAN_HELLO_HAS_*
+  uint8_t queue;
+  uint16_t pos_x;
+  uint16_t pos_y;
+  int16_t vel_x;
+  int16_t vel_y;
+};
+
+// Encode h dans buf, renvoie la longueur ou 0 si buf est trop petit
+// Encodes h into buf, returns the length or 0 when buf is too small
+uint16_t dseran_hello_pack(const struct dseran_hello *h, uint8_t *buf, uint16_t size);
+
+// Décode buf dans h, renvoie 0 si la version ou la longueur est invalide
+// Decodes buf into h, returns 0 when the version or the length is invalid
+uint8_t dseran_hello_parse(struct dseran_hello *h, const uint8_t *buf, uint16_t len);
+
+#endif /* DSERAN_HELLO_H_ */
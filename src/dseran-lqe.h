@@ -0,0 +1,114 @@
+/*
+ * dseran-lqe.h : Estimation de la qualité des liens (fenêtre de hellos, ETX)
+ * Link quality estimation (hello window, ETX)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Le taux de réception des hellos (HRR) est mesuré sur une fenêtre glissante
+ * des 16 derniers numéros de séquence. L'ETX est une moyenne exponentielle
+ * alimentée par les hellos (1 / HRR) et par le retour MAC des envois unicast
+ * (nombre de transmissions), comme link-stats de Contiki-NG. Toutes les
+ * valeurs sont entières, en 1/128 (DSERAN_ETX_DIVISOR).
+ * The hello reception ratio (HRR) is measured over a sliding window of the
+ * last 16 sequence numbers. ETX is an exponential moving average fed by
+ * hellos (1 / HRR) and by MAC feedback on unicast sends (transmission
+ * count), like Contiki-NG link-stats. All values are integers, in 1/128
+ * (DSERAN_ETX_DIVISOR).
+ */
+
+#ifndef DSERAN_LQE_H_
+#define DSERAN_LQE_H_
+
+#include <stdint.h>
+
+#define DSERAN_ETX_DIVISOR   128
+#define DSERAN_ETX_INIT      (2 * DSERAN_ETX_DIVISOR)    // lien inconnu / unknown link
+#define DSERAN_ETX_MAX       (16 * DSERAN_ETX_DIVISOR)
+#define DSERAN_ETX_NOACK     (12 * DSERAN_ETX_DIVISOR)   // échantillon d'un envoi non acquitté / unacked send sample
+#define DSERAN_LQE_WINDOW    16
+
+// Poids des moyennes (sur 100) : les hellos sont rares, ils pèsent plus
+// Average weights (out of 100): hellos are rare, they weigh more
+#define DSERAN_LQE_ALPHA_HELLO 70
+#define DSERAN_LQE_ALPHA_MAC   90
+
+// État d'estimation d'un voisin / Per-neighbor estimation state
+struct dseran_lqe {
+  uint16_t rx_window;   // bit i : hello (last_seq - i) reçu / received
+  uint16_t etx;         // en 1/128 / in 1/128
+  uint8_t last_seq;
+  uint8_t rx_len;       // taille utile de la fenêtre / valid window length
+};
+
+static inline void
+dseran_lqe_init(struct dseran_lqe *l, uint8_t seq)
+{
+  l->rx_window = 1;
+  l->rx_len = 1;
+  l->last_seq = seq;
+  l->etx = DSERAN_ETX_INIT;
+}
+
+static inline uint8_t
+dseran_lqe_popcount(uint16_t v)
+{
+  uint8_t c = 0;
+  while(v) {
+    v &= v - 1;
+    c++;
+  }
+  return c;
+}
+
+// HRR en 1/128 / HRR in 1/128
+static inline uint16_t
+dseran_lqe_hrr(const struct dseran_lqe *l)
+{
+  uint16_t mask = l->rx_len >= DSERAN_LQE_WINDOW ? 0xffff : (uint16_t)((1u << l->rx_len) - 1);
+  return (uint16_t)(dseran_lqe_popcount(l->rx_window & mask) * DSERAN_ETX_DIVISOR / l->rx_len);
+}
+
+static inline void
+dseran_lqe_ewma(struct dseran_lqe *l, uint16_t sample, uint8_t alpha)
+{
+  uint32_t etx = ((uint32_t)l->etx * alpha + (uint32_t)sample * (100 - alpha)) / 100;
+  if(etx < DSERAN_ETX_DIVISOR) {
+    etx = DSERAN_ETX_DIVISOR;
+  }
+  l->etx = etx > DSERAN_ETX_MAX ? DSERAN_ETX_MAX : (uint16_t)etx;
+}
+
+// Hello de numéro seq reçu ; renvoie 0 pour un doublon
+// Hello with number seq received; returns 0 for a duplicate
+static inline uint8_t
+dseran_lqe_hello(struct dseran_lqe *l, uint8_t seq)
+{
+  uint8_t gap = (uint8_t)(seq - l->last_seq);
+
+  if(gap == 0) {
+    return 0;
+  }
+  if(gap > DSERAN_LQE_WINDOW) {
+    // Long silence ou redémarrage : la fenêtre repart / Long silence or reboot: the window restarts
+    l->rx_window = 1;
+    l->rx_len = 1;
+  } else {
+    l->rx_window = (uint16_t)((l->rx_window << gap) | 1);
+    l->rx_len = l->rx_len + gap > DSERAN_LQE_WINDOW ? DSERAN_LQE_WINDOW : l->rx_len + gap;
+  }
+  l->last_seq = seq;
+  dseran_lqe_ewma(l, (uint16_t)((uint32_t)DSERAN_ETX_DIVISOR * DSERAN_ETX_DIVISOR /
+                                dseran_lqe_hrr(l)), DSERAN_LQE_ALPHA_HELLO);
+  return 1;
+}
+
+// Retour MAC d'un envoi unicast / MAC feedback of a unicast send
+static inline void
+dseran_lqe_tx(struct dseran_lqe *l, uint8_t acked, uint8_t numtx)
+{
+  dseran_lqe_ewma(l, acked ? (uint16_t)(numtx * DSERAN_ETX_DIVISOR) : DSERAN_ETX_NOACK,
+                  DSERAN_LQE_ALPHA_MAC);
+}
+
+#endif /* DSERAN_LQE_H_ */
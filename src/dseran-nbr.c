@@ -0,0 +1,636 @@
+/*
+ * dseran-nbr.c : Table des voisins D-SERAN (index haché, expiration, meilleur saut)
+ * D-SERAN neighbor table (hashed index, expiry, best next hop)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Les entrées sont rangées de façon compacte dans neighbors[] ; un index haché
+ * à sondage linéaire (suppression par décalage arrière, sans pierre tombale)
+ * donne l'entrée d'une adresse en une recherche. Une roue temporelle unique
+ * gère l'expiration et un classement incrémental garde le meilleur voisin et
+ * ses DSERAN_BACKUP_HOPS secours.
+ * Entries are packed in neighbors[]; a linear-probing hash index (backward-shift
+ * deletion, no tombstones) maps an address to its entry in one lookup. A single
+ * timer wheel handles expiry and an incremental ranking keeps the best neighbor
+ * and its DSERAN_BACKUP_HOPS backups.
+ */
+
+#include "contiki.h"
+#include "sys/log.h"
+#include "net/linkaddr.h"
+#include "dseran-nbr.h"
+#include "dseran-trace.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_MODULE "D-SERAN"
+#define LOG_LEVEL DSERAN_LOG_LEVEL
+
+// Traces de débogage détaillées / Detailed debug traces
+#ifdef DSERAN_NBR_CONF_VERBOSE
+#define NBR_VERBOSE DSERAN_NBR_CONF_VERBOSE
+#else
+#define NBR_VERBOSE DSERAN_VERBOSE
+#endif
+#if NBR_VERBOSE
+#define NBR_PRINTF(...) printf(__VA_ARGS__)
+#else
+#define NBR_PRINTF(...)
+#endif
+
+#define NONE DSERAN_NBR_NONE
+#define HASH_MASK (DSERAN_NBR_HASH_SIZE - 1)
+
+// Table compacte et index haché / Packed table and hash index
+static struct dseran_nbr neighbors[DSERAN_MAX_NEIGHBORS];
+static dseran_nbr_idx_t neighbor_count = 0;
+static dseran_nbr_idx_t hash_index[DSERAN_NBR_HASH_SIZE];
+
+// Roue temporelle unique : un voisin rafraîchi est chaîné dans la case courante
+// et expire quand la roue y revient, soit après DSERAN_ROUTE_TIMEOUT (à un tick près).
+// Single timer wheel: a refreshed neighbor is chained into the current slot and
+// expires when the wheel comes back to it, i.e. after DSERAN_ROUTE_TIMEOUT (within a tick).
+static dseran_nbr_idx_t wheel_head[DSERAN_WHEEL_SLOTS];
+static uint8_t wheel_pos = 0;
+static struct ctimer wheel_timer;
+static struct process *owner_process;
+
+// Classement incrémental : nh_rank[0..nh_len) contient exactement les meilleurs voisins
+// éligibles, par score décroissant, et aucun non classé ne dépasse le dernier. Quand
+// un classé d'un classement plein passe sous les autres, la fin du classement devient
+// inconnue (nh_stale) ; elle n'est recalculée par un balayage complet que lorsque le
+// meilleur manque ou qu'un secours non classé est demandé.
+// Incremental ranking: nh_rank[0..nh_len) holds exactly the best eligible neighbors,
+// by decreasing score, and no unranked one beats the last. When a ranked neighbor of
+// a full ranking falls below the others, the end of the ranking becomes unknown
+// (nh_stale); a full scan only recomputes it when the best is missing or when an
+// unranked backup is requested.
+static dseran_nbr_idx_t nh_rank[DSERAN_NBR_RANKED];
+static dseran_score_t nh_score[DSERAN_NBR_RANKED];
+static uint8_t nh_len = 0;
+static uint8_t nh_stale = 0;
+static uint8_t nh_changed = 0;
+
+#define NH_BEST() (nh_len > 0 ? nh_rank[0] : NONE)
+
+#if DSERAN_PREDICT
+#define NBR_TTD(idx) (neighbors[idx].pred.ttd)
+#else
+#define NBR_TTD(idx) DSERAN_PRED_TTD_NONE
+#endif
+
+#if DSERAN_WATCHDOG
+// Case courante des fenêtres du chien de garde, avancée avec la roue
+// Current slot of the watchdog windows, advanced with the wheel
+static uint8_t wd_pos = 0;
+// Identifiant Cooja d'une adresse lien (octets 0 et 1) / Cooja id of a link address (bytes 0 and 1)
+#define NBR_NODE_ID(idx) (((uint16_t)neighbors[idx].addr.u8[0] << 8) | neighbors[idx].addr.u8[1])
+#endif
+
+// Compteurs (DSERAN_STATS) / Counters (DSERAN_STATS)
+static struct dseran_nbr_stats stats;
+#if DSERAN_STATS
+#define NBR_STAT(field) (stats.field++)
+#else
+#define NBR_STAT(field)
+#endif
+
+static void nh_index_update(dseran_nbr_idx_t idx);
+static void wheel_tick(void *ptr);
+#if DSERAN_WATCHDOG
+static void behavior_update(dseran_nbr_idx_t idx);
+#endif
+
+// Signale un changement du meilleur et réveille le processus propriétaire
+// Flag a best change and wake the owner process
+static void nh_mark_changed(void) {
+  nh_changed = 1;
+  if(owner_process != NULL) {
+    process_poll(owner_process);
+  }
+}
+
+// Score composite, nul si non éligible / Composite score, zero when not eligible
+// confiance * énergie < 2^31, donc >> 7 tient sur 24 bits ; la division par l'ETX (>= 1)
+// et le facteur ttd / horizon (< 1) ne peuvent que réduire / trust * energy < 2^31, so >> 7
+// fits in 24 bits; dividing by ETX (>= 1) and the ttd / horizon factor (< 1) can only
+// shrink it
+static dseran_score_t compose_score(dseran_trust_t trust, uint16_t energy, uint8_t hops,
+                                    uint16_t etx, uint16_t ttd) {
+  dseran_score_t te;
+
+  if(trust <= DSERAN_TRUST_THRESHOLD || energy <= DSERAN_ENERGY_THRESHOLD) {
+    return 0;
+  }
+#if DSERAN_PREDICT
+  // Épuisement imminent : le voisin mourrait avec la route / Imminent depletion: the
+  // neighbor would die with the route
+  if(ttd <= DSERAN_PRED_CRITICAL) {
+    return 0;
+  }
+#endif
+  te = dseran_score(trust, energy) >> 7;
+#if DSERAN_ETX_WEIGHT >= 1
+  te = te * DSERAN_ETX_DIVISOR / etx;
+#endif
+#if DSERAN_ETX_WEIGHT >= 2
+  te = te * DSERAN_ETX_DIVISOR / etx;
+#endif
+#if DSERAN_PREDICT
+  if(ttd < DSERAN_PRED_HORIZON) {
+    te = te * ttd / DSERAN_PRED_HORIZON;
+  }
+#endif
+  return ((dseran_score_t)(DSERAN_HOPS_INF - hops) << 24) | te;
+}
+
+// Score d'un voisin, nul s'il n'est pas éligible / Neighbor score, zero when not eligible
+static dseran_score_t neighbor_score(dseran_nbr_idx_t idx) {
+  if(idx == NONE || neighbors[idx].suspended) {
+    return 0;
+  }
+  return compose_score(neighbors[idx].trust, neighbors[idx].residual_energy, neighbors[idx].hops,
+                       neighbors[idx].lqe.etx, NBR_TTD(idx));
+}
+
+// Case d'origine d'une adresse / Home slot of an address
+static uint16_t hash_home(const linkaddr_t *addr) {
+  uint16_t h = 5381;
+
+  for(uint8_t i=0; i<LINKADDR_SIZE; i++) {
+    h = (uint16_t)((h << 5) + h) ^ addr->u8[i];
+  }
+  h ^= h >> 8;
+  return h & HASH_MASK;
+}
+
+// Case contenant l'adresse, ou case vide qui termine sa chaîne
+// Slot holding the address, or the empty slot ending its chain
+static uint16_t hash_slot_of(const linkaddr_t *addr) {
+  uint16_t s = hash_home(addr);
+
+  NBR_STAT(lookups);
+  while(hash_index[s] != NONE) {
+    NBR_STAT(probes);
+    if(linkaddr_cmp(&neighbors[hash_index[s]].addr, addr)) {
+      break;
+    }
+    s = (s + 1) & HASH_MASK;
+  }
+  return s;
+}
+
+// Libère une case en décalant la suite de la chaîne vers l'arrière
+// Free a slot by shifting the rest of the chain backwards
+static void hash_remove_slot(uint16_t hole) {
+  uint16_t j = hole;
+
+  for(;;) {
+    j = (j + 1) & HASH_MASK;
+    if(hash_index[j] == NONE) {
+      break;
+    }
+    uint16_t home = hash_home(&neighbors[hash_index[j]].addr);
+    // L'entrée en j peut combler le trou si sa case d'origine n'est pas dans ]hole, j]
+    // The entry at j may fill the hole if its home is not within ]hole, j]
+    uint8_t stays = (hole < j) ? (home > hole && home <= j) : (home > hole || home <= j);
+    if(!stays) {
+      hash_index[hole] = hash_index[j];
+      hole = j;
+    }
+  }
+  hash_index[hole] = NONE;
+}
+
+// Retire un voisin de sa case de la roue / Unlink a neighbor from its wheel slot
+static void wheel_unlink(dseran_nbr_idx_t idx) {
+  struct dseran_nbr *n = &neighbors[idx];
+
+  if(n->wheel_prev != NONE) {
+    neighbors[n->wheel_prev].wheel_next = n->wheel_next;
+  } else {
+    wheel_head[n->wheel_slot] = n->wheel_next;
+  }
+  if(n->wheel_next != NONE) {
+    neighbors[n->wheel_next].wheel_prev = n->wheel_prev;
+  }
+}
+
+// Chaîne un voisin dans une case ; la case courante vaut un tour complet
+// Chain a neighbor into a slot; the current slot means a full turn
+static void wheel_insert(dseran_nbr_idx_t idx, uint8_t slot) {
+  struct dseran_nbr *n = &neighbors[idx];
+
+  n->wheel_slot = slot;
+  n->wheel_prev = NONE;
+  n->wheel_next = wheel_head[slot];
+  if(n->wheel_next != NONE) {
+    neighbors[n->wheel_next].wheel_prev = idx;
+  }
+  wheel_head[slot] = idx;
+}
+
+// Rafraîchit un voisin : repousse son expiration d'un tour / Refresh a neighbor: push its expiry one turn
+static void neighbor_refresh(dseran_nbr_idx_t idx) {
+  neighbors[idx].last_seen = clock_time();
+  if(neighbors[idx].wheel_slot != wheel_pos) {
+    wheel_unlink(idx);
+    wheel_insert(idx, wheel_pos);
+  }
+}
+
+// Suppression d'un voisin en O(1) : le dernier prend sa place
+// O(1) neighbor removal: the last entry takes its place
+static void neighbor_remove(dseran_nbr_idx_t idx) {
+  dseran_nbr_idx_t last = neighbor_count - 1;
+
+  // Le voisin devient inéligible avant de quitter le classement / The neighbor becomes
+  // ineligible before leaving the ranking
+  neighbors[idx].trust = 0;
+  nh_index_update(idx);
+  wheel_unlink(idx);
+  hash_remove_slot(hash_slot_of(&neighbors[idx].addr));
+
+  if(idx != last) {
+    struct dseran_nbr *n = &neighbors[idx];
+
+    hash_index[hash_slot_of(&neighbors[last].addr)] = idx;
+    memcpy(n, &neighbors[last], sizeof(struct dseran_nbr));
+    if(n->wheel_prev != NONE) {
+      neighbors[n->wheel_prev].wheel_next = idx;
+    } else {
+      wheel_head[n->wheel_slot] = idx;
+    }
+    if(n->wheel_next != NONE) {
+      neighbors[n->wheel_next].wheel_prev = idx;
+    }
+    for(uint8_t r=0; r<nh_len; r++) {
+      if(nh_rank[r] == last) {
+        nh_rank[r] = idx;
+      }
+    }
+  }
+  neighbor_count--;
+  stats.leaves++;
+}
+
+// Avance de la roue : expire uniquement la case atteinte / Wheel advance: expire only the reached slot
+static void wheel_tick(void *ptr) {
+  wheel_pos = (wheel_pos + 1) % DSERAN_WHEEL_SLOTS;
+
+#if DSERAN_WATCHDOG
+  // Décroissance : la plus ancienne case de chaque fenêtre est vidée
+  // Decay: the oldest slot of every window is emptied
+  wd_pos = (wd_pos + 1) % DSERAN_WD_SLOTS;
+  for(dseran_nbr_idx_t i=0; i<neighbor_count; i++) {
+    if(dseran_behavior_rotate(&neighbors[i].wd, wd_pos)) {
+      behavior_update(i);
+    }
+  }
+#endif
+
+  // Le propriétaire est prévenu des départs / The owner is told about departures
+  if(wheel_head[wheel_pos] != NONE) {
+    process_poll(owner_process);
+  }
+  while(wheel_head[wheel_pos] != NONE) {
+    dseran_nbr_idx_t idx = wheel_head[wheel_pos];
+
+    LOG_INFO("NBR_EXPIRE %u %lu\n", neighbors[idx].addr.u8[0], clock_time());
+    NBR_PRINTF("D-SERAN: Voisin %02x:%02x expiré (silence > %lu s)\n",
+               neighbors[idx].addr.u8[0], neighbors[idx].addr.u8[1],
+               (unsigned long)(DSERAN_ROUTE_TIMEOUT / CLOCK_SECOND));
+    neighbor_remove(idx);
+  }
+  ctimer_reset(&wheel_timer);
+}
+
+// Choix de la victime quand la table est pleine : plus faible score, puis plus ancienne
+// Victim choice when the table is full: lowest score, then stalest
+static dseran_nbr_idx_t select_victim(void) {
+  dseran_nbr_idx_t victim = 0;
+  dseran_score_t victim_score = neighbor_score(0);
+
+  for(dseran_nbr_idx_t i=1; i<neighbor_count; i++) {
+    dseran_score_t score = neighbor_score(i);
+    if(score < victim_score ||
+       (score == victim_score && neighbors[i].last_seen < neighbors[victim].last_seen)) {
+      victim = i;
+      victim_score = score;
+    }
+  }
+  return victim;
+}
+
+// Insère idx au rang pos ; le dernier sort d'un classement plein
+// Insert idx at rank pos; the last one leaves a full ranking
+static void nh_rank_insert(uint8_t pos, dseran_nbr_idx_t idx, dseran_score_t score) {
+  uint8_t r = nh_len < DSERAN_NBR_RANKED ? nh_len++ : DSERAN_NBR_RANKED - 1;
+
+  for(; r > pos; r--) {
+    nh_rank[r] = nh_rank[r - 1];
+    nh_score[r] = nh_score[r - 1];
+  }
+  nh_rank[pos] = idx;
+  nh_score[pos] = score;
+}
+
+// Rang où score s'insère après les égaux / Rank where score goes, after equal ones
+static uint8_t nh_rank_position(dseran_score_t score) {
+  uint8_t pos = nh_len;
+
+  while(pos > 0 && score > nh_score[pos - 1]) {
+    pos--;
+  }
+  return pos;
+}
+
+// Balayage complet de la table (repli) / Full table scan (fallback)
+static void nh_index_rescan(void) {
+  dseran_nbr_idx_t old_best = NH_BEST();
+
+  NBR_STAT(scans);
+  nh_len = 0;
+  nh_stale = 0;
+
+  // Évaluation de tous les voisins / Evaluate all neighbors
+  for(dseran_nbr_idx_t i=0; i<neighbor_count; i++) {
+    // Un candidat valide a toujours un score > 0 / A valid candidate always scores > 0
+    dseran_score_t score = neighbor_score(i);
+    uint8_t pos = nh_rank_position(score);
+    if(score > 0 && pos < DSERAN_NBR_RANKED) {
+      nh_rank_insert(pos, i, score);
+    }
+  }
+  if(NH_BEST() != old_best) {
+    nh_mark_changed();
+  }
+}
+
+// Mise à jour du classement après modification du voisin idx / Ranking update after neighbor idx changed
+static void nh_index_update(dseran_nbr_idx_t idx) {
+  dseran_score_t score = neighbor_score(idx);
+  dseran_nbr_idx_t old_best = NH_BEST();
+  uint8_t pos;
+
+  NBR_STAT(updates);
+
+  // idx quitte son rang : les autres classés restent exacts
+  // idx leaves its rank: the other ranked neighbors stay exact
+  for(pos=0; pos<nh_len; pos++) {
+    if(nh_rank[pos] == idx) {
+      // Cas courant : le nouveau score garde la même place / Common case: the new score keeps the same place
+      if(score > 0 && (pos == 0 || score <= nh_score[pos - 1]) &&
+         (pos + 1 < nh_len ? score >= nh_score[pos + 1] :
+          score >= nh_score[pos] || (!nh_stale && nh_len < DSERAN_NBR_RANKED))) {
+        nh_score[pos] = score;
+        return;
+      }
+      // Un classement plein perd sa dernière place connue / A full ranking loses its last known place
+      if(nh_len == DSERAN_NBR_RANKED) {
+        nh_stale = 1;
+      }
+      nh_len--;
+      for(; pos<nh_len; pos++) {
+        nh_rank[pos] = nh_rank[pos + 1];
+        nh_score[pos] = nh_score[pos + 1];
+      }
+      break;
+    }
+  }
+
+  if(score > 0) {
+    pos = nh_rank_position(score);
+    if(pos < nh_len) {
+      // idx dépasse un classé : un classement ainsi rempli redevient exact
+      // idx beats a ranked neighbor: a ranking filled that way is exact again
+      nh_rank_insert(pos, idx, score);
+      if(nh_len == DSERAN_NBR_RANKED) {
+        nh_stale = 0;
+      }
+    } else if(!nh_stale && nh_len < DSERAN_NBR_RANKED) {
+      // Classement non plein : aucun autre voisin éligible n'attend
+      // Ranking not full: no other eligible neighbor is waiting
+      nh_rank_insert(pos, idx, score);
+    }
+  }
+  // Le meilleur reste toujours exact / The best always stays exact
+  if(nh_stale && nh_len == 0) {
+    nh_index_rescan();
+  }
+  if(NH_BEST() != old_best) {
+    nh_mark_changed();
+  }
+}
+
+void dseran_nbr_init(struct process *owner) {
+  neighbor_count = 0;
+  nh_len = 0;
+  nh_stale = 0;
+  nh_changed = 0;
+  memset(&stats, 0, sizeof(stats));
+
+  // Index et roue vides / Empty index and wheel
+  memset(hash_index, 0xff, sizeof(hash_index));
+  memset(wheel_head, 0xff, sizeof(wheel_head));
+  wheel_pos = 0;
+#if DSERAN_WATCHDOG
+  wd_pos = 0;
+#endif
+  owner_process = owner;
+  ctimer_set(&wheel_timer, DSERAN_WHEEL_TICK, wheel_tick, NULL);
+
+  // Rapport d'occupation mémoire / Memory footprint report
+  LOG_INFO("NBR_RAM %u %u %u\n", (unsigned)DSERAN_MAX_NEIGHBORS,
+           (unsigned)DSERAN_NBR_RAM_PER_ENTRY,
+           (unsigned)(sizeof(neighbors) + sizeof(hash_index) + sizeof(wheel_head)));
+}
+
+struct dseran_nbr *dseran_nbr_lookup(const linkaddr_t *addr) {
+  dseran_nbr_idx_t idx = hash_index[hash_slot_of(addr)];
+
+  return idx == NONE ? NULL : &neighbors[idx];
+}
+
+struct dseran_nbr *dseran_nbr_add_or_update(const linkaddr_t *addr, uint16_t energy,
+                                            dseran_trust_t trust, uint8_t hops, uint8_t seq) {
+  uint16_t slot = hash_slot_of(addr);
+  dseran_nbr_idx_t idx = hash_index[slot];
+
+  if(idx != NONE) {
+    // Mise à jour des informations existantes / Update existing information
+    neighbors[idx].residual_energy = energy;
+#if !DSERAN_WATCHDOG
+    neighbors[idx].trust = trust;
+#endif
+    neighbors[idx].hops = hops;
+    neighbors[idx].suspended = 0;   // le hello prouve le lien / the hello proves the link
+    dseran_lqe_hello(&neighbors[idx].lqe, seq);
+#if DSERAN_PREDICT
+    dseran_pred_sample(&neighbors[idx].pred, energy, clock_time());
+#endif
+    neighbor_refresh(idx);
+    nh_index_update(idx);
+
+    // Trace de débogage / Debug trace
+    NBR_PRINTF("D-SERAN: Voisin %02x:%02x mis à jour, énergie: %u, confiance: %u%%\n",
+               addr->u8[0], addr->u8[1], energy, DSERAN_Q_TO_CENT(neighbors[idx].trust));
+    return &neighbors[idx];
+  }
+
+#if DSERAN_WATCHDOG
+  // Aucune preuve encore : l'a priori / No evidence yet: the prior
+  trust = DSERAN_WD_INIT_TRUST;
+#endif
+
+  // Table pleine : éviction si le nouveau venu vaut mieux que la victime ou si
+  // celle-ci est à moitié expirée / Full table: evict when the newcomer beats the
+  // victim or when the victim is half expired
+  if(neighbor_count >= DSERAN_MAX_NEIGHBORS) {
+    dseran_nbr_idx_t victim = select_victim();
+
+    if(compose_score(trust, energy, hops, DSERAN_ETX_INIT, DSERAN_PRED_TTD_NONE) <= neighbor_score(victim) &&
+       clock_time() - neighbors[victim].last_seen < DSERAN_ROUTE_TIMEOUT / 2) {
+      NBR_PRINTF("D-SERAN: Impossible d'ajouter le voisin %02x:%02x, table pleine\n",
+                 addr->u8[0], addr->u8[1]);
+      return NULL;
+    }
+    LOG_INFO("NBR_EVICT %u %lu\n", neighbors[victim].addr.u8[0], clock_time());
+    neighbor_remove(victim);
+    // L'éviction a pu décaler la chaîne / The eviction may have shifted the chain
+    slot = hash_slot_of(addr);
+  }
+
+  // Ajout d'un nouveau voisin / Add new neighbor
+  idx = neighbor_count++;
+  hash_index[slot] = idx;
+  linkaddr_copy(&neighbors[idx].addr, addr);
+  neighbors[idx].residual_energy = energy;
+  neighbors[idx].trust = trust;
+  neighbors[idx].hops = hops;
+  neighbors[idx].tx_fail = 0;
+  neighbors[idx].suspended = 0;
+  dseran_lqe_init(&neighbors[idx].lqe, seq);
+#if DSERAN_PREDICT
+  dseran_pred_init(&neighbors[idx].pred, energy, clock_time());
+#endif
+#if DSERAN_WATCHDOG
+  dseran_behavior_init(&neighbors[idx].wd);
+#endif
+  neighbors[idx].last_seen = clock_time();
+  wheel_insert(idx, wheel_pos);
+  nh_index_update(idx);
+  stats.joins++;
+
+  NBR_PRINTF("D-SERAN: Nouveau voisin ajouté: %02x:%02x (total: %u)\n",
+             addr->u8[0], addr->u8[1], (unsigned)neighbor_count);
+  return &neighbors[idx];
+}
+
+void dseran_nbr_update_trust(struct dseran_nbr *n, dseran_dtrust_t delta) {
+  // Addition saturante entre 0 et 1 / Saturating addition between 0 and 1
+  n->trust = dseran_trust_add_sat(n->trust, delta);
+  nh_index_update(n - neighbors);
+}
+
+#if DSERAN_WATCHDOG
+// Confiance recalculée depuis la fenêtre ; le passage sous le seuil est une détection
+// Trust recomputed from the window; falling below the threshold is a detection
+static void behavior_update(dseran_nbr_idx_t idx) {
+  struct dseran_nbr *n = &neighbors[idx];
+  dseran_trust_t trust = dseran_behavior_trust(&n->wd);
+
+  if(trust == n->trust) {
+    return;
+  }
+  if(trust <= DSERAN_TRUST_THRESHOLD && n->trust > DSERAN_TRUST_THRESHOLD) {
+    struct dseran_behavior_sum sum;
+
+    dseran_behavior_sum(&n->wd, &sum);
+    DSERAN_TRACE4(DSERAN_EV_DETECT, NBR_NODE_ID(idx), sum.expected, sum.forwarded, sum.dropped);
+    NBR_PRINTF("D-SERAN: Voisin %02x:%02x suspect, %u relais / %u pertes\n",
+               n->addr.u8[0], n->addr.u8[1], sum.forwarded, sum.dropped);
+  }
+  n->trust = trust;
+  nh_index_update(idx);
+}
+
+void dseran_nbr_expect(struct dseran_nbr *n) {
+  dseran_behavior_count(&n->wd.expected[wd_pos]);
+}
+
+void dseran_nbr_observe(struct dseran_nbr *n, uint8_t forwarded) {
+  dseran_behavior_count(forwarded ? &n->wd.forwarded[wd_pos] : &n->wd.dropped[wd_pos]);
+  behavior_update(n - neighbors);
+}
+#endif
+
+void dseran_nbr_link_tx(struct dseran_nbr *n, uint8_t acked, uint8_t numtx) {
+  dseran_lqe_tx(&n->lqe, acked, numtx);
+  nh_index_update(n - neighbors);
+}
+
+void dseran_nbr_remove(struct dseran_nbr *n) {
+  neighbor_remove(n - neighbors);
+}
+
+void dseran_nbr_set_validity(struct dseran_nbr *n, clock_time_t validity) {
+  clock_time_t ticks = validity / DSERAN_WHEEL_TICK;
+  uint8_t left = (n->wheel_slot + DSERAN_WHEEL_SLOTS - wheel_pos) % DSERAN_WHEEL_SLOTS;
+
+  // Ticks restants avant expiration, au moins jusqu'au prochain
+  // Ticks left before expiry, at least until the next one
+  if(left == 0) {
+    left = DSERAN_WHEEL_SLOTS;
+  }
+  if(ticks == 0) {
+    ticks = 1;
+  }
+  if(ticks < left) {
+    wheel_unlink(n - neighbors);
+    wheel_insert(n - neighbors, (wheel_pos + ticks) % DSERAN_WHEEL_SLOTS);
+  }
+}
+
+void dseran_nbr_suspend(struct dseran_nbr *n) {
+  if(!n->suspended) {
+    n->suspended = 1;
+    nh_index_update(n - neighbors);
+  }
+}
+
+const struct dseran_nbr *dseran_nbr_best(void) {
+  NBR_STAT(queries);
+  return nh_len == 0 ? NULL : &neighbors[nh_rank[0]];
+}
+
+const struct dseran_nbr *dseran_nbr_backup(uint8_t i) {
+  if(i >= nh_len && nh_stale) {
+    nh_index_rescan();
+  }
+  return i < nh_len ? &neighbors[nh_rank[i]] : NULL;
+}
+
+dseran_score_t dseran_nbr_best_score(void) {
+  return nh_len == 0 ? 0 : nh_score[0];
+}
+
+dseran_nbr_idx_t dseran_nbr_best_index(void) {
+  return NH_BEST();
+}
+
+uint8_t dseran_nbr_best_changed(void) {
+  uint8_t changed = nh_changed;
+
+  nh_changed = 0;
+  return changed;
+}
+
+dseran_nbr_idx_t dseran_nbr_count(void) {
+  return neighbor_count;
+}
+
+const struct dseran_nbr_stats *dseran_nbr_get_stats(void) {
+  return &stats;
+}
@@ -0,0 +1,210 @@
+/*
+ * dseran-nbr.h : Table des voisins D-SERAN (index haché, expiration, meilleur saut)
+ * D-SERAN neighbor table (hashed index, expiry, best next hop)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Table à capacité configurable, indexée par une table de hachage à adressage
+ * ouvert sur l'adresse lien : une seule recherche par hello.
+ * Configurable-capacity table indexed by an open-addressed hash on the link
+ * address: a single lookup per hello.
+ * Accélération par hello (bench-hello) face à une table linéaire faisant le
+ * même travail (qualité du lien, prédiction, classement) : 0,93x à 8
+ * entrées, 0,97x à 16, 1,25x à 32, 1,7x à 64, 3,1x à 256. / Speedup per
+ * hello (bench-hello) against a linear table doing the same work (link
+ * quality, prediction, ranking): 0.93x at 8 entries, 0.97x at 16, 1.25x at
+ * 32, 1.7x at 64, 3.1x at 256.
+ */
+
+#ifndef DSERAN_NBR_H_
+#define DSERAN_NBR_H_
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+#include "dseran-fixed.h"
+#include "dseran-lqe.h"
+#include "dseran-pred.h"
+#include "dseran-behavior.h"
+
+// Capacité de la table (surchargeable dans project-conf.h) / Table capacity (overridable in project-conf.h)
+#ifdef DSERAN_CONF_MAX_NEIGHBORS
+#define DSERAN_MAX_NEIGHBORS DSERAN_CONF_MAX_NEIGHBORS
+#else
+#define DSERAN_MAX_NEIGHBORS 16
+#endif
+
+// Indices sur 8 bits tant que la capacité le permet / 8-bit indices while capacity allows
+#if DSERAN_MAX_NEIGHBORS < 255
+typedef uint8_t dseran_nbr_idx_t;
+#define DSERAN_NBR_NONE 0xff
+#else
+typedef uint16_t dseran_nbr_idx_t;
+#define DSERAN_NBR_NONE 0xffff
+#endif
+
+// Taille de la table de hachage : puissance de 2, facteur de charge <= 1/2
+// Hash table size: power of two, load factor <= 1/2
+#if DSERAN_MAX_NEIGHBORS <= 8
+#define DSERAN_NBR_HASH_SIZE 16
+#elif DSERAN_MAX_NEIGHBORS <= 16
+#define DSERAN_NBR_HASH_SIZE 32
+#elif DSERAN_MAX_NEIGHBORS <= 32
+#define DSERAN_NBR_HASH_SIZE 64
+#elif DSERAN_MAX_NEIGHBORS <= 64
+#define DSERAN_NBR_HASH_SIZE 128
+#elif DSERAN_MAX_NEIGHBORS <= 128
+#define DSERAN_NBR_HASH_SIZE 256
+#elif DSERAN_MAX_NEIGHBORS <= 256
+#define DSERAN_NBR_HASH_SIZE 512
+#else
+#error "DSERAN_CONF_MAX_NEIGHBORS trop grand / too large (max 256)"
+#endif
+
+// Seuils d'éligibilité / Eligibility thresholds
+#ifdef DSERAN_CONF_ENERGY_THRESHOLD
+#define DSERAN_ENERGY_THRESHOLD DSERAN_CONF_ENERGY_THRESHOLD   // mJ
+#else
+#define DSERAN_ENERGY_THRESHOLD 10                 // mJ
+#endif
+#define DSERAN_TRUST_THRESHOLD  DSERAN_Q(0.5)      // Q1.15
+
+// Distance au puits / Distance to the sink
+#define DSERAN_HOPS_INF 0xff    // pas de route vers le puits / no route to the sink
+#define DSERAN_MAX_HOPS 32      // au-delà, la route est considérée perdue / beyond, the route is lost
+
+// Poids de l'ETX dans le score : 0 l'ignore, 1 divise par l'ETX, 2 par son carré
+// (les hellos ne mesurent qu'un sens du lien) / ETX weight in the score: 0 ignores it,
+// 1 divides by ETX, 2 by its square (hellos only measure one link direction)
+#ifdef DSERAN_CONF_ETX_WEIGHT
+#define DSERAN_ETX_WEIGHT DSERAN_CONF_ETX_WEIGHT
+#else
+#define DSERAN_ETX_WEIGHT 2
+#endif
+
+// Score composite : couche de distance dans l'octet de poids fort, puis confiance * énergie
+// / ETX^poids sur 24 bits, réduit près de l'épuisement prévu. Un voisin plus proche du puits
+// l'emporte toujours, ce qui limite les boucles sans les exclure : une distance annoncée peut
+// être périmée (d-seran.c rompt alors la boucle, cause REPAIR 4). / Composite score: distance
+// layer in the top byte, then trust * energy / ETX^weight on 24 bits, reduced near the
+// predicted depletion. A neighbor closer to the sink always wins, which limits loops without
+// ruling them out: an advertised distance may be stale (d-seran.c then breaks the loop,
+// REPAIR cause 4).
+#define DSERAN_NBR_SCORE_HOPS(s) (DSERAN_HOPS_INF - (uint8_t)((s) >> 24))
+#define DSERAN_NBR_SCORE_TE(s)   ((s) & 0xffffffUL)
+
+// Voisins de secours classés derrière le meilleur, prêts pour une bascule immédiate
+// Backup neighbors ranked behind the best one, ready for an immediate failover
+#ifdef DSERAN_CONF_BACKUP_HOPS
+#define DSERAN_BACKUP_HOPS DSERAN_CONF_BACKUP_HOPS
+#else
+#define DSERAN_BACKUP_HOPS 2
+#endif
+#define DSERAN_NBR_RANKED (1 + DSERAN_BACKUP_HOPS)
+
+// Durée de validité d'un voisin et roue d'expiration / Neighbor validity and expiry wheel
+#ifdef DSERAN_CONF_ROUTE_TIMEOUT
+#define DSERAN_ROUTE_TIMEOUT DSERAN_CONF_ROUTE_TIMEOUT
+#else
+#define DSERAN_ROUTE_TIMEOUT (CLOCK_SECOND * 30)
+#endif
+#define DSERAN_WHEEL_SLOTS 8
+#define DSERAN_WHEEL_TICK (DSERAN_ROUTE_TIMEOUT / DSERAN_WHEEL_SLOTS)
+
+// Entrée de la table / Table entry
+struct dseran_nbr {
+  linkaddr_t addr;
+  dseran_trust_t trust;
+  uint16_t residual_energy;
+  clock_time_t last_seen;
+  uint8_t hops;         // distance annoncée au puits / advertised distance to the sink
+  uint8_t tx_fail;      // échecs MAC consécutifs / consecutive MAC failures
+  uint8_t suspended;    // lien suspect, inéligible jusqu'au prochain hello / suspect link, ineligible until the next hello
+  struct dseran_lqe lqe; // qualité du lien / link quality
+#if DSERAN_PREDICT
+  struct dseran_pred pred; // épuisement prévu / predicted depletion
+#endif
+#if DSERAN_WATCHDOG
+  struct dseran_behavior wd; // relais observés, d'où la confiance / observed forwards, hence the trust
+#endif
+  dseran_nbr_idx_t wheel_prev;   // chaînage dans la case de la roue / chaining in the wheel slot
+  dseran_nbr_idx_t wheel_next;
+  uint8_t wheel_slot;
+};
+
+// Octets de RAM par entrée, index haché compris / RAM bytes per entry, hash index included
+#define DSERAN_NBR_RAM_PER_ENTRY \
+  (sizeof(struct dseran_nbr) + \
+   (DSERAN_NBR_HASH_SIZE * sizeof(dseran_nbr_idx_t)) / DSERAN_MAX_NEIGHBORS)
+
+// Compteurs de performance de l'index (profil minimal : 0) ; joins et leaves sont
+// toujours tenus, ils pilotent Trickle / Index performance counters (minimal
+// profile: 0); joins and leaves are always kept, they drive Trickle
+#ifdef DSERAN_CONF_STATS
+#define DSERAN_STATS DSERAN_CONF_STATS
+#else
+#define DSERAN_STATS 1
+#endif
+
+// Compteurs de l'index du meilleur saut / Best next hop index counters
+struct dseran_nbr_stats {
+  uint32_t queries;   // demandes de next hop / next hop requests
+  uint32_t updates;   // mises à jour incrémentales / incremental updates
+  uint32_t scans;     // balayages complets / full table scans
+  uint32_t probes;    // sondages de la table de hachage / hash table probes
+  uint32_t lookups;   // recherches par adresse / address lookups
+  uint32_t joins;     // voisins ajoutés / neighbors added
+  uint32_t leaves;    // voisins retirés (expiration, éviction, lien rompu) / neighbors removed (expiry, eviction, broken link)
+};
+
+void dseran_nbr_init(struct process *owner);
+
+// Recherche unique : mise à jour ou insertion (éviction si pleine), NULL si refusé ;
+// avec le chien de garde, trust est ignoré et un nouveau voisin part de l'a priori
+// Single lookup: update or insert (eviction when full), NULL when refused; with the
+// watchdog, trust is ignored and a new neighbor starts from the prior
+struct dseran_nbr *dseran_nbr_add_or_update(const linkaddr_t *addr, uint16_t energy,
+                                            dseran_trust_t trust, uint8_t hops, uint8_t seq);
+struct dseran_nbr *dseran_nbr_lookup(const linkaddr_t *addr);
+void dseran_nbr_update_trust(struct dseran_nbr *n, dseran_dtrust_t delta);
+
+#if DSERAN_WATCHDOG
+// Preuves du chien de garde : la confiance ne suit plus les hellos mais la fenêtre
+// de n ; une donnée lui est confiée (expect), puis relayée ou perdue (observe)
+// Watchdog evidence: trust no longer follows the hellos but the window of n; a
+// data frame is handed to it (expect), then forwarded or dropped (observe)
+void dseran_nbr_expect(struct dseran_nbr *n);
+void dseran_nbr_observe(struct dseran_nbr *n, uint8_t forwarded);
+#endif
+
+// Retour MAC d'un envoi unicast vers n (ETX) / MAC feedback of a unicast send to n (ETX)
+void dseran_nbr_link_tx(struct dseran_nbr *n, uint8_t acked, uint8_t numtx);
+
+// Expiration avancée à validity, arrondie au tick de la roue, jamais repoussée ;
+// le prochain hello rend la validité complète / Expiry brought forward to validity,
+// rounded to the wheel tick, never pushed back; the next hello restores full validity
+void dseran_nbr_set_validity(struct dseran_nbr *n, clock_time_t validity);
+
+// Retrait immédiat (lien rompu) / Immediate removal (broken link)
+void dseran_nbr_remove(struct dseran_nbr *n);
+
+// Lien suspect (échec MAC, hello manqué) : le premier secours prend la tête en O(1)
+// Suspect link (MAC failure, missed hello): the first backup takes the lead in O(1)
+void dseran_nbr_suspend(struct dseran_nbr *n);
+
+// Meilleur voisin en O(1), NULL si aucun / Best neighbor in O(1), NULL if none
+const struct dseran_nbr *dseran_nbr_best(void);
+
+// i-ème secours (1..DSERAN_BACKUP_HOPS) derrière le meilleur, NULL si aucun
+// i-th backup (1..DSERAN_BACKUP_HOPS) behind the best, NULL if none
+const struct dseran_nbr *dseran_nbr_backup(uint8_t i);
+dseran_score_t dseran_nbr_best_score(void);
+dseran_nbr_idx_t dseran_nbr_best_index(void);
+
+// Vrai une fois après chaque changement du meilleur / True once after each best change
+uint8_t dseran_nbr_best_changed(void);
+
+dseran_nbr_idx_t dseran_nbr_count(void);
+const struct dseran_nbr_stats *dseran_nbr_get_stats(void);
+
+#endif /* DSERAN_NBR_H_ */
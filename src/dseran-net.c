@@ -0,0 +1,76 @@
+/*
+ * dseran-net.c : Adresses et crochets de routage communs aux pilotes
+ * Addresses and routing hooks shared by the drivers
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ */
+
+#include "contiki.h"
+#include "dseran-net.h"
+#include <string.h>
+
+void dseran_net_lladdr_from_ipaddr(linkaddr_t *ll, const uip_ipaddr_t *ip) {
+#if LINKADDR_SIZE == 8
+  memcpy(ll, &ip->u8[8], LINKADDR_SIZE);
+  ll->u8[0] ^= 0x02;
+#else
+  memcpy(ll, &ip->u8[16 - LINKADDR_SIZE], LINKADDR_SIZE);
+#endif
+}
+
+void dseran_net_global_from_lladdr(uip_ipaddr_t *ip, const linkaddr_t *ll) {
+  uip_ip6addr(ip, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(ip, (uip_lladdr_t *)ll);
+}
+
+void dseran_net_nbr_ipaddr(uip_ipaddr_t *ip, const linkaddr_t *ll) {
+  uip_ip6addr(ip, 0xfe80, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(ip, (uip_lladdr_t *)ll);
+  if(uip_ds6_nbr_lookup(ip) == NULL) {
+    uip_ds6_nbr_add(ip, (const uip_lladdr_t *)ll, 1, NBR_REACHABLE, NBR_TABLE_REASON_ROUTE, NULL);
+  }
+}
+
+void dseran_net_root_set_prefix(uip_ipaddr_t *prefix, uip_ipaddr_t *iid) {
+}
+
+int dseran_net_get_sr_node_ipaddr(uip_ipaddr_t *addr, const uip_sr_node_t *node) {
+  return 0;
+}
+
+void dseran_net_leave_network(void) {
+}
+
+void dseran_net_repair(const char *str) {
+}
+
+void dseran_net_neighbor_state_changed(uip_ds6_nbr_t *nbr) {
+}
+
+void dseran_net_drop_route(uip_ds6_route_t *route) {
+}
+
+uint8_t dseran_net_is_in_leaf_mode(void) {
+  return 0;
+}
+
+bool dseran_net_ext_header_remove(void) {
+  return uip_remove_ext_hdr();
+}
+
+int dseran_net_ext_header_update(void) {
+  return 0;
+}
+
+int dseran_net_ext_header_hbh_update(uint8_t *ext_buf, int opt_offset) {
+  return 1;
+}
+
+int dseran_net_ext_header_srh_update(void) {
+  return 0;
+}
+
+int dseran_net_ext_header_srh_get_next_hop(uip_ipaddr_t *ipaddr) {
+  return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * dseran-net.h : Adresses et crochets de routage communs aux pilotes
+ * Addresses and routing hooks shared by the drivers
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * D-SERAN, AODV, DSR et OLSR dérivent leurs adresses de la même façon
+ * (fd00::IID global, fe80::IID lien-local) et laissent vides les mêmes
+ * entrées de struct routing_driver ; elles sont réunies ici.
+ * D-SERAN, AODV, DSR and OLSR derive their addresses the same way
+ * (fd00::IID global, fe80::IID link-local) and leave the same struct
+ * routing_driver entries empty; they are gathered here.
+ */
+
+#ifndef DSERAN_NET_H_
+#define DSERAN_NET_H_
+
+#include "contiki.h"
+#include "net/routing/routing.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "net/linkaddr.h"
+
+// Adresse lien déduite de l'IID, inverse de uip_ds6_set_addr_iid()
+// Link address derived from the IID, inverse of uip_ds6_set_addr_iid()
+void dseran_net_lladdr_from_ipaddr(linkaddr_t *ll, const uip_ipaddr_t *ip);
+
+// Adresse globale fd00::IID d'un nœud / Global fd00::IID address of a node
+void dseran_net_global_from_lladdr(uip_ipaddr_t *ip, const linkaddr_t *ll);
+
+// Adresse lien-local d'un voisin, ajouté au cache uIP pour éviter la résolution ND
+// Link-local address of a neighbor, added to the uIP cache to avoid ND resolution
+void dseran_net_nbr_ipaddr(uip_ipaddr_t *ip, const linkaddr_t *ll);
+
+// Entrées sans effet du pilote de routage / No-op routing driver entries
+void dseran_net_root_set_prefix(uip_ipaddr_t *prefix, uip_ipaddr_t *iid);
+int dseran_net_get_sr_node_ipaddr(uip_ipaddr_t *addr, const uip_sr_node_t *node);
+void dseran_net_leave_network(void);
+void dseran_net_repair(const char *str);
+void dseran_net_neighbor_state_changed(uip_ds6_nbr_t *nbr);
+void dseran_net_drop_route(uip_ds6_route_t *route);
+uint8_t dseran_net_is_in_leaf_mode(void);
+
+// Aucun en-tête d'extension propre aux pilotes / No driver specific extension header
+bool dseran_net_ext_header_remove(void);
+int dseran_net_ext_header_update(void);
+int dseran_net_ext_header_hbh_update(uint8_t *ext_buf, int opt_offset);
+int dseran_net_ext_header_srh_update(void);
+int dseran_net_ext_header_srh_get_next_hop(uip_ipaddr_t *ipaddr);
+
+#endif /* DSERAN_NET_H_ */
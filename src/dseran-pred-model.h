@@ -0,0 +1,20 @@
+/*
+ * dseran-pred-model.h : Poids du prédicteur d'épuisement (généré)
+ * Depletion predictor weights (generated)
+ *
+ * Généré par / Generated by scripts/pred_train.py --hist 8 --ahead 8 --period 10 --min-weight 0.5
+ * Données / Data: DATA/dseran_energy.csv, DATA/dsr_energy.csv, DATA/olsr_energy.csv
+ * 252 fenêtres / windows ; MAE int8 1.023 mJ/période / period
+ * (dernière période / last period 6.857)
+ */
+
+#ifndef DSERAN_PRED_MODEL_H_
+#define DSERAN_PRED_MODEL_H_
+
+#define DSERAN_PRED_MODEL_PERIOD_S 10     // période d'échantillonnage en s / sampling period in s
+#define DSERAN_PRED_MODEL_HIST     8      // périodes en entrée / input periods
+#define DSERAN_PRED_MODEL_SHIFT    9      // somme des poids / weight sum: 1 << SHIFT
+// Poids, de la période la plus récente à la plus ancienne / Weights, newest period to oldest
+#define DSERAN_PRED_MODEL_WEIGHTS  { 32, 57, 71, 80, 89, 83, 65, 35 }
+
+#endif /* DSERAN_PRED_MODEL_H_ */
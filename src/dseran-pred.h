@@ -0,0 +1,168 @@
+/*
+ * dseran-pred.h : Prédiction de l'épuisement des voisins (noyau int8)
+ * Neighbor depletion prediction (int8 kernel)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * L'énergie annoncée par les hellos d'un voisin est échantillonnée une fois
+ * par période du modèle ; la consommation de chaque période est rangée sur
+ * 8 bits (pas DSERAN_PRED_UNIT mJ) dans une fenêtre de DSERAN_PRED_HIST
+ * périodes. Un produit scalaire int8 x int8 avec les poids de
+ * dseran-pred-model.h (scripts/pred_train.py) prédit la consommation à
+ * venir, d'où le nombre de périodes avant épuisement. Pas de tas, pas de
+ * flottant ; l'inférence n'a lieu qu'à chaque nouvel échantillon.
+ * The energy advertised by a neighbor's hellos is sampled once per model
+ * period; the drain of each period is stored on 8 bits (DSERAN_PRED_UNIT mJ
+ * steps) in a window of DSERAN_PRED_HIST periods. An int8 x int8 dot product
+ * with the weights of dseran-pred-model.h (scripts/pred_train.py) predicts
+ * the drain ahead, hence the number of periods to depletion. No heap, no
+ * floating point; inference only runs on each new sample.
+ */
+
+#ifndef DSERAN_PRED_H_
+#define DSERAN_PRED_H_
+
+#include "contiki.h"
+#include <stdint.h>
+#include "dseran-pred-model.h"
+
+// Prédiction active (profil minimal : 0) / Prediction enabled (minimal profile: 0)
+#ifdef DSERAN_CONF_PREDICT
+#define DSERAN_PREDICT DSERAN_CONF_PREDICT
+#else
+#define DSERAN_PREDICT 1
+#endif
+
+// Pas d'entrée en mJ/période : 8 mJ couvrent jusqu'à 100 mW sur 10 s
+// Input step in mJ/period: 8 mJ cover up to 100 mW over 10 s
+#ifdef DSERAN_CONF_PRED_UNIT
+#define DSERAN_PRED_UNIT DSERAN_CONF_PRED_UNIT
+#else
+#define DSERAN_PRED_UNIT 8
+#endif
+
+// Un voisin à moins de DSERAN_PRED_HORIZON périodes de l'épuisement voit son score
+// réduit d'autant ; à DSERAN_PRED_CRITICAL ou moins, il n'est plus éligible
+// A neighbor less than DSERAN_PRED_HORIZON periods from depletion has its score
+// reduced accordingly; at DSERAN_PRED_CRITICAL or less, it is no longer eligible
+#ifdef DSERAN_CONF_PRED_HORIZON
+#define DSERAN_PRED_HORIZON DSERAN_CONF_PRED_HORIZON
+#else
+#define DSERAN_PRED_HORIZON 30
+#endif
+#ifdef DSERAN_CONF_PRED_CRITICAL
+#define DSERAN_PRED_CRITICAL DSERAN_CONF_PRED_CRITICAL
+#else
+#define DSERAN_PRED_CRITICAL 3
+#endif
+#if DSERAN_PRED_HORIZON > 255
+#error "DSERAN_CONF_PRED_HORIZON > 255 : le score sur 24 bits déborderait / the 24-bit score would overflow"
+#endif
+#if DSERAN_PRED_MODEL_SHIFT > 11
+#error "DSERAN_PRED_MODEL_SHIFT > 11 : les calculs ne tiennent plus sur 32 bits / no longer fit in 32 bits"
+#endif
+
+#define DSERAN_PRED_PERIOD   ((clock_time_t)DSERAN_PRED_MODEL_PERIOD_S * CLOCK_SECOND)
+#define DSERAN_PRED_HIST     DSERAN_PRED_MODEL_HIST
+#define DSERAN_PRED_MIN_HIST 2          // échantillons avant la première prédiction / samples before the first prediction
+#define DSERAN_PRED_TTD_NONE 0xffff     // pas d'épuisement en vue / no depletion in sight
+
+// État de prédiction d'un voisin / Per-neighbor prediction state
+struct dseran_pred {
+  int8_t drain[DSERAN_PRED_HIST];   // anneau, en DSERAN_PRED_UNIT mJ/période / ring, in DSERAN_PRED_UNIT mJ/period
+  clock_time_t last_time;           // instant du dernier échantillon / time of the last sample
+  uint16_t last_energy;             // mJ
+  uint16_t ttd;                     // périodes avant épuisement / periods to depletion
+  uint8_t pos;                      // prochaine case de l'anneau / next ring slot
+  uint8_t len;
+};
+
+static inline void
+dseran_pred_init(struct dseran_pred *p, uint16_t energy, clock_time_t now)
+{
+  for(uint8_t i=0; i<DSERAN_PRED_HIST; i++) {
+    p->drain[i] = 0;
+  }
+  p->last_time = now;
+  p->last_energy = energy;
+  p->ttd = DSERAN_PRED_TTD_NONE;
+  p->pos = 0;
+  p->len = 0;
+}
+
+// Consommation prédite en mJ/période << DSERAN_PRED_MODEL_SHIFT ; tant que la fenêtre
+// n'est pas pleine, les poids des périodes connues sont ramenés à une somme de 1
+// Predicted drain in mJ/period << DSERAN_PRED_MODEL_SHIFT; while the window is not
+// full, the weights of the known periods are scaled back to a sum of 1
+static inline int32_t
+dseran_pred_drain(const struct dseran_pred *p)
+{
+  static const int8_t w[DSERAN_PRED_HIST] = DSERAN_PRED_MODEL_WEIGHTS;
+  int32_t acc = 0;
+  int16_t wsum = 0;
+  uint8_t j = p->pos;
+
+  // De la période la plus récente à la plus ancienne / Newest period to oldest
+  for(uint8_t i=0; i<p->len; i++) {
+    j = (j == 0 ? DSERAN_PRED_HIST : j) - 1;
+    acc += (int16_t)w[i] * p->drain[j];
+    wsum += w[i];
+  }
+  if(p->len < DSERAN_PRED_HIST) {
+    if(wsum <= 0) {
+      return 0;
+    }
+    acc = acc * (1 << DSERAN_PRED_MODEL_SHIFT) / wsum;
+  }
+  return acc * DSERAN_PRED_UNIT;
+}
+
+// Périodes avant épuisement à partir de energy / Periods to depletion from energy
+static inline uint16_t
+dseran_pred_ttd(uint16_t energy, int32_t drain)
+{
+  uint32_t ttd;
+
+  if(drain <= 0) {
+    return DSERAN_PRED_TTD_NONE;
+  }
+  ttd = ((uint32_t)energy << DSERAN_PRED_MODEL_SHIFT) / (uint32_t)drain;
+  return ttd >= DSERAN_PRED_TTD_NONE ? DSERAN_PRED_TTD_NONE - 1 : (uint16_t)ttd;
+}
+
+// Énergie annoncée à l'instant now : un échantillon par période au plus, ramené à la
+// période si les hellos sont espacés ; renvoie 1 si ttd a changé / Energy advertised at
+// time now: at most one sample per period, scaled to the period when hellos are spaced
+// out; returns 1 when ttd changed
+static inline uint8_t
+dseran_pred_sample(struct dseran_pred *p, uint16_t energy, clock_time_t now)
+{
+  clock_time_t dt = now - p->last_time;
+  int32_t d;
+  uint16_t ttd;
+
+  if(dt < DSERAN_PRED_PERIOD / 2) {
+    return 0;
+  }
+  d = ((int32_t)p->last_energy - energy) * (int32_t)DSERAN_PRED_PERIOD / (int32_t)dt;
+  // Arrondi loin de zéro puis saturation, comme pred_train.py / Rounded away from zero
+  // then saturated, like pred_train.py
+  d = d >= 0 ? (d + DSERAN_PRED_UNIT / 2) / DSERAN_PRED_UNIT : -((-d + DSERAN_PRED_UNIT / 2) / DSERAN_PRED_UNIT);
+  p->drain[p->pos] = d > 127 ? 127 : (d < -128 ? -128 : (int8_t)d);
+  p->pos = (p->pos + 1) % DSERAN_PRED_HIST;
+  if(p->len < DSERAN_PRED_HIST) {
+    p->len++;
+  }
+  p->last_time = now;
+  p->last_energy = energy;
+
+  ttd = p->len < DSERAN_PRED_MIN_HIST ? DSERAN_PRED_TTD_NONE : dseran_pred_ttd(energy, dseran_pred_drain(p));
+  if(ttd == p->ttd) {
+    return 0;
+  }
+  p->ttd = ttd;
+  return 1;
+}
+
+#endif /* DSERAN_PRED_H_ */
@@ -0,0 +1,164 @@
+/*
+ * dseran-profile.h : Profils de compilation D-SERAN (minimal, production, mobile, debug)
+ * D-SERAN build profiles (minimal, production, mobile, debug)
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Le profil choisit, à la compilation, les traces, les statistiques, les
+ * journaux et les fonctions embarqués ; la cible (sky, z1, cooja, native)
+ * dimensionne les tables. Chaque valeur reste surchargeable par un
+ * DSERAN_CONF_* défini avant (DEFINES=... ou project-conf.h).
+ *   minimal    : ni traces ni statistiques, journaux d'erreur seulement,
+ *                sans mobilité, prédiction d'épuisement ni chien de garde,
+ *                un seul secours ; pour tenir à côté d'une application sur
+ *                les 10 Ko de RAM d'un sky
+ *   production : traces binaires et statistiques (comportement par défaut,
+ *                celui des simulations)
+ *   mobile     : production avec la mobilité (mobility.c, position et
+ *                vitesse dans les hellos, basculement anticipé)
+ *   debug      : traces texte, printf de débogage et journaux DBG
+ * The profile selects, at compile time, the traces, statistics, logs and
+ * features built in; the target (sky, z1, cooja, native) sizes the tables.
+ * Every value can still be overridden by a DSERAN_CONF_* defined earlier
+ * (DEFINES=... or project-conf.h).
+ *   minimal    : no traces nor statistics, error logs only, no mobility,
+ *                depletion prediction nor watchdog, a single backup; to fit
+ *                next to an application in the 10 KB of RAM of a sky
+ *   production : binary traces and statistics (default behavior, the one
+ *                of the simulations)
+ *   mobile     : production with mobility (mobility.c, position and
+ *                velocity in hellos, pre-emptive handoff)
+ *   debug      : text traces, debug printf and DBG logs
+ *
+ * Sélection / Selection : make PROFILE=minimal|production|mobile|debug
+ */
+
+#ifndef DSERAN_PROFILE_H_
+#define DSERAN_PROFILE_H_
+
+#define DSERAN_PROFILE_MINIMAL    0
+#define DSERAN_PROFILE_PRODUCTION 1
+#define DSERAN_PROFILE_DEBUG      2
+#define DSERAN_PROFILE_MOBILE     3
+
+#ifdef DSERAN_CONF_PROFILE
+#define DSERAN_PROFILE DSERAN_CONF_PROFILE
+#else
+#define DSERAN_PROFILE DSERAN_PROFILE_PRODUCTION
+#endif
+
+#if DSERAN_PROFILE == DSERAN_PROFILE_MINIMAL
+
+// mobility.c n'est pas compilé dans ce profil / mobility.c is not built in this profile
+#if defined(DSERAN_CONF_MOBILITY) && DSERAN_CONF_MOBILITY
+#error "Profil minimal sans mobilité / minimal profile without mobility"
+#endif
+#define DSERAN_CONF_MOBILITY 0
+#ifndef DSERAN_CONF_TRACE
+#define DSERAN_CONF_TRACE 0
+#endif
+#ifndef DSERAN_CONF_STATS
+#define DSERAN_CONF_STATS 0
+#endif
+#ifndef DSERAN_CONF_VERBOSE
+#define DSERAN_CONF_VERBOSE 0
+#endif
+#ifndef DSERAN_CONF_LOG_LEVEL
+#define DSERAN_CONF_LOG_LEVEL LOG_LEVEL_ERR
+#endif
+#ifndef DSERAN_CONF_BACKUP_HOPS
+#define DSERAN_CONF_BACKUP_HOPS 1
+#endif
+#ifndef DSERAN_CONF_PREDICT
+#define DSERAN_CONF_PREDICT 0
+#endif
+// dseran-watchdog.c n'est pas compilé dans ce profil / dseran-watchdog.c is not built in this profile
+#if (defined(DSERAN_CONF_WATCHDOG) && DSERAN_CONF_WATCHDOG) || (defined(DSERAN_CONF_ATTACK) && DSERAN_CONF_ATTACK)
+#error "Profil minimal sans chien de garde ni attaque / minimal profile without watchdog nor attack"
+#endif
+#define DSERAN_CONF_WATCHDOG 0
+#define DSERAN_STACK_LOG_LEVEL LOG_LEVEL_NONE
+
+#elif DSERAN_PROFILE == DSERAN_PROFILE_DEBUG
+
+#ifndef DSERAN_CONF_TRACE_BINARY
+#define DSERAN_CONF_TRACE_BINARY 0
+#endif
+#ifndef DSERAN_CONF_VERBOSE
+#define DSERAN_CONF_VERBOSE 1
+#endif
+#ifndef DSERAN_NBR_CONF_VERBOSE
+#define DSERAN_NBR_CONF_VERBOSE 1
+#endif
+#ifndef DSERAN_CONF_LOG_LEVEL
+#define DSERAN_CONF_LOG_LEVEL LOG_LEVEL_DBG
+#endif
+#define DSERAN_STACK_LOG_LEVEL LOG_LEVEL_WARN
+
+#elif DSERAN_PROFILE == DSERAN_PROFILE_MOBILE
+
+#ifndef DSERAN_CONF_MOBILITY
+#define DSERAN_CONF_MOBILITY 1
+#endif
+#define DSERAN_STACK_LOG_LEVEL LOG_LEVEL_WARN
+
+#else /* production */
+
+#define DSERAN_STACK_LOG_LEVEL LOG_LEVEL_WARN
+
+#endif /* DSERAN_PROFILE */
+
+// Tables par cible : voisins D-SERAN, voisins uIP, tampons, routes, traces
+// Per-target tables: D-SERAN neighbors, uIP neighbors, buffers, routes, traces
+#if defined(CONTIKI_TARGET_SKY) || defined(CONTIKI_TARGET_Z1)
+// 10 Ko (sky) ou 8 Ko (z1) de RAM ; seule la route par défaut est installée
+// 10 KB (sky) or 8 KB (z1) of RAM; only the default route is installed
+#ifndef DSERAN_CONF_MAX_NEIGHBORS
+#define DSERAN_CONF_MAX_NEIGHBORS (DSERAN_PROFILE == DSERAN_PROFILE_MINIMAL ? 6 : 8)
+#endif
+#ifndef NBR_TABLE_CONF_MAX_NEIGHBORS
+#define NBR_TABLE_CONF_MAX_NEIGHBORS 6
+#endif
+#ifndef QUEUEBUF_CONF_NUM
+#define QUEUEBUF_CONF_NUM            4
+#endif
+#ifndef UIP_CONF_MAX_ROUTES
+#define UIP_CONF_MAX_ROUTES          2
+#endif
+#ifndef DSERAN_CONF_TRACE_BUF_SIZE
+#define DSERAN_CONF_TRACE_BUF_SIZE   48
+#endif
+// cc2420 : l'acquittement automatique exige le filtrage d'adresse, pas d'écoute des relais
+// cc2420: auto-ack requires address filtering, no relay overhearing
+#ifndef DSERAN_CONF_WATCHDOG
+#define DSERAN_CONF_WATCHDOG         0
+#endif
+#endif /* CONTIKI_TARGET_SKY || CONTIKI_TARGET_Z1 */
+
+// TSCH : pas d'écoute hors des cases de l'ordonnancement, dseran-watchdog.c n'est pas compilé
+// TSCH: no listening outside the scheduled cells, dseran-watchdog.c is not built
+#if defined(DSERAN_CONF_TSCH) && DSERAN_CONF_TSCH
+#if (defined(DSERAN_CONF_WATCHDOG) && DSERAN_CONF_WATCHDOG) || (defined(DSERAN_CONF_ATTACK) && DSERAN_CONF_ATTACK)
+#error "TSCH sans chien de garde ni attaque / TSCH without watchdog nor attack"
+#endif
+#ifndef DSERAN_CONF_WATCHDOG
+#define DSERAN_CONF_WATCHDOG 0
+#endif
+#if defined(CONTIKI_TARGET_SKY) || defined(CONTIKI_TARGET_Z1)
+#ifndef TSCH_QUEUE_CONF_NUM_PER_NEIGHBOR
+#define TSCH_QUEUE_CONF_NUM_PER_NEIGHBOR 4
+#endif
+#endif
+#endif
+
+// Chien de garde et attaque, lus par project-conf.h pour le choix du pilote MAC
+// Watchdog and attack, read by project-conf.h to pick the MAC driver
+#ifndef DSERAN_CONF_WATCHDOG
+#define DSERAN_CONF_WATCHDOG 1
+#endif
+#ifndef DSERAN_CONF_ATTACK
+#define DSERAN_CONF_ATTACK 0
+#endif
+
+#endif /* DSERAN_PROFILE_H_ */
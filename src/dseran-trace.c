@@ -0,0 +1,179 @@
+/*
+ * dseran-trace.c : Traces binaires compactes pour D-SERAN
+ * Compact binary traces for D-SERAN
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Les enregistrements sont accumulés dans un tampon en RAM et écrits en
+ * hexadécimal, un lot par ligne, quand le tampon est plein, quand l'écart de
+ * temps ne tient plus sur 16 bits ou à l'échéance du vidage périodique.
+ * Records are buffered in RAM and written in hex, one batch per line, when
+ * the buffer is full, when the time delta no longer fits in 16 bits, or when
+ * the periodic flush fires.
+ */
+
+#include "contiki.h"
+#include "sys/log.h"
+#include "dseran-trace.h"
+#include <stdio.h>
+
+#define LOG_MODULE "D-SERAN"
+// Niveau fixe : ces journaux sont les traces, que DSERAN_CONF_TRACE désactive
+// Fixed level: these logs are the traces, which DSERAN_CONF_TRACE disables
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+// Module vide sans traces (profil minimal) / Empty module without traces (minimal profile)
+#if DSERAN_TRACE
+
+// Sortie caractère par caractère, surchargeable pour les bancs d'essai
+// Character output, overridable for benchmarks
+#ifdef DSERAN_TRACE_CONF_PUTCHAR
+#define TRACE_PUTCHAR DSERAN_TRACE_CONF_PUTCHAR
+int TRACE_PUTCHAR(int c);
+#else
+#define TRACE_PUTCHAR putchar
+#endif
+
+// Description d'un événement / Event description
+struct trace_event {
+  const char *name;
+  uint8_t nargs;
+  uint8_t with_time;   // horodatage ajouté au texte / timestamp appended to the text
+};
+
+// Indexé par identifiant, mêmes formats que les anciens LOG_INFO
+// Indexed by identifier, same formats as the previous LOG_INFO records
+static const struct trace_event events[DSERAN_EV_COUNT] = {
+  [DSERAN_EV_ENERGY]          = { "ENERGY", 2, 0 },
+  [DSERAN_EV_SEND_UDP]        = { "SEND_UDP", 1, 1 },
+  [DSERAN_EV_RECV]            = { "RECV", 1, 1 },
+  [DSERAN_EV_HOP]             = { "HOP", 1, 1 },
+  [DSERAN_EV_MOVE]            = { "MOVE", 2, 1 },
+  [DSERAN_EV_LIFETIME]        = { "LIFETIME", 1, 1 },
+  [DSERAN_EV_DATA_TX]         = { "DATA_TX", 2, 1 },
+  [DSERAN_EV_DATA_RX]         = { "DATA_RX", 4, 0 },
+  [DSERAN_EV_LOCAL_REPAIR]    = { "LOCAL_REPAIR", 1, 1 },
+  [DSERAN_EV_POS]             = { "POS", 3, 0 },
+  [DSERAN_EV_HELLO_SUPPRESS]  = { "HELLO_SUPPRESS", 1, 1 },
+  [DSERAN_EV_TRICKLE_RESET]   = { "TRICKLE_RESET", 1, 1 },
+  [DSERAN_EV_LQE]             = { "LQE", 3, 1 },
+  [DSERAN_EV_ENERGEST]        = { "ENERGEST", 4, 1 },
+  [DSERAN_EV_REPAIR]          = { "REPAIR", 3, 1 },
+  [DSERAN_EV_HANDOFF]         = { "HANDOFF", 2, 1 },
+  [DSERAN_EV_DETECT]          = { "DETECT", 4, 1 },
+  [DSERAN_EV_CTRL_BYTES]      = { "CTRL_BYTES", 1, 1 },
+  [DSERAN_EV_AGG]             = { "AGG", 3, 1 },
+};
+
+#if DSERAN_TRACE_BINARY
+
+#define RECORD_MAX (1 + 2 + 4 * 2)
+
+static uint8_t buf[DSERAN_TRACE_BUF_SIZE];
+static uint16_t buf_len;
+static uint32_t batch_start;   // horodatage du premier enregistrement / first record timestamp
+static uint32_t batch_last;    // horodatage du dernier enregistrement / last record timestamp
+static struct ctimer flush_timer;
+
+static const char hex_digits[] = "0123456789abcdef";
+
+static void put_hex(uint8_t b) {
+  TRACE_PUTCHAR(hex_digits[b >> 4]);
+  TRACE_PUTCHAR(hex_digits[b & 0x0f]);
+}
+
+void dseran_trace_flush(void) {
+  uint16_t i;
+
+  if(buf_len == 0) {
+    return;
+  }
+  TRACE_PUTCHAR('T');
+  TRACE_PUTCHAR('R');
+  TRACE_PUTCHAR('C');
+  TRACE_PUTCHAR(' ');
+  for(i=0; i<4; i++) {
+    put_hex((uint8_t)(batch_start >> (24 - 8 * i)));
+  }
+  TRACE_PUTCHAR(' ');
+  for(i=0; i<buf_len; i++) {
+    put_hex(buf[i]);
+  }
+  TRACE_PUTCHAR('\n');
+  buf_len = 0;
+}
+
+static void flush_tick(void *ptr) {
+  dseran_trace_flush();
+  ctimer_reset(&flush_timer);
+}
+
+static void put_u16(uint16_t v) {
+  buf[buf_len++] = v & 0xff;
+  buf[buf_len++] = v >> 8;
+}
+
+void dseran_trace(uint8_t ev, uint16_t a, uint16_t b, uint16_t c, uint16_t d) {
+  uint32_t now = (uint32_t)clock_time();
+  uint8_t nargs = events[ev].nargs;
+
+  // Nouveau lot si plein ou si l'écart dépasse 16 bits / New batch when full or delta exceeds 16 bits
+  if(buf_len + RECORD_MAX > DSERAN_TRACE_BUF_SIZE || (buf_len > 0 && now - batch_last > 0xffff)) {
+    dseran_trace_flush();
+  }
+  if(buf_len == 0) {
+    batch_start = now;
+    batch_last = now;
+  }
+
+  buf[buf_len++] = ev;
+  put_u16((uint16_t)(now - batch_last));
+  batch_last = now;
+  if(nargs > 0) {
+    put_u16(a);
+  }
+  if(nargs > 1) {
+    put_u16(b);
+  }
+  if(nargs > 2) {
+    put_u16(c);
+  }
+  if(nargs > 3) {
+    put_u16(d);
+  }
+}
+
+void dseran_trace_init(void) {
+  buf_len = 0;
+  ctimer_set(&flush_timer, DSERAN_TRACE_FLUSH_INTERVAL, flush_tick, NULL);
+}
+
+#else /* DSERAN_TRACE_BINARY */
+
+// Mode texte : mêmes enregistrements qu'avant les traces binaires
+// Text mode: same records as before binary traces
+void dseran_trace(uint8_t ev, uint16_t a, uint16_t b, uint16_t c, uint16_t d) {
+  const struct trace_event *e = &events[ev];
+  uint16_t args[4] = { a, b, c, d };
+  uint8_t i;
+
+  LOG_INFO("%s", e->name);
+  for(i=0; i<e->nargs; i++) {
+    LOG_INFO_(" %u", args[i]);
+  }
+  if(e->with_time) {
+    LOG_INFO_(" %lu", (unsigned long)clock_time());
+  }
+  LOG_INFO_("\n");
+}
+
+void dseran_trace_flush(void) {
+}
+
+void dseran_trace_init(void) {
+}
+
+#endif /* DSERAN_TRACE_BINARY */
+
+#endif /* DSERAN_TRACE */
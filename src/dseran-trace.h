@@ -0,0 +1,119 @@
+/*
+ * dseran-trace.h : Traces binaires compactes pour D-SERAN
+ * Compact binary traces for D-SERAN
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Chaque événement est un identifiant, un horodatage et quelques arguments
+ * entiers de 16 bits, accumulés en RAM puis vidés par lots sur la liaison
+ * série sous forme de lignes "TRC". scripts/trace_decode.py reconstruit les
+ * enregistrements texte (ENERGY, SEND_UDP, RECV, HOP...) lus par parse_logs.py.
+ * Each event is an identifier, a timestamp and a few 16-bit integer
+ * arguments, buffered in RAM and flushed in batches over serial as "TRC"
+ * lines. scripts/trace_decode.py rebuilds the text records (ENERGY, SEND_UDP,
+ * RECV, HOP...) read by parse_logs.py.
+ *
+ * Format d'une ligne / Line format:
+ *   TRC <t0: 8 hex> <enregistrements / records: hex>
+ *   enregistrement / record = id (1 octet / byte), dt (2 octets / bytes, LE),
+ *                             arguments (2 octets LE chacun / 2 bytes LE each)
+ */
+
+#ifndef DSERAN_TRACE_H_
+#define DSERAN_TRACE_H_
+
+#include "contiki.h"
+
+// Traces compilées (profil minimal : 0) / Traces built in (minimal profile: 0)
+#ifdef DSERAN_CONF_TRACE
+#define DSERAN_TRACE DSERAN_CONF_TRACE
+#else
+#define DSERAN_TRACE 1
+#endif
+
+// Traces binaires (1) ou texte LOG_INFO (0) / Binary traces (1) or LOG_INFO text (0)
+#ifdef DSERAN_CONF_TRACE_BINARY
+#define DSERAN_TRACE_BINARY DSERAN_CONF_TRACE_BINARY
+#else
+#define DSERAN_TRACE_BINARY 1
+#endif
+
+// Taille du tampon de traces en octets / Trace buffer size in bytes
+#ifdef DSERAN_CONF_TRACE_BUF_SIZE
+#define DSERAN_TRACE_BUF_SIZE DSERAN_CONF_TRACE_BUF_SIZE
+#else
+#define DSERAN_TRACE_BUF_SIZE 96
+#endif
+
+// Vidage périodique du tampon / Periodic buffer flush
+#define DSERAN_TRACE_FLUSH_INTERVAL (CLOCK_SECOND * 60)
+
+// Traces de débogage printf, désactivées par défaut avec les traces binaires
+// printf debug traces, disabled by default with binary traces
+#ifdef DSERAN_CONF_VERBOSE
+#define DSERAN_VERBOSE DSERAN_CONF_VERBOSE
+#else
+#define DSERAN_VERBOSE (!DSERAN_TRACE_BINARY)
+#endif
+#if DSERAN_VERBOSE
+#define DSERAN_PRINTF(...) printf(__VA_ARGS__)
+#else
+#define DSERAN_PRINTF(...)
+#endif
+
+// Niveau des journaux LOG_* des modules D-SERAN / LOG_* level of the D-SERAN modules
+#ifdef DSERAN_CONF_LOG_LEVEL
+#define DSERAN_LOG_LEVEL DSERAN_CONF_LOG_LEVEL
+#else
+#define DSERAN_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// Identifiants d'événements, à garder alignés avec scripts/trace_decode.py
+// Event identifiers, keep in sync with scripts/trace_decode.py
+enum {
+  DSERAN_EV_ENERGY = 1,     // résiduelle, récoltée / residual, harvested
+  DSERAN_EV_SEND_UDP,       // énergie / energy
+  DSERAN_EV_RECV,           // énergie du voisin / neighbor energy
+  DSERAN_EV_HOP,            // indice du meilleur voisin / best neighbor index
+  DSERAN_EV_MOVE,           // adresse lien [0], [1] / link address [0], [1]
+  DSERAN_EV_LIFETIME,       // adresse lien [0] / link address [0]
+  DSERAN_EV_DATA_TX,        // source, séquence / source, sequence
+  DSERAN_EV_DATA_RX,        // source, séquence, latence (ms), sauts / source, sequence, latency (ms), hops
+  DSERAN_EV_LOCAL_REPAIR,   // adresse lien [0] du voisin retiré / removed neighbor link address [0]
+  DSERAN_EV_POS,            // x * 10, y * 10, déplacement * 100 / displacement * 100
+  DSERAN_EV_HELLO_SUPPRESS, // intervalle Trickle courant (s) / current Trickle interval (s)
+  DSERAN_EV_TRICKLE_RESET,  // cause / cause
+  DSERAN_EV_LQE,            // adresse lien [0], HRR %, ETX * 100 / link address [0], HRR %, ETX * 100
+  DSERAN_EV_ENERGEST,       // mJ consommés : CPU, LPM, émission, écoute / mJ consumed: CPU, LPM, transmit, listen
+  DSERAN_EV_REPAIR,         // durée ms, lectures perdues, cause / duration ms, lost readings, cause
+  DSERAN_EV_HANDOFF,        // adresse lien [0] du parent quitté, durée de vie prévue ms / left parent link address [0], predicted lifetime ms
+  DSERAN_EV_DETECT,         // identifiant du voisin suspect, attentes, relais, pertes / suspect neighbor id, expected, forwarded, dropped
+  DSERAN_EV_CTRL_BYTES,     // octets de contrôle émis dans la minute / control bytes sent during the minute
+  DSERAN_EV_AGG,            // trames de données émises, lectures portées, lectures perdues dans la minute / data frames sent, readings carried, readings lost during the minute
+  DSERAN_EV_COUNT
+};
+
+#if DSERAN_TRACE
+void dseran_trace_init(void);
+
+// Enregistre un événement ; seuls les arguments déclarés pour l'événement sont conservés
+// Records an event; only the arguments declared for the event are kept
+void dseran_trace(uint8_t ev, uint16_t a, uint16_t b, uint16_t c, uint16_t d);
+
+// Vide immédiatement le tampon (avant un arrêt) / Flushes the buffer now (before a shutdown)
+void dseran_trace_flush(void);
+#else
+// Appels vides, éliminés avec leurs arguments par le compilateur
+// Empty calls, removed together with their arguments by the compiler
+static inline void dseran_trace_init(void) {}
+static inline void dseran_trace(uint8_t ev, uint16_t a, uint16_t b, uint16_t c, uint16_t d) {}
+static inline void dseran_trace_flush(void) {}
+#endif
+
+#define DSERAN_TRACE1(ev, a)          dseran_trace(ev, a, 0, 0, 0)
+#define DSERAN_TRACE2(ev, a, b)       dseran_trace(ev, a, b, 0, 0)
+#define DSERAN_TRACE3(ev, a, b, c)    dseran_trace(ev, a, b, c, 0)
+#define DSERAN_TRACE4(ev, a, b, c, d) dseran_trace(ev, a, b, c, d)
+
+#endif /* DSERAN_TRACE_H_ */
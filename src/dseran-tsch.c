@@ -0,0 +1,143 @@
+/*
+ * dseran-tsch.c : Ordonnancement TSCH propre à D-SERAN
+ * D-SERAN TSCH schedule
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Cases à la réception, comme Orchestra : un nœud écoute dans
+ * DSERAN_TSCH_RX_CELLS cases réparties sur la supertrame et chaque enfant
+ * émet dans l'une d'elles, choisie d'après sa propre adresse ; les enfants
+ * d'un parent dense se partagent ainsi plusieurs cases au lieu d'une seule
+ * (repli exponentiel TSCH dans chacune). Une trame en file pour un voisin
+ * sans case dédiée, par exemple l'ancien prochain saut après un changement,
+ * part dans la case partagée.
+ * Receiver-based cells, as in Orchestra: a node listens in
+ * DSERAN_TSCH_RX_CELLS cells spread over the slotframe and each child
+ * transmits in one of them, chosen from its own address; the children of a
+ * dense parent thus share several cells instead of a single one (TSCH
+ * exponential backoff in each). A frame queued for a neighbor without a
+ * dedicated cell, for instance the former next hop after a change, leaves
+ * in the shared cell.
+ */
+
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/linkaddr.h"
+#include "net/mac/tsch/tsch.h"
+#include "sys/log.h"
+#include "dseran-tsch.h"
+#include "dseran-trace.h"
+
+#define LOG_MODULE "D-SERAN"
+#define LOG_LEVEL DSERAN_LOG_LEVEL
+
+// Supertrames : la plus petite poignée l'emporte sur une case commune
+// Slotframes: the lowest handle wins on a common timeslot
+#define SF_SHARED       0
+#define SF_UNICAST      1
+#define SHARED_CHANNEL  0
+#define UNICAST_CHANNEL 1
+
+// Écart entre les cases d'écoute d'un nœud, toutes distinctes / Gap between a node's listening cells, all distinct
+#define CELL_STEP (DSERAN_TSCH_UNICAST_PERIOD / DSERAN_TSCH_RX_CELLS)
+
+static struct tsch_slotframe *sf_unicast;
+static linkaddr_t next_hop;
+static uint16_t tx_slot;
+static uint8_t tx_set = 0;
+
+// i-ième case d'écoute d'un nœud, tirée de son adresse / A node's i-th listening cell, drawn from its address
+static uint16_t slot_of(const linkaddr_t *addr, uint8_t i) {
+  return (addr->u8[LINKADDR_SIZE - 1] + (addr->u8[LINKADDR_SIZE - 2] << 8) + i * CELL_STEP) %
+         DSERAN_TSCH_UNICAST_PERIOD;
+}
+
+// Vrai si slot est l'une de nos cases d'écoute / True when slot is one of our listening cells
+static uint8_t is_rx_slot(uint16_t slot) {
+  for(uint8_t i=0; i<DSERAN_TSCH_RX_CELLS; i++) {
+    if(slot_of(&linkaddr_node_addr, i) == slot) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Case d'écoute, partagée avec l'émission quand le prochain saut y tombe aussi
+// Listening cell, shared with transmission when the next hop falls on it too
+static void rx_cell_set(uint16_t slot, uint8_t with_tx) {
+  if(with_tx) {
+    tsch_schedule_add_link(sf_unicast, LINK_OPTION_RX | LINK_OPTION_TX | LINK_OPTION_SHARED,
+                           LINK_TYPE_NORMAL, &next_hop, slot, UNICAST_CHANNEL, 1);
+  } else {
+    tsch_schedule_add_link(sf_unicast, LINK_OPTION_RX, LINK_TYPE_NORMAL,
+                           &tsch_broadcast_address, slot, UNICAST_CHANNEL, 1);
+  }
+}
+
+void dseran_tsch_init(void) {
+  struct tsch_slotframe *sf_shared;
+
+  // Balises, hellos et repli unicast / EBs, hellos and unicast fallback
+  tsch_schedule_remove_all_slotframes();
+  sf_shared = tsch_schedule_add_slotframe(SF_SHARED, DSERAN_TSCH_SHARED_PERIOD);
+  tsch_schedule_add_link(sf_shared, LINK_OPTION_RX | LINK_OPTION_TX | LINK_OPTION_SHARED | LINK_OPTION_TIME_KEEPING,
+                         LINK_TYPE_ADVERTISING, &tsch_broadcast_address, 0, SHARED_CHANNEL, 1);
+
+  sf_unicast = tsch_schedule_add_slotframe(SF_UNICAST, DSERAN_TSCH_UNICAST_PERIOD);
+  linkaddr_copy(&next_hop, &linkaddr_null);
+  tx_set = 0;
+  for(uint8_t i=0; i<DSERAN_TSCH_RX_CELLS; i++) {
+    rx_cell_set(slot_of(&linkaddr_node_addr, i), 0);
+  }
+  LOG_INFO("TSCH: supertrames / slotframes %u/%u, écoute / listen %u x%u\n",
+           DSERAN_TSCH_SHARED_PERIOD, DSERAN_TSCH_UNICAST_PERIOD,
+           slot_of(&linkaddr_node_addr, 0), DSERAN_TSCH_RX_CELLS);
+
+  NETSTACK_MAC.on();
+}
+
+void dseran_tsch_set_coordinator(void) {
+  tsch_set_coordinator(1);
+}
+
+// Réallocation de la case d'émission au changement de prochain saut
+// Transmit cell reallocation when the next hop changes
+void dseran_tsch_set_next_hop(const linkaddr_t *addr) {
+  if(sf_unicast == NULL || linkaddr_cmp(addr, &next_hop)) {
+    return;
+  }
+
+  // Ancienne case rendue : les trames restantes passent par la case partagée
+  // Former cell released: the remaining frames go through the shared cell
+  if(tx_set) {
+    if(is_rx_slot(tx_slot)) {
+      rx_cell_set(tx_slot, 0);
+    } else {
+      tsch_schedule_remove_link_by_offsets(sf_unicast, tx_slot, UNICAST_CHANNEL);
+    }
+    tx_set = 0;
+  }
+  linkaddr_copy(&next_hop, addr);
+  if(linkaddr_cmp(addr, &linkaddr_null)) {
+    return;
+  }
+
+  // Notre case parmi celles du prochain saut / Our cell among those of the next hop
+  tx_slot = slot_of(addr, linkaddr_node_addr.u8[LINKADDR_SIZE - 1] % DSERAN_TSCH_RX_CELLS);
+  if(is_rx_slot(tx_slot)) {
+    rx_cell_set(tx_slot, 1);
+  } else {
+    tsch_schedule_add_link(sf_unicast, LINK_OPTION_TX | LINK_OPTION_SHARED, LINK_TYPE_NORMAL,
+                           addr, tx_slot, UNICAST_CHANNEL, 1);
+  }
+  tx_set = 1;
+  // Les keepalives suivent la route / Keepalives follow the route
+  tsch_queue_update_time_source(addr);
+}
+
+void dseran_tsch_joined(void) {
+  if(tx_set) {
+    tsch_queue_update_time_source(&next_hop);
+  }
+}
@@ -0,0 +1,75 @@
+/*
+ * dseran-tsch.h : Ordonnancement TSCH propre à D-SERAN
+ * D-SERAN TSCH schedule
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Avec make MAC=tsch, D-SERAN installe son propre ordonnancement à la place
+ * du 6TiSCH minimal : une case partagée (balises EB, hellos, unicast vers
+ * les voisins sans case dédiée) dans une supertrame de
+ * DSERAN_TSCH_SHARED_PERIOD, et une supertrame unicast de
+ * DSERAN_TSCH_UNICAST_PERIOD où chaque nœud écoute dans les
+ * DSERAN_TSCH_RX_CELLS cases tirées de son adresse et émet vers son prochain
+ * saut dans l'une des cases du prochain saut.
+ * La case d'émission suit parent_select() ; le prochain saut devient aussi
+ * la source de temps. Hors de ces cases, la radio est coupée.
+ * With make MAC=tsch, D-SERAN installs its own schedule instead of the
+ * 6TiSCH minimal one: a shared cell (EBs, hellos, unicast to neighbors
+ * without a dedicated cell) in a DSERAN_TSCH_SHARED_PERIOD slotframe, and a
+ * DSERAN_TSCH_UNICAST_PERIOD unicast slotframe where every node listens in
+ * the DSERAN_TSCH_RX_CELLS cells drawn from its address and transmits to its
+ * next hop in one of the next hop's cells. The transmit cell follows parent_select(); the next hop
+ * also becomes the time source. Outside these cells, the radio is off.
+ */
+
+#ifndef DSERAN_TSCH_H_
+#define DSERAN_TSCH_H_
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+
+#ifdef DSERAN_CONF_TSCH
+#define DSERAN_TSCH DSERAN_CONF_TSCH
+#else
+#define DSERAN_TSCH 0
+#endif
+
+// Supertrame de la case partagée (cases de 10 ms, 15 ms sur sky) / Shared cell slotframe (10 ms timeslots, 15 ms on sky)
+#ifdef DSERAN_CONF_TSCH_SHARED_PERIOD
+#define DSERAN_TSCH_SHARED_PERIOD DSERAN_CONF_TSCH_SHARED_PERIOD
+#else
+#define DSERAN_TSCH_SHARED_PERIOD 31
+#endif
+
+// Supertrame unicast, première avec la précédente / Unicast slotframe, coprime with the previous one
+#ifdef DSERAN_CONF_TSCH_UNICAST_PERIOD
+#define DSERAN_TSCH_UNICAST_PERIOD DSERAN_CONF_TSCH_UNICAST_PERIOD
+#else
+#define DSERAN_TSCH_UNICAST_PERIOD 17
+#endif
+
+// Cases d'écoute par nœud : les enfants d'un parent s'y répartissent d'après
+// leur adresse ; chaque case vide coûte une attente de réception par supertrame
+// Listening cells per node: a parent's children spread over them by address;
+// every empty cell costs one receive wait per slotframe
+#ifdef DSERAN_CONF_TSCH_RX_CELLS
+#define DSERAN_TSCH_RX_CELLS DSERAN_CONF_TSCH_RX_CELLS
+#else
+#define DSERAN_TSCH_RX_CELLS 3
+#endif
+
+// Installe l'ordonnancement et démarre TSCH / Installs the schedule and starts TSCH
+void dseran_tsch_init(void);
+
+// Le puits est coordinateur : il émet les premières balises / The sink is the coordinator: it sends the first EBs
+void dseran_tsch_set_coordinator(void);
+
+// Prochain saut installé, linkaddr_null si aucun / Installed next hop, linkaddr_null when none
+void dseran_tsch_set_next_hop(const linkaddr_t *addr);
+
+// TSCH_CALLBACK_JOINING_NETWORK : source de temps rétablie après une (ré)association
+// TSCH_CALLBACK_JOINING_NETWORK: time source restored after a (re)association
+void dseran_tsch_joined(void);
+
+#endif /* DSERAN_TSCH_H_ */
@@ -0,0 +1,213 @@
+/*
+ * dseran-watchdog.c : Chien de garde des relais et motes attaquants
+ * Forwarding watchdog and attacker motes
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Les données sont reconnues à leur fin de trame (lectures struct
+ * dseran_data accolées, dseran-agg.h), sans décoder 6LoWPAN. Une attente,
+ * pour la dernière lecture de la trame, est ouverte au retour MAC d'une
+ * trame acquittée (dseran_watchdog_sent, depuis le pilote de routage) et fermée
+ * par la trame de relais entendue ou par son échéance. Le puits, à distance
+ * nulle, consomme les données : il n'est jamais attendu. Le filtrage
+ * d'adresse de la radio est levé pour entendre les relais ; sur cc2420
+ * (sky, z1) l'acquittement automatique en dépend, le chien de garde y est
+ * donc désactivé par dseran-profile.h.
+ * Data frames are recognized by their frame tail (back-to-back struct
+ * dseran_data readings, dseran-agg.h), without decoding 6LoWPAN. An
+ * expectation, for the last reading of the frame, opens on the MAC
+ * feedback of an acked frame (dseran_watchdog_sent, from the routing
+ * driver) and closes with the overheard relay frame or its deadline. The sink, at distance
+ * zero, consumes the data: it is never expected to forward. The radio
+ * address filter is lifted to overhear relays; on cc2420 (sky, z1)
+ * auto-ack depends on it, so dseran-profile.h disables the watchdog there.
+ */
+
+#include "contiki.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include "net/linkaddr.h"
+#include "net/mac/mac.h"
+#include "net/mac/csma/csma.h"
+#include "net/mac/framer/frame802154.h"
+#include "dev/radio.h"
+#include "lib/random.h"
+#include "sys/ctimer.h"
+#include "sys/node-id.h"
+#include "dseran-watchdog.h"
+#include "dseran-nbr.h"
+#include <string.h>
+
+#if DSERAN_WD_VERIFY
+// Donnée confiée à un voisin, en attente de son relais / Data handed to a neighbor, awaiting its relay
+struct expectation {
+  linkaddr_t nbr;
+  uint16_t origin;
+  uint16_t seq;
+  clock_time_t deadline;
+};
+
+// File par échéance croissante : toutes les attentes ont le même délai
+// Queue by increasing deadline: all expectations share the same delay
+static struct expectation pending[DSERAN_WD_PENDING];
+static uint8_t pending_len = 0;
+static struct ctimer expiry_timer;
+#endif
+
+// i-ème lecture D-SERAN depuis la fin de buf ? / i-th D-SERAN reading from the end of buf?
+static uint8_t data_tail(struct dseran_data *msg, const uint8_t *buf, uint16_t len, uint8_t i) {
+  if(len < (i + 1) * sizeof(*msg)) {
+    return 0;
+  }
+  memcpy(msg, buf + len - (i + 1) * sizeof(*msg), sizeof(*msg));
+  return msg->magic == DSERAN_DATA_MAGIC;
+}
+
+#if DSERAN_WD_VERIFY
+static void pending_remove(uint8_t i) {
+  pending_len--;
+  for(; i<pending_len; i++) {
+    pending[i] = pending[i + 1];
+  }
+}
+
+// Échéances atteintes : pertes / Deadlines reached: drops
+static void expiry_cb(void *ptr) {
+  clock_time_t now = clock_time();
+
+  while(pending_len > 0 && !CLOCK_LT(now, pending[0].deadline)) {
+    struct dseran_nbr *n = dseran_nbr_lookup(&pending[0].nbr);
+
+    pending_remove(0);
+    if(n != NULL) {
+      dseran_nbr_observe(n, 0);
+    }
+  }
+  if(pending_len > 0) {
+    ctimer_set(&expiry_timer, pending[0].deadline - now, expiry_cb, NULL);
+  }
+}
+
+void dseran_watchdog_sent(struct dseran_nbr *n) {
+  struct dseran_data msg;
+
+  if(n->hops == 0 || packetbuf_holds_broadcast() ||
+     !data_tail(&msg, packetbuf_dataptr(), packetbuf_datalen(), 0)) {
+    return;
+  }
+  // File pleine : la plus ancienne attente est abandonnée sans preuve
+  // Full queue: the oldest expectation is given up without evidence
+  if(pending_len == DSERAN_WD_PENDING) {
+    pending_remove(0);
+  }
+  linkaddr_copy(&pending[pending_len].nbr, &n->addr);
+  pending[pending_len].origin = msg.origin;
+  pending[pending_len].seq = msg.seq;
+  pending[pending_len].deadline = clock_time() + DSERAN_WD_TIMEOUT;
+  if(pending_len++ == 0) {
+    ctimer_set(&expiry_timer, DSERAN_WD_TIMEOUT, expiry_cb, NULL);
+  }
+  dseran_nbr_expect(n);
+}
+
+// Lecture attendue de src ? / Expected reading from src?
+static void relayed(const linkaddr_t *src, const struct dseran_data *msg) {
+  for(uint8_t i=0; i<pending_len; i++) {
+    if(pending[i].origin == msg->origin && pending[i].seq == msg->seq &&
+       linkaddr_cmp(&pending[i].nbr, src)) {
+      struct dseran_nbr *n = dseran_nbr_lookup(src);
+
+      pending_remove(i);
+      if(n != NULL) {
+        dseran_nbr_observe(n, 1);
+      }
+      return;
+    }
+  }
+}
+
+// Trame de src entendue : chaque lecture peut être un relais attendu, le
+// relais ayant pu regrouper autrement / Frame from src overheard: every reading
+// may be an expected relay, since the relay may have grouped them differently
+static void overheard(const linkaddr_t *src, const uint8_t *payload, uint16_t len) {
+  struct dseran_data msg;
+
+  for(uint8_t i=0; data_tail(&msg, payload, len, i); i++) {
+    relayed(src, &msg);
+  }
+}
+#else
+void dseran_watchdog_sent(struct dseran_nbr *n) {
+}
+#endif /* DSERAN_WD_VERIFY */
+
+static void wd_init(void) {
+  csma_driver.init();
+#if DSERAN_WD_VERIFY
+  // Réception des trames destinées aux autres / Receive the frames meant for others
+  radio_value_t mode;
+  if(NETSTACK_RADIO.get_value(RADIO_PARAM_RX_MODE, &mode) == RADIO_RESULT_OK) {
+    NETSTACK_RADIO.set_value(RADIO_PARAM_RX_MODE, mode & ~RADIO_RX_MODE_ADDRESS_FILTER);
+  }
+#endif
+}
+
+static void wd_send(mac_callback_t sent, void *ptr) {
+#if DSERAN_ATTACK != DSERAN_ATTACK_NONE
+  struct dseran_data msg;
+  uint8_t relay = 0;
+
+  // Trame portant la donnée d'un autre : jetée, l'émission est déclarée réussie
+  // Frame carrying someone else's data: dropped, the transmission is reported as done
+  if(!packetbuf_holds_broadcast()) {
+    for(uint8_t i=0; data_tail(&msg, packetbuf_dataptr(), packetbuf_datalen(), i); i++) {
+      relay |= msg.origin != node_id;
+    }
+  }
+  if(relay && (DSERAN_ATTACK == DSERAN_ATTACK_BLACKHOLE || random_rand() % 100 < DSERAN_ATTACK_DROP)) {
+    mac_call_sent_callback(sent, ptr, MAC_TX_OK, 1);
+    return;
+  }
+#endif
+  csma_driver.send(sent, ptr);
+}
+
+static void wd_input(void) {
+#if DSERAN_WD_VERIFY
+  frame802154_t frame;
+
+  // Unicast destiné à un autre : examiné ici, CSMA l'aurait rejeté
+  // Unicast meant for another node: examined here, CSMA would have rejected it
+  if(frame802154_parse(packetbuf_dataptr(), packetbuf_datalen(), &frame) > 0 &&
+     frame.fcf.frame_type == FRAME802154_DATAFRAME &&
+     !frame802154_is_broadcast_addr(frame.fcf.dest_addr_mode, frame.dest_addr) &&
+     !linkaddr_cmp((linkaddr_t *)frame.dest_addr, &linkaddr_node_addr)) {
+    overheard((linkaddr_t *)frame.src_addr, frame.payload, frame.payload_len);
+    return;
+  }
+#endif
+  csma_driver.input();
+}
+
+static int wd_on(void) {
+  return csma_driver.on();
+}
+
+static int wd_off(void) {
+  return csma_driver.off();
+}
+
+static int wd_max_payload(void) {
+  return csma_driver.max_payload();
+}
+
+const struct mac_driver dseran_watchdog_mac_driver = {
+  "D-SERAN watchdog",
+  wd_init,
+  wd_send,
+  wd_input,
+  wd_on,
+  wd_off,
+  wd_max_payload,
+};
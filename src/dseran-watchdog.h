@@ -0,0 +1,76 @@
+/*
+ * dseran-watchdog.h : Chien de garde des relais et motes attaquants
+ * Forwarding watchdog and attacker motes
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Un pilote MAC mince au-dessus de CSMA écoute les trames destinées aux
+ * autres nœuds : une donnée acquittée par un voisin doit être entendue,
+ * relayée par lui, avant DSERAN_WD_TIMEOUT, sinon elle compte comme perdue
+ * dans sa fenêtre (dseran-behavior.h). Le même pilote fait des motes
+ * attaquantes (DSERAN_CONF_ATTACK) : trou noir, qui attire les routes en
+ * annonçant un saut du puits puis jette toutes les données relayées, ou
+ * trou gris, qui en jette DSERAN_ATTACK_DROP %.
+ * A thin MAC driver on top of CSMA listens to the frames meant for other
+ * nodes: a data frame acked by a neighbor must be overheard, relayed by it,
+ * within DSERAN_WD_TIMEOUT, otherwise it counts as dropped in its window
+ * (dseran-behavior.h). The same driver turns motes into attackers
+ * (DSERAN_CONF_ATTACK): blackhole, which lures routes by advertising one hop
+ * to the sink and then drops every relayed data frame, or grayhole, which
+ * drops DSERAN_ATTACK_DROP % of them.
+ */
+
+#ifndef DSERAN_WATCHDOG_H_
+#define DSERAN_WATCHDOG_H_
+
+#include "contiki.h"
+#include "net/mac/mac.h"
+#include "dseran-behavior.h"
+#include "dseran-nbr.h"
+#include "dseran-agg.h"
+
+// Comportement de la mote / Mote behavior
+#define DSERAN_ATTACK_NONE      0
+#define DSERAN_ATTACK_BLACKHOLE 1
+#define DSERAN_ATTACK_GRAYHOLE  2
+#ifdef DSERAN_CONF_ATTACK
+#define DSERAN_ATTACK DSERAN_CONF_ATTACK
+#else
+#define DSERAN_ATTACK DSERAN_ATTACK_NONE
+#endif
+
+// Part des données relayées jetées par un trou gris (%) / Share of relayed data dropped by a grayhole (%)
+#ifdef DSERAN_CONF_ATTACK_DROP
+#define DSERAN_ATTACK_DROP DSERAN_CONF_ATTACK_DROP
+#else
+#define DSERAN_ATTACK_DROP 50
+#endif
+
+// Délai de relais toléré, attente CSMA et file d'agrégation comprises
+// Tolerated relay delay, CSMA backoff and aggregation queue included
+#ifdef DSERAN_CONF_WD_TIMEOUT
+#define DSERAN_WD_TIMEOUT DSERAN_CONF_WD_TIMEOUT
+#else
+#define DSERAN_WD_TIMEOUT (CLOCK_SECOND * 2 + DSERAN_AGG_HOLD)
+#endif
+
+// Attentes en cours au plus ; la plus ancienne cède sa place / Pending expectations at most; the oldest gives way
+#ifdef DSERAN_CONF_WD_PENDING
+#define DSERAN_WD_PENDING DSERAN_CONF_WD_PENDING
+#else
+#define DSERAN_WD_PENDING 8
+#endif
+
+// Les attaquants ne jugent pas leurs voisins / Attackers do not judge their neighbors
+#define DSERAN_WD_VERIFY (DSERAN_WATCHDOG && DSERAN_ATTACK == DSERAN_ATTACK_NONE)
+
+// Pilote MAC (NETSTACK_CONF_MAC) : CSMA, écoute des relais, attaque
+// MAC driver (NETSTACK_CONF_MAC): CSMA, relay overhearing, attack
+extern const struct mac_driver dseran_watchdog_mac_driver;
+
+// Trame de packetbuf acquittée par n : une donnée à relayer devient une attente
+// Frame in packetbuf acked by n: a data frame to relay becomes an expectation
+void dseran_watchdog_sent(struct dseran_nbr *n);
+
+#endif /* DSERAN_WATCHDOG_H_ */
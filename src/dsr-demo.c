@@ -1,122 +1,148 @@
 /*
- * dsr-demo.c : Protocole de référence DSR simplifié pour MANET sous Contiki-NG
- * Simplified DSR reference protocol for MANET under Contiki-NG
- * 
+ * dsr-demo.c : Protocole de référence DSR pour MANET sous Contiki-NG
+ * DSR reference protocol for MANET under Contiki-NG
+ *
  * Auteur / Author: Madani Belacel
  * Date de création / Created: 22/03/2023
- * Dernière mise à jour / Last updated: 28/04/2023
- * 
- * Implémentation simplifiée de DSR pour comparaison avec D-SERAN
- * Simplified DSR implementation for comparison with D-SERAN
+ * Dernière mise à jour / Last updated: Août 2025
+ *
+ * Même charge que D-SERAN (une donnée vers le puits toutes les
+ * DSERAN_CONF_DATA_INTERVAL, énergie mesurée par energest) routée par la
+ * source avec DSR (dsr.c). Le taux de succès du cache et le nombre de
+ * sauvetages sont journalisés chaque minute (ROUTE_CACHE), les découvertes
+ * par dsr.c (ROUTE_DISC).
+ * Same workload as D-SERAN (one data frame to the sink every
+ * DSERAN_CONF_DATA_INTERVAL, energy measured through energest) source-routed
+ * by DSR (dsr.c). The cache hit rate and the salvage count are logged every
+ * minute (ROUTE_CACHE), discoveries by dsr.c (ROUTE_DISC).
  */
 
 #include "contiki.h"
-#include "net/ipv6/uip-ds6.h"
+#include "net/netstack.h"
+#include "net/routing/routing.h"
 #include "net/ipv6/uip.h"
-#include "net/ipv6/uip-udp-packet.h"
 #include "sys/log.h"
+#include "sys/node-id.h"
 #include "lib/random.h"
+#include "dsr.h"
+#include "dseran-energy.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define LOG_MODULE "DSR-DEMO"
 #define LOG_LEVEL LOG_LEVEL_INFO
 
-// Configuration des paramètres / Parameter configuration
-#define UDP_PORT 1236
-#define SEND_INTERVAL (CLOCK_SECOND * 12)
-#define MAX_HOPS 15
+// Puits et trafic partagés avec D-SERAN / Sink and traffic shared with D-SERAN
+#ifdef DSERAN_CONF_SINK_ID
+#define SINK_ID DSERAN_CONF_SINK_ID
+#else
+#define SINK_ID 1
+#endif
+#ifdef DSERAN_CONF_DATA_INTERVAL
+#define DATA_INTERVAL DSERAN_CONF_DATA_INTERVAL
+#else
+#define DATA_INTERVAL (CLOCK_SECOND * 15)
+#endif
+#define ENERGY_INTERVAL (CLOCK_SECOND * 5)
+#define CACHE_LOG_EVERY 12     // intervalles d'énergie, soit une minute / energy intervals, i.e. one minute
 
 PROCESS(dsr_demo_process, "DSR Demo Protocol");
 AUTOSTART_PROCESSES(&dsr_demo_process);
 
+struct dsr_data {
+  uint16_t origin;      // node_id de la source / source node_id
+  uint16_t seq;
+  uint32_t send_time;   // clock_time() de l'émetteur / sender clock_time()
+};
+
 // Variables globales / Global variables
-static struct uip_udp_conn *udp_conn;
+static uip_ipaddr_t sink_ipaddr;
 static uint16_t seq_id = 0;
 
-// Statistiques de performance / Performance statistics
-static uint16_t packets_sent = 0;
-static uint16_t route_discoveries = 0;
-
-// Simulation de l'énergie / Energy simulation
-static uint16_t my_energy = 100;
-
-// Fonction de découverte de route / Route discovery function
-static void discover_route(void) {
-  route_discoveries++;
-  
-  // Simulation de la découverte de route / Route discovery simulation
-  printf("DSR: Découverte de route #%u initiée\n", route_discoveries);
-  
-  // Consommation d'énergie pour la découverte / Energy consumption for discovery
-  my_energy -= 2;
-  
-  LOG_INFO("ROUTE_DISC %u %lu\n", route_discoveries, clock_time());
-}
+// Énergie résiduelle / Residual energy
+static uint16_t my_energy;
 
 // Fonction d'envoi de paquets / Packet sending function
 static void send_packet(void) {
-  char buf[32];
+  struct dsr_data msg;
   
-  // Préparation du message / Message preparation
-  sprintf(buf, "DSR_DATA %u %lu", seq_id++, clock_time());
-  
-  // Envoi UDP / UDP sending
-  uip_udp_packet_send(udp_conn, buf, strlen(buf));
+  msg.origin = node_id;
+  msg.seq = ++seq_id;
+  msg.send_time = (uint32_t)clock_time();
+  LOG_INFO("DATA_TX %u %u %lu\n", msg.origin, msg.seq, (unsigned long)clock_time());
+  dsr_send(&sink_ipaddr, &msg, sizeof(msg));
+}
+
+// Réception des données au puits, sauts lus dans la route source
+// Data reception at the sink, hops read from the source route
+static void data_input(const uint8_t *data, uint16_t len, uint8_t hops) {
+  struct dsr_data msg;
   
-  // Mise à jour des statistiques / Statistics update
-  packets_sent++;
-  my_energy--;
+  if(len != sizeof(msg)) {
+    return;
+  }
+  memcpy(&msg, data, sizeof(msg));
   
-  // Logs de débogage / Debug logs
-  LOG_INFO("SEND_UDP %u %lu\n", seq_id, clock_time());
-  LOG_INFO("ENERGY %u %lu\n", my_energy, clock_time());
+  // Latence en ms (horloges Cooja alignées) / Latency in ms (aligned Cooja clocks)
+  uint32_t latency = ((uint32_t)clock_time() - msg.send_time) * 1000 / CLOCK_SECOND;
   
-  // Traces de débogage occasionnelles / Occasional debug traces
-  if (random_rand() % 12 == 0) {
-    printf("DSR: Paquet envoyé #%u, énergie: %u mJ\n", seq_id-1, my_energy);
-  }
+  LOG_INFO("DATA_RX %u %u %lu %u\n", msg.origin, msg.seq, (unsigned long)latency, hops);
 }
 
 // Processus principal DSR / Main DSR process
 PROCESS_THREAD(dsr_demo_process, ev, data) {
-  static struct etimer send_timer;
-  static struct etimer route_timer;
+  static struct etimer send_timer, energy_timer;
+  static uint8_t energy_ticks = 0;
   
   PROCESS_BEGIN();
   
-  // Configuration de la connexion UDP / UDP connection setup
-  udp_conn = udp_new(NULL, UIP_HTONS(UDP_PORT), NULL);
-  udp_bind(udp_conn, UIP_HTONS(UDP_PORT));
+  dseran_energy_init();
+  my_energy = dseran_energy_residual();
+  NETSTACK_ROUTING.get_root_ipaddr(&sink_ipaddr);
+  if(node_id == SINK_ID) {
+    NETSTACK_ROUTING.root_start();
+  }
+  dsr_set_input_callback(data_input);
   
-  // Configuration des timers / Timer setup
-  etimer_set(&send_timer, SEND_INTERVAL);
-  etimer_set(&route_timer, CLOCK_SECOND * 30);  // Découverte de route périodique
+  // Configuration des timers, premier envoi décalé / Timer setup, first sending offset
+  etimer_set(&energy_timer, ENERGY_INTERVAL);
+  etimer_set(&send_timer, DATA_INTERVAL + random_rand() % DATA_INTERVAL);
   
-  printf("DSR: Démonstration démarrée, port UDP: %d\n", UDP_PORT);
+  printf("DSR: Démonstration démarrée, puits / sink %u\n", SINK_ID);
   
   while(1) {
-    PROCESS_WAIT_EVENT();
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&send_timer) || etimer_expired(&energy_timer));
     
-    // Gestion du timer d'envoi / Send timer handling
-    if(etimer_expired(&send_timer)) {
-      send_packet();
-      etimer_reset(&send_timer);
+    // Énergie mesurée, cache de routes chaque minute / Measured energy, route cache every minute
+    if(etimer_expired(&energy_timer)) {
+      dseran_energy_update();
+      my_energy = dseran_energy_residual();
+      LOG_INFO("ENERGY %u %lu\n", my_energy, (unsigned long)clock_time());
+      if(++energy_ticks == CACHE_LOG_EVERY) {
+        const struct dsr_stats *st = dsr_get_stats();
+        LOG_INFO("ROUTE_CACHE %lu %lu %lu %lu\n", (unsigned long)st->lookups, (unsigned long)st->hits,
+                 (unsigned long)st->salvaged, (unsigned long)clock_time());
+        energy_ticks = 0;
+      }
+      etimer_reset(&energy_timer);
     }
     
-    // Gestion du timer de découverte de route / Route discovery timer handling
-    if(etimer_expired(&route_timer)) {
-      discover_route();
-      etimer_reset(&route_timer);
+    // Envoi périodique vers le puits / Periodic sending to the sink
+    if(etimer_expired(&send_timer)) {
+      if(node_id != SINK_ID) {
+        send_packet();
+      }
+      etimer_reset(&send_timer);
     }
     
     // Vérification de la fin de vie / Lifetime check
     if(my_energy == 0) {
-      LOG_INFO("LIFETIME %u %lu\n", linkaddr_node_addr.u8[0], clock_time());
+      LOG_INFO("LIFETIME %u %lu\n", linkaddr_node_addr.u8[0], (unsigned long)clock_time());
       printf("DSR: Énergie épuisée, arrêt du protocole\n");
       PROCESS_EXIT();
     }
   }
   
   PROCESS_END();
-} 
\ No newline at end of file
+}
@@ -0,0 +1,904 @@
+/*
+ * dsr.c : Routage par la source DSR (RFC 4728) pour Contiki-NG
+ * DSR source routing (RFC 4728) for Contiki-NG
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Écarts à la RFC : les en-têtes DSR voyagent en UDP (port 4728) sur les
+ * adresses lien-local plutôt qu'en en-tête IPv6 propre ; la maintenance
+ * des routes s'appuie sur l'acquittement MAC (section 8.3.1) et non sur
+ * des demandes d'acquittement ; pas de RREP gratuit, de raccourcissement
+ * automatique des routes ni d'écoute promiscuitaire. Un paquet fragmenté
+ * par 6LoWPAN donne un retour MAC par fragment : la correspondance
+ * trame/paquet du tampon de maintenance n'est alors qu'approchée.
+ * Departures from the RFC: DSR headers travel over UDP (port 4728) on
+ * link-local addresses rather than as an IPv6 header of their own; route
+ * maintenance relies on the MAC ack (section 8.3.1) rather than on ack
+ * requests; no gratuitous RREP, automatic route shortening nor promiscuous
+ * listening. A packet fragmented by 6LoWPAN yields one MAC feedback per
+ * fragment: the frame/packet matching of the maintenance buffer is then
+ * only approximate.
+ */
+
+#include "contiki.h"
+#include "net/routing/routing.h"
+#include "net/ipv6/simple-udp.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "net/linkaddr.h"
+#include "net/mac/mac.h"
+#include "lib/random.h"
+#include "sys/ctimer.h"
+#include "sys/log.h"
+#include "dsr.h"
+#include "dseran-energy.h"
+#include "dseran-net.h"
+#include <string.h>
+
+// Module des journaux attendu par parse_logs.py et logparse / Log module expected by parse_logs.py and logparse
+#define LOG_MODULE "DSR-DEMO"
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+// Messages / Messages
+#define DSR_RREQ 1
+#define DSR_RREP 2
+#define DSR_RERR 3
+#define DSR_DATA 4
+
+#define RREQ_TABLE     16                    // RREQ déjà vus / RREQs already seen
+#define RREQ_LIFETIME  (CLOCK_SECOND * 10)
+#define DISCOVERIES    2
+#define MAINT_NUM      8                     // paquets en attente d'acquittement / packets awaiting an ack
+#define MAINT_TIMEOUT  (CLOCK_SECOND * 2)
+#define DELAYED_NUM    4
+#define BROADCAST_JITTER (CLOCK_SECOND / 50)
+#define BROKEN_NUM     4
+#define PURGE_INTERVAL CLOCK_SECOND
+
+// Charge utile : donnée, ou lien rompu (amont, aval) d'un RERR
+// Payload: data, or broken link (upstream, downstream) of a RERR
+#define PAYLOAD_MAX (DSR_MAX_PAYLOAD > 2 * LINKADDR_SIZE ? DSR_MAX_PAYLOAD : 2 * LINKADDR_SIZE)
+
+struct dsr_hdr {
+  uint8_t type;
+  uint8_t hops;          // adresses dans route[] / addresses in route[]
+  uint8_t next;          // indice du destinataire de la trame / index of the frame receiver
+  uint8_t ttl;           // RREQ : sauts restants ; DATA : sauvetages / RREQ: hops left; DATA: salvages
+  uint16_t id;           // identifiant du RREQ / RREQ identifier
+  uint16_t len;          // charge utile après la route / payload after the route
+  uip_ipaddr_t target;
+};
+
+// Route de la source (indice 0) à la cible ; seuls hops adresses et len
+// octets passent sur l'air / Route from the source (index 0) to the target;
+// only hops addresses and len bytes go on the air
+struct dsr_msg {
+  struct dsr_hdr h;
+  linkaddr_t route[DSR_MAX_HOPS + 1];
+  uint8_t payload[PAYLOAD_MAX];
+};
+#define MSG_MAX sizeof(struct dsr_msg)
+
+// Chemin en cache, du premier saut à la cible ; len 0 : case libre
+// Cached path, from the first hop to the target; len 0: free slot
+struct dsr_path {
+  uip_ipaddr_t target;
+  linkaddr_t hop[DSR_MAX_HOPS];
+  clock_time_t last_used;
+  uint8_t len;
+};
+
+struct rreq_seen {
+  linkaddr_t orig;
+  uint16_t id;
+  clock_time_t expires;
+};
+
+// Découverte en cours : un RREQ non propagé, puis DSR_MAX_REQUEST_REXMT inondations
+// Discovery in progress: one non-propagating RREQ, then DSR_MAX_REQUEST_REXMT floods
+struct discovery {
+  uip_ipaddr_t target;
+  struct ctimer timer;
+  uint8_t attempt;
+  uint8_t used;
+};
+
+// Donnée du tampon d'émission / Send buffer data
+struct pending {
+  uip_ipaddr_t target;
+  uint8_t data[DSR_MAX_PAYLOAD];
+  uint16_t len;
+};
+
+// Paquet envoyé en attente de l'acquittement MAC ; stamp garde l'ordre par
+// voisin, failed marque un échec déjà signalé par le MAC
+// Packet sent awaiting the MAC ack; stamp keeps the order per neighbor,
+// failed marks a failure already reported by the MAC
+struct maint {
+  uint8_t buf[MSG_MAX];
+  uint16_t len;
+  linkaddr_t to;
+  clock_time_t expires;
+  uint16_t stamp;
+  uint8_t failed;
+};
+
+struct delayed {
+  uint8_t buf[MSG_MAX];
+  uint16_t len;
+  struct ctimer timer;
+};
+
+PROCESS(dsr_process, "DSR");
+
+static struct simple_udp_connection dsr_conn;
+static struct dsr_path cache[DSR_CACHE_SIZE];
+static struct rreq_seen seen[RREQ_TABLE];
+static uint8_t seen_pos = 0;
+static struct discovery discoveries[DISCOVERIES];
+static struct pending pending[DSR_SEND_BUFFER];
+static uint8_t pending_len = 0;
+static struct maint maint[MAINT_NUM];
+static uint16_t maint_stamp = 0;
+static struct delayed delayed[DELAYED_NUM];
+static struct dsr_stats stats;
+static dsr_input_callback_t input_cb;
+
+static uip_ipaddr_t my_ipaddr;
+static uip_ipaddr_t sink_ipaddr;
+static uint8_t is_root = 0;
+static uint16_t rreq_id = 0;
+
+// Voisins perdus signalés par le MAC, traités hors de son rappel
+// Lost neighbors reported by the MAC, handled outside its callback
+static linkaddr_t broken[BROKEN_NUM];
+static uint8_t nbroken = 0;
+
+// Forme sur l'air : en-tête de HDR_LEN octets (champs de 16 bits en ordre réseau), hops adresses, len octets
+// Wire form: HDR_LEN-byte header (16-bit fields in network order), hops addresses, len bytes
+#define HDR_LEN 24
+
+static void put_u16(uint8_t *p, uint16_t v) {
+  p[0] = v >> 8;
+  p[1] = v;
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+  return (uint16_t)p[0] << 8 | p[1];
+}
+
+static uint16_t msg_pack(const struct dsr_msg *m, uint8_t *buf) {
+  uint16_t off = HDR_LEN;
+
+  buf[0] = m->h.type;
+  buf[1] = m->h.hops;
+  buf[2] = m->h.next;
+  buf[3] = m->h.ttl;
+  put_u16(&buf[4], m->h.id);
+  put_u16(&buf[6], m->h.len);
+  memcpy(&buf[8], &m->h.target, sizeof(uip_ipaddr_t));
+  memcpy(buf + off, m->route, m->h.hops * sizeof(linkaddr_t));
+  off += m->h.hops * sizeof(linkaddr_t);
+  memcpy(buf + off, m->payload, m->h.len);
+  return off + m->h.len;
+}
+
+static uint8_t msg_unpack(struct dsr_msg *m, const uint8_t *buf, uint16_t len) {
+  uint16_t off = HDR_LEN;
+
+  if(len < off) {
+    return 0;
+  }
+  m->h.type = buf[0];
+  m->h.hops = buf[1];
+  m->h.next = buf[2];
+  m->h.ttl = buf[3];
+  m->h.id = get_u16(&buf[4]);
+  m->h.len = get_u16(&buf[6]);
+  memcpy(&m->h.target, &buf[8], sizeof(uip_ipaddr_t));
+  if(m->h.hops == 0 || m->h.hops > DSR_MAX_HOPS + 1 || m->h.len > PAYLOAD_MAX ||
+     len != off + m->h.hops * sizeof(linkaddr_t) + m->h.len) {
+    return 0;
+  }
+  memcpy(m->route, buf + off, m->h.hops * sizeof(linkaddr_t));
+  off += m->h.hops * sizeof(linkaddr_t);
+  memcpy(m->payload, buf + off, m->h.len);
+  return 1;
+}
+
+static void log_control(uint8_t type) {
+  if(type != DSR_DATA) {
+    LOG_INFO("SEND_UDP %u %lu\n", dseran_energy_residual(), (unsigned long)clock_time());
+  }
+}
+
+static void delayed_cb(void *ptr) {
+  struct delayed *d = ptr;
+  uip_ipaddr_t ip;
+
+  uip_create_linklocal_allnodes_mcast(&ip);
+  simple_udp_sendto(&dsr_conn, d->buf, d->len, &ip);
+  log_control(d->buf[0]);
+  d->len = 0;
+}
+
+// Diffusion après une gigue aléatoire, immédiate si aucune place
+// Broadcast after a random jitter, immediate when no slot is free
+static void send_broadcast(const struct dsr_msg *m) {
+  struct delayed *d = NULL;
+
+  for(uint8_t i=0; i<DELAYED_NUM; i++) {
+    if(delayed[i].len == 0) {
+      d = &delayed[i];
+      break;
+    }
+  }
+  if(d == NULL) {
+    struct delayed now;
+    now.len = msg_pack(m, now.buf);
+    delayed_cb(&now);
+    return;
+  }
+  d->len = msg_pack(m, d->buf);
+  ctimer_set(&d->timer, 1 + random_rand() % BROADCAST_JITTER, delayed_cb, d);
+}
+
+// Unicast vers route[next], gardé jusqu'à son acquittement MAC ; le plus
+// ancien suivi cède sa place / Unicast to route[next], kept until its MAC ack;
+// the oldest tracked one gives way
+static void send_unicast(const struct dsr_msg *m) {
+  struct maint *e = &maint[0];
+  uip_ipaddr_t ip;
+
+  for(uint8_t i=0; i<MAINT_NUM; i++) {
+    if(maint[i].len == 0) {
+      e = &maint[i];
+      break;
+    }
+    if((int16_t)(maint[i].stamp - e->stamp) < 0) {
+      e = &maint[i];
+    }
+  }
+  e->len = msg_pack(m, e->buf);
+  linkaddr_copy(&e->to, &m->route[m->h.next]);
+  e->expires = clock_time() + MAINT_TIMEOUT;
+  e->stamp = maint_stamp++;
+  e->failed = 0;
+
+  dseran_net_nbr_ipaddr(&ip, &e->to);
+  simple_udp_sendto(&dsr_conn, e->buf, e->len, &ip);
+  log_control(m->h.type);
+}
+
+// Premier paquet suivi vers ce voisin, en échec ou encore en attente du MAC
+// First packet tracked towards this neighbor, failed or still awaiting the MAC
+static struct maint *maint_oldest(const linkaddr_t *to, uint8_t failed) {
+  struct maint *e = NULL;
+
+  for(uint8_t i=0; i<MAINT_NUM; i++) {
+    if(maint[i].len != 0 && maint[i].failed == failed && linkaddr_cmp(&maint[i].to, to) &&
+       (e == NULL || (int16_t)(maint[i].stamp - e->stamp) < 0)) {
+      e = &maint[i];
+    }
+  }
+  return e;
+}
+
+// Cache de chemins / Path cache
+
+static uint8_t path_has(const linkaddr_t *hop, uint8_t len, const linkaddr_t *a) {
+  for(uint8_t i=0; i<len; i++) {
+    if(linkaddr_cmp(&hop[i], a)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Chemin le plus court vers target, le plus récemment utilisé à égalité
+// Shortest path to target, the most recently used on a tie
+static struct dsr_path *cache_lookup(const uip_ipaddr_t *target) {
+  struct dsr_path *best = NULL;
+
+  for(uint8_t i=0; i<DSR_CACHE_SIZE; i++) {
+    struct dsr_path *p = &cache[i];
+    if(p->len == 0 || !uip_ipaddr_cmp(&p->target, target)) {
+      continue;
+    }
+    if(best == NULL || p->len < best->len ||
+       (p->len == best->len && CLOCK_LT(best->last_used, p->last_used))) {
+      best = p;
+    }
+  }
+  return best;
+}
+
+// Chemin ajouté ou rafraîchi ; sans place, le moins récemment utilisé est évincé
+// Path added or refreshed; without room, the least recently used one is evicted
+static void cache_add(const uip_ipaddr_t *target, const linkaddr_t *hop, uint8_t len) {
+  struct dsr_path *victim = NULL;
+
+  if(len == 0 || len > DSR_MAX_HOPS || path_has(hop, len, &linkaddr_node_addr)) {
+    return;
+  }
+  for(uint8_t i=0; i<DSR_CACHE_SIZE; i++) {
+    struct dsr_path *p = &cache[i];
+    if(p->len == len && uip_ipaddr_cmp(&p->target, target) &&
+       memcmp(p->hop, hop, len * sizeof(linkaddr_t)) == 0) {
+      p->last_used = clock_time();
+      return;
+    }
+    if(victim == NULL || (victim->len != 0 && (p->len == 0 || CLOCK_LT(p->last_used, victim->last_used)))) {
+      victim = p;
+    }
+  }
+  uip_ipaddr_copy(&victim->target, target);
+  memcpy(victim->hop, hop, len * sizeof(linkaddr_t));
+  victim->len = len;
+  victim->last_used = clock_time();
+}
+
+// Chemins empruntant le lien a-b, dans un sens ou l'autre, effacés
+// Paths using the a-b link, in either direction, erased
+static void cache_remove_link(const linkaddr_t *a, const linkaddr_t *b) {
+  for(uint8_t i=0; i<DSR_CACHE_SIZE; i++) {
+    struct dsr_path *p = &cache[i];
+    const linkaddr_t *prev = &linkaddr_node_addr;
+    for(uint8_t j=0; j<p->len; j++) {
+      if((linkaddr_cmp(prev, a) && linkaddr_cmp(&p->hop[j], b)) ||
+         (linkaddr_cmp(prev, b) && linkaddr_cmp(&p->hop[j], a))) {
+        p->len = 0;
+        break;
+      }
+      prev = &p->hop[j];
+    }
+  }
+}
+
+// Émission de données / Data transmission
+
+static void data_originate(struct dsr_path *p, const uip_ipaddr_t *target, const uint8_t *data,
+                           uint16_t len, uint8_t salvage) {
+  struct dsr_msg m;
+
+  memset(&m.h, 0, sizeof(m.h));
+  m.h.type = DSR_DATA;
+  m.h.hops = p->len + 1;
+  m.h.next = 1;
+  m.h.ttl = salvage;
+  m.h.len = len;
+  uip_ipaddr_copy(&m.h.target, target);
+  linkaddr_copy(&m.route[0], &linkaddr_node_addr);
+  memcpy(&m.route[1], p->hop, p->len * sizeof(linkaddr_t));
+  memcpy(m.payload, data, len);
+  p->last_used = clock_time();
+  send_unicast(&m);
+}
+
+static void pending_add(const uip_ipaddr_t *target, const uint8_t *data, uint16_t len) {
+  if(pending_len == DSR_SEND_BUFFER) {
+    memmove(&pending[0], &pending[1], (DSR_SEND_BUFFER - 1) * sizeof(pending[0]));
+    pending_len--;
+  }
+  uip_ipaddr_copy(&pending[pending_len].target, target);
+  memcpy(pending[pending_len].data, data, len);
+  pending[pending_len].len = len;
+  pending_len++;
+}
+
+// Découverte de route / Route discovery
+
+static uint8_t rreq_seen(const linkaddr_t *orig, uint16_t id) {
+  clock_time_t now = clock_time();
+
+  for(uint8_t i=0; i<RREQ_TABLE; i++) {
+    if(seen[i].id == id && CLOCK_LT(now, seen[i].expires) && linkaddr_cmp(&seen[i].orig, orig)) {
+      return 1;
+    }
+  }
+  linkaddr_copy(&seen[seen_pos].orig, orig);
+  seen[seen_pos].id = id;
+  seen[seen_pos].expires = now + RREQ_LIFETIME;
+  seen_pos = (seen_pos + 1) % RREQ_TABLE;
+  return 0;
+}
+
+static struct discovery *discovery_lookup(const uip_ipaddr_t *target) {
+  for(uint8_t i=0; i<DISCOVERIES; i++) {
+    if(discoveries[i].used && uip_ipaddr_cmp(&discoveries[i].target, target)) {
+      return &discoveries[i];
+    }
+  }
+  return NULL;
+}
+
+// Fin de découverte : les données en attente partent par le chemin trouvé ou sont perdues
+// Discovery end: the pending data leaves through the path found or is lost
+static void discovery_end(const uip_ipaddr_t *target, struct dsr_path *p) {
+  struct discovery *d = discovery_lookup(target);
+  uint8_t kept = 0;
+
+  if(d != NULL) {
+    ctimer_stop(&d->timer);
+    d->used = 0;
+  }
+  if(p != NULL) {
+    LOG_INFO("HOP %u %lu\n", p->len, (unsigned long)clock_time());
+  } else {
+    stats.failures++;
+  }
+  for(uint8_t i=0; i<pending_len; i++) {
+    if(!uip_ipaddr_cmp(&pending[i].target, target)) {
+      pending[kept++] = pending[i];
+    } else if(p != NULL) {
+      data_originate(p, target, pending[i].data, pending[i].len, 0);
+    }
+  }
+  pending_len = kept;
+}
+
+static void rreq_originate(struct discovery *d) {
+  struct dsr_msg m;
+
+  memset(&m.h, 0, sizeof(m.h));
+  m.h.type = DSR_RREQ;
+  m.h.hops = 1;
+  m.h.ttl = d->attempt == 0 ? 1 : DSR_MAX_HOPS;
+  m.h.id = ++rreq_id;
+  uip_ipaddr_copy(&m.h.target, &d->target);
+  linkaddr_copy(&m.route[0], &linkaddr_node_addr);
+  rreq_seen(&m.route[0], m.h.id);
+  send_broadcast(&m);
+  stats.rreq_sent++;
+}
+
+// Attente doublée à chaque inondation, bornée par DSR_MAX_REQUEST_PERIOD (section 8.2.1)
+// Wait doubled at every flood, capped by DSR_MAX_REQUEST_PERIOD (section 8.2.1)
+static void discovery_timeout(void *ptr) {
+  struct discovery *d = ptr;
+  clock_time_t wait;
+
+  if(++d->attempt > DSR_MAX_REQUEST_REXMT) {
+    discovery_end(&d->target, NULL);
+    return;
+  }
+  wait = DSR_REQUEST_PERIOD << (d->attempt - 1);
+  if(wait > DSR_MAX_REQUEST_PERIOD) {
+    wait = DSR_MAX_REQUEST_PERIOD;
+  }
+  rreq_originate(d);
+  ctimer_set(&d->timer, wait, discovery_timeout, d);
+}
+
+static void discover(const uip_ipaddr_t *target) {
+  struct discovery *d = NULL;
+
+  if(discovery_lookup(target) != NULL) {
+    return;
+  }
+  for(uint8_t i=0; i<DISCOVERIES; i++) {
+    if(!discoveries[i].used) {
+      d = &discoveries[i];
+      break;
+    }
+  }
+  if(d == NULL) {
+    discovery_end(target, NULL);
+    return;
+  }
+  stats.discoveries++;
+  LOG_INFO("ROUTE_DISC %lu %lu\n", (unsigned long)stats.discoveries, (unsigned long)clock_time());
+
+  uip_ipaddr_copy(&d->target, target);
+  d->used = 1;
+  d->attempt = 0;
+  rreq_originate(d);
+  ctimer_set(&d->timer, DSR_NONPROP_TIMEOUT, discovery_timeout, d);
+}
+
+// Interface publique / Public interface
+
+void dsr_set_input_callback(dsr_input_callback_t cb) {
+  input_cb = cb;
+}
+
+uint8_t dsr_send(const uip_ipaddr_t *target, const void *data, uint16_t len) {
+  struct dsr_path *p;
+
+  if(len > DSR_MAX_PAYLOAD) {
+    return 0;
+  }
+  stats.lookups++;
+  p = cache_lookup(target);
+  if(p != NULL) {
+    stats.hits++;
+    data_originate(p, target, data, len, 0);
+    return 1;
+  }
+  pending_add(target, data, len);
+  discover(target);
+  return 1;
+}
+
+uint8_t dsr_route_cached(const uip_ipaddr_t *target, uint8_t *hops) {
+  const struct dsr_path *p = cache_lookup(target);
+
+  if(p == NULL) {
+    return 0;
+  }
+  if(hops != NULL) {
+    *hops = p->len;
+  }
+  return 1;
+}
+
+const struct dsr_stats *dsr_get_stats(void) {
+  return &stats;
+}
+
+// Maintenance de route / Route maintenance
+
+// RERR vers la source par le début de route déjà parcouru, à rebours
+// RERR to the source through the part of the route already travelled, backwards
+static void rerr_send(const struct dsr_msg *data, const linkaddr_t *nbr) {
+  struct dsr_msg m;
+  uint8_t me = data->h.next - 1;
+
+  memset(&m.h, 0, sizeof(m.h));
+  m.h.type = DSR_RERR;
+  m.h.hops = me + 1;
+  m.h.next = 1;
+  m.h.len = 2 * LINKADDR_SIZE;
+  dseran_net_global_from_lladdr(&m.h.target, &data->route[0]);
+  for(uint8_t i=0; i<=me; i++) {
+    linkaddr_copy(&m.route[i], &data->route[me - i]);
+  }
+  memcpy(m.payload, &linkaddr_node_addr, LINKADDR_SIZE);
+  memcpy(m.payload + LINKADDR_SIZE, nbr, LINKADDR_SIZE);
+  send_unicast(&m);
+  stats.rerr_sent++;
+}
+
+// Sauvetage par un relais : la route déjà parcourue, source d'origine en
+// tête, est prolongée par le chemin en cache et le compteur de sauvetages
+// augmente (section 8.4.1) ; la cible compte ainsi les sauts réels depuis la
+// vraie source / Salvage by a relay: the route already travelled, original
+// source first, is extended with the cached path and the salvage count goes
+// up (section 8.4.1); the target thus counts the actual hops from the real source
+static void data_resend(const struct dsr_msg *m, const struct dsr_path *p) {
+  static struct dsr_msg s;
+  uint8_t me = m->h.next - 1;
+
+  s.h = m->h;
+  s.h.hops = me + 1 + p->len;
+  s.h.next = me + 1;
+  s.h.ttl++;
+  memcpy(s.route, m->route, (me + 1) * sizeof(linkaddr_t));
+  memcpy(&s.route[me + 1], p->hop, p->len * sizeof(linkaddr_t));
+  memcpy(s.payload, m->payload, m->h.len);
+  send_unicast(&s);
+}
+
+// Donnée dont le prochain saut ne répond plus : la source la renvoie ou la
+// remet en attente, un relais la sauve par un autre chemin (section 8.4.1)
+// Data whose next hop no longer answers: the source resends or buffers it,
+// a relay salvages it through another path (section 8.4.1)
+static void data_salvage(const struct dsr_msg *m) {
+  struct dsr_path *p = cache_lookup(&m->h.target);
+  uint8_t me = m->h.next - 1;
+
+  if(m->h.next == 1) {
+    if(p != NULL) {
+      data_originate(p, &m->h.target, m->payload, m->h.len, m->h.ttl);
+    } else {
+      pending_add(&m->h.target, m->payload, m->h.len);
+      discover(&m->h.target);
+    }
+    return;
+  }
+  // Sans boucle avec la route déjà parcourue / Without a loop through the route already travelled
+  if(p == NULL || m->h.ttl >= DSR_MAX_SALVAGE || me + 1 + p->len > DSR_MAX_HOPS + 1) {
+    return;
+  }
+  for(uint8_t i=0; i<p->len; i++) {
+    if(path_has(m->route, me, &p->hop[i])) {
+      return;
+    }
+  }
+  data_resend(m, p);
+  stats.salvaged++;
+}
+
+// Lien rompu : chemins effacés, puis chaque paquet dont le MAC a signalé
+// l'échec vers ce voisin est signalé à sa source (une fois par source) et
+// sauvé si possible ; ceux encore en file MAC attendent leur propre retour,
+// un acquittement tardif ne doit pas produire de doublon
+// Broken link: paths erased, then every packet towards this neighbor whose
+// failure the MAC reported is reported to its source (once per source) and
+// salvaged when possible; those still queued in the MAC wait for their own
+// feedback, a late ack must not produce a duplicate
+static void link_break(const linkaddr_t *nbr) {
+  linkaddr_t reported[MAINT_NUM];
+  uint8_t nreported = 0;
+  struct maint *e;
+  struct dsr_msg m;
+
+  stats.link_breaks++;
+  cache_remove_link(&linkaddr_node_addr, nbr);
+  while((e = maint_oldest(nbr, 1)) != NULL) {
+    uint8_t ok = msg_unpack(&m, e->buf, e->len);
+    e->len = 0;
+    if(!ok || m.h.type != DSR_DATA) {
+      continue;
+    }
+    if(m.h.next > 1 && !path_has(reported, nreported, &m.route[0])) {
+      linkaddr_copy(&reported[nreported++], &m.route[0]);
+      rerr_send(&m, nbr);
+    }
+    data_salvage(&m);
+  }
+}
+
+// Réception / Reception
+
+static void rreq_input(struct dsr_msg *m) {
+  struct dsr_path *p;
+  uint8_t n;
+
+  if(path_has(m->route, m->h.hops, &linkaddr_node_addr) || rreq_seen(&m->route[0], m->h.id) ||
+     m->h.hops > DSR_MAX_HOPS) {
+    return;
+  }
+  n = m->h.hops;
+  linkaddr_copy(&m->route[n++], &linkaddr_node_addr);
+  m->h.hops = n;
+
+  if(uip_ds6_is_my_addr(&m->h.target)) {
+    // Réponse de la cible par la route inverse (section 8.2.2) / Reply by the target through the reverse route (section 8.2.2)
+    m->h.type = DSR_RREP;
+    m->h.next = n - 2;
+    send_unicast(m);
+    stats.rrep_sent++;
+    return;
+  }
+
+  p = cache_lookup(&m->h.target);
+  if(p != NULL && n + p->len <= DSR_MAX_HOPS + 1) {
+    // Réponse du cache si la route complète reste sans boucle (section 8.2.3)
+    // Cache reply when the complete route stays loop-free (section 8.2.3)
+    uint8_t loop = 0;
+    for(uint8_t i=0; i<p->len && !loop; i++) {
+      loop = path_has(m->route, n, &p->hop[i]);
+    }
+    if(!loop) {
+      memcpy(&m->route[n], p->hop, p->len * sizeof(linkaddr_t));
+      m->h.type = DSR_RREP;
+      m->h.hops = n + p->len;
+      m->h.next = n - 2;
+      p->last_used = clock_time();
+      send_unicast(m);
+      stats.rrep_sent++;
+      stats.cache_replies++;
+      return;
+    }
+  }
+
+  // Relais si le TTL et la place pour la cible le permettent / Relay when the TTL and room for the target allow
+  if(m->h.ttl > 1 && n < DSR_MAX_HOPS + 1) {
+    m->h.ttl--;
+    send_broadcast(m);
+    stats.rreq_sent++;
+  }
+}
+
+static void rrep_input(struct dsr_msg *m) {
+  uint8_t me = m->h.next;
+
+  // Suite du chemin vers la cible, apprise par chaque nœud du retour
+  // Rest of the path to the target, learnt by every node on the way back
+  cache_add(&m->h.target, &m->route[me + 1], m->h.hops - me - 1);
+  if(me == 0) {
+    if(discovery_lookup(&m->h.target) != NULL) {
+      discovery_end(&m->h.target, cache_lookup(&m->h.target));
+    }
+    return;
+  }
+  m->h.next--;
+  send_unicast(m);
+  stats.rrep_sent++;
+}
+
+static void rerr_input(struct dsr_msg *m) {
+  linkaddr_t a, b;
+
+  if(m->h.len != 2 * LINKADDR_SIZE) {
+    return;
+  }
+  memcpy(&a, m->payload, LINKADDR_SIZE);
+  memcpy(&b, m->payload + LINKADDR_SIZE, LINKADDR_SIZE);
+  cache_remove_link(&a, &b);
+  if(m->h.next + 1 < m->h.hops) {
+    m->h.next++;
+    send_unicast(m);
+    stats.rerr_sent++;
+  }
+}
+
+static void data_input(struct dsr_msg *m) {
+  uint8_t me = m->h.next;
+
+  if(me + 1 == m->h.hops) {
+    if(uip_ds6_is_my_addr(&m->h.target) && input_cb != NULL) {
+      input_cb(m->payload, m->h.len, m->h.hops - 1);
+    }
+    return;
+  }
+  // Chemin vers la cible appris de la route source / Path to the target learnt from the source route
+  cache_add(&m->h.target, &m->route[me + 1], m->h.hops - me - 1);
+  m->h.next++;
+  send_unicast(m);
+}
+
+static void dsr_rx_callback(struct simple_udp_connection *c, const uip_ipaddr_t *sender_addr,
+                            uint16_t sender_port, const uip_ipaddr_t *receiver_addr,
+                            uint16_t receiver_port, const uint8_t *data, uint16_t datalen) {
+  static struct dsr_msg m;
+
+  if(!msg_unpack(&m, data, datalen)) {
+    return;
+  }
+  if(m.h.type != DSR_DATA) {
+    LOG_INFO("RECV %u %lu\n", dseran_energy_residual(), (unsigned long)clock_time());
+  }
+  if(m.h.type == DSR_RREQ) {
+    rreq_input(&m);
+    return;
+  }
+  // Unicast suivant une route : ce nœud doit en être le saut courant
+  // Unicast following a route: this node must be its current hop
+  if(m.h.next >= m.h.hops || !linkaddr_cmp(&m.route[m.h.next], &linkaddr_node_addr)) {
+    return;
+  }
+  switch(m.h.type) {
+  case DSR_RREP:
+    rrep_input(&m);
+    break;
+  case DSR_RERR:
+    rerr_input(&m);
+    break;
+  case DSR_DATA:
+    data_input(&m);
+    break;
+  default:
+    LOG_WARN("Message DSR inconnu / unknown DSR message %u\n", m.h.type);
+  }
+}
+
+// Chemins inutilisés et paquets jamais acquittés oubliés / Unused paths and never acked packets forgotten
+static void purge(void) {
+  clock_time_t now = clock_time();
+
+  for(uint8_t i=0; i<DSR_CACHE_SIZE; i++) {
+    if(cache[i].len != 0 && !CLOCK_LT(now, cache[i].last_used + DSR_CACHE_TIMEOUT)) {
+      cache[i].len = 0;
+    }
+  }
+  for(uint8_t i=0; i<MAINT_NUM; i++) {
+    if(maint[i].len != 0 && !CLOCK_LT(now, maint[i].expires)) {
+      maint[i].len = 0;
+    }
+  }
+}
+
+PROCESS_THREAD(dsr_process, ev, data) {
+  static struct etimer purge_timer;
+
+  PROCESS_BEGIN();
+
+  simple_udp_register(&dsr_conn, DSR_UDP_PORT, NULL, DSR_UDP_PORT, dsr_rx_callback);
+  etimer_set(&purge_timer, PURGE_INTERVAL);
+  while(1) {
+    PROCESS_WAIT_EVENT();
+    if(ev == PROCESS_EVENT_POLL) {
+      for(uint8_t i=0; i<nbroken; i++) {
+        link_break(&broken[i]);
+      }
+      nbroken = 0;
+    }
+    if(etimer_expired(&purge_timer)) {
+      purge();
+      etimer_reset(&purge_timer);
+    }
+  }
+
+  PROCESS_END();
+}
+
+// Interface du pilote de routage / Routing driver interface
+
+// Adresse globale fd00::IID et adresse bien connue du puits, fd00::1
+// Global fd00::IID address and well-known sink address, fd00::1
+static void driver_init(void) {
+  dseran_net_global_from_lladdr(&my_ipaddr, &linkaddr_node_addr);
+  uip_ds6_addr_add(&my_ipaddr, 0, ADDR_AUTOCONF);
+  uip_ip6addr(&sink_ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 1);
+  process_start(&dsr_process, NULL);
+}
+
+static int driver_root_start(void) {
+  if(!is_root) {
+    is_root = 1;
+    uip_ds6_addr_add(&sink_ipaddr, 0, ADDR_MANUAL);
+  }
+  return 0;
+}
+
+static int driver_node_is_root(void) {
+  return is_root;
+}
+
+static int driver_get_root_ipaddr(uip_ipaddr_t *ipaddr) {
+  uip_ipaddr_copy(ipaddr, &sink_ipaddr);
+  return 1;
+}
+
+// À la demande : joint dès qu'un chemin vers le puits est en cache / On demand: joined once a path to the sink is cached
+static int driver_node_has_joined(void) {
+  return is_root || dsr_route_cached(&sink_ipaddr, NULL);
+}
+
+static int driver_node_is_reachable(void) {
+  return driver_node_has_joined();
+}
+
+// Retour MAC : un acquittement libère le plus ancien paquet suivi vers ce
+// voisin, un échec le marque et rompt le lien / MAC feedback: an ack releases
+// the oldest packet tracked towards this neighbor, a failure marks it and
+// breaks the link
+static void driver_link_callback(const linkaddr_t *addr, int status, int numtx) {
+  struct maint *e = maint_oldest(addr, 0);
+
+  if(status == MAC_TX_OK) {
+    if(e != NULL) {
+      e->len = 0;
+    }
+  } else if(status == MAC_TX_NOACK) {
+    if(e != NULL) {
+      e->failed = 1;
+    }
+    for(uint8_t i=0; i<nbroken; i++) {
+      if(linkaddr_cmp(&broken[i], addr)) {
+        return;
+      }
+    }
+    if(nbroken < BROKEN_NUM) {
+      linkaddr_copy(&broken[nbroken++], addr);
+      process_poll(&dsr_process);
+    }
+  }
+}
+
+const struct routing_driver dsr_routing_driver = {
+  "dsr",
+  driver_init,
+  dseran_net_root_set_prefix,
+  driver_root_start,
+  driver_node_is_root,
+  driver_get_root_ipaddr,
+  dseran_net_get_sr_node_ipaddr,
+  dseran_net_leave_network,
+  driver_node_has_joined,
+  driver_node_is_reachable,
+  dseran_net_repair,
+  dseran_net_repair,
+  dseran_net_ext_header_remove,
+  dseran_net_ext_header_update,
+  dseran_net_ext_header_hbh_update,
+  dseran_net_ext_header_srh_update,
+  dseran_net_ext_header_srh_get_next_hop,
+  driver_link_callback,
+  dseran_net_neighbor_state_changed,
+  dseran_net_drop_route,
+  dseran_net_is_in_leaf_mode,
+};
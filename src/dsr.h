@@ -0,0 +1,121 @@
+/*
+ * dsr.h : Routage par la source DSR (RFC 4728) pour Contiki-NG
+ * DSR source routing (RFC 4728) for Contiki-NG
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Chaque donnée porte la liste complète de ses sauts (adresses lien) et
+ * chaque nœud la relaie, en UDP lien-local, au suivant de la liste ; uIP ne
+ * route rien. Les chemins viennent d'un cache borné, évincé au plus
+ * anciennement utilisé, rempli par les RREP et par les routes source des
+ * données relayées, et purgé des liens rompus. Sans chemin, la donnée
+ * attend dans le tampon d'émission la fin d'une découverte : RREQ non
+ * propagé aux voisins, puis inondé avec attente doublée à chaque essai ;
+ * un intermédiaire qui connaît la suite répond depuis son cache. Une trame
+ * non acquittée rompt le lien : les chemins qui l'empruntent sont effacés,
+ * un RERR remonte vers la source et la donnée est sauvée par un autre
+ * chemin du cache si possible.
+ * Every data packet carries the complete list of its hops (link addresses)
+ * and every node relays it, over link-local UDP, to the next one in the
+ * list; uIP routes nothing. Paths come from a bounded cache, evicted least
+ * recently used first, filled by RREPs and by the source routes of relayed
+ * data, and purged of broken links. Without a path, data waits in the send
+ * buffer for a discovery to end: a non-propagating RREQ to the neighbors,
+ * then a flooded one with the wait doubled at every attempt; an
+ * intermediate node that knows the rest of the way replies from its cache.
+ * An unacked frame breaks the link: the paths using it are erased, a RERR
+ * goes back to the source and the data is salvaged through another cached
+ * path when possible.
+ */
+
+#ifndef DSR_H_
+#define DSR_H_
+
+#include "contiki.h"
+#include "net/ipv6/uip.h"
+
+// Sauts au plus dans une route source / Hops at most in a source route
+#ifdef DSR_CONF_MAX_HOPS
+#define DSR_MAX_HOPS DSR_CONF_MAX_HOPS
+#else
+#define DSR_MAX_HOPS 16
+#endif
+
+// Chemins en cache, toutes destinations confondues / Cached paths, all destinations together
+#ifdef DSR_CONF_CACHE_SIZE
+#define DSR_CACHE_SIZE DSR_CONF_CACHE_SIZE
+#else
+#define DSR_CACHE_SIZE 8
+#endif
+
+// Chemin inutilisé plus longtemps : oublié / Path unused for longer: forgotten
+#ifdef DSR_CONF_CACHE_TIMEOUT
+#define DSR_CACHE_TIMEOUT DSR_CONF_CACHE_TIMEOUT
+#else
+#define DSR_CACHE_TIMEOUT (CLOCK_SECOND * 300)
+#endif
+
+// Données en attente d'une découverte / Data awaiting a discovery
+#ifdef DSR_CONF_SEND_BUFFER
+#define DSR_SEND_BUFFER DSR_CONF_SEND_BUFFER
+#else
+#define DSR_SEND_BUFFER 4
+#endif
+
+// Charge utile au plus d'une donnée / Largest data payload
+#ifdef DSR_CONF_MAX_PAYLOAD
+#define DSR_MAX_PAYLOAD DSR_CONF_MAX_PAYLOAD
+#else
+#define DSR_MAX_PAYLOAD 16
+#endif
+
+// Découverte : RREQ aux voisins seuls, puis inondations (RFC 4728, section 9)
+// Discovery: RREQ to the neighbors only, then floods (RFC 4728, section 9)
+#define DSR_NONPROP_TIMEOUT  (CLOCK_SECOND / 32)
+#define DSR_REQUEST_PERIOD   (CLOCK_SECOND / 2)
+#define DSR_MAX_REQUEST_PERIOD (CLOCK_SECOND * 10)
+#ifdef DSR_CONF_MAX_REQUEST_REXMT
+#define DSR_MAX_REQUEST_REXMT DSR_CONF_MAX_REQUEST_REXMT
+#else
+#define DSR_MAX_REQUEST_REXMT 3
+#endif
+
+// Sauvetages au plus d'une même donnée / Salvages at most of a single data packet
+#define DSR_MAX_SALVAGE 15
+
+#define DSR_UDP_PORT 4728
+
+// Donnée remise à la destination, hops sauts plus loin que sa source
+// Data delivered to the destination, hops hops away from its source
+typedef void (*dsr_input_callback_t)(const uint8_t *data, uint16_t len, uint8_t hops);
+
+// Compteurs depuis le démarrage / Counters since boot
+struct dsr_stats {
+  uint32_t lookups;         // envois de la source / sends at the source
+  uint32_t hits;            // ... servis par le cache / ... served by the cache
+  uint32_t discoveries;
+  uint32_t failures;        // découvertes sans réponse / unanswered discoveries
+  uint32_t rreq_sent;       // émis ou relayés / originated or relayed
+  uint32_t rrep_sent;       // dont réponses du cache : cache_replies / cache replies among them: cache_replies
+  uint32_t cache_replies;
+  uint32_t rerr_sent;
+  uint32_t salvaged;
+  uint32_t link_breaks;
+};
+
+// Appelé pour chaque donnée dont ce nœud est la destination
+// Called for every data packet this node is the destination of
+void dsr_set_input_callback(dsr_input_callback_t cb);
+
+// Envoi par le cache, sinon mise en attente et découverte ; 0 si la donnée est rejetée
+// Send through the cache, otherwise buffer and discover; 0 when the data is rejected
+uint8_t dsr_send(const uip_ipaddr_t *target, const void *data, uint16_t len);
+
+// Vrai si le cache a un chemin vers target (sauts dans *hops si non NULL)
+// True when the cache holds a path to target (hops in *hops when not NULL)
+uint8_t dsr_route_cached(const uip_ipaddr_t *target, uint8_t *hops);
+
+const struct dsr_stats *dsr_get_stats(void);
+
+#endif /* DSR_H_ */
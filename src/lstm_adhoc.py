@@ -1,21 +0,0 @@
-# lstm_adhoc.py : LSTM pour prédiction énergétique et détection d'anomalies
-import numpy as np
-# from tensorflow.lite import Interpreter  # Pour modèle quantifié 8 bits
-
-def predict_energy(history):
-    """Prédit la consommation d'énergie future à partir de l'historique."""
-    # Charger le modèle LSTM quantifié, faire la prédiction
-    # ...
-    return 0.0  # Valeur prédite (exemple)
-
-def detect_anomaly(history):
-    """Détecte une anomalie dans la série temporelle d'énergie."""
-    # Charger le modèle, renvoyer True/False
-    # ...
-    return False
-
-if __name__ == "__main__":
-    # Exemple d'utilisation
-    h = np.zeros(10)
-    print("Prediction:", predict_energy(h))
-    print("Anomaly:", detect_anomaly(h)) 
\ No newline at end of file
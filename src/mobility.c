@@ -5,35 +5,167 @@
  * Auteur / Author: Madani Belacel
  * Date: Août 2025
  * 
- * Implémentation des modèles de mobilité pour simulations MANET
- * Implementation of mobility models for MANET simulations
+ * Implémentation des modèles de mobilité pour simulations MANET. Les tirages
+ * utilisent un générateur propre au module (xorshift32), initialisé par
+ * DSERAN_MOBILITY_SEED et node_id : les trajectoires ne dépendent ni de
+ * random_rand() ni de l'ordre des autres événements.
+ * Implementation of mobility models for MANET simulations. Draws use a
+ * module-private generator (xorshift32), seeded from DSERAN_MOBILITY_SEED and
+ * node_id: trajectories depend neither on random_rand() nor on the order of
+ * other events.
  */
 
 #include "contiki.h"
-#include "lib/random.h"
+#include "sys/node-id.h"
+#include "mobility.h"
+#include "dseran-trace.h"
 #include <stdio.h>
 #include <math.h>
 
+// Pas de temps en s / Time step in s
+#define MOBILITY_DT ((float)DSERAN_MOBILITY_INTERVAL / CLOCK_SECOND)
+
+// Gauss-Markov : moyenne et écarts types, bande de bord en m
+// Gauss-Markov: mean and standard deviations, edge band in m
+#define GM_SPEED_MEAN  ((DSERAN_MOBILITY_SPEED_MIN + DSERAN_MOBILITY_SPEED_MAX) / 2)
+#define GM_SPEED_SIGMA ((DSERAN_MOBILITY_SPEED_MAX - DSERAN_MOBILITY_SPEED_MIN) / 4)
+#define GM_DIR_SIGMA   ((float)M_PI / 4)
+#define GM_EDGE        (DSERAN_MOBILITY_AREA / 10)
+
 // Structures pour la position, la vitesse, etc. / Structures for position, speed, etc.
 typedef struct {
-  float x, y;           // Coordonnées 2D / 2D coordinates
-  float speed;          // Vitesse en unités/tour / Speed in units/turn
-  float direction;      // Direction en degrés / Direction in degrees
+  float x, y;           // Coordonnées 2D en m / 2D coordinates in m
+  float speed;          // Vitesse en m/s / Speed in m/s
+  float direction;      // Direction en radians / Direction in radians
+  float wx, wy;         // Destination RWP / RWP waypoint
+  float mean_dir;       // Direction moyenne Gauss-Markov / Gauss-Markov mean direction
+  uint16_t pause;       // Pas de pause restants / Remaining pause steps
 } node_mobility_t;
 
 static node_mobility_t my_mobility;
+static uint32_t rng_state;
+#if DSERAN_MOBILITY_MODEL == MOBILITY_MODEL_GAUSS_MARKOV
+static float gm_alpha;  // mémoire par pas / memory per step
+#endif
+
+PROCESS(mobility_process, "D-SERAN mobility");
+
+// xorshift32 : reproductible d'une plateforme à l'autre / reproducible across platforms
+static uint32_t rng_next(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+// Uniforme dans [0, 1) sur 24 bits / Uniform in [0, 1) over 24 bits
+static float rng_uniform(void) {
+  return (rng_next() >> 8) * (1.0f / 16777216.0f);
+}
+
+#if DSERAN_MOBILITY_MODEL == MOBILITY_MODEL_GAUSS_MARKOV
+// Normale centrée réduite (Box-Muller) / Standard normal (Box-Muller)
+static float rng_gauss(void) {
+  float u = 1.0f - rng_uniform();    // (0, 1] : log défini / log defined
+  
+  return sqrtf(-2.0f * logf(u)) * cosf(2.0f * (float)M_PI * rng_uniform());
+}
+
+// Un pas Gauss-Markov ; près d'un bord, la direction moyenne vise le centre
+// One Gauss-Markov step; near an edge, the mean direction aims at the centre
+static void gauss_markov_step(void) {
+  float a = gm_alpha;
+  float noise = sqrtf(1.0f - a * a);
+  float mean_dir = my_mobility.mean_dir;
+  
+  if(my_mobility.x < GM_EDGE || my_mobility.x > DSERAN_MOBILITY_AREA - GM_EDGE ||
+     my_mobility.y < GM_EDGE || my_mobility.y > DSERAN_MOBILITY_AREA - GM_EDGE) {
+    mean_dir = atan2f(DSERAN_MOBILITY_AREA / 2 - my_mobility.y, DSERAN_MOBILITY_AREA / 2 - my_mobility.x);
+    // Écart angulaire le plus court / Shortest angular gap
+    while(mean_dir - my_mobility.direction > (float)M_PI) {
+      mean_dir -= 2 * (float)M_PI;
+    }
+    while(mean_dir - my_mobility.direction < -(float)M_PI) {
+      mean_dir += 2 * (float)M_PI;
+    }
+  }
+  
+  my_mobility.speed = a * my_mobility.speed + (1 - a) * GM_SPEED_MEAN +
+                      noise * GM_SPEED_SIGMA * rng_gauss();
+  my_mobility.direction = a * my_mobility.direction + (1 - a) * mean_dir +
+                          noise * GM_DIR_SIGMA * rng_gauss();
+  if(my_mobility.speed < 0) {
+    my_mobility.speed = 0;
+  } else if(my_mobility.speed > DSERAN_MOBILITY_SPEED_MAX) {
+    my_mobility.speed = DSERAN_MOBILITY_SPEED_MAX;
+  }
+  
+  my_mobility.x += my_mobility.speed * cosf(my_mobility.direction) * MOBILITY_DT;
+  my_mobility.y += my_mobility.speed * sinf(my_mobility.direction) * MOBILITY_DT;
+  
+  // Rebond sur les limites de la zone / Bounce on the area boundaries
+  if(my_mobility.x < 0 || my_mobility.x > DSERAN_MOBILITY_AREA) {
+    my_mobility.x = my_mobility.x < 0 ? -my_mobility.x : 2 * DSERAN_MOBILITY_AREA - my_mobility.x;
+    my_mobility.direction = (float)M_PI - my_mobility.direction;
+  }
+  if(my_mobility.y < 0 || my_mobility.y > DSERAN_MOBILITY_AREA) {
+    my_mobility.y = my_mobility.y < 0 ? -my_mobility.y : 2 * DSERAN_MOBILITY_AREA - my_mobility.y;
+    my_mobility.direction = -my_mobility.direction;
+  }
+}
+#else
+// Nouvelle destination et vitesse RWP / New RWP waypoint and speed
+static void rwp_next_leg(void) {
+  my_mobility.wx = rng_uniform() * DSERAN_MOBILITY_AREA;
+  my_mobility.wy = rng_uniform() * DSERAN_MOBILITY_AREA;
+  my_mobility.speed = DSERAN_MOBILITY_SPEED_MIN +
+                      rng_uniform() * (DSERAN_MOBILITY_SPEED_MAX - DSERAN_MOBILITY_SPEED_MIN);
+  my_mobility.direction = atan2f(my_mobility.wy - my_mobility.y, my_mobility.wx - my_mobility.x);
+}
+
+// Un pas RWP : vers la destination, puis pause / One RWP step: towards the waypoint, then pause
+static void rwp_step(void) {
+  float dx = my_mobility.wx - my_mobility.x;
+  float dy = my_mobility.wy - my_mobility.y;
+  float left = sqrtf(dx * dx + dy * dy);
+  float step = my_mobility.speed * MOBILITY_DT;
+  
+  if(left <= step) {
+    my_mobility.x = my_mobility.wx;
+    my_mobility.y = my_mobility.wy;
+    my_mobility.pause = (uint16_t)(rng_uniform() * DSERAN_MOBILITY_PAUSE_MAX / MOBILITY_DT);
+    rwp_next_leg();
+    return;
+  }
+  my_mobility.x += dx * step / left;
+  my_mobility.y += dy * step / left;
+}
+#endif
 
 // Initialisation de la mobilité / Mobility initialization
 void mobility_init(void) {
+  // Graine non nulle propre au nœud / Non-zero per-node seed
+  rng_state = (uint32_t)DSERAN_MOBILITY_SEED * 2654435761u ^ ((uint32_t)node_id * 40503u + 1);
+  if(rng_state == 0) {
+    rng_state = 1;
+  }
+  
   // Initialiser la position et la mobilité selon le modèle choisi / Initialize position and mobility
-  my_mobility.x = random_rand() % 100;
-  my_mobility.y = random_rand() % 100;
-  my_mobility.speed = 1.0 + (random_rand() % 5);
-  my_mobility.direction = random_rand() % 360;
+  my_mobility.x = rng_uniform() * DSERAN_MOBILITY_AREA;
+  my_mobility.y = rng_uniform() * DSERAN_MOBILITY_AREA;
+  my_mobility.pause = 0;
+#if DSERAN_MOBILITY_MODEL == MOBILITY_MODEL_GAUSS_MARKOV
+  gm_alpha = powf(DSERAN_MOBILITY_GM_ALPHA, MOBILITY_DT);
+  my_mobility.speed = GM_SPEED_MEAN;
+  my_mobility.direction = rng_uniform() * 2 * (float)M_PI;
+  my_mobility.mean_dir = my_mobility.direction;
+#else
+  rwp_next_leg();
+#endif
   
   // Affichage de l'état initial / Display initial state
-  printf("Mobility: Position initiale: (%.1f, %.1f), vitesse: %.1f, direction: %.1f°\n",
-         my_mobility.x, my_mobility.y, my_mobility.speed, my_mobility.direction);
+  DSERAN_PRINTF("Mobility: Position initiale: (%.1f, %.1f), vitesse: %.1f m/s, modèle: %u\n",
+                my_mobility.x, my_mobility.y, my_mobility.speed, DSERAN_MOBILITY_MODEL);
 }
 
 // Mise à jour de la mobilité / Mobility update
@@ -42,41 +174,32 @@ void mobility_update(void) {
   float old_x = my_mobility.x;
   float old_y = my_mobility.y;
   
-  // Mettre à jour la position selon RWP (simplifié) / Update position according to RWP (simplified)
-  my_mobility.x += my_mobility.speed * cos(my_mobility.direction * M_PI / 180.0);
-  my_mobility.y += my_mobility.speed * sin(my_mobility.direction * M_PI / 180.0);
-  
-  // Gestion des limites de la zone / Boundary handling
-  if(my_mobility.x < 0) {
-    my_mobility.x = 0;
-    printf("Mobility: Limite gauche atteinte, position ajustée\n");
-  }
-  if(my_mobility.y < 0) {
-    my_mobility.y = 0;
-    printf("Mobility: Limite basse atteinte, position ajustée\n");
-  }
-  if(my_mobility.x > 100) {
-    my_mobility.x = 100;
-    printf("Mobility: Limite droite atteinte, position ajustée\n");
-  }
-  if(my_mobility.y > 100) {
-    my_mobility.y = 100;
-    printf("Mobility: Limite haute atteinte, position ajustée\n");
+  // Pause RWP : immobile, mais les voisins extrapolent peut-être encore notre vitesse
+  // RWP pause: still, but neighbors may still extrapolate our velocity
+  if(my_mobility.pause > 0) {
+    my_mobility.pause--;
+    notify_d_seran_of_movement();
+    return;
   }
   
+#if DSERAN_MOBILITY_MODEL == MOBILITY_MODEL_GAUSS_MARKOV
+  gauss_markov_step();
+#else
+  rwp_step();
+#endif
+  
   // Calcul de la distance parcourue / Distance calculation
-  float distance = sqrt((my_mobility.x - old_x) * (my_mobility.x - old_x) + 
-                        (my_mobility.y - old_y) * (my_mobility.y - old_y));
+  float distance = sqrtf((my_mobility.x - old_x) * (my_mobility.x - old_x) +
+                         (my_mobility.y - old_y) * (my_mobility.y - old_y));
   
-  // Affichage occasionnel de la mobilité / Occasional mobility display
+  // Trace occasionnelle de la position, en entiers / Occasional integer position trace
   static uint8_t update_count = 0;
   if(++update_count % 8 == 0) {
-    printf("Mobility: Position: (%.1f, %.1f), déplacement: %.2f unités\n",
-           my_mobility.x, my_mobility.y, distance);
+    DSERAN_TRACE3(DSERAN_EV_POS, (uint16_t)(my_mobility.x * 10), (uint16_t)(my_mobility.y * 10),
+                  (uint16_t)(distance * 100));
   }
   
   // Notifier D-SERAN du mouvement / Notify D-SERAN of movement
-  extern void notify_d_seran_of_movement(void);
   notify_d_seran_of_movement();
 }
 
@@ -86,13 +209,43 @@ void mobility_get_position(float *x, float *y) {
   *y = my_mobility.y;
 }
 
+// Vitesse actuelle en m/s, nulle pendant une pause / Current velocity in m/s, zero while paused
+void mobility_get_velocity(float *vx, float *vy) {
+  if(my_mobility.pause > 0) {
+    *vx = 0;
+    *vy = 0;
+    return;
+  }
+  *vx = my_mobility.speed * cosf(my_mobility.direction);
+  *vy = my_mobility.speed * sinf(my_mobility.direction);
+}
+
 // Fonction pour définir manuellement la position / Manually set position
 void mobility_set_position(float x, float y) {
   my_mobility.x = x;
   my_mobility.y = y;
+#if DSERAN_MOBILITY_MODEL == MOBILITY_MODEL_RWP
+  // La destination reste, le cap suit / The waypoint stays, the heading follows
+  my_mobility.direction = atan2f(my_mobility.wy - y, my_mobility.wx - x);
+#endif
   
-  printf("Mobility: Position manuellement définie à (%.1f, %.1f)\n", x, y);
+  DSERAN_PRINTF("Mobility: Position manuellement définie à (%.1f, %.1f)\n", x, y);
 }
 
-// Hooks pour interaction avec D-SERAN / Hooks for D-SERAN interaction
-// extern void notify_d_seran_of_movement(void); 
\ No newline at end of file
+// Déplacement périodique / Periodic movement
+PROCESS_THREAD(mobility_process, ev, data) {
+  static struct etimer move_timer;
+  
+  PROCESS_BEGIN();
+  
+  mobility_init();
+  etimer_set(&move_timer, DSERAN_MOBILITY_INTERVAL);
+  
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&move_timer));
+    etimer_reset(&move_timer);
+    mobility_update();
+  }
+  
+  PROCESS_END();
+}
@@ -0,0 +1,92 @@
+/*
+ * mobility.h : Gestion de la mobilité pour MANET
+ * Mobility management for MANET
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Positions en mètres, vitesses en m/s. mobility_process appelle
+ * mobility_update() toutes les DSERAN_MOBILITY_INTERVAL, qui prévient
+ * D-SERAN par notify_d_seran_of_movement().
+ * Positions in meters, velocities in m/s. mobility_process calls
+ * mobility_update() every DSERAN_MOBILITY_INTERVAL, which tells D-SERAN
+ * through notify_d_seran_of_movement().
+ */
+
+#ifndef MOBILITY_H_
+#define MOBILITY_H_
+
+#include "contiki.h"
+
+// Période de mise à jour de la position / Position update period
+#ifdef DSERAN_CONF_MOBILITY_INTERVAL
+#define DSERAN_MOBILITY_INTERVAL DSERAN_CONF_MOBILITY_INTERVAL
+#else
+#define DSERAN_MOBILITY_INTERVAL CLOCK_SECOND
+#endif
+
+// Modèles de mobilité / Mobility models
+#define MOBILITY_MODEL_RWP          0   // Random Waypoint avec pauses / with pauses
+#define MOBILITY_MODEL_GAUSS_MARKOV 1
+
+#ifdef DSERAN_CONF_MOBILITY_MODEL
+#define DSERAN_MOBILITY_MODEL DSERAN_CONF_MOBILITY_MODEL
+#else
+#define DSERAN_MOBILITY_MODEL MOBILITY_MODEL_RWP
+#endif
+
+// Graine commune, combinée avec node_id : même scénario à chaque exécution
+// Common seed, combined with node_id: same scenario on every run
+#ifdef DSERAN_CONF_MOBILITY_SEED
+#define DSERAN_MOBILITY_SEED DSERAN_CONF_MOBILITY_SEED
+#else
+#define DSERAN_MOBILITY_SEED 2025
+#endif
+
+// Zone carrée en m / Square area in m
+#ifdef DSERAN_CONF_MOBILITY_AREA
+#define DSERAN_MOBILITY_AREA DSERAN_CONF_MOBILITY_AREA
+#else
+#define DSERAN_MOBILITY_AREA 100.0f
+#endif
+
+// Vitesses en m/s ; un minimum non nul évite l'effondrement de la vitesse moyenne RWP
+// Speeds in m/s; a non-zero minimum avoids the RWP average speed decay
+#ifdef DSERAN_CONF_MOBILITY_SPEED_MIN
+#define DSERAN_MOBILITY_SPEED_MIN DSERAN_CONF_MOBILITY_SPEED_MIN
+#else
+#define DSERAN_MOBILITY_SPEED_MIN 1.0f
+#endif
+#ifdef DSERAN_CONF_MOBILITY_SPEED_MAX
+#define DSERAN_MOBILITY_SPEED_MAX DSERAN_CONF_MOBILITY_SPEED_MAX
+#else
+#define DSERAN_MOBILITY_SPEED_MAX 5.0f
+#endif
+
+// Pause RWP maximale en s, tirée uniformément / Maximum RWP pause in s, drawn uniformly
+#ifdef DSERAN_CONF_MOBILITY_PAUSE_MAX
+#define DSERAN_MOBILITY_PAUSE_MAX DSERAN_CONF_MOBILITY_PAUSE_MAX
+#else
+#define DSERAN_MOBILITY_PAUSE_MAX 10
+#endif
+
+// Mémoire Gauss-Markov par seconde (0 : marche aléatoire, 1 : ligne droite)
+// Gauss-Markov memory per second (0: random walk, 1: straight line)
+#ifdef DSERAN_CONF_MOBILITY_GM_ALPHA
+#define DSERAN_MOBILITY_GM_ALPHA DSERAN_CONF_MOBILITY_GM_ALPHA
+#else
+#define DSERAN_MOBILITY_GM_ALPHA 0.75f
+#endif
+
+PROCESS_NAME(mobility_process);
+
+void mobility_init(void);
+void mobility_update(void);
+void mobility_get_position(float *x, float *y);
+void mobility_get_velocity(float *vx, float *vy);
+void mobility_set_position(float x, float y);
+
+// Fourni par d-seran.c / Provided by d-seran.c
+void notify_d_seran_of_movement(void);
+
+#endif /* MOBILITY_H_ */
@@ -1,122 +1,164 @@
 /*
- * olsr-demo.c : Protocole de référence OLSR simplifié pour MANET sous Contiki-NG
- * Simplified OLSR reference protocol for MANET under Contiki-NG
- * 
+ * olsr-demo.c : Protocole de référence OLSR pour MANET sous Contiki-NG
+ * OLSR reference protocol for MANET under Contiki-NG
+ *
  * Auteur / Author: Madani Belacel
  * Date de création / Created: 25/03/2023
- * Dernière mise à jour / Last updated: 02/05/2023
- * 
- * Implémentation simplifiée d'OLSR pour comparaison avec D-SERAN
- * Simplified OLSR implementation for comparison with D-SERAN
+ * Dernière mise à jour / Last updated: Août 2025
+ *
+ * Même charge que D-SERAN (une donnée vers le puits toutes les
+ * DSERAN_CONF_DATA_INTERVAL, énergie mesurée par energest) routée par OLSR
+ * (olsr.c). Comme D-SERAN, une donnée n'est émise que si la table de
+ * routage mène au puits : le rapport DATA_TX / envois attendus mesure la
+ * disponibilité des routes. Les octets de contrôle émis sont journalisés
+ * chaque minute (CTRL_BYTES).
+ * Same workload as D-SERAN (one data frame to the sink every
+ * DSERAN_CONF_DATA_INTERVAL, energy measured through energest) routed by
+ * OLSR (olsr.c). Like D-SERAN, data is only sent when the routing table
+ * leads to the sink: the DATA_TX / expected sends ratio measures route
+ * availability. The control bytes sent are logged every minute
+ * (CTRL_BYTES).
  */
 
 #include "contiki.h"
+#include "net/netstack.h"
+#include "net/routing/routing.h"
+#include "net/ipv6/simple-udp.h"
 #include "net/ipv6/uip-ds6.h"
 #include "net/ipv6/uip.h"
-#include "net/ipv6/uip-udp-packet.h"
 #include "sys/log.h"
+#include "sys/node-id.h"
 #include "lib/random.h"
+#include "olsr.h"
+#include "dseran-energy.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define LOG_MODULE "OLSR-DEMO"
 #define LOG_LEVEL LOG_LEVEL_INFO
 
-// Configuration des paramètres / Parameter configuration
-#define UDP_PORT 1237
-#define SEND_INTERVAL (CLOCK_SECOND * 8)
-#define HELLO_INTERVAL (CLOCK_SECOND * 5)
+// Puits et trafic partagés avec D-SERAN / Sink and traffic shared with D-SERAN
+#ifdef DSERAN_CONF_SINK_ID
+#define SINK_ID DSERAN_CONF_SINK_ID
+#else
+#define SINK_ID 1
+#endif
+#ifdef DSERAN_CONF_DATA_INTERVAL
+#define DATA_INTERVAL DSERAN_CONF_DATA_INTERVAL
+#else
+#define DATA_INTERVAL (CLOCK_SECOND * 15)
+#endif
+#define DATA_PORT 5678
+#define ENERGY_INTERVAL (CLOCK_SECOND * 5)
+#define CTRL_LOG_EVERY 12      // intervalles d'énergie, soit une minute / energy intervals, i.e. one minute
 
 PROCESS(olsr_demo_process, "OLSR Demo Protocol");
 AUTOSTART_PROCESSES(&olsr_demo_process);
 
+struct olsr_data {
+  uint16_t origin;      // node_id de la source / source node_id
+  uint16_t seq;
+  uint32_t send_time;   // clock_time() de l'émetteur / sender clock_time()
+};
+
 // Variables globales / Global variables
-static struct uip_udp_conn *udp_conn;
+static struct simple_udp_connection data_conn;
+static uip_ipaddr_t sink_ipaddr;
 static uint16_t seq_id = 0;
 
-// Statistiques de performance / Performance statistics
-static uint16_t packets_sent = 0;
-static uint16_t hello_messages = 0;
-
-// Simulation de l'énergie / Energy simulation
-static uint16_t my_energy = 100;
+// Énergie résiduelle / Residual energy
+static uint16_t my_energy;
 
-// Fonction d'envoi de messages HELLO / HELLO message sending function
-static void send_hello(void) {
-  hello_messages++;
-  
-  // Simulation de l'envoi de messages HELLO / HELLO message sending simulation
-  printf("OLSR: Message HELLO #%u envoyé\n", hello_messages);
-  
-  // Consommation d'énergie pour HELLO / Energy consumption for HELLO
-  my_energy -= 1;
+// Fonction d'envoi de paquets, rien sans route vers le puits
+// Packet sending function, nothing without a route to the sink
+static void send_packet(void) {
+  struct olsr_data msg;
   
-  LOG_INFO("HELLO_MSG %u %lu\n", hello_messages, clock_time());
+  if(!NETSTACK_ROUTING.node_has_joined()) {
+    return;
+  }
+  msg.origin = node_id;
+  msg.seq = ++seq_id;
+  msg.send_time = (uint32_t)clock_time();
+  LOG_INFO("DATA_TX %u %u %lu\n", msg.origin, msg.seq, (unsigned long)clock_time());
+  simple_udp_sendto(&data_conn, &msg, sizeof(msg), &sink_ipaddr);
 }
 
-// Fonction d'envoi de paquets / Packet sending function
-static void send_packet(void) {
-  char buf[32];
-  
-  // Préparation du message / Message preparation
-  sprintf(buf, "OLSR_DATA %u %lu", seq_id++, clock_time());
-  
-  // Envoi UDP / UDP sending
-  uip_udp_packet_send(udp_conn, buf, strlen(buf));
+// Réception des données au puits / Data reception at the sink
+static void data_rx_callback(struct simple_udp_connection *c, const uip_ipaddr_t *sender_addr,
+                             uint16_t sender_port, const uip_ipaddr_t *receiver_addr,
+                             uint16_t receiver_port, const uint8_t *data, uint16_t datalen) {
+  struct olsr_data msg;
   
-  // Mise à jour des statistiques / Statistics update
-  packets_sent++;
-  my_energy--;
+  if(!NETSTACK_ROUTING.node_is_root() || datalen != sizeof(msg)) {
+    return;
+  }
+  memcpy(&msg, data, sizeof(msg));
   
-  // Logs de débogage / Debug logs
-  LOG_INFO("SEND_UDP %u %lu\n", seq_id, clock_time());
-  LOG_INFO("ENERGY %u %lu\n", my_energy, clock_time());
+  // Latence en ms (horloges Cooja alignées) et sauts déduits du TTL
+  // Latency in ms (aligned Cooja clocks) and hops derived from the TTL
+  uint32_t latency = ((uint32_t)clock_time() - msg.send_time) * 1000 / CLOCK_SECOND;
+  uint8_t hops = uip_ds6_if.cur_hop_limit - UIP_IP_BUF->ttl + 1;
   
-  // Traces de débogage occasionnelles / Occasional debug traces
-  if (random_rand() % 10 == 0) {
-    printf("OLSR: Paquet envoyé #%u, énergie: %u mJ\n", seq_id-1, my_energy);
-  }
+  LOG_INFO("DATA_RX %u %u %lu %u\n", msg.origin, msg.seq, (unsigned long)latency, hops);
 }
 
 // Processus principal OLSR / Main OLSR process
 PROCESS_THREAD(olsr_demo_process, ev, data) {
-  static struct etimer send_timer;
-  static struct etimer hello_timer;
+  static struct etimer send_timer, energy_timer;
+  static uint8_t energy_ticks = 0;
+  static uint32_t ctrl_logged = 0;
   
   PROCESS_BEGIN();
   
-  // Configuration de la connexion UDP / UDP connection setup
-  udp_conn = udp_new(NULL, UIP_HTONS(UDP_PORT), NULL);
-  udp_bind(udp_conn, UIP_HTONS(UDP_PORT));
+  dseran_energy_init();
+  my_energy = dseran_energy_residual();
+  NETSTACK_ROUTING.get_root_ipaddr(&sink_ipaddr);
+  if(node_id == SINK_ID) {
+    NETSTACK_ROUTING.root_start();
+  }
+  simple_udp_register(&data_conn, DATA_PORT, NULL, DATA_PORT, data_rx_callback);
   
-  // Configuration des timers / Timer setup
-  etimer_set(&send_timer, SEND_INTERVAL);
-  etimer_set(&hello_timer, HELLO_INTERVAL);
+  // Configuration des timers, premier envoi décalé / Timer setup, first sending offset
+  etimer_set(&energy_timer, ENERGY_INTERVAL);
+  etimer_set(&send_timer, DATA_INTERVAL + random_rand() % DATA_INTERVAL);
   
-  printf("OLSR: Démonstration démarrée, port UDP: %d\n", UDP_PORT);
+  printf("OLSR: Démonstration démarrée, puits / sink %u\n", SINK_ID);
   
   while(1) {
-    PROCESS_WAIT_EVENT();
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&send_timer) || etimer_expired(&energy_timer));
     
-    // Gestion du timer d'envoi / Send timer handling
-    if(etimer_expired(&send_timer)) {
-      send_packet();
-      etimer_reset(&send_timer);
+    // Énergie mesurée, octets de contrôle chaque minute / Measured energy, control bytes every minute
+    if(etimer_expired(&energy_timer)) {
+      dseran_energy_update();
+      my_energy = dseran_energy_residual();
+      LOG_INFO("ENERGY %u %lu\n", my_energy, (unsigned long)clock_time());
+      if(++energy_ticks == CTRL_LOG_EVERY) {
+        const struct olsr_stats *st = olsr_get_stats();
+        LOG_INFO("CTRL_BYTES %lu %lu\n", (unsigned long)(st->ctrl_bytes - ctrl_logged),
+                 (unsigned long)clock_time());
+        ctrl_logged = st->ctrl_bytes;
+        energy_ticks = 0;
+      }
+      etimer_reset(&energy_timer);
     }
     
-    // Gestion du timer HELLO / HELLO timer handling
-    if(etimer_expired(&hello_timer)) {
-      send_hello();
-      etimer_reset(&hello_timer);
+    // Envoi périodique vers le puits / Periodic sending to the sink
+    if(etimer_expired(&send_timer)) {
+      if(node_id != SINK_ID) {
+        send_packet();
+      }
+      etimer_reset(&send_timer);
     }
     
     // Vérification de la fin de vie / Lifetime check
     if(my_energy == 0) {
-      LOG_INFO("LIFETIME %u %lu\n", linkaddr_node_addr.u8[0], clock_time());
+      LOG_INFO("LIFETIME %u %lu\n", linkaddr_node_addr.u8[0], (unsigned long)clock_time());
       printf("OLSR: Énergie épuisée, arrêt du protocole\n");
       PROCESS_EXIT();
     }
   }
   
   PROCESS_END();
-} 
\ No newline at end of file
+}
@@ -0,0 +1,1120 @@
+/*
+ * olsr.c : Routage proactif OLSR (RFC 3626) pour Contiki-NG
+ * Proactive OLSR routing (RFC 3626) for Contiki-NG
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Écarts à la RFC : une seule interface, les adresses principales sont les
+ * adresses lien (pas de MID ni de HNA) ; le puits se signale par un drapeau
+ * dans ses HELLO et TC, et chaque nœud route fd00::1 par une route par
+ * défaut uIP vers le prochain saut du chemin vers lui ; pas d'hystérésis
+ * de qualité des liens ; un TC vide est répété pendant TOP_HOLD_TIME après
+ * la perte du dernier sélecteur. Tables bornées : un lien qui ne trouve pas
+ * de place est ignoré jusqu'à sa prochaine annonce.
+ * Departures from the RFC: a single interface, main addresses are link
+ * addresses (no MID nor HNA); the sink flags itself in its HELLOs and TCs,
+ * and every node routes fd00::1 through a uIP default route towards the next
+ * hop of its path to it; no link quality hysteresis; an empty TC is repeated
+ * for TOP_HOLD_TIME after the last selector is lost. Bounded tables: a link
+ * that finds no room is ignored until its next advertisement.
+ */
+
+#include "contiki.h"
+#include "net/routing/routing.h"
+#include "net/ipv6/simple-udp.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "net/linkaddr.h"
+#include "lib/random.h"
+#include "sys/ctimer.h"
+#include "sys/log.h"
+#include "olsr.h"
+#include "dseran-energy.h"
+#include "dseran-net.h"
+#include <string.h>
+
+// Module des journaux attendu par parse_logs.py et logparse / Log module expected by parse_logs.py and logparse
+#define LOG_MODULE "OLSR-DEMO"
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+// Messages et codes de lien (section 6.1.1) / Messages and link codes (section 6.1.1)
+#define OLSR_HELLO 1
+#define OLSR_TC    2
+
+#define LINK_ASYM 1
+#define LINK_SYM  2
+#define LINK_MPR  3        // symétrique et choisi comme MPR / symmetric and selected as MPR
+
+#define MSG_FLAG_ROOT 0x01  // émis par le puits / sent by the sink
+
+// HELLO : type, drapeaux, disposition, nombre, puis (adresse, code) par voisin
+// HELLO: type, flags, willingness, count, then (address, code) per neighbor
+#define HELLO_HDR   4
+#define HELLO_ENTRY (LINKADDR_SIZE + 1)
+#define HELLO_MAX   (HELLO_HDR + OLSR_MAX_NEIGHBORS * HELLO_ENTRY)
+
+// TC : type, drapeaux, TTL, sauts, séquence, ANSN, origine, nombre, puis une adresse par sélecteur
+// TC: type, flags, TTL, hops, sequence, ANSN, originator, count, then one address per selector
+#define TC_SEQ      4
+#define TC_ANSN     6
+#define TC_ORIG     8
+#define TC_COUNT    (TC_ORIG + LINKADDR_SIZE)
+#define TC_HDR      (TC_COUNT + 1)
+#define TC_MAX      (TC_HDR + OLSR_MAX_NEIGHBORS * LINKADDR_SIZE)
+#define TC_TTL      255
+
+#define MSG_MAX          (HELLO_MAX > TC_MAX ? HELLO_MAX : TC_MAX)
+#define MAXJITTER        (OLSR_HELLO_INTERVAL / 4)
+#define DUP_NUM          16
+#define DUP_HOLD_TIME    (CLOCK_SECOND * 30)
+#define DELAYED_NUM      4
+#define PURGE_INTERVAL   CLOCK_SECOND
+#define HOPS_INF         0xff
+
+// Voisin direct / Direct neighbor
+#define NB_USED     0x01
+#define NB_SYM      0x02
+#define NB_MPR      0x04    // choisi comme MPR par ce nœud / selected as MPR by this node
+#define NB_SELECTOR 0x08    // a choisi ce nœud comme MPR / selected this node as MPR
+
+struct olsr_nbr {
+  linkaddr_t addr;
+  clock_time_t asym_until;
+  clock_time_t sym_until;
+  clock_time_t selector_until;
+  uint8_t willingness;
+  uint8_t flags;
+};
+
+struct olsr_twohop {
+  linkaddr_t via;
+  linkaddr_t addr;
+  clock_time_t expires;
+  uint8_t used;
+};
+
+struct olsr_topo {
+  linkaddr_t last;
+  linkaddr_t dest;
+  clock_time_t expires;
+  uint16_t ansn;
+  uint8_t used;
+};
+
+struct olsr_dup {
+  linkaddr_t orig;
+  clock_time_t expires;
+  uint16_t seq;
+  uint8_t retransmitted;
+};
+
+// Arbre des plus courts chemins : pred est le dernier saut avant dest
+// Shortest-path tree: pred is the last hop before dest
+#define RT_USED   0x01
+#define RT_MARK   0x02    // sous-arbre à réparer / subtree being repaired
+#define RT_QUEUED 0x04
+
+struct olsr_route {
+  linkaddr_t dest;
+  linkaddr_t next;
+  linkaddr_t pred;
+  uint8_t hops;
+  uint8_t flags;
+};
+
+struct delayed {
+  uint8_t buf[MSG_MAX];
+  uint16_t len;
+  struct ctimer timer;
+};
+
+PROCESS(olsr_process, "OLSR");
+
+static struct simple_udp_connection olsr_conn;
+static struct olsr_nbr nbrs[OLSR_MAX_NEIGHBORS];
+static struct olsr_twohop twohop[OLSR_MAX_TWOHOP];
+static struct olsr_topo topo[OLSR_MAX_TOPOLOGY];
+static struct olsr_dup dups[DUP_NUM];
+static uint8_t dup_pos = 0;
+static struct olsr_route routes[OLSR_MAX_ROUTES];
+static struct delayed delayed[DELAYED_NUM];
+static struct olsr_stats stats;
+
+static uip_ipaddr_t my_ipaddr;
+static uip_ipaddr_t sink_ipaddr;
+static uint8_t is_root = 0;
+static uint16_t msg_seq = 0;
+static uint16_t ansn = 0;
+static clock_time_t tc_empty_until;
+
+// Puits connu et route par défaut vers lui / Known sink and default route towards it
+static linkaddr_t root_addr;
+static uint8_t have_root = 0;
+static uip_ipaddr_t defrt_ipaddr;
+static uint8_t defrt_set = 0;
+static uint8_t root_hops = HOPS_INF;
+
+// Champs de 16 bits en ordre réseau (section 3.3) / 16-bit fields in network order (section 3.3)
+static uint16_t get16(const uint8_t *p) {
+  return (uint16_t)p[0] << 8 | p[1];
+}
+
+static void put16(uint8_t *p, uint16_t v) {
+  p[0] = v >> 8;
+  p[1] = v;
+}
+
+// Comparaison circulaire (section 19) / Circular comparison (section 19)
+static int seq_newer(uint16_t a, uint16_t b) {
+  return (int16_t)(a - b) > 0;
+}
+
+static uint8_t is_me(const linkaddr_t *a) {
+  return linkaddr_cmp(a, &linkaddr_node_addr);
+}
+
+static uint8_t addr_in(const linkaddr_t *list, uint8_t len, const linkaddr_t *a) {
+  for(uint8_t i=0; i<len; i++) {
+    if(linkaddr_cmp(&list[i], a)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void send_msg(const uint8_t *buf, uint16_t len) {
+  uip_ipaddr_t ip;
+
+  uip_create_linklocal_allnodes_mcast(&ip);
+  simple_udp_sendto(&olsr_conn, buf, len, &ip);
+  stats.ctrl_bytes += len;
+  LOG_INFO("SEND_UDP %u %lu\n", dseran_energy_residual(), (unsigned long)clock_time());
+}
+
+static void delayed_cb(void *ptr) {
+  struct delayed *d = ptr;
+
+  send_msg(d->buf, d->len);
+  d->len = 0;
+}
+
+// Relais après une gigue aléatoire (section 3.5), immédiat si aucune place
+// Relay after a random jitter (section 3.5), immediate when no slot is free
+static void send_jittered(const uint8_t *buf, uint16_t len) {
+  for(uint8_t i=0; i<DELAYED_NUM; i++) {
+    if(delayed[i].len == 0) {
+      memcpy(delayed[i].buf, buf, len);
+      delayed[i].len = len;
+      ctimer_set(&delayed[i].timer, 1 + random_rand() % MAXJITTER, delayed_cb, &delayed[i]);
+      return;
+    }
+  }
+  send_msg(buf, len);
+}
+
+// Tables / Tables
+
+static struct olsr_nbr *nbr_find(const linkaddr_t *a) {
+  for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+    if((nbrs[i].flags & NB_USED) && linkaddr_cmp(&nbrs[i].addr, a)) {
+      return &nbrs[i];
+    }
+  }
+  return NULL;
+}
+
+static struct olsr_nbr *nbr_sym(const linkaddr_t *a) {
+  struct olsr_nbr *n = nbr_find(a);
+
+  return n != NULL && (n->flags & NB_SYM) ? n : NULL;
+}
+
+static struct olsr_route *route_find(const linkaddr_t *dest) {
+  for(uint8_t i=0; i<OLSR_MAX_ROUTES; i++) {
+    if((routes[i].flags & RT_USED) && linkaddr_cmp(&routes[i].dest, dest)) {
+      return &routes[i];
+    }
+  }
+  return NULL;
+}
+
+static struct olsr_route *route_alloc(const linkaddr_t *dest) {
+  for(uint8_t i=0; i<OLSR_MAX_ROUTES; i++) {
+    if(!(routes[i].flags & RT_USED)) {
+      linkaddr_copy(&routes[i].dest, dest);
+      routes[i].flags = RT_USED;
+      routes[i].hops = HOPS_INF;
+      return &routes[i];
+    }
+  }
+  return NULL;
+}
+
+// Distance de u, 0 pour ce nœud, HOPS_INF sans route ou en réparation
+// Distance of u, 0 for this node, HOPS_INF without a route or under repair
+static uint8_t node_hops(const linkaddr_t *u) {
+  const struct olsr_route *r;
+
+  if(is_me(u)) {
+    return 0;
+  }
+  r = route_find(u);
+  return r == NULL || (r->flags & RT_MARK) ? HOPS_INF : r->hops;
+}
+
+// Routage incrémental / Incremental routing
+//
+// Les arcs du graphe sont les liens symétriques de ce nœud, les liens
+// (voisin, deux sauts) des HELLO et les liens (dernier saut, destination)
+// des TC. Un arc ajouté ne relâche que les destinations qu'il raccourcit,
+// de proche en proche ; un arc perdu n'invalide que le sous-arbre qu'il
+// portait, reconnecté ensuite depuis le reste de l'arbre.
+// The graph arcs are this node's symmetric links, the (neighbor, two-hop)
+// links of HELLOs and the (last hop, destination) links of TCs. An added arc
+// only relaxes the destinations it shortens, step by step; a lost arc only
+// invalidates the subtree it carried, then reconnected from the rest of the
+// tree.
+
+static uint8_t queue[OLSR_MAX_ROUTES];
+static uint8_t q_head, q_len;
+
+static void enqueue(struct olsr_route *r) {
+  if(!(r->flags & RT_QUEUED)) {
+    r->flags |= RT_QUEUED;
+    queue[(q_head + q_len++) % OLSR_MAX_ROUTES] = r - routes;
+  }
+}
+
+// Arc u -> w de distance du = node_hops(u) ; vrai si w a changé
+// Arc u -> w with du = node_hops(u); true when w changed
+static uint8_t relax_arc(const linkaddr_t *u, uint8_t du, const linkaddr_t *w) {
+  struct olsr_route *r;
+  const linkaddr_t *next;
+
+  if(du == HOPS_INF || is_me(w)) {
+    return 0;
+  }
+  if(is_me(u)) {
+    next = w;
+  } else {
+    next = &route_find(u)->next;
+  }
+  r = route_find(w);
+  if(r == NULL) {
+    r = route_alloc(w);
+    if(r == NULL) {
+      return 0;
+    }
+  } else if((r->flags & RT_MARK) || du + 1 > r->hops ||
+            (du + 1 == r->hops && (!linkaddr_cmp(&r->pred, u) || linkaddr_cmp(&r->next, next)))) {
+    // Pas plus court ; à longueur égale, seul le parent actuel peut changer le prochain saut
+    // Not shorter; at equal length, only the current parent may change the next hop
+    return 0;
+  }
+  r->hops = du + 1;
+  linkaddr_copy(&r->pred, u);
+  linkaddr_copy(&r->next, next);
+  stats.spf_touched++;
+  enqueue(r);
+  return 1;
+}
+
+// Tous les arcs sortant de u / Every arc leaving u
+static void relax_from(const linkaddr_t *u) {
+  uint8_t du = node_hops(u);
+
+  if(du == HOPS_INF) {
+    return;
+  }
+  if(is_me(u)) {
+    for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+      if(nbrs[i].flags & NB_SYM) {
+        relax_arc(u, 0, &nbrs[i].addr);
+      }
+    }
+  }
+  for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+    if(twohop[i].used && linkaddr_cmp(&twohop[i].via, u)) {
+      relax_arc(u, du, &twohop[i].addr);
+    }
+  }
+  for(uint8_t i=0; i<OLSR_MAX_TOPOLOGY; i++) {
+    if(topo[i].used && linkaddr_cmp(&topo[i].last, u)) {
+      relax_arc(u, du, &topo[i].dest);
+    }
+  }
+}
+
+// Propagation en largeur depuis les destinations modifiées / Breadth-first propagation from the changed destinations
+static void relax_queue(void) {
+  while(q_len > 0) {
+    struct olsr_route *r = &routes[queue[q_head]];
+    q_head = (q_head + 1) % OLSR_MAX_ROUTES;
+    q_len--;
+    r->flags &= ~RT_QUEUED;
+    relax_from(&r->dest);
+  }
+}
+
+static void root_route_update(void);
+
+static void arc_added(const linkaddr_t *u, const linkaddr_t *w) {
+  if(relax_arc(u, node_hops(u), w)) {
+    stats.spf_updates++;
+    relax_queue();
+    root_route_update();
+  }
+}
+
+// Meilleur dernier saut hors réparation vers v / Best last hop towards v outside the repair
+static uint8_t best_pred(const linkaddr_t *v, linkaddr_t *pred) {
+  uint8_t best = HOPS_INF;
+
+  if(nbr_sym(v) != NULL) {
+    linkaddr_copy(pred, &linkaddr_node_addr);
+    return 1;
+  }
+  for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+    uint8_t h;
+    if(twohop[i].used && linkaddr_cmp(&twohop[i].addr, v) &&
+       (h = node_hops(&twohop[i].via)) != HOPS_INF && h + 1 < best) {
+      best = h + 1;
+      linkaddr_copy(pred, &twohop[i].via);
+    }
+  }
+  for(uint8_t i=0; i<OLSR_MAX_TOPOLOGY; i++) {
+    uint8_t h;
+    if(topo[i].used && linkaddr_cmp(&topo[i].dest, v) &&
+       (h = node_hops(&topo[i].last)) != HOPS_INF && h + 1 < best) {
+      best = h + 1;
+      linkaddr_copy(pred, &topo[i].last);
+    }
+  }
+  return best;
+}
+
+// Prochain saut hérité du prédécesseur, déjà reconnecté / Next hop inherited from the predecessor, already reconnected
+static void route_set_next(struct olsr_route *r) {
+  if(is_me(&r->pred)) {
+    linkaddr_copy(&r->next, &r->dest);
+  } else {
+    linkaddr_copy(&r->next, &route_find(&r->pred)->next);
+  }
+}
+
+// Arc u -> v perdu : si v en dépendait, son sous-arbre est marqué, reconnecté
+// par le reste de l'arbre (distances croissantes), et ce qui reste isolé est oublié
+// Arc u -> v lost: if v relied on it, its subtree is marked, reconnected
+// through the rest of the tree (increasing distances), and what stays cut off
+// is forgotten
+static void arc_removed(const linkaddr_t *u, const linkaddr_t *v) {
+  struct olsr_route *r = route_find(v);
+  uint8_t changed;
+
+  if(r == NULL || !linkaddr_cmp(&r->pred, u)) {
+    return;
+  }
+  stats.spf_updates++;
+  r->flags |= RT_MARK;
+  do {
+    changed = 0;
+    for(uint8_t i=0; i<OLSR_MAX_ROUTES; i++) {
+      struct olsr_route *c = &routes[i];
+      if((c->flags & (RT_USED | RT_MARK)) == RT_USED && !is_me(&c->pred)) {
+        const struct olsr_route *p = route_find(&c->pred);
+        if(p != NULL && (p->flags & RT_MARK)) {
+          c->flags |= RT_MARK;
+          changed = 1;
+        }
+      }
+    }
+  } while(changed);
+
+  // Reconnexion par distances croissantes : à chaque tour, la destination
+  // marquée la plus proche du reste de l'arbre / Reconnection by increasing
+  // distance: at each round, the marked destination closest to the rest of the tree
+  while(1) {
+    struct olsr_route *best = NULL;
+    linkaddr_t best_p, p;
+    uint8_t best_h = HOPS_INF;
+    for(uint8_t i=0; i<OLSR_MAX_ROUTES; i++) {
+      struct olsr_route *c = &routes[i];
+      if(c->flags & RT_MARK) {
+        uint8_t h = best_pred(&c->dest, &p);
+        if(h < best_h) {
+          best_h = h;
+          best = c;
+          linkaddr_copy(&best_p, &p);
+        }
+      }
+    }
+    if(best == NULL) {
+      break;
+    }
+    best->flags &= ~RT_MARK;
+    best->hops = best_h;
+    linkaddr_copy(&best->pred, &best_p);
+    route_set_next(best);
+    stats.spf_touched++;
+  }
+  for(uint8_t i=0; i<OLSR_MAX_ROUTES; i++) {
+    if(routes[i].flags & RT_MARK) {
+      routes[i].flags = 0;
+      stats.spf_touched++;
+    }
+  }
+  root_route_update();
+}
+
+// Route par défaut uIP vers le prochain saut du chemin vers le puits
+// uIP default route towards the next hop of the path to the sink
+static void root_route_update(void) {
+  const struct olsr_route *r = have_root && !is_root ? route_find(&root_addr) : NULL;
+  uip_ipaddr_t nh;
+
+  if(r != NULL) {
+    dseran_net_nbr_ipaddr(&nh, &r->next);
+  }
+  if(defrt_set && (r == NULL || !uip_ipaddr_cmp(&nh, &defrt_ipaddr))) {
+    uip_ds6_defrt_t *old = uip_ds6_defrt_lookup(&defrt_ipaddr);
+    if(old != NULL) {
+      uip_ds6_defrt_rm(old);
+    }
+    defrt_set = 0;
+  }
+  if(r != NULL && !defrt_set && uip_ds6_defrt_add(&nh, 0) != NULL) {
+    uip_ipaddr_copy(&defrt_ipaddr, &nh);
+    defrt_set = 1;
+  }
+  if(r != NULL && r->hops != root_hops) {
+    LOG_INFO("HOP %u %lu\n", r->hops, (unsigned long)clock_time());
+  }
+  root_hops = r != NULL ? r->hops : HOPS_INF;
+}
+
+// Relais multipoints (section 8.3.1) / Multipoint relays (section 8.3.1)
+
+// Voisins à deux sauts stricts : ni ce nœud, ni un voisin symétrique, par un voisin prêt à relayer
+// Strict two-hop neighbors: neither this node nor a symmetric neighbor, through a neighbor willing to relay
+static uint8_t twohop_strict(const struct olsr_twohop *t) {
+  const struct olsr_nbr *via = nbr_sym(&t->via);
+
+  return t->used && via != NULL && via->willingness != OLSR_WILL_NEVER &&
+         !is_me(&t->addr) && nbr_sym(&t->addr) == NULL;
+}
+
+// Nombre de voisins à deux sauts encore découverts que le voisin n couvrirait
+// Number of still uncovered two-hop neighbors that neighbor n would cover
+static uint8_t mpr_reach(const struct olsr_nbr *n, const linkaddr_t *n2, const uint8_t *covered, uint8_t nn2) {
+  uint8_t reach = 0;
+
+  for(uint8_t j=0; j<nn2; j++) {
+    if(covered[j]) {
+      continue;
+    }
+    for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+      if(twohop_strict(&twohop[i]) && linkaddr_cmp(&twohop[i].via, &n->addr) &&
+         linkaddr_cmp(&twohop[i].addr, &n2[j])) {
+        reach++;
+        break;
+      }
+    }
+  }
+  return reach;
+}
+
+static void mpr_take(struct olsr_nbr *n, const linkaddr_t *n2, uint8_t *covered, uint8_t nn2) {
+  n->flags |= NB_MPR;
+  for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+    if(twohop_strict(&twohop[i]) && linkaddr_cmp(&twohop[i].via, &n->addr)) {
+      for(uint8_t j=0; j<nn2; j++) {
+        if(linkaddr_cmp(&twohop[i].addr, &n2[j])) {
+          covered[j] = 1;
+        }
+      }
+    }
+  }
+}
+
+// Choix glouton : WILL_ALWAYS, puis seuls fournisseurs d'un voisin à deux
+// sauts, puis plus grande couverture restante (disposition, puis degré)
+// Greedy selection: WILL_ALWAYS, then sole providers of a two-hop neighbor,
+// then largest remaining coverage (willingness, then degree)
+static void mpr_select(void) {
+  static const uint8_t none[OLSR_MAX_TWOHOP];
+  linkaddr_t n2[OLSR_MAX_TWOHOP];
+  uint8_t covered[OLSR_MAX_TWOHOP];
+  uint8_t old[OLSR_MAX_NEIGHBORS];
+  uint8_t nn2 = 0, changed = 0;
+
+  for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+    if(twohop_strict(&twohop[i]) && !addr_in(n2, nn2, &twohop[i].addr)) {
+      linkaddr_copy(&n2[nn2++], &twohop[i].addr);
+    }
+  }
+  memset(covered, 0, sizeof(covered));
+  for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+    old[i] = nbrs[i].flags & NB_MPR;
+    nbrs[i].flags &= ~NB_MPR;
+    if((nbrs[i].flags & NB_SYM) && nbrs[i].willingness == OLSR_WILL_ALWAYS) {
+      mpr_take(&nbrs[i], n2, covered, nn2);
+    }
+  }
+  for(uint8_t j=0; j<nn2; j++) {
+    struct olsr_nbr *only = NULL;
+    uint8_t providers = 0;
+    for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+      if(twohop_strict(&twohop[i]) && linkaddr_cmp(&twohop[i].addr, &n2[j])) {
+        only = nbr_find(&twohop[i].via);
+        providers++;
+      }
+    }
+    if(providers == 1 && !covered[j]) {
+      mpr_take(only, n2, covered, nn2);
+    }
+  }
+  while(1) {
+    struct olsr_nbr *best = NULL;
+    uint8_t best_reach = 0, best_deg = 0;
+    for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+      struct olsr_nbr *n = &nbrs[i];
+      uint8_t reach, deg;
+      if(!(n->flags & NB_SYM) || (n->flags & NB_MPR) || n->willingness == OLSR_WILL_NEVER ||
+         (reach = mpr_reach(n, n2, covered, nn2)) == 0) {
+        continue;
+      }
+      deg = mpr_reach(n, n2, none, nn2);
+      if(best == NULL || n->willingness > best->willingness ||
+         (n->willingness == best->willingness &&
+          (reach > best_reach || (reach == best_reach && deg > best_deg)))) {
+        best = n;
+        best_reach = reach;
+        best_deg = deg;
+      }
+    }
+    if(best == NULL) {
+      break;
+    }
+    mpr_take(best, n2, covered, nn2);
+  }
+  for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+    changed |= old[i] != (nbrs[i].flags & NB_MPR);
+  }
+  stats.mpr_changes += changed;
+}
+
+// HELLO (section 6) / HELLO (section 6)
+
+static void hello_send(void) {
+  uint8_t buf[HELLO_MAX];
+  uint16_t len = HELLO_HDR;
+  uint8_t count = 0;
+  clock_time_t now = clock_time();
+
+  for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+    const struct olsr_nbr *n = &nbrs[i];
+    if(!(n->flags & NB_USED) || !CLOCK_LT(now, n->asym_until)) {
+      continue;
+    }
+    memcpy(buf + len, &n->addr, LINKADDR_SIZE);
+    buf[len + LINKADDR_SIZE] = (n->flags & NB_MPR) ? LINK_MPR : (n->flags & NB_SYM) ? LINK_SYM : LINK_ASYM;
+    len += HELLO_ENTRY;
+    count++;
+  }
+  buf[0] = OLSR_HELLO;
+  buf[1] = is_root ? MSG_FLAG_ROOT : 0;
+  buf[2] = OLSR_WILLINGNESS;
+  buf[3] = count;
+  send_msg(buf, len);
+  stats.hello_sent++;
+}
+
+static struct olsr_nbr *nbr_add(const linkaddr_t *a) {
+  for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+    if(!(nbrs[i].flags & NB_USED)) {
+      memset(&nbrs[i], 0, sizeof(nbrs[i]));
+      linkaddr_copy(&nbrs[i].addr, a);
+      nbrs[i].flags = NB_USED;
+      return &nbrs[i];
+    }
+  }
+  return NULL;
+}
+
+static struct olsr_twohop *twohop_find(const linkaddr_t *via, const linkaddr_t *a) {
+  for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+    if(twohop[i].used && linkaddr_cmp(&twohop[i].via, via) && linkaddr_cmp(&twohop[i].addr, a)) {
+      return &twohop[i];
+    }
+  }
+  return NULL;
+}
+
+static void twohop_remove(struct olsr_twohop *t) {
+  linkaddr_t via, a;
+
+  linkaddr_copy(&via, &t->via);
+  linkaddr_copy(&a, &t->addr);
+  t->used = 0;
+  arc_removed(&via, &a);
+}
+
+// Voisin devenu asymétrique ou perdu : liens à deux sauts et arc retirés
+// Neighbor now asymmetric or lost: two-hop links and arc removed
+static void nbr_sym_lost(struct olsr_nbr *n) {
+  for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+    if(twohop[i].used && linkaddr_cmp(&twohop[i].via, &n->addr)) {
+      twohop_remove(&twohop[i]);
+    }
+  }
+  n->flags &= ~(NB_SYM | NB_MPR);
+  arc_removed(&linkaddr_node_addr, &n->addr);
+}
+
+// Ensemble des sélecteurs modifié : nouvel ANSN (section 9.3) / Selector set changed: new ANSN (section 9.3)
+static void selectors_changed(void) {
+  uint8_t any = 0;
+
+  ansn++;
+  for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+    any |= nbrs[i].flags & NB_SELECTOR;
+  }
+  if(!any) {
+    tc_empty_until = clock_time() + OLSR_TOP_HOLD_TIME;
+  }
+}
+
+// Détection de voisinage (section 7.1.1, 8.1) et voisins à deux sauts (section 8.2.1)
+// Neighborhood sensing (section 7.1.1, 8.1) and two-hop neighbors (section 8.2.1)
+static void hello_input(const linkaddr_t *from, const uint8_t *buf, uint16_t len) {
+  struct olsr_nbr *n;
+  clock_time_t now = clock_time();
+  uint8_t count = buf[3], changed = 0;
+  uint8_t was_sym;
+
+  if(len != HELLO_HDR + count * HELLO_ENTRY) {
+    return;
+  }
+  n = nbr_find(from);
+  if(n == NULL && (n = nbr_add(from)) == NULL) {
+    return;
+  }
+  was_sym = n->flags & NB_SYM;
+  n->willingness = buf[2];
+  n->asym_until = now + OLSR_NEIGHB_HOLD_TIME;
+  for(uint8_t k=0; k<count; k++) {
+    const uint8_t *e = buf + HELLO_HDR + k * HELLO_ENTRY;
+    if(memcmp(e, &linkaddr_node_addr, LINKADDR_SIZE) == 0) {
+      n->sym_until = now + OLSR_NEIGHB_HOLD_TIME;
+      if(e[LINKADDR_SIZE] == LINK_MPR) {
+        n->selector_until = now + OLSR_NEIGHB_HOLD_TIME;
+        if(!(n->flags & NB_SELECTOR)) {
+          n->flags |= NB_SELECTOR;
+          selectors_changed();
+        }
+      }
+    }
+  }
+  if(!CLOCK_LT(now, n->sym_until)) {
+    return;
+  }
+  if(!was_sym) {
+    n->flags |= NB_SYM;
+    changed = 1;
+    arc_added(&linkaddr_node_addr, from);
+  }
+
+  // Voisins symétriques de l'émetteur : ajoutés ou rafraîchis, les autres retirés
+  // Symmetric neighbors of the sender: added or refreshed, the others removed
+  for(uint8_t k=0; k<count; k++) {
+    const uint8_t *e = buf + HELLO_HDR + k * HELLO_ENTRY;
+    struct olsr_twohop *t;
+    linkaddr_t a;
+    if(e[LINKADDR_SIZE] == LINK_ASYM) {
+      continue;
+    }
+    memcpy(&a, e, LINKADDR_SIZE);
+    if(is_me(&a)) {
+      continue;
+    }
+    t = twohop_find(from, &a);
+    if(t == NULL) {
+      for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+        if(!twohop[i].used) {
+          t = &twohop[i];
+          break;
+        }
+      }
+      if(t == NULL) {
+        continue;
+      }
+      linkaddr_copy(&t->via, from);
+      linkaddr_copy(&t->addr, &a);
+      t->used = 1;
+      changed = 1;
+      arc_added(from, &a);
+    }
+    t->expires = now + OLSR_NEIGHB_HOLD_TIME;
+  }
+  for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+    struct olsr_twohop *t = &twohop[i];
+    uint8_t listed = 0;
+    if(!t->used || !linkaddr_cmp(&t->via, from)) {
+      continue;
+    }
+    for(uint8_t k=0; k<count && !listed; k++) {
+      const uint8_t *e = buf + HELLO_HDR + k * HELLO_ENTRY;
+      listed = e[LINKADDR_SIZE] != LINK_ASYM && memcmp(e, &t->addr, LINKADDR_SIZE) == 0;
+    }
+    if(!listed) {
+      twohop_remove(t);
+      changed = 1;
+    }
+  }
+  if(changed) {
+    mpr_select();
+  }
+}
+
+// TC (section 9) / TC (section 9)
+
+static void tc_send(void) {
+  uint8_t buf[TC_MAX];
+  uint16_t len = TC_HDR;
+  uint8_t count = 0;
+
+  for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+    if(nbrs[i].flags & NB_SELECTOR) {
+      memcpy(buf + len, &nbrs[i].addr, LINKADDR_SIZE);
+      len += LINKADDR_SIZE;
+      count++;
+    }
+  }
+  if(count == 0 && !is_root && !CLOCK_LT(clock_time(), tc_empty_until)) {
+    return;
+  }
+  buf[0] = OLSR_TC;
+  buf[1] = is_root ? MSG_FLAG_ROOT : 0;
+  buf[2] = TC_TTL;
+  buf[3] = 0;
+  put16(buf + TC_SEQ, ++msg_seq);
+  put16(buf + TC_ANSN, ansn);
+  memcpy(buf + TC_ORIG, &linkaddr_node_addr, LINKADDR_SIZE);
+  buf[TC_COUNT] = count;
+  send_msg(buf, len);
+  stats.tc_sent++;
+}
+
+// Message déjà reçu (section 3.4) ; sinon enregistré / Message already received (section 3.4); otherwise recorded
+static struct olsr_dup *dup_lookup(const linkaddr_t *orig, uint16_t seq, uint8_t *fresh) {
+  clock_time_t now = clock_time();
+  struct olsr_dup *d;
+
+  for(uint8_t i=0; i<DUP_NUM; i++) {
+    if(dups[i].seq == seq && CLOCK_LT(now, dups[i].expires) && linkaddr_cmp(&dups[i].orig, orig)) {
+      *fresh = 0;
+      return &dups[i];
+    }
+  }
+  d = &dups[dup_pos];
+  dup_pos = (dup_pos + 1) % DUP_NUM;
+  linkaddr_copy(&d->orig, orig);
+  d->seq = seq;
+  d->expires = now + DUP_HOLD_TIME;
+  d->retransmitted = 0;
+  *fresh = 1;
+  return d;
+}
+
+// Ensemble topologique (section 9.5) : ANSN plus ancien ignoré, liens périmés retirés
+// Topology set (section 9.5): older ANSN ignored, outdated links removed
+static void tc_process(const linkaddr_t *orig, uint16_t tc_ansn, const uint8_t *adv, uint8_t count) {
+  clock_time_t now = clock_time();
+
+  for(uint8_t i=0; i<OLSR_MAX_TOPOLOGY; i++) {
+    if(topo[i].used && linkaddr_cmp(&topo[i].last, orig) && seq_newer(topo[i].ansn, tc_ansn)) {
+      return;
+    }
+  }
+  for(uint8_t i=0; i<OLSR_MAX_TOPOLOGY; i++) {
+    struct olsr_topo *t = &topo[i];
+    if(t->used && linkaddr_cmp(&t->last, orig) && t->ansn != tc_ansn) {
+      linkaddr_t dest;
+      linkaddr_copy(&dest, &t->dest);
+      t->used = 0;
+      arc_removed(orig, &dest);
+    }
+  }
+  for(uint8_t k=0; k<count; k++) {
+    struct olsr_topo *t = NULL, *free_slot = NULL;
+    linkaddr_t a;
+    memcpy(&a, adv + k * LINKADDR_SIZE, LINKADDR_SIZE);
+    if(is_me(&a)) {
+      continue;
+    }
+    for(uint8_t i=0; i<OLSR_MAX_TOPOLOGY && t == NULL; i++) {
+      if(!topo[i].used) {
+        free_slot = free_slot != NULL ? free_slot : &topo[i];
+      } else if(linkaddr_cmp(&topo[i].last, orig) && linkaddr_cmp(&topo[i].dest, &a)) {
+        t = &topo[i];
+      }
+    }
+    if(t == NULL) {
+      if(free_slot == NULL) {
+        continue;
+      }
+      t = free_slot;
+      linkaddr_copy(&t->last, orig);
+      linkaddr_copy(&t->dest, &a);
+      t->used = 1;
+      t->ansn = tc_ansn;
+      t->expires = now + OLSR_TOP_HOLD_TIME;
+      arc_added(orig, &a);
+    }
+    t->ansn = tc_ansn;
+    t->expires = now + OLSR_TOP_HOLD_TIME;
+  }
+}
+
+// Traitement puis relais par les seuls MPR de l'émetteur (section 3.4.1)
+// Processing then relaying by the sender's MPRs only (section 3.4.1)
+static void tc_input(const linkaddr_t *from, uint8_t *buf, uint16_t len) {
+  const struct olsr_nbr *n = nbr_sym(from);
+  struct olsr_dup *d;
+  linkaddr_t orig;
+  uint8_t fresh;
+
+  if(len < TC_HDR || len != TC_HDR + buf[TC_COUNT] * LINKADDR_SIZE || n == NULL) {
+    return;
+  }
+  memcpy(&orig, buf + TC_ORIG, LINKADDR_SIZE);
+  if(is_me(&orig)) {
+    return;
+  }
+  d = dup_lookup(&orig, get16(buf + TC_SEQ), &fresh);
+  if(fresh) {
+    if(buf[1] & MSG_FLAG_ROOT) {
+      linkaddr_copy(&root_addr, &orig);
+      have_root = 1;
+    }
+    tc_process(&orig, get16(buf + TC_ANSN), buf + TC_HDR, buf[TC_COUNT]);
+    root_route_update();
+  }
+  if(d->retransmitted || buf[2] <= 1) {
+    return;
+  }
+  if(!(n->flags & NB_SELECTOR)) {
+    stats.tc_suppressed += fresh;
+    return;
+  }
+  d->retransmitted = 1;
+  buf[2]--;
+  buf[3]++;
+  send_jittered(buf, len);
+  stats.tc_sent++;
+  stats.tc_forwarded++;
+}
+
+static void olsr_rx_callback(struct simple_udp_connection *c, const uip_ipaddr_t *sender_addr,
+                             uint16_t sender_port, const uip_ipaddr_t *receiver_addr,
+                             uint16_t receiver_port, const uint8_t *data, uint16_t datalen) {
+  static uint8_t buf[MSG_MAX];
+  linkaddr_t from;
+
+  if(datalen < HELLO_HDR || datalen > sizeof(buf)) {
+    return;
+  }
+  memcpy(buf, data, datalen);
+  dseran_net_lladdr_from_ipaddr(&from, sender_addr);
+  LOG_INFO("RECV %u %lu\n", dseran_energy_residual(), (unsigned long)clock_time());
+
+  switch(buf[0]) {
+  case OLSR_HELLO:
+    hello_input(&from, buf, datalen);
+    if((buf[1] & MSG_FLAG_ROOT) && !have_root) {
+      linkaddr_copy(&root_addr, &from);
+      have_root = 1;
+      root_route_update();
+    }
+    break;
+  case OLSR_TC:
+    tc_input(&from, buf, datalen);
+    break;
+  default:
+    LOG_WARN("Message OLSR inconnu / unknown OLSR message %u\n", buf[0]);
+  }
+}
+
+// Liens, sélecteurs et ensemble topologique expirés (sections 8.1, 8.4.1, 9.4)
+// Expired links, selectors and topology set (sections 8.1, 8.4.1, 9.4)
+static void purge(void) {
+  clock_time_t now = clock_time();
+  uint8_t changed = 0;
+
+  for(uint8_t i=0; i<OLSR_MAX_TOPOLOGY; i++) {
+    struct olsr_topo *t = &topo[i];
+    if(t->used && !CLOCK_LT(now, t->expires)) {
+      linkaddr_t last, dest;
+      linkaddr_copy(&last, &t->last);
+      linkaddr_copy(&dest, &t->dest);
+      t->used = 0;
+      arc_removed(&last, &dest);
+    }
+  }
+  for(uint8_t i=0; i<OLSR_MAX_TWOHOP; i++) {
+    if(twohop[i].used && !CLOCK_LT(now, twohop[i].expires)) {
+      twohop_remove(&twohop[i]);
+      changed = 1;
+    }
+  }
+  for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+    struct olsr_nbr *n = &nbrs[i];
+    if(!(n->flags & NB_USED)) {
+      continue;
+    }
+    if((n->flags & NB_SELECTOR) && !CLOCK_LT(now, n->selector_until)) {
+      n->flags &= ~NB_SELECTOR;
+      selectors_changed();
+    }
+    if((n->flags & NB_SYM) && !CLOCK_LT(now, n->sym_until)) {
+      nbr_sym_lost(n);
+      changed = 1;
+    }
+    if(!CLOCK_LT(now, n->asym_until)) {
+      if(n->flags & NB_SELECTOR) {
+        selectors_changed();
+      }
+      n->flags = 0;
+    }
+  }
+  if(changed) {
+    mpr_select();
+  }
+}
+
+PROCESS_THREAD(olsr_process, ev, data) {
+  static struct etimer hello_timer, tc_timer, purge_timer;
+
+  PROCESS_BEGIN();
+
+  simple_udp_register(&olsr_conn, OLSR_UDP_PORT, NULL, OLSR_UDP_PORT, olsr_rx_callback);
+  // Émissions périodiques avancées d'une gigue (section 18.3) / Periodic emissions advanced by a jitter (section 18.3)
+  etimer_set(&hello_timer, random_rand() % OLSR_HELLO_INTERVAL);
+  etimer_set(&tc_timer, OLSR_TC_INTERVAL - random_rand() % MAXJITTER);
+  etimer_set(&purge_timer, PURGE_INTERVAL);
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&hello_timer) || etimer_expired(&tc_timer) ||
+                             etimer_expired(&purge_timer));
+    if(etimer_expired(&purge_timer)) {
+      purge();
+      etimer_reset(&purge_timer);
+    }
+    if(etimer_expired(&hello_timer)) {
+      hello_send();
+      etimer_set(&hello_timer, OLSR_HELLO_INTERVAL - random_rand() % MAXJITTER);
+    }
+    if(etimer_expired(&tc_timer)) {
+      tc_send();
+      etimer_set(&tc_timer, OLSR_TC_INTERVAL - random_rand() % MAXJITTER);
+    }
+  }
+
+  PROCESS_END();
+}
+
+// Interface publique / Public interface
+
+uint8_t olsr_route_lookup(const linkaddr_t *dest, linkaddr_t *next_hop, uint8_t *hops) {
+  const struct olsr_route *r = route_find(dest);
+
+  if(r == NULL) {
+    return 0;
+  }
+  if(next_hop != NULL) {
+    linkaddr_copy(next_hop, &r->next);
+  }
+  if(hops != NULL) {
+    *hops = r->hops;
+  }
+  return 1;
+}
+
+uint8_t olsr_mpr_count(void) {
+  uint8_t count = 0;
+
+  for(uint8_t i=0; i<OLSR_MAX_NEIGHBORS; i++) {
+    count += (nbrs[i].flags & NB_MPR) != 0;
+  }
+  return count;
+}
+
+const struct olsr_stats *olsr_get_stats(void) {
+  return &stats;
+}
+
+// Interface du pilote de routage / Routing driver interface
+
+// Adresse globale fd00::IID et adresse bien connue du puits, fd00::1
+// Global fd00::IID address and well-known sink address, fd00::1
+static void driver_init(void) {
+  dseran_net_global_from_lladdr(&my_ipaddr, &linkaddr_node_addr);
+  uip_ds6_addr_add(&my_ipaddr, 0, ADDR_AUTOCONF);
+  uip_ip6addr(&sink_ipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 1);
+  process_start(&olsr_process, NULL);
+}
+
+static int driver_root_start(void) {
+  if(!is_root) {
+    is_root = 1;
+    uip_ds6_addr_add(&sink_ipaddr, 0, ADDR_MANUAL);
+  }
+  return 0;
+}
+
+static int driver_node_is_root(void) {
+  return is_root;
+}
+
+static int driver_get_root_ipaddr(uip_ipaddr_t *ipaddr) {
+  uip_ipaddr_copy(ipaddr, &sink_ipaddr);
+  return 1;
+}
+
+// Proactif : joint dès que la table de routage mène au puits / Proactive: joined once the routing table leads to the sink
+static int driver_node_has_joined(void) {
+  return is_root || defrt_set;
+}
+
+static int driver_node_is_reachable(void) {
+  return driver_node_has_joined();
+}
+
+// Les liens ne se perdent que par l'absence de HELLO (section 8.1)
+// Links are only lost through missing HELLOs (section 8.1)
+static void driver_link_callback(const linkaddr_t *addr, int status, int numtx) {
+}
+
+const struct routing_driver olsr_routing_driver = {
+  "olsr",
+  driver_init,
+  dseran_net_root_set_prefix,
+  driver_root_start,
+  driver_node_is_root,
+  driver_get_root_ipaddr,
+  dseran_net_get_sr_node_ipaddr,
+  dseran_net_leave_network,
+  driver_node_has_joined,
+  driver_node_is_reachable,
+  dseran_net_repair,
+  dseran_net_repair,
+  dseran_net_ext_header_remove,
+  dseran_net_ext_header_update,
+  dseran_net_ext_header_hbh_update,
+  dseran_net_ext_header_srh_update,
+  dseran_net_ext_header_srh_get_next_hop,
+  driver_link_callback,
+  dseran_net_neighbor_state_changed,
+  dseran_net_drop_route,
+  dseran_net_is_in_leaf_mode,
+};
@@ -0,0 +1,113 @@
+/*
+ * olsr.h : Routage proactif OLSR (RFC 3626) pour Contiki-NG
+ * Proactive OLSR routing (RFC 3626) for Contiki-NG
+ *
+ * Auteur / Author: Madani Belacel
+ * Date: Août 2025
+ *
+ * Pilote de routage olsr_routing_driver : HELLO périodiques annonçant les
+ * liens (asymétriques, symétriques, MPR) d'où chaque nœud tire ses voisins
+ * symétriques et ses voisins à deux sauts ; choix glouton des relais
+ * multipoints (MPR) couvrant tout le voisinage à deux sauts ; TC annonçant
+ * les sélecteurs MPR, relayés par les seuls MPR de l'émetteur ; table de
+ * routage en plus courts chemins (sauts) tenue à jour incrémentalement à
+ * chaque lien ajouté ou perdu, sans recalcul complet. uIP route les données
+ * vers le puits par une route par défaut vers le prochain saut du chemin.
+ * Les messages passent en UDP (port 698) sur les adresses lien-local.
+ * Routing driver olsr_routing_driver: periodic HELLOs advertising the links
+ * (asymmetric, symmetric, MPR) from which every node derives its symmetric
+ * neighbors and its two-hop neighbors; greedy selection of the multipoint
+ * relays (MPR) covering the whole two-hop neighborhood; TCs advertising the
+ * MPR selectors, relayed by the sender's MPRs only; shortest-path (hops)
+ * routing table kept up to date incrementally on every link added or lost,
+ * without a full recomputation. uIP routes data to the sink through a
+ * default route towards the next hop of the path. Messages go over UDP
+ * (port 698) on link-local addresses.
+ */
+
+#ifndef OLSR_H_
+#define OLSR_H_
+
+#include "contiki.h"
+#include "net/linkaddr.h"
+
+// Intervalles d'émission (RFC 3626, section 18.2) / Emission intervals (RFC 3626, section 18.2)
+#ifdef OLSR_CONF_HELLO_INTERVAL
+#define OLSR_HELLO_INTERVAL OLSR_CONF_HELLO_INTERVAL
+#else
+#define OLSR_HELLO_INTERVAL (CLOCK_SECOND * 2)
+#endif
+#ifdef OLSR_CONF_TC_INTERVAL
+#define OLSR_TC_INTERVAL OLSR_CONF_TC_INTERVAL
+#else
+#define OLSR_TC_INTERVAL (CLOCK_SECOND * 5)
+#endif
+
+// Durées de validité : trois intervalles / Holding times: three intervals
+#define OLSR_NEIGHB_HOLD_TIME (3 * OLSR_HELLO_INTERVAL)
+#define OLSR_TOP_HOLD_TIME    (3 * OLSR_TC_INTERVAL)
+
+// Voisins directs / Direct neighbors
+#ifdef OLSR_CONF_MAX_NEIGHBORS
+#define OLSR_MAX_NEIGHBORS OLSR_CONF_MAX_NEIGHBORS
+#elif defined(NBR_TABLE_CONF_MAX_NEIGHBORS)
+#define OLSR_MAX_NEIGHBORS NBR_TABLE_CONF_MAX_NEIGHBORS
+#else
+#define OLSR_MAX_NEIGHBORS 16
+#endif
+
+// Liens (voisin, voisin à deux sauts) / (neighbor, two-hop neighbor) links
+#ifdef OLSR_CONF_MAX_TWOHOP
+#define OLSR_MAX_TWOHOP OLSR_CONF_MAX_TWOHOP
+#else
+#define OLSR_MAX_TWOHOP 48
+#endif
+
+// Liens (dernier saut, destination) appris des TC / (last hop, destination) links learnt from TCs
+#ifdef OLSR_CONF_MAX_TOPOLOGY
+#define OLSR_MAX_TOPOLOGY OLSR_CONF_MAX_TOPOLOGY
+#else
+#define OLSR_MAX_TOPOLOGY 96
+#endif
+
+// Destinations de la table de routage / Routing table destinations
+#ifdef OLSR_CONF_MAX_ROUTES
+#define OLSR_MAX_ROUTES OLSR_CONF_MAX_ROUTES
+#else
+#define OLSR_MAX_ROUTES 64
+#endif
+
+// Disposition à relayer (section 18.8) / Willingness to relay (section 18.8)
+#define OLSR_WILL_NEVER   0
+#define OLSR_WILL_DEFAULT 3
+#define OLSR_WILL_ALWAYS  7
+#ifdef OLSR_CONF_WILLINGNESS
+#define OLSR_WILLINGNESS OLSR_CONF_WILLINGNESS
+#else
+#define OLSR_WILLINGNESS OLSR_WILL_DEFAULT
+#endif
+
+#define OLSR_UDP_PORT 698
+
+// Compteurs depuis le démarrage / Counters since boot
+struct olsr_stats {
+  uint32_t hello_sent;
+  uint32_t tc_sent;           // émis ou relayés / originated or relayed
+  uint32_t tc_forwarded;
+  uint32_t tc_suppressed;     // reçus sans relais : émetteur non sélecteur / received without relaying: sender not a selector
+  uint32_t ctrl_bytes;        // charge UDP de contrôle émise / control UDP payload sent
+  uint32_t mpr_changes;
+  uint32_t spf_updates;       // mises à jour incrémentales / incremental updates
+  uint32_t spf_touched;       // destinations revues par ces mises à jour / destinations revisited by them
+};
+
+// Vrai si une route mène à dest (sauts dans *hops si non NULL)
+// True when a route leads to dest (hops in *hops when not NULL)
+uint8_t olsr_route_lookup(const linkaddr_t *dest, linkaddr_t *next_hop, uint8_t *hops);
+
+// Nombre de MPR choisis / Number of selected MPRs
+uint8_t olsr_mpr_count(void);
+
+const struct olsr_stats *olsr_get_stats(void);
+
+#endif /* OLSR_H_ */
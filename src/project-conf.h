@@ -12,25 +12,104 @@
 #ifndef PROJECT_CONF_H_
 #define PROJECT_CONF_H_
 
+// Profil de compilation et tables par cible, prioritaires sur les valeurs ci-dessous
+// Build profile and per-target tables, taking precedence over the values below
+#include "dseran-profile.h"
+
 // Configuration spécifique D-SERAN / D-SERAN specific configuration
 #ifdef D_SERAN_CONF
 #define NETSTACK_CONF_ROUTING d_seran_routing_driver
+// CSMA sous le chien de garde des relais ou une attaque (dseran-watchdog.h)
+// CSMA under the relay watchdog or an attack (dseran-watchdog.h)
+#if DSERAN_CONF_WATCHDOG || DSERAN_CONF_ATTACK
+#define NETSTACK_CONF_MAC dseran_watchdog_mac_driver
+#endif
+// TSCH (make MAC=tsch) : ordonnancement D-SERAN au lieu du 6TiSCH minimal (dseran-tsch.h)
+// TSCH (make MAC=tsch): D-SERAN schedule instead of the 6TiSCH minimal one (dseran-tsch.h)
+#if DSERAN_CONF_TSCH
+#define TSCH_SCHEDULE_CONF_WITH_6TISCH_MINIMAL 0
+#define TSCH_SCHEDULE_CONF_MAX_SLOTFRAMES      2
+#ifndef DSERAN_CONF_TSCH_RX_CELLS
+#define DSERAN_CONF_TSCH_RX_CELLS              3
+#endif
+// Case partagée, cases d'écoute, case d'émission / Shared cell, listening cells, transmit cell
+#define TSCH_SCHEDULE_CONF_MAX_LINKS           (2 + DSERAN_CONF_TSCH_RX_CELLS)
+#define TSCH_CONF_AUTOSTART                    0
+#define TSCH_CALLBACK_JOINING_NETWORK          dseran_tsch_joined
+#endif
+#endif
+
+// Référence AODV (Makefile.aodv) / AODV baseline (Makefile.aodv)
+#ifdef AODV_CONF
+#define NETSTACK_CONF_ROUTING aodv_routing_driver
+#endif
+
+// Référence DSR (Makefile.dsr) / DSR baseline (Makefile.dsr)
+#ifdef DSR_CONF
+#define NETSTACK_CONF_ROUTING dsr_routing_driver
+#endif
+
+// Référence OLSR (Makefile.olsr) / OLSR baseline (Makefile.olsr)
+#ifdef OLSR_CONF
+#define NETSTACK_CONF_ROUTING olsr_routing_driver
 #endif
 
 // Paramètres réseau généraux / General network parameters
 #define UIP_CONF_ROUTER              1
 #define ENERGEST_CONF_ON             1
 
-// Niveaux de log pour différents composants / Log levels for different components
-#define LOG_CONF_LEVEL_RPL           LOG_LEVEL_WARN
-#define LOG_CONF_LEVEL_TCPIP         LOG_LEVEL_WARN
-#define LOG_CONF_LEVEL_IPV6          LOG_LEVEL_WARN
-#define LOG_CONF_LEVEL_MAC           LOG_LEVEL_WARN
-#define LOG_CONF_LEVEL_FRAMER        LOG_LEVEL_WARN
+// Niveaux de log pour différents composants (selon le profil) / Log levels for different components (per profile)
+#define LOG_CONF_LEVEL_RPL           DSERAN_STACK_LOG_LEVEL
+#define LOG_CONF_LEVEL_TCPIP         DSERAN_STACK_LOG_LEVEL
+#define LOG_CONF_LEVEL_IPV6          DSERAN_STACK_LOG_LEVEL
+#define LOG_CONF_LEVEL_MAC           DSERAN_STACK_LOG_LEVEL
+#define LOG_CONF_LEVEL_FRAMER        DSERAN_STACK_LOG_LEVEL
 
-// Configuration des buffers et tables / Buffer and table configuration
+// Configuration des buffers et tables (réduites sur sky et z1) / Buffer and table configuration (reduced on sky and z1)
+#ifndef QUEUEBUF_CONF_NUM
 #define QUEUEBUF_CONF_NUM            16
+#endif
+#ifndef UIP_CONF_MAX_ROUTES
 #define UIP_CONF_MAX_ROUTES          16
+#endif
+#ifndef NBR_TABLE_CONF_MAX_NEIGHBORS
 #define NBR_TABLE_CONF_MAX_NEIGHBORS 16
+#endif
+
+// Capacité de la table des voisins D-SERAN (indépendante de la table uIP)
+// D-SERAN neighbor table capacity (independent of the uIP table)
+// RAM par entrée affichée au démarrage (NBR_RAM) / RAM per entry printed at boot (NBR_RAM)
+#ifndef DSERAN_CONF_MAX_NEIGHBORS
+#define DSERAN_CONF_MAX_NEIGHBORS    16
+#endif
+
+// Hellos Trickle : intervalle minimal et nombre de doublements (Imax = Imin << doublements)
+// Trickle hellos: minimal interval and number of doublings (Imax = Imin << doublings)
+#ifndef DSERAN_CONF_HELLO_IMIN
+#define DSERAN_CONF_HELLO_IMIN       (CLOCK_SECOND * 2)
+#endif
+#ifndef DSERAN_CONF_HELLO_IDOUBLINGS
+#define DSERAN_CONF_HELLO_IDOUBLINGS 4
+#endif
+
+// Un voisin silencieux expire après trois intervalles maximaux
+// A silent neighbor expires after three maximal intervals
+#ifndef DSERAN_CONF_ROUTE_TIMEOUT
+#define DSERAN_CONF_ROUTE_TIMEOUT    (3 * (DSERAN_CONF_HELLO_IMIN << DSERAN_CONF_HELLO_IDOUBLINGS))
+#endif
+
+// Budget énergétique mesuré par energest (mJ) et seuil d'éligibilité d'un voisin
+// Energy budget measured through energest (mJ) and neighbor eligibility threshold
+#ifndef DSERAN_CONF_INIT_ENERGY
+#define DSERAN_CONF_INIT_ENERGY      60000
+#endif
+#ifndef DSERAN_CONF_ENERGY_THRESHOLD
+#define DSERAN_CONF_ENERGY_THRESHOLD 1000
+#endif
+// Énergie sur 8 bits dans les hellos : 60 J / 255 ~ 236 mJ par pas
+// 8-bit energy in hellos: 60 J / 255 ~ 236 mJ per step
+#ifndef DSERAN_CONF_HELLO_ENERGY_STEP
+#define DSERAN_CONF_HELLO_ENERGY_STEP 236
+#endif
 
 #endif /* PROJECT_CONF_H_ */ 
\ No newline at end of file